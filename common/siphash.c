@@ -0,0 +1,169 @@
+/*******************************************************************************
+* File Name        : siphash.c
+*
+* Description      : This file contains SipHash-2-4, a keyed hash that serves as a
+*                    pseudorandom function. It depends on no other source of either
+*                    project, so that it can be built into the secure image.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "siphash.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Initial state of SipHash ("somepseudorandomlygeneratedbytes") and its
+ * numbers of compression and finalization rounds.
+ */
+#define SIPHASH_V0                           (0x736F6D6570736575ULL)
+#define SIPHASH_V1                           (0x646F72616E646F6DULL)
+#define SIPHASH_V2                           (0x6C7967656E657261ULL)
+#define SIPHASH_V3                           (0x7465646279746573ULL)
+#define SIPHASH_C_ROUNDS                     (2U)
+#define SIPHASH_D_ROUNDS                     (4U)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: load_le64
+********************************************************************************
+* Summary:
+* Reads a little-endian 64-bit word from any alignment.
+*******************************************************************************/
+static inline uint64_t load_le64(const uint8_t *p)
+{
+    uint64_t value = 0U;
+
+    for (uint32_t i = 0; i < 8U; i++)
+    {
+        value |= (uint64_t)p[i] << (8U * i);
+    }
+
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: rotl64
+********************************************************************************
+* Summary:
+* Rotates a 64-bit word left.
+*******************************************************************************/
+static inline uint64_t rotl64(uint64_t x, uint32_t bits)
+{
+    return (x << bits) | (x >> (64U - bits));
+}
+
+/*******************************************************************************
+* Function Name: sip_rounds
+********************************************************************************
+* Summary:
+* Applies SipRounds to the SipHash state.
+*******************************************************************************/
+static void sip_rounds(uint64_t *v, uint32_t rounds)
+{
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        v[0] += v[1];
+        v[1] = rotl64(v[1], 13U);
+        v[1] ^= v[0];
+        v[0] = rotl64(v[0], 32U);
+        v[2] += v[3];
+        v[3] = rotl64(v[3], 16U);
+        v[3] ^= v[2];
+        v[0] += v[3];
+        v[3] = rotl64(v[3], 21U);
+        v[3] ^= v[0];
+        v[2] += v[1];
+        v[1] = rotl64(v[1], 17U);
+        v[1] ^= v[2];
+        v[2] = rotl64(v[2], 32U);
+    }
+}
+
+/*******************************************************************************
+* Function Name: siphash_2_4
+********************************************************************************
+* Summary:
+* Computes SipHash-2-4 of a buffer. Unlike a plain hash, it is a keyed
+* pseudorandom function: without the key, its values cannot be predicted or
+* inverted, even for inputs from a small set.
+*
+* Parameters:
+*  const uint8_t *key: SIPHASH_KEY_SIZE bytes of key
+*  const uint8_t *data: Data
+*  uint32_t length: Length of the data
+*
+* Return:
+*  uint64_t: Hash
+*
+*******************************************************************************/
+uint64_t siphash_2_4(const uint8_t *key, const uint8_t *data, uint32_t length)
+{
+    uint64_t k0 = load_le64(key);
+    uint64_t k1 = load_le64(&key[8]);
+    uint64_t v[4] = { k0 ^ SIPHASH_V0, k1 ^ SIPHASH_V1, k0 ^ SIPHASH_V2, k1 ^ SIPHASH_V3 };
+    uint32_t end = length & ~7U;
+    uint64_t last = (uint64_t)length << 56;
+
+    for (uint32_t i = 0; i < end; i += 8U)
+    {
+        uint64_t m = load_le64(&data[i]);
+
+        v[3] ^= m;
+        sip_rounds(v, SIPHASH_C_ROUNDS);
+        v[0] ^= m;
+    }
+
+    for (uint32_t i = end; i < length; i++)
+    {
+        last |= (uint64_t)data[i] << (8U * (i - end));
+    }
+
+    v[3] ^= last;
+    sip_rounds(v, SIPHASH_C_ROUNDS);
+    v[0] ^= last;
+    v[2] ^= 0xFFU;
+    sip_rounds(v, SIPHASH_D_ROUNDS);
+
+    return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,304 @@
+/*******************************************************************************
+* File Name        : anomaly_detector.c
+*
+* Description      : This file contains the RF anomaly detector. Each feature of a
+*                    full sweep is compared with the median and the median absolute
+*                    deviation of the previous ANOMALY_WINDOW sweeps, so a few
+*                    unusual sweeps in the window do not shift the baseline. The
+*                    cost per sweep is bounded by the fixed window size.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "anomaly_detector.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Scales the MAD to the standard deviation of normally distributed data. */
+#define MAD_TO_SIGMA                         (1.4826f)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    float    samples[ANOMALY_WINDOW];
+    uint32_t head;
+    uint32_t count;
+} feature_window_t;
+
+static MODULE_STATE feature_window_t anomaly_windows[ANOMALY_FEATURE_COUNT];
+static MODULE_STATE anomaly_status_t anomaly_state;
+
+/* Lower bound of the scale of every feature. A quiet environment gives a MAD
+ * of zero, which would flag any change of a single AP or a single dB.
+ */
+static const float min_scale[ANOMALY_FEATURE_COUNT] =
+{
+    [ANOMALY_FEATURE_AP_COUNT]  = 1.0f,
+    [ANOMALY_FEATURE_MEAN_RSSI] = 1.0f,
+    [ANOMALY_FEATURE_DROPOUT]   = 20.0f
+};
+
+static const char * const flag_names[ANOMALY_FLAG_COUNT] =
+{
+    "AP count collapse",
+    "AP count drift",
+    "RSSI shift",
+    "dropout spike"
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: median
+********************************************************************************
+* Summary:
+* Returns the median of 'count' values, sorting them in place. Insertion sort
+* is used because the window is small and fixed.
+*******************************************************************************/
+static float median(float *values, uint32_t count)
+{
+    for (uint32_t i = 1; i < count; i++)
+    {
+        float v = values[i];
+        uint32_t j = i;
+
+        while ((j > 0U) && (values[j - 1U] > v))
+        {
+            values[j] = values[j - 1U];
+            j--;
+        }
+
+        values[j] = v;
+    }
+
+    return ((count & 1U) != 0U) ? values[count / 2U] :
+           ((values[(count / 2U) - 1U] + values[count / 2U]) * 0.5f);
+}
+
+/*******************************************************************************
+* Function Name: window_baseline
+********************************************************************************
+* Summary:
+* Computes the median and the scale (MAD based) of a feature window.
+*******************************************************************************/
+static void window_baseline(const feature_window_t *window, uint32_t feature,
+                            anomaly_baseline_t *baseline)
+{
+    float values[ANOMALY_WINDOW];
+    float scale;
+
+    memcpy(values, window->samples, window->count * sizeof(float));
+    baseline->median = median(values, window->count);
+
+    for (uint32_t i = 0; i < window->count; i++)
+    {
+        float deviation = window->samples[i] - baseline->median;
+
+        values[i] = (deviation < 0.0f) ? -deviation : deviation;
+    }
+
+    scale = MAD_TO_SIGMA * median(values, window->count);
+    baseline->scale = (scale < min_scale[feature]) ? min_scale[feature] : scale;
+}
+
+/*******************************************************************************
+* Function Name: anomaly_detector_init
+********************************************************************************
+* Summary:
+* Clears the baselines and the statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void anomaly_detector_init(void)
+{
+    memset(anomaly_windows, 0, sizeof(anomaly_windows));
+    memset(&anomaly_state, 0, sizeof(anomaly_state));
+}
+
+/*******************************************************************************
+* Function Name: anomaly_detector_update
+********************************************************************************
+* Summary:
+* Scores the features of a full sweep against the baseline of the previous
+* sweeps and then adds them to the baseline.
+*
+* Parameters:
+*  const float *features: ANOMALY_FEATURE_COUNT values of the sweep
+*
+* Return:
+*  uint8_t: ANOMALY_* flags raised by the sweep, 0 if none
+*
+*******************************************************************************/
+uint8_t anomaly_detector_update(const float *features)
+{
+    uint8_t flags = 0;
+    bool ready = (anomaly_windows[0].count >= ANOMALY_MIN_BASELINE);
+
+    for (uint32_t f = 0; f < ANOMALY_FEATURE_COUNT; f++)
+    {
+        feature_window_t *window = &anomaly_windows[f];
+        anomaly_baseline_t *baseline = &anomaly_state.feature[f];
+
+        baseline->last = features[f];
+
+        if (ready)
+        {
+            window_baseline(window, f, baseline);
+            baseline->last_z = (features[f] - baseline->median) / baseline->scale;
+        }
+
+        window->samples[window->head] = features[f];
+        window->head = (window->head + 1U) % ANOMALY_WINDOW;
+
+        if (window->count < ANOMALY_WINDOW)
+        {
+            window->count++;
+        }
+    }
+
+    if (!ready)
+    {
+        return 0U;
+    }
+
+    float z_ap = anomaly_state.feature[ANOMALY_FEATURE_AP_COUNT].last_z;
+    float z_rssi = anomaly_state.feature[ANOMALY_FEATURE_MEAN_RSSI].last_z;
+
+    if (z_ap <= -ANOMALY_Z_THRESHOLD)
+    {
+        flags |= ANOMALY_AP_COLLAPSE;
+    }
+
+    anomaly_state.cusum += (-z_ap) - ANOMALY_CUSUM_SLACK;
+
+    if (anomaly_state.cusum < 0.0f)
+    {
+        anomaly_state.cusum = 0.0f;
+    }
+    else if (anomaly_state.cusum >= ANOMALY_CUSUM_LIMIT)
+    {
+        flags |= ANOMALY_AP_DRIFT;
+        anomaly_state.cusum = 0.0f;
+    }
+
+    if ((z_rssi >= ANOMALY_Z_THRESHOLD) || (z_rssi <= -ANOMALY_Z_THRESHOLD))
+    {
+        flags |= ANOMALY_RSSI_SHIFT;
+    }
+
+    if (anomaly_state.feature[ANOMALY_FEATURE_DROPOUT].last_z >= ANOMALY_Z_THRESHOLD)
+    {
+        flags |= ANOMALY_DROPOUT_SPIKE;
+    }
+
+    anomaly_state.scans++;
+    anomaly_state.last_flags = flags;
+
+    if (0U != flags)
+    {
+        anomaly_state.flagged_scans++;
+
+        for (uint32_t i = 0; i < ANOMALY_FLAG_COUNT; i++)
+        {
+            if (0U != (flags & (1U << i)))
+            {
+                anomaly_state.flag_counts[i]++;
+            }
+        }
+    }
+
+    return flags;
+}
+
+/*******************************************************************************
+* Function Name: anomaly_detector_status
+********************************************************************************
+* Summary:
+* Returns the baselines, the last scores and the number of flagged sweeps.
+*
+* Parameters:
+*  anomaly_status_t *status: Detector status
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void anomaly_detector_status(anomaly_status_t *status)
+{
+    *status = anomaly_state;
+}
+
+/*******************************************************************************
+* Function Name: anomaly_flag_name
+********************************************************************************
+* Summary:
+* Returns the name of one anomaly flag.
+*
+* Parameters:
+*  uint8_t flag: One ANOMALY_* flag
+*
+* Return:
+*  const char*: Name of the flag
+*
+*******************************************************************************/
+const char* anomaly_flag_name(uint8_t flag)
+{
+    for (uint32_t i = 0; i < ANOMALY_FLAG_COUNT; i++)
+    {
+        if (flag == (1U << i))
+        {
+            return flag_names[i];
+        }
+    }
+
+    return "?";
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,133 @@
+/*******************************************************************************
+* File Name        : anomaly_detector.h
+*
+* Description      : This file contains the structures and function prototypes of
+*                    the RF anomaly detector.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_ANOMALY_DETECTOR_H_
+#define SOURCE_ANOMALY_DETECTOR_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of past full sweeps forming the baseline of every feature. */
+#define ANOMALY_WINDOW                       (32U)
+
+/* Full sweeps needed before anything is flagged. */
+#define ANOMALY_MIN_BASELINE                 (8U)
+
+/* A feature is anomalous when its robust z-score, (x - median) / (1.4826 *
+ * MAD), reaches this value.
+ */
+#define ANOMALY_Z_THRESHOLD                  (5.0f)
+
+/* One-sided CUSUM on the AP count z-score, which catches a gradual collapse
+ * that never crosses ANOMALY_Z_THRESHOLD in a single scan.
+ */
+#define ANOMALY_CUSUM_SLACK                  (1.0f)
+#define ANOMALY_CUSUM_LIMIT                  (8.0f)
+
+/* Anomaly flags */
+#define ANOMALY_AP_COLLAPSE                  (0x01U)
+#define ANOMALY_AP_DRIFT                     (0x02U)
+#define ANOMALY_RSSI_SHIFT                   (0x04U)
+#define ANOMALY_DROPOUT_SPIKE                (0x08U)
+#define ANOMALY_FLAG_COUNT                   (4U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+typedef enum
+{
+    ANOMALY_FEATURE_AP_COUNT = 0,   /* Unique BSSIDs in the scan */
+    ANOMALY_FEATURE_MEAN_RSSI,      /* Mean RSSI of the results in dBm */
+    ANOMALY_FEATURE_DROPOUT,        /* Per mille of the BSSIDs of the previous
+                                     * scan that disappeared */
+    ANOMALY_FEATURE_COUNT
+} anomaly_feature_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    float median;
+    float scale;
+    float last;
+    float last_z;
+} anomaly_baseline_t;
+
+typedef struct
+{
+    anomaly_baseline_t feature[ANOMALY_FEATURE_COUNT];
+    float    cusum;
+    uint32_t scans;
+    uint32_t flagged_scans;
+    uint32_t flag_counts[ANOMALY_FLAG_COUNT];
+    uint8_t  last_flags;
+} anomaly_status_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void anomaly_detector_init(void);
+uint8_t anomaly_detector_update(const float *features);
+void anomaly_detector_status(anomaly_status_t *status);
+const char* anomaly_flag_name(uint8_t flag);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_ANOMALY_DETECTOR_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,375 @@
+/*******************************************************************************
+* File Name        : bss_width.c
+*
+* Description      : This file contains the operating width decoder. It reads the
+*                    HT Operation element (40 MHz in the 2.4 GHz and 5 GHz bands),
+*                    the VHT Operation element or the VHT information of the HE
+*                    Operation element (80, 160 and 80+80 MHz in the 5 GHz band),
+*                    and the 6 GHz information of the HE Operation element.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "bss_width.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IE_HEADER_LENGTH                     (2U)
+
+/* HT Operation: primary channel, then the secondary channel offset (bits 0-1)
+ * and the STA channel width (bit 2).
+ */
+#define HT_MIN_LENGTH                        (2U)
+#define HT_SECONDARY_MASK                    (0x03U)
+#define HT_SECONDARY_ABOVE                   (1U)
+#define HT_SECONDARY_BELOW                   (3U)
+#define HT_ANY_WIDTH                         (0x04U)
+
+/* VHT Operation information: channel width, then the center frequency
+ * segments 0 and 1.
+ */
+#define VHT_INFO_LENGTH                      (3U)
+#define VHT_WIDTH_20_40                      (0U)
+#define VHT_WIDTH_80_160                     (1U)
+#define VHT_WIDTH_160                        (2U)
+#define VHT_WIDTH_80_80                      (3U)
+
+/* HE Operation: element ID extension, 3 bytes of parameters, the BSS color
+ * and the basic HE-MCS set, followed by optional fields.
+ */
+#define HE_FIXED_LENGTH                      (7U)
+#define HE_VHT_INFO_PRESENT                  (1UL << 14)
+#define HE_CO_HOSTED_BSS                     (1UL << 15)
+#define HE_6GHZ_INFO_PRESENT                 (1UL << 17)
+#define HE_CO_HOSTED_LENGTH                  (1U)
+
+/* 6 GHz Operation information: primary channel, control (width in bits 0-1),
+ * center frequency segments 0 and 1, minimum rate.
+ */
+#define HE_6GHZ_INFO_LENGTH                  (5U)
+#define HE_6GHZ_WIDTH_MASK                   (0x03U)
+#define HE_6GHZ_WIDTH_160                    (3U)
+
+/* Channel numbers of 20 MHz channels are 4 apart, so the center of a 160 MHz
+ * channel is 8 away from the center of its 80 MHz segment.
+ */
+#define CHANNEL_STEP                         (4U)
+#define SEGMENT_160_OFFSET                   (8U)
+
+#define CHANNEL_2_4GHZ_MAX                   (14U)
+#define CHANNEL_5GHZ_MIN                     (36U)
+#define CHANNEL_5GHZ_MAX                     (177U)
+#define CHANNEL_6GHZ_MAX                     (233U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    const uint8_t *ht;
+    const uint8_t *vht;
+    const uint8_t *he_6ghz;
+} operation_elements_t;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: find_elements
+********************************************************************************
+* Summary:
+* Finds the operation elements, or their VHT and 6 GHz information, and
+* checks their lengths.
+*******************************************************************************/
+static void find_elements(const uint8_t *ies, uint32_t length, operation_elements_t *ops)
+{
+    uint32_t offset = 0U;
+
+    memset(ops, 0, sizeof(*ops));
+
+    while ((NULL != ies) && ((offset + IE_HEADER_LENGTH) <= length))
+    {
+        uint8_t id = ies[offset];
+        uint8_t size = ies[offset + 1U];
+        const uint8_t *body = &ies[offset + IE_HEADER_LENGTH];
+
+        if ((offset + IE_HEADER_LENGTH + size) > length)
+        {
+            return;
+        }
+
+        if ((BSS_WIDTH_HT_OPERATION_ID == id) && (size >= HT_MIN_LENGTH))
+        {
+            ops->ht = body;
+        }
+        else if ((BSS_WIDTH_VHT_OPERATION_ID == id) && (size >= VHT_INFO_LENGTH))
+        {
+            ops->vht = body;
+        }
+        else if ((BSS_WIDTH_EXTENSION_ID == id) && (size >= HE_FIXED_LENGTH) &&
+                 (BSS_WIDTH_HE_OPERATION_EXT_ID == body[0]))
+        {
+            uint32_t params = (uint32_t)body[1] | ((uint32_t)body[2] << 8) |
+                              ((uint32_t)body[3] << 16);
+            uint32_t field = HE_FIXED_LENGTH;
+
+            if (0U != (params & HE_VHT_INFO_PRESENT))
+            {
+                /* The VHT Operation element takes precedence if present. */
+                if ((NULL == ops->vht) && ((field + VHT_INFO_LENGTH) <= size))
+                {
+                    ops->vht = &body[field];
+                }
+
+                field += VHT_INFO_LENGTH;
+            }
+
+            if (0U != (params & HE_CO_HOSTED_BSS))
+            {
+                field += HE_CO_HOSTED_LENGTH;
+            }
+
+            if ((0U != (params & HE_6GHZ_INFO_PRESENT)) && ((field + HE_6GHZ_INFO_LENGTH) <= size))
+            {
+                ops->he_6ghz = &body[field];
+            }
+        }
+
+        offset += IE_HEADER_LENGTH + size;
+    }
+}
+
+/*******************************************************************************
+* Function Name: add_segment
+********************************************************************************
+* Summary:
+* Adds the 20 MHz subchannels of a 40, 80 or 160 MHz segment given by its
+* center channel.
+*******************************************************************************/
+static void add_segment(bss_width_t *bss, uint8_t center, uint16_t width_mhz)
+{
+    uint32_t count = width_mhz / 20U;
+    int32_t first = (int32_t)center - (int32_t)((count - 1U) * (CHANNEL_STEP / 2U));
+
+    for (uint32_t i = 0; (i < count) && (bss->count < BSS_WIDTH_MAX_SUBCHANNELS); i++)
+    {
+        bss->subchannels[bss->count++] = (uint8_t)(first + (int32_t)(i * CHANNEL_STEP));
+    }
+}
+
+/*******************************************************************************
+* Function Name: add_wide
+********************************************************************************
+* Summary:
+* Adds the subchannels of an 80, 160 or 80+80 MHz BSS given by its center
+* frequency segments, as the VHT and 6 GHz operation information encode them.
+*******************************************************************************/
+static void add_wide(bss_width_t *bss, uint8_t segment0, uint8_t segment1)
+{
+    uint8_t distance = (segment1 > segment0) ? (uint8_t)(segment1 - segment0) :
+                                               (uint8_t)(segment0 - segment1);
+
+    if (0U == segment1)
+    {
+        add_segment(bss, segment0, 80U);
+        bss->width_mhz = 80U;
+    }
+    else if (SEGMENT_160_OFFSET == distance)
+    {
+        add_segment(bss, segment1, 160U);
+        bss->width_mhz = 160U;
+    }
+    else
+    {
+        add_segment(bss, segment0, 80U);
+        add_segment(bss, segment1, 80U);
+        bss->width_mhz = 160U;
+    }
+}
+
+/*******************************************************************************
+* Function Name: is_valid
+********************************************************************************
+* Summary:
+* Returns true if the subchannels are channels of the band and include the
+* primary channel.
+*******************************************************************************/
+static bool is_valid(const bss_width_t *bss, uint8_t band)
+{
+    uint8_t low = (BSS_WIDTH_BAND_5GHZ == band) ? CHANNEL_5GHZ_MIN : 1U;
+    uint8_t high = (BSS_WIDTH_BAND_2_4GHZ == band) ? CHANNEL_2_4GHZ_MAX :
+                   (BSS_WIDTH_BAND_5GHZ == band) ? CHANNEL_5GHZ_MAX : CHANNEL_6GHZ_MAX;
+    bool primary = false;
+
+    for (uint32_t i = 0; i < bss->count; i++)
+    {
+        if ((bss->subchannels[i] < low) || (bss->subchannels[i] > high))
+        {
+            return false;
+        }
+
+        primary |= (bss->subchannels[i] == bss->primary);
+    }
+
+    return primary;
+}
+
+/*******************************************************************************
+* Function Name: bss_width_decode
+********************************************************************************
+* Summary:
+* Finds the 20 MHz subchannels a BSS occupies. In the 2.4 GHz band, a 40 MHz
+* BSS occupies its primary channel and the secondary channel 4 channel
+* numbers away. A BSS whose elements are missing or inconsistent with its
+* channel is taken as 20 MHz wide.
+*
+* Parameters:
+*  uint8_t band: Band of the BSS (BSS_WIDTH_BAND_)
+*  uint8_t channel: Primary channel of the BSS
+*  const uint8_t *ies: Information elements of the scan result
+*  uint32_t length: Length of the information elements
+*  bss_width_t *bss: Receives the width and the subchannels
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void bss_width_decode(uint8_t band, uint8_t channel, const uint8_t *ies, uint32_t length,
+                      bss_width_t *bss)
+{
+    operation_elements_t ops;
+
+    find_elements(ies, length, &ops);
+
+    bss->primary = channel;
+    bss->count = 0U;
+
+    if ((BSS_WIDTH_BAND_6GHZ == band) && (NULL != ops.he_6ghz))
+    {
+        uint8_t width = ops.he_6ghz[1] & HE_6GHZ_WIDTH_MASK;
+
+        if (HE_6GHZ_WIDTH_160 == width)
+        {
+            add_wide(bss, ops.he_6ghz[2], ops.he_6ghz[3]);
+        }
+        else if (0U != width)
+        {
+            bss->width_mhz = (uint16_t)(20U << width);
+            add_segment(bss, ops.he_6ghz[2], bss->width_mhz);
+        }
+    }
+    else if ((BSS_WIDTH_BAND_5GHZ == band) && (NULL != ops.vht) &&
+             (VHT_WIDTH_20_40 != ops.vht[0]))
+    {
+        if (VHT_WIDTH_160 == ops.vht[0])
+        {
+            add_segment(bss, ops.vht[1], 160U);
+            bss->width_mhz = 160U;
+        }
+        else if (VHT_WIDTH_80_80 == ops.vht[0])
+        {
+            add_segment(bss, ops.vht[1], 80U);
+            add_segment(bss, ops.vht[2], 80U);
+            bss->width_mhz = 160U;
+        }
+        else
+        {
+            add_wide(bss, ops.vht[1], ops.vht[2]);
+        }
+    }
+
+    if ((0U == bss->count) && (BSS_WIDTH_BAND_6GHZ != band) && (NULL != ops.ht) &&
+        (0U != (ops.ht[1] & HT_ANY_WIDTH)))
+    {
+        uint8_t secondary = ops.ht[1] & HT_SECONDARY_MASK;
+
+        if (HT_SECONDARY_ABOVE == secondary)
+        {
+            bss->subchannels[bss->count++] = channel;
+            bss->subchannels[bss->count++] = (uint8_t)(channel + CHANNEL_STEP);
+            bss->width_mhz = 40U;
+        }
+        else if (HT_SECONDARY_BELOW == secondary)
+        {
+            bss->subchannels[bss->count++] = (uint8_t)(channel - CHANNEL_STEP);
+            bss->subchannels[bss->count++] = channel;
+            bss->width_mhz = 40U;
+        }
+    }
+
+    if ((0U == bss->count) || !is_valid(bss, band))
+    {
+        bss->width_mhz = 20U;
+        bss->count = 1U;
+        bss->subchannels[0] = channel;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bss_width_frequency
+********************************************************************************
+* Summary:
+* Returns the center frequency of a 20 MHz channel.
+*
+* Parameters:
+*  uint8_t band: Band of the channel (BSS_WIDTH_BAND_)
+*  uint8_t channel: Channel number
+*
+* Return:
+*  uint32_t: Center frequency in MHz
+*
+*******************************************************************************/
+uint32_t bss_width_frequency(uint8_t band, uint8_t channel)
+{
+    switch (band)
+    {
+        case BSS_WIDTH_BAND_2_4GHZ:
+            return (CHANNEL_2_4GHZ_MAX == channel) ? 2484U : (2407U + (5U * channel));
+
+        case BSS_WIDTH_BAND_6GHZ:
+            return 5950U + (5U * channel);
+
+        default:
+            return 5000U + (5U * channel);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+* File Name        : bss_width.h
+*
+* Description      : This file contains the structures and functions of the
+*                    operating width decoder, which finds the 20 MHz subchannels a
+*                    BSS occupies from its HT, VHT and HE Operation elements.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_BSS_WIDTH_H_
+#define SOURCE_BSS_WIDTH_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bands, with the values of cy_wcm_wifi_band_t. */
+#define BSS_WIDTH_BAND_2_4GHZ                (1U)
+#define BSS_WIDTH_BAND_5GHZ                  (2U)
+#define BSS_WIDTH_BAND_6GHZ                  (3U)
+
+/* 160 MHz and 80+80 MHz BSSs occupy eight 20 MHz subchannels. */
+#define BSS_WIDTH_MAX_SUBCHANNELS            (8U)
+
+#define BSS_WIDTH_HT_OPERATION_ID            (61U)
+#define BSS_WIDTH_VHT_OPERATION_ID           (192U)
+#define BSS_WIDTH_EXTENSION_ID               (255U)
+#define BSS_WIDTH_HE_OPERATION_EXT_ID        (36U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Operating width of a BSS. An 80+80 MHz BSS is reported as 160 MHz wide. */
+typedef struct
+{
+    uint8_t  primary;
+    uint16_t width_mhz;
+    uint8_t  count;
+    uint8_t  subchannels[BSS_WIDTH_MAX_SUBCHANNELS];
+} bss_width_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bss_width_decode(uint8_t band, uint8_t channel, const uint8_t *ies, uint32_t length,
+                      bss_width_t *bss);
+uint32_t bss_width_frequency(uint8_t band, uint8_t channel);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_BSS_WIDTH_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,460 @@
+/*******************************************************************************
+* File Name        : bssid_stability.c
+*
+* Description      : This file contains the BSSID stability tracker. Each BSSID table
+*                    entry has a 64-bit presence bitmap and a 64-bit channel change
+*                    bitmap over the last full sweeps, counted with popcount, and an
+*                    exponentially weighted RSSI mean and variance. The state of an
+*                    entry is brought up to date only when its BSSID is reported or
+*                    read: the sweeps it missed are shifted in as zeros at that time,
+*                    so a scan costs O(1) per reported BSSID and nothing per missing
+*                    one.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "bssid_stability.h"
+#include "bssid_table.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Weight of a new RSSI sample in the mean and the variance. */
+#define RSSI_ALPHA                           (0.125f)
+
+#define CENTI                                (100.0f)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Bit 0 of the bitmaps is the full sweep 'sweep'. */
+typedef struct
+{
+    uint64_t presence;
+    uint64_t changes;
+    uint32_t first_sweep;
+    uint32_t sweep;
+    uint16_t generation;
+    uint8_t  channel;
+    uint8_t  longest_dropout;
+    float    mean_rssi;
+    float    var_rssi;
+    bool     in_use;
+} stability_entry_t;
+
+static MODULE_STATE stability_entry_t stability_entries[BSSID_TABLE_MAX_ENTRIES];
+
+/* Number of completed full sweeps, which is also the index of the full sweep
+ * in progress.
+ */
+static MODULE_STATE uint32_t stability_sweeps;
+static MODULE_STATE bool stability_full_sweep;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: popcount64
+********************************************************************************
+* Summary:
+* Returns the number of bits set.
+*******************************************************************************/
+static uint32_t popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return (uint32_t)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: trailing_zeros64
+********************************************************************************
+* Summary:
+* Returns the number of clear bits below the lowest set bit of a nonzero value.
+*******************************************************************************/
+static uint32_t trailing_zeros64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(x);
+#else
+    return popcount64((x & (0U - x)) - 1U);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: shift_out
+********************************************************************************
+* Summary:
+* Shifts a bitmap by a number of sweeps, which may exceed its width.
+*******************************************************************************/
+static uint64_t shift_out(uint64_t bitmap, uint32_t sweeps)
+{
+    return (sweeps >= BSSID_STABILITY_WINDOW) ? 0U : (bitmap << sweeps);
+}
+
+/*******************************************************************************
+* Function Name: window_mask
+********************************************************************************
+* Summary:
+* Returns the mask of the first 'length' bits.
+*******************************************************************************/
+static uint64_t window_mask(uint32_t length)
+{
+    return (length >= BSSID_STABILITY_WINDOW) ? UINT64_MAX : ((1ULL << length) - 1U);
+}
+
+/*******************************************************************************
+* Function Name: longest_zero_run
+********************************************************************************
+* Summary:
+* Returns the length of the longest run of clear bits among the first 'length'
+* bits. Each iteration shortens every run by one, so the cost is the length
+* of the longest run.
+*******************************************************************************/
+static uint32_t longest_zero_run(uint64_t bitmap, uint32_t length)
+{
+    uint64_t runs = (~bitmap) & window_mask(length);
+    uint32_t longest = 0;
+
+    while (0U != runs)
+    {
+        runs &= runs >> 1;
+        longest++;
+    }
+
+    return longest;
+}
+
+/*******************************************************************************
+* Function Name: entry_of
+********************************************************************************
+* Summary:
+* Returns the entry of a BSSID, or NULL if it belongs to a recycled BSSID.
+*******************************************************************************/
+static stability_entry_t* entry_of(uint16_t table_index, uint16_t generation)
+{
+    if (table_index >= BSSID_TABLE_MAX_ENTRIES)
+    {
+        return NULL;
+    }
+
+    stability_entry_t *entry = &stability_entries[table_index];
+
+    return (entry->in_use && (entry->generation == generation)) ? entry : NULL;
+}
+
+/*******************************************************************************
+* Function Name: bssid_stability_init
+********************************************************************************
+* Summary:
+* Clears the state of all BSSIDs.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void bssid_stability_init(void)
+{
+    memset(stability_entries, 0, sizeof(stability_entries));
+    stability_sweeps = 0;
+    stability_full_sweep = false;
+}
+
+/*******************************************************************************
+* Function Name: bssid_stability_begin
+********************************************************************************
+* Summary:
+* Starts a new scan. Only full sweeps count as seen or missed.
+*
+* Parameters:
+*  bool full_sweep: true if the scan covered all channels without filter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void bssid_stability_begin(bool full_sweep)
+{
+    stability_full_sweep = full_sweep;
+}
+
+/*******************************************************************************
+* Function Name: bssid_stability_observe
+********************************************************************************
+* Summary:
+* Records a scan result. A BSSID reported several times in a scan is counted
+* once, but every report updates the RSSI statistics.
+*
+* Parameters:
+*  uint16_t table_index: Index of the BSSID in the BSSID table
+*  uint16_t generation: Generation of the BSSID table entry
+*  int16_t rssi: RSSI in dBm
+*  uint8_t channel: Channel of the scan result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void bssid_stability_observe(uint16_t table_index, uint16_t generation,
+                             int16_t rssi, uint8_t channel)
+{
+    if (table_index >= BSSID_TABLE_MAX_ENTRIES)
+    {
+        return;
+    }
+
+    stability_entry_t *entry = entry_of(table_index, generation);
+
+    if (NULL == entry)
+    {
+        entry = &stability_entries[table_index];
+        memset(entry, 0, sizeof(*entry));
+        entry->generation = generation;
+        entry->first_sweep = stability_sweeps;
+        entry->sweep = stability_sweeps;
+        entry->channel = channel;
+        entry->mean_rssi = (float)rssi;
+        entry->in_use = true;
+    }
+
+    float delta = (float)rssi - entry->mean_rssi;
+
+    entry->mean_rssi += RSSI_ALPHA * delta;
+    entry->var_rssi = (1.0f - RSSI_ALPHA) * (entry->var_rssi + (RSSI_ALPHA * delta * delta));
+
+    if (!stability_full_sweep)
+    {
+        return;
+    }
+
+    /* Catch up with the sweeps missed since the last report. */
+    uint32_t elapsed = stability_sweeps - entry->sweep;
+
+    if (elapsed > 1U)
+    {
+        uint32_t dropout = elapsed - 1U;
+
+        if (dropout > entry->longest_dropout)
+        {
+            entry->longest_dropout = (uint8_t)((dropout > UINT8_MAX) ? UINT8_MAX : dropout);
+        }
+    }
+
+    entry->presence = shift_out(entry->presence, elapsed) | 1U;
+    entry->changes = shift_out(entry->changes, elapsed);
+    entry->sweep = stability_sweeps;
+
+    if (channel != entry->channel)
+    {
+        entry->changes |= 1U;
+        entry->channel = channel;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bssid_stability_commit
+********************************************************************************
+* Summary:
+* Completes the scan in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void bssid_stability_commit(void)
+{
+    if (stability_full_sweep)
+    {
+        stability_sweeps++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bssid_stability_get
+********************************************************************************
+* Summary:
+* Computes the stability of a BSSID as of the last completed full sweep.
+*
+* Parameters:
+*  uint16_t table_index: Index of the BSSID in the BSSID table
+*  uint16_t generation: Generation of the BSSID table entry
+*  bssid_stability_t *stability: Stability of the BSSID
+*
+* Return:
+*  bool: false if the BSSID was never reported by a full sweep
+*
+*******************************************************************************/
+bool bssid_stability_get(uint16_t table_index, uint16_t generation,
+                         bssid_stability_t *stability)
+{
+    const stability_entry_t *entry = entry_of(table_index, generation);
+
+    if ((NULL == entry) || (entry->first_sweep == stability_sweeps))
+    {
+        return false;
+    }
+
+    /* Align bit 0 with the last completed full sweep. A BSSID already seen by
+     * the full sweep in progress has that sweep in bit 0, which is dropped.
+     */
+    uint64_t presence = entry->presence;
+    uint64_t changes = entry->changes;
+    uint32_t age;
+
+    if (entry->sweep == stability_sweeps)
+    {
+        presence >>= 1;
+        changes >>= 1;
+        age = 0;
+    }
+    else
+    {
+        age = stability_sweeps - 1U - entry->sweep;
+    }
+
+    uint32_t followed = stability_sweeps - entry->first_sweep;
+    uint32_t window = (followed < BSSID_STABILITY_WINDOW) ? followed : BSSID_STABILITY_WINDOW;
+
+    presence = shift_out(presence, age) & window_mask(window);
+    changes = shift_out(changes, age) & window_mask(window);
+
+    /* The current dropout is the run of misses up to the last full sweep,
+     * which may be longer than the window. Without a presence in the window,
+     * it runs from the last completed full sweep that reported the BSSID, or
+     * from the start if there is none.
+     */
+    uint32_t current = followed;
+
+    if (0U != presence)
+    {
+        current = trailing_zeros64(presence);
+    }
+    else if ((entry->sweep != stability_sweeps) && (0U != (entry->presence & 1U)))
+    {
+        current = age;
+    }
+
+    memset(stability, 0, sizeof(*stability));
+    stability->window = (uint8_t)window;
+    stability->seen = (uint8_t)popcount64(presence);
+    stability->missed = (uint8_t)(window - stability->seen);
+    stability->current_dropout = (uint8_t)((current > UINT8_MAX) ? UINT8_MAX : current);
+    stability->longest_dropout = (uint8_t)longest_zero_run(presence, window);
+    stability->longest_dropout_ever = (stability->current_dropout > entry->longest_dropout) ?
+                                      stability->current_dropout : entry->longest_dropout;
+    stability->channel_changes = (uint8_t)popcount64(changes);
+    stability->channel = entry->channel;
+    stability->mean_rssi = (int16_t)((entry->mean_rssi < 0.0f) ? (entry->mean_rssi - 0.5f) :
+                                                                 (entry->mean_rssi + 0.5f));
+
+    /* The square root is found by Newton's method to avoid the math library;
+     * a few iterations are enough for centi-dB resolution.
+     */
+    float std = entry->var_rssi;
+
+    if (std > 0.0f)
+    {
+        float x = (std > 1.0f) ? std : 1.0f;
+
+        for (uint32_t i = 0; i < 8U; i++)
+        {
+            x = 0.5f * (x + (std / x));
+        }
+
+        std = x;
+    }
+
+    stability->rssi_std_centi_db = (uint16_t)((std * CENTI) + 0.5f);
+
+    if (window >= BSSID_STABILITY_MIN_SWEEPS)
+    {
+        float score = (float)BSSID_STABILITY_MAX_SCORE * (float)stability->seen / (float)window;
+
+        score *= BSSID_STABILITY_STD_REF_DB / (BSSID_STABILITY_STD_REF_DB + std);
+        score *= (float)BSSID_STABILITY_DROPOUT_REF /
+                 (float)(BSSID_STABILITY_DROPOUT_REF + stability->longest_dropout);
+        score /= (float)(1U + stability->channel_changes);
+        stability->score = (uint8_t)(score + 0.5f);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bssid_stability_score
+********************************************************************************
+* Summary:
+* Returns the stability score of a BSSID, for the features that choose APs.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID
+*
+* Return:
+*  uint8_t: Score from 0 to BSSID_STABILITY_MAX_SCORE, 0 if unknown
+*
+*******************************************************************************/
+uint8_t bssid_stability_score(const uint8_t *bssid)
+{
+    bssid_stability_t stability;
+    uint16_t index = bssid_table_find(bssid);
+    const bssid_table_entry_t *entry = bssid_table_get(index);
+
+    if ((NULL == entry) || (!bssid_stability_get(index, entry->generation, &stability)))
+    {
+        return 0;
+    }
+
+    return stability.score;
+}
+
+/* [] END OF FILE */
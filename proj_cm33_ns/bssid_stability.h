@@ -0,0 +1,116 @@
+/*******************************************************************************
+* File Name        : bssid_stability.h
+*
+* Description      : This file contains the structures and function prototypes of the
+*                    BSSID stability tracker, which scores how reliably each BSSID of
+*                    the BSSID table appears across full sweeps.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_BSSID_STABILITY_H_
+#define SOURCE_BSSID_STABILITY_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of full sweeps covered by the presence and channel change bitmaps. */
+#define BSSID_STABILITY_WINDOW               (64U)
+
+/* A BSSID followed for fewer full sweeps than this is not scored. */
+#define BSSID_STABILITY_MIN_SWEEPS           (4U)
+
+/* RSSI standard deviation and dropout length at which the score is halved. */
+#define BSSID_STABILITY_STD_REF_DB           (3.0f)
+#define BSSID_STABILITY_DROPOUT_REF          (4U)
+
+#define BSSID_STABILITY_MAX_SCORE            (100U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Stability of one BSSID. The counts cover the last 'window' full sweeps,
+ * up to BSSID_STABILITY_WINDOW, except longest_dropout_ever. The score is the
+ * availability, scaled down by the RSSI spread, the longest dropout of the
+ * window and the number of channel changes of the window.
+ */
+typedef struct
+{
+    uint8_t  window;
+    uint8_t  seen;
+    uint8_t  missed;
+    uint8_t  current_dropout;
+    uint8_t  longest_dropout;
+    uint8_t  longest_dropout_ever;
+    uint8_t  channel_changes;
+    uint8_t  channel;
+    int16_t  mean_rssi;
+    uint16_t rssi_std_centi_db;
+    uint8_t  score;
+} bssid_stability_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bssid_stability_init(void);
+void bssid_stability_begin(bool full_sweep);
+void bssid_stability_observe(uint16_t table_index, uint16_t generation,
+                             int16_t rssi, uint8_t channel);
+void bssid_stability_commit(void);
+bool bssid_stability_get(uint16_t table_index, uint16_t generation,
+                         bssid_stability_t *stability);
+uint8_t bssid_stability_score(const uint8_t *bssid);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_BSSID_STABILITY_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,305 @@
+/*******************************************************************************
+* File Name        : bssid_table.c
+*
+* Description      : This file contains the open-addressing hash table that maps
+*                    a BSSID to a stable index shared by the per-BSSID trackers.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "bssid_table.h"
+#include "hash_service.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The hash index is kept at twice the table capacity so that the linear probe
+ * sequences stay short even when the table is full.
+ */
+#define BSSID_HASH_SLOTS                     (2U * BSSID_TABLE_MAX_ENTRIES)
+#define BSSID_HASH_MASK                      (BSSID_HASH_SLOTS - 1U)
+#define BSSID_HASH_EMPTY                     (BSSID_TABLE_INVALID_INDEX)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE bssid_table_entry_t bssid_entries[BSSID_TABLE_MAX_ENTRIES];
+static MODULE_STATE uint16_t bssid_hash_index[BSSID_HASH_SLOTS];
+static MODULE_STATE uint32_t bssid_entry_count;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bssid_hash
+********************************************************************************
+* Summary:
+* Returns the home slot of a BSSID in the hash index.
+*******************************************************************************/
+static uint32_t bssid_hash(const uint8_t *bssid)
+{
+    return hash_service_hash32(bssid, BSSID_LENGTH) & BSSID_HASH_MASK;
+}
+
+/*******************************************************************************
+* Function Name: bssid_hash_remove
+********************************************************************************
+* Summary:
+* Removes an entry from the hash index using backward-shift deletion so that
+* no tombstones are needed and lookups never degrade over time.
+*******************************************************************************/
+static void bssid_hash_remove(uint16_t index)
+{
+    uint32_t slot = bssid_hash(bssid_entries[index].bssid);
+
+    while (bssid_hash_index[slot] != index)
+    {
+        slot = (slot + 1U) & BSSID_HASH_MASK;
+    }
+
+    uint32_t hole = slot;
+
+    for (;;)
+    {
+        slot = (slot + 1U) & BSSID_HASH_MASK;
+
+        uint16_t moved = bssid_hash_index[slot];
+
+        if (BSSID_HASH_EMPTY == moved)
+        {
+            break;
+        }
+
+        /* Shift the entry back only if its home slot is not cyclically
+         * between the hole and its current position.
+         */
+        uint32_t home = bssid_hash(bssid_entries[moved].bssid);
+
+        if (((slot - home) & BSSID_HASH_MASK) >= ((slot - hole) & BSSID_HASH_MASK))
+        {
+            bssid_hash_index[hole] = moved;
+            hole = slot;
+        }
+    }
+
+    bssid_hash_index[hole] = BSSID_HASH_EMPTY;
+}
+
+/*******************************************************************************
+* Function Name: bssid_table_init
+********************************************************************************
+* Summary:
+* Clears all the entries of the BSSID table.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void bssid_table_init(void)
+{
+    memset(bssid_entries, 0, sizeof(bssid_entries));
+    memset(bssid_hash_index, 0xFF, sizeof(bssid_hash_index));
+    bssid_entry_count = 0;
+}
+
+/*******************************************************************************
+* Function Name: bssid_table_find
+********************************************************************************
+* Summary:
+* Looks up the index of a BSSID.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID to look up
+*
+* Return:
+*  uint16_t: Index of the BSSID or BSSID_TABLE_INVALID_INDEX if not tracked
+*
+*******************************************************************************/
+uint16_t bssid_table_find(const uint8_t *bssid)
+{
+    uint32_t slot = bssid_hash(bssid);
+
+    while (BSSID_HASH_EMPTY != bssid_hash_index[slot])
+    {
+        uint16_t index = bssid_hash_index[slot];
+
+        if (0 == memcmp(bssid_entries[index].bssid, bssid, BSSID_LENGTH))
+        {
+            return index;
+        }
+
+        slot = (slot + 1U) & BSSID_HASH_MASK;
+    }
+
+    return BSSID_TABLE_INVALID_INDEX;
+}
+
+/*******************************************************************************
+* Function Name: bssid_table_insert
+********************************************************************************
+* Summary:
+* Returns the index of a BSSID, adding it to the table if required. When the
+* table is full, the entry with the oldest last_seen_scan is recycled and its
+* generation is incremented.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID seen in the scan
+*  uint32_t scan_sequence: Sequence number of the current scan
+*
+* Return:
+*  uint16_t: Index of the BSSID in the table
+*
+*******************************************************************************/
+uint16_t bssid_table_insert(const uint8_t *bssid, uint32_t scan_sequence)
+{
+    uint16_t index = bssid_table_find(bssid);
+
+    if (BSSID_TABLE_INVALID_INDEX == index)
+    {
+        if (bssid_entry_count < BSSID_TABLE_MAX_ENTRIES)
+        {
+            index = (uint16_t)bssid_entry_count++;
+        }
+        else
+        {
+            /* Recycle the least recently seen entry. This only happens when
+             * a new BSSID appears in a full table.
+             */
+            index = 0;
+
+            for (uint16_t i = 1; i < BSSID_TABLE_MAX_ENTRIES; i++)
+            {
+                if (bssid_entries[i].last_seen_scan <
+                    bssid_entries[index].last_seen_scan)
+                {
+                    index = i;
+                }
+            }
+
+            bssid_hash_remove(index);
+        }
+
+        bssid_entries[index].generation++;
+        bssid_entries[index].in_use = true;
+        memcpy(bssid_entries[index].bssid, bssid, BSSID_LENGTH);
+
+        uint32_t slot = bssid_hash(bssid);
+
+        while (BSSID_HASH_EMPTY != bssid_hash_index[slot])
+        {
+            slot = (slot + 1U) & BSSID_HASH_MASK;
+        }
+
+        bssid_hash_index[slot] = index;
+    }
+
+    bssid_entries[index].last_seen_scan = scan_sequence;
+
+    return index;
+}
+
+/*******************************************************************************
+* Function Name: bssid_table_get
+********************************************************************************
+* Summary:
+* Returns the entry stored at an index.
+*
+* Parameters:
+*  uint16_t index: Index returned by bssid_table_insert or bssid_table_find
+*
+* Return:
+*  const bssid_table_entry_t*: Entry or NULL if the index is not in use
+*
+*******************************************************************************/
+const bssid_table_entry_t* bssid_table_get(uint16_t index)
+{
+    if ((index >= BSSID_TABLE_MAX_ENTRIES) || (!bssid_entries[index].in_use))
+    {
+        return NULL;
+    }
+
+    return &bssid_entries[index];
+}
+
+/*******************************************************************************
+* Function Name: bssid_table_is_current
+********************************************************************************
+* Summary:
+* Checks whether an index still refers to the BSSID it was assigned to when
+* the caller recorded the generation.
+*
+* Parameters:
+*  uint16_t index: Index in the table
+*  uint16_t generation: Generation recorded by the caller
+*
+* Return:
+*  bool: true if the entry has not been recycled since
+*
+*******************************************************************************/
+bool bssid_table_is_current(uint16_t index, uint16_t generation)
+{
+    return ((index < BSSID_TABLE_MAX_ENTRIES) &&
+            (bssid_entries[index].in_use) &&
+            (bssid_entries[index].generation == generation));
+}
+
+/*******************************************************************************
+* Function Name: bssid_table_count
+********************************************************************************
+* Summary:
+* Returns the number of BSSIDs in the table.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: Number of entries in use
+*
+*******************************************************************************/
+uint32_t bssid_table_count(void)
+{
+    return bssid_entry_count;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,105 @@
+/*******************************************************************************
+* File Name        : bssid_table.h
+*
+* Description      : This file contains the macros, structures, and function
+*                    prototypes of the fixed-capacity BSSID table that assigns a
+*                    stable index to every BSSID seen in the scan results.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_BSSID_TABLE_H_
+#define SOURCE_BSSID_TABLE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BSSID_LENGTH                         (6U)
+
+/* Maximum number of BSSIDs tracked at the same time. Must be a power of two.
+ * When the table is full, the entry that was seen least recently is recycled.
+ */
+#ifndef BSSID_TABLE_MAX_ENTRIES
+#define BSSID_TABLE_MAX_ENTRIES              (64U)
+#endif
+
+#define BSSID_TABLE_INVALID_INDEX            (0xFFFFU)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* One tracked BSSID. The generation is incremented every time the entry is
+ * recycled for a different BSSID so that modules keeping per-BSSID state in
+ * arrays parallel to the table can detect a stale slot in O(1).
+ */
+typedef struct
+{
+    uint8_t  bssid[BSSID_LENGTH];
+    uint16_t generation;
+    uint32_t last_seen_scan;
+    bool     in_use;
+} bssid_table_entry_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bssid_table_init(void);
+uint16_t bssid_table_find(const uint8_t *bssid);
+uint16_t bssid_table_insert(const uint8_t *bssid, uint32_t scan_sequence);
+const bssid_table_entry_t* bssid_table_get(uint16_t index);
+bool bssid_table_is_current(uint16_t index, uint16_t generation);
+uint32_t bssid_table_count(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_BSSID_TABLE_H_ */
+
+/* [] END OF FILE */
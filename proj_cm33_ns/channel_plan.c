@@ -0,0 +1,818 @@
+/*******************************************************************************
+* File Name        : channel_plan.c
+*
+* Description      : This file contains the regulatory channel planner. It keeps
+*                    the channel rules of a few regulatory regions, infers the
+*                    country from the Country IEs of the scan results when none is
+*                    configured, and builds the channel lists of the scans without
+*                    the channels that are invalid in the country or disabled, with
+*                    the DFS channels scanned passively.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "channel_plan.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CHANNEL_2_4GHZ_LAST                  (13U)
+#define CHANNEL_DFS_FIRST                    (52U)
+#define CHANNEL_DFS_LAST                     (144U)
+#define CHANNEL_NOT_FOUND                    (CHANNEL_PLAN_MAX_CHANNELS)
+#define IE_HEADER_LENGTH                     (2U)
+
+#define ARRAY_COUNT(a)                       (sizeof(a) / sizeof((a)[0]))
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Channels first to last of one band, 20 MHz apart in the 5 GHz band. */
+typedef struct
+{
+    uint8_t             first;
+    uint8_t             last;
+    channel_plan_scan_t scan;
+} plan_rule_t;
+
+typedef struct
+{
+    const char        *name;
+    const plan_rule_t *rules;
+    uint32_t           rule_count;
+    bool               six_ghz;
+} plan_region_def_t;
+
+typedef struct
+{
+    char                  code[CHANNEL_PLAN_COUNTRY_LENGTH];
+    channel_plan_region_t region;
+} plan_country_t;
+
+typedef struct
+{
+    char     code[CHANNEL_PLAN_COUNTRY_LENGTH];
+    uint32_t votes;
+} plan_candidate_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint8_t plan_channels[CHANNEL_PLAN_MAX_CHANNELS] =
+{
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+    36, 40, 44, 48, 52, 56, 60, 64,
+    100, 104, 108, 112, 116, 120, 124, 128, 132, 136, 140, 144,
+    149, 153, 157, 161, 165
+};
+
+/* Without a known country, channels that are not allowed everywhere are
+ * only listened to.
+ */
+static const plan_rule_t world_rules[] =
+{
+    { 1,   11,  CHANNEL_PLAN_ACTIVE  },
+    { 12,  13,  CHANNEL_PLAN_PASSIVE },
+    { 36,  48,  CHANNEL_PLAN_ACTIVE  },
+    { 52,  144, CHANNEL_PLAN_PASSIVE },
+    { 149, 165, CHANNEL_PLAN_PASSIVE }
+};
+
+static const plan_rule_t fcc_rules[] =
+{
+    { 1,   11,  CHANNEL_PLAN_ACTIVE  },
+    { 36,  48,  CHANNEL_PLAN_ACTIVE  },
+    { 52,  144, CHANNEL_PLAN_PASSIVE },
+    { 149, 165, CHANNEL_PLAN_ACTIVE  }
+};
+
+static const plan_rule_t etsi_rules[] =
+{
+    { 1,   13,  CHANNEL_PLAN_ACTIVE  },
+    { 36,  48,  CHANNEL_PLAN_ACTIVE  },
+    { 52,  140, CHANNEL_PLAN_PASSIVE }
+};
+
+static const plan_rule_t japan_rules[] =
+{
+    { 1,   13,  CHANNEL_PLAN_ACTIVE  },
+    { 36,  48,  CHANNEL_PLAN_ACTIVE  },
+    { 52,  144, CHANNEL_PLAN_PASSIVE }
+};
+
+static const plan_rule_t china_rules[] =
+{
+    { 1,   13,  CHANNEL_PLAN_ACTIVE  },
+    { 36,  48,  CHANNEL_PLAN_ACTIVE  },
+    { 52,  64,  CHANNEL_PLAN_PASSIVE },
+    { 149, 165, CHANNEL_PLAN_ACTIVE  }
+};
+
+static const plan_region_def_t plan_regions[CHANNEL_PLAN_REGION_COUNT] =
+{
+    [CHANNEL_PLAN_REGION_WORLD] = { "world", world_rules, ARRAY_COUNT(world_rules), true  },
+    [CHANNEL_PLAN_REGION_FCC]   = { "FCC",   fcc_rules,   ARRAY_COUNT(fcc_rules),   true  },
+    [CHANNEL_PLAN_REGION_ETSI]  = { "ETSI",  etsi_rules,  ARRAY_COUNT(etsi_rules),  true  },
+    [CHANNEL_PLAN_REGION_JAPAN] = { "Japan", japan_rules, ARRAY_COUNT(japan_rules), true  },
+    [CHANNEL_PLAN_REGION_CHINA] = { "China", china_rules, ARRAY_COUNT(china_rules), false }
+};
+
+/* Countries not listed here use the world rules. */
+static const plan_country_t plan_countries[] =
+{
+    { {'U','S'}, CHANNEL_PLAN_REGION_FCC   }, { {'C','A'}, CHANNEL_PLAN_REGION_FCC   },
+    { {'M','X'}, CHANNEL_PLAN_REGION_FCC   }, { {'P','R'}, CHANNEL_PLAN_REGION_FCC   },
+    { {'T','W'}, CHANNEL_PLAN_REGION_FCC   }, { {'A','T'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'B','E'}, CHANNEL_PLAN_REGION_ETSI  }, { {'B','G'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'C','H'}, CHANNEL_PLAN_REGION_ETSI  }, { {'C','Y'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'C','Z'}, CHANNEL_PLAN_REGION_ETSI  }, { {'D','E'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'D','K'}, CHANNEL_PLAN_REGION_ETSI  }, { {'E','E'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'E','S'}, CHANNEL_PLAN_REGION_ETSI  }, { {'F','I'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'F','R'}, CHANNEL_PLAN_REGION_ETSI  }, { {'G','B'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'G','R'}, CHANNEL_PLAN_REGION_ETSI  }, { {'H','R'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'H','U'}, CHANNEL_PLAN_REGION_ETSI  }, { {'I','E'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'I','S'}, CHANNEL_PLAN_REGION_ETSI  }, { {'I','T'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'L','I'}, CHANNEL_PLAN_REGION_ETSI  }, { {'L','T'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'L','U'}, CHANNEL_PLAN_REGION_ETSI  }, { {'L','V'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'M','T'}, CHANNEL_PLAN_REGION_ETSI  }, { {'N','L'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'N','O'}, CHANNEL_PLAN_REGION_ETSI  }, { {'P','L'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'P','T'}, CHANNEL_PLAN_REGION_ETSI  }, { {'R','O'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'S','E'}, CHANNEL_PLAN_REGION_ETSI  }, { {'S','I'}, CHANNEL_PLAN_REGION_ETSI  },
+    { {'S','K'}, CHANNEL_PLAN_REGION_ETSI  }, { {'J','P'}, CHANNEL_PLAN_REGION_JAPAN },
+    { {'C','N'}, CHANNEL_PLAN_REGION_CHINA }
+};
+
+/* Country set from the console or the application configuration, and the one
+ * inferred from the Country IEs. The configured one takes precedence. Empty
+ * codes are all zero.
+ */
+static MODULE_STATE char plan_configured[CHANNEL_PLAN_COUNTRY_LENGTH];
+static MODULE_STATE char plan_inferred[CHANNEL_PLAN_COUNTRY_LENGTH];
+static MODULE_STATE channel_plan_region_t plan_region;
+
+/* Channel masks, one bit per entry of plan_channels. */
+static MODULE_STATE uint64_t plan_allowed_mask;
+static MODULE_STATE uint64_t plan_passive_mask;
+static MODULE_STATE uint64_t plan_disabled_mask;
+
+/* Country IEs of the sweep in progress and the leading country of the last
+ * sweeps.
+ */
+static MODULE_STATE plan_candidate_t plan_candidates[CHANNEL_PLAN_MAX_CANDIDATES];
+static MODULE_STATE char plan_leader[CHANNEL_PLAN_COUNTRY_LENGTH];
+static MODULE_STATE uint32_t plan_leader_sweeps;
+
+static MODULE_STATE channel_plan_stats_t plan_stats;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: channel_index
+********************************************************************************
+* Summary:
+* Returns the index of a channel in plan_channels, or CHANNEL_NOT_FOUND.
+*******************************************************************************/
+static uint32_t channel_index(uint8_t channel)
+{
+    for (uint32_t i = 0; i < CHANNEL_PLAN_MAX_CHANNELS; i++)
+    {
+        if (plan_channels[i] == channel)
+        {
+            return i;
+        }
+    }
+
+    return CHANNEL_NOT_FOUND;
+}
+
+/*******************************************************************************
+* Function Name: is_country_code
+********************************************************************************
+* Summary:
+* Returns true if the first two characters are a valid country code. "XX",
+* used by APs without a country, is not.
+*******************************************************************************/
+static bool is_country_code(const char *code)
+{
+    return (code[0] >= 'A') && (code[0] <= 'Z') && (code[1] >= 'A') && (code[1] <= 'Z') &&
+           !((code[0] == 'X') && (code[1] == 'X'));
+}
+
+/*******************************************************************************
+* Function Name: apply_country
+********************************************************************************
+* Summary:
+* Looks up the region of the effective country and rebuilds the channel
+* masks from its rules.
+*******************************************************************************/
+static void apply_country(void)
+{
+    const char *country = (0 != plan_configured[0]) ? plan_configured : plan_inferred;
+
+    plan_region = CHANNEL_PLAN_REGION_WORLD;
+
+    for (uint32_t i = 0; i < ARRAY_COUNT(plan_countries); i++)
+    {
+        if (0 == memcmp(plan_countries[i].code, country, CHANNEL_PLAN_COUNTRY_LENGTH))
+        {
+            plan_region = plan_countries[i].region;
+            break;
+        }
+    }
+
+    const plan_region_def_t *region = &plan_regions[plan_region];
+
+    plan_allowed_mask = 0U;
+    plan_passive_mask = 0U;
+
+    for (uint32_t i = 0; i < CHANNEL_PLAN_MAX_CHANNELS; i++)
+    {
+        uint8_t channel = plan_channels[i];
+
+        for (uint32_t r = 0; r < region->rule_count; r++)
+        {
+            const plan_rule_t *rule = &region->rules[r];
+
+            if ((channel < rule->first) || (channel > rule->last))
+            {
+                continue;
+            }
+
+            plan_allowed_mask |= (1ULL << i);
+
+            /* Radar detection is required on the DFS channels everywhere. */
+            if ((CHANNEL_PLAN_PASSIVE == rule->scan) ||
+                ((channel >= CHANNEL_DFS_FIRST) && (channel <= CHANNEL_DFS_LAST)))
+            {
+                plan_passive_mask |= (1ULL << i);
+            }
+
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: in_effect
+********************************************************************************
+* Summary:
+* Returns true if the scans follow the plan: a country is known or a channel
+* is disabled. Otherwise the scans keep the channel list of the WLAN firmware.
+*******************************************************************************/
+static bool in_effect(void)
+{
+    return (0 != plan_configured[0]) || (0 != plan_inferred[0]) || (0U != plan_disabled_mask);
+}
+
+/*******************************************************************************
+* Function Name: in_bands
+********************************************************************************
+* Summary:
+* Returns true if a channel of plan_channels belongs to one of the bands.
+*******************************************************************************/
+static bool in_bands(uint8_t channel, uint8_t bands)
+{
+    return (0U != (bands & ((channel <= CHANNEL_2_4GHZ_LAST) ? CHANNEL_PLAN_BAND_2_4GHZ :
+                                                               CHANNEL_PLAN_BAND_5GHZ)));
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_init
+********************************************************************************
+* Summary:
+* Clears the countries, the disabled channels and the statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void channel_plan_init(void)
+{
+    memset(plan_configured, 0, sizeof(plan_configured));
+    memset(plan_inferred, 0, sizeof(plan_inferred));
+    memset(plan_candidates, 0, sizeof(plan_candidates));
+    memset(plan_leader, 0, sizeof(plan_leader));
+    memset(&plan_stats, 0, sizeof(plan_stats));
+    plan_leader_sweeps = 0U;
+    plan_disabled_mask = 0U;
+
+    apply_country();
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_set_country
+********************************************************************************
+* Summary:
+* Sets the country of the plan. An empty string or NULL returns to the
+* country inferred from the Country IEs.
+*
+* Parameters:
+*  const char *country: Two letter country code
+*
+* Return:
+*  bool: false if the country code is not valid
+*
+*******************************************************************************/
+bool channel_plan_set_country(const char *country)
+{
+    if ((NULL == country) || (0 == country[0]))
+    {
+        memset(plan_configured, 0, sizeof(plan_configured));
+    }
+    else if ((CHANNEL_PLAN_COUNTRY_LENGTH == strlen(country)) && is_country_code(country))
+    {
+        memcpy(plan_configured, country, CHANNEL_PLAN_COUNTRY_LENGTH);
+    }
+    else
+    {
+        return false;
+    }
+
+    apply_country();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_country
+********************************************************************************
+* Summary:
+* Returns the effective country of the plan.
+*
+* Parameters:
+*  char *country: Receives the country code, CHANNEL_PLAN_COUNTRY_LENGTH + 1 bytes
+*  bool *inferred: Set if the country was inferred from the Country IEs
+*
+* Return:
+*  bool: false if no country is known
+*
+*******************************************************************************/
+bool channel_plan_country(char *country, bool *inferred)
+{
+    const char *code = (0 != plan_configured[0]) ? plan_configured : plan_inferred;
+
+    memcpy(country, code, CHANNEL_PLAN_COUNTRY_LENGTH);
+    country[CHANNEL_PLAN_COUNTRY_LENGTH] = 0;
+    *inferred = (0 == plan_configured[0]);
+
+    return (0 != code[0]);
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_region
+********************************************************************************
+* Summary:
+* Returns the regulatory region of the effective country.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  channel_plan_region_t: Region, CHANNEL_PLAN_REGION_WORLD if unknown
+*
+*******************************************************************************/
+channel_plan_region_t channel_plan_region(void)
+{
+    return plan_region;
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_region_name
+********************************************************************************
+* Summary:
+* Returns the name of a regulatory region.
+*
+* Parameters:
+*  channel_plan_region_t region: Region
+*
+* Return:
+*  const char*: Name of the region
+*
+*******************************************************************************/
+const char* channel_plan_region_name(channel_plan_region_t region)
+{
+    return (region < CHANNEL_PLAN_REGION_COUNT) ? plan_regions[region].name : "?";
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_set_disabled
+********************************************************************************
+* Summary:
+* Disables a channel in every scan, or enables it again.
+*
+* Parameters:
+*  uint8_t channel: 2.4 GHz or 5 GHz channel
+*  bool disabled: true to disable the channel
+*
+* Return:
+*  bool: false if the channel is not a 2.4 GHz or 5 GHz channel of the plan
+*
+*******************************************************************************/
+bool channel_plan_set_disabled(uint8_t channel, bool disabled)
+{
+    uint32_t index = channel_index(channel);
+
+    if (CHANNEL_NOT_FOUND == index)
+    {
+        return false;
+    }
+
+    if (disabled)
+    {
+        plan_disabled_mask |= (1ULL << index);
+    }
+    else
+    {
+        plan_disabled_mask &= ~(1ULL << index);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_is_disabled
+********************************************************************************
+* Summary:
+* Returns true if a channel was disabled with channel_plan_set_disabled().
+*
+* Parameters:
+*  uint8_t channel: Channel
+*
+* Return:
+*  bool: true if the channel is disabled
+*
+*******************************************************************************/
+bool channel_plan_is_disabled(uint8_t channel)
+{
+    uint32_t index = channel_index(channel);
+
+    return (CHANNEL_NOT_FOUND != index) && (0U != (plan_disabled_mask & (1ULL << index)));
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_begin
+********************************************************************************
+* Summary:
+* Starts counting the Country IEs of a sweep.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void channel_plan_begin(void)
+{
+    memset(plan_candidates, 0, sizeof(plan_candidates));
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_observe
+********************************************************************************
+* Summary:
+* Counts the country of the Country IE of a scan result, if it has one. Only
+* the country string is used: the triplets describe the AP's own channels and
+* power limits, not the channels a client may scan.
+*
+* Parameters:
+*  const uint8_t *ies: Information elements of the scan result
+*  uint32_t ie_length: Length of the information elements
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void channel_plan_observe(const uint8_t *ies, uint32_t ie_length)
+{
+    uint32_t offset = 0U;
+
+    if (NULL == ies)
+    {
+        return;
+    }
+
+    while ((offset + IE_HEADER_LENGTH) <= ie_length)
+    {
+        uint8_t id = ies[offset];
+        uint8_t length = ies[offset + 1U];
+
+        if ((offset + IE_HEADER_LENGTH + length) > ie_length)
+        {
+            return;
+        }
+
+        if ((CHANNEL_PLAN_COUNTRY_IE_ID == id) && (length >= CHANNEL_PLAN_COUNTRY_IE_MIN_LENGTH))
+        {
+            break;
+        }
+
+        offset += IE_HEADER_LENGTH + length;
+    }
+
+    if ((offset + IE_HEADER_LENGTH) > ie_length)
+    {
+        return;
+    }
+
+    const char *code = (const char *)&ies[offset + IE_HEADER_LENGTH];
+
+    if (!is_country_code(code))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < CHANNEL_PLAN_MAX_CANDIDATES; i++)
+    {
+        plan_candidate_t *candidate = &plan_candidates[i];
+
+        if (0U == candidate->votes)
+        {
+            memcpy(candidate->code, code, CHANNEL_PLAN_COUNTRY_LENGTH);
+        }
+
+        if (0 == memcmp(candidate->code, code, CHANNEL_PLAN_COUNTRY_LENGTH))
+        {
+            candidate->votes++;
+            return;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_commit
+********************************************************************************
+* Summary:
+* Completes a sweep. A country that led CHANNEL_PLAN_INFER_SWEEPS successive
+* sweeps becomes the inferred country. Sweeps without enough Country IEs, such
+* as filtered ones, leave the inference as it is.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void channel_plan_commit(void)
+{
+    const plan_candidate_t *best = NULL;
+
+    for (uint32_t i = 0; i < CHANNEL_PLAN_MAX_CANDIDATES; i++)
+    {
+        if ((plan_candidates[i].votes >= CHANNEL_PLAN_MIN_VOTES) &&
+            ((NULL == best) || (plan_candidates[i].votes > best->votes)))
+        {
+            best = &plan_candidates[i];
+        }
+    }
+
+    if (NULL == best)
+    {
+        return;
+    }
+
+    if (0 == memcmp(plan_leader, best->code, CHANNEL_PLAN_COUNTRY_LENGTH))
+    {
+        plan_leader_sweeps++;
+    }
+    else
+    {
+        memcpy(plan_leader, best->code, CHANNEL_PLAN_COUNTRY_LENGTH);
+        plan_leader_sweeps = 1U;
+    }
+
+    if ((plan_leader_sweeps >= CHANNEL_PLAN_INFER_SWEEPS) &&
+        (0 != memcmp(plan_inferred, plan_leader, CHANNEL_PLAN_COUNTRY_LENGTH)))
+    {
+        memcpy(plan_inferred, plan_leader, CHANNEL_PLAN_COUNTRY_LENGTH);
+        apply_country();
+    }
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_lookup
+********************************************************************************
+* Summary:
+* Returns how a 2.4 GHz or 5 GHz channel may be scanned. While the plan is not
+* in effect, every channel is scanned actively as before.
+*
+* Parameters:
+*  uint8_t channel: Channel
+*
+* Return:
+*  channel_plan_scan_t: Skip, active or passive scan
+*
+*******************************************************************************/
+channel_plan_scan_t channel_plan_lookup(uint8_t channel)
+{
+    if (!in_effect())
+    {
+        return CHANNEL_PLAN_ACTIVE;
+    }
+
+    uint32_t index = channel_index(channel);
+
+    if ((CHANNEL_NOT_FOUND == index) || (0U == (plan_allowed_mask & (1ULL << index))) ||
+        (0U != (plan_disabled_mask & (1ULL << index))))
+    {
+        return CHANNEL_PLAN_SKIP;
+    }
+
+    return (0U != (plan_passive_mask & (1ULL << index))) ? CHANNEL_PLAN_PASSIVE :
+                                                          CHANNEL_PLAN_ACTIVE;
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_build
+********************************************************************************
+* Summary:
+* Builds the channel lists of a sweep of the given bands.
+*
+* Parameters:
+*  uint8_t bands: CHANNEL_PLAN_BAND_ flags of the bands to scan
+*  channel_plan_t *plan: Receives the channel lists
+*
+* Return:
+*  bool: false if the plan is not in effect and the default channel list of
+*        the WLAN firmware should be scanned
+*
+*******************************************************************************/
+bool channel_plan_build(uint8_t bands, channel_plan_t *plan)
+{
+    plan->active_count = 0U;
+    plan->passive_count = 0U;
+    plan->six_ghz = (0U != (bands & CHANNEL_PLAN_BAND_6GHZ)) && plan_regions[plan_region].six_ghz;
+
+    for (uint32_t i = 0; i < CHANNEL_PLAN_MAX_CHANNELS; i++)
+    {
+        uint8_t channel = plan_channels[i];
+
+        if (!in_bands(channel, bands))
+        {
+            continue;
+        }
+
+        switch (channel_plan_lookup(channel))
+        {
+            case CHANNEL_PLAN_ACTIVE:
+                plan->active[plan->active_count++] = channel;
+                break;
+
+            case CHANNEL_PLAN_PASSIVE:
+                plan->passive[plan->passive_count++] = channel;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    plan->active[plan->active_count] = 0U;
+    plan->passive[plan->passive_count] = 0U;
+
+    return in_effect();
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_estimate_ms
+********************************************************************************
+* Summary:
+* Estimates the radio time of a 2.4 GHz and 5 GHz sweep from the dwell times.
+* The default sweep visits every channel of plan_channels, the DFS channels
+* passively.
+*
+* Parameters:
+*  uint8_t bands: CHANNEL_PLAN_BAND_ flags of the bands to scan
+*  bool planned: true for the planned sweep, false for the default one
+*
+* Return:
+*  uint32_t: Estimated duration in ms
+*
+*******************************************************************************/
+uint32_t channel_plan_estimate_ms(uint8_t bands, bool planned)
+{
+    uint32_t total = 0U;
+
+    for (uint32_t i = 0; i < CHANNEL_PLAN_MAX_CHANNELS; i++)
+    {
+        uint8_t channel = plan_channels[i];
+        channel_plan_scan_t scan;
+
+        if (!in_bands(channel, bands))
+        {
+            continue;
+        }
+
+        if (planned && in_effect())
+        {
+            scan = channel_plan_lookup(channel);
+        }
+        else
+        {
+            scan = ((channel >= CHANNEL_DFS_FIRST) && (channel <= CHANNEL_DFS_LAST)) ?
+                   CHANNEL_PLAN_PASSIVE : CHANNEL_PLAN_ACTIVE;
+        }
+
+        if (CHANNEL_PLAN_ACTIVE == scan)
+        {
+            total += CHANNEL_PLAN_ACTIVE_DWELL_MS;
+        }
+        else if (CHANNEL_PLAN_PASSIVE == scan)
+        {
+            total += CHANNEL_PLAN_PASSIVE_DWELL_MS;
+        }
+    }
+
+    return total;
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_account_sweep
+********************************************************************************
+* Summary:
+* Adds the measured duration of an unfiltered sweep to the statistics.
+*
+* Parameters:
+*  bool planned: true if the sweep used the planned channel lists
+*  uint32_t duration_ms: Duration of the sweep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void channel_plan_account_sweep(bool planned, uint32_t duration_ms)
+{
+    if (planned)
+    {
+        plan_stats.planned_sweeps++;
+        plan_stats.planned_ms += duration_ms;
+    }
+    else
+    {
+        plan_stats.default_sweeps++;
+        plan_stats.default_ms += duration_ms;
+    }
+}
+
+/*******************************************************************************
+* Function Name: channel_plan_stats
+********************************************************************************
+* Summary:
+* Returns the sweep statistics.
+*
+* Parameters:
+*  channel_plan_stats_t *stats: Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void channel_plan_stats(channel_plan_stats_t *stats)
+{
+    *stats = plan_stats;
+}
+
+/* [] END OF FILE */
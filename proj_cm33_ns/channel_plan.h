@@ -0,0 +1,166 @@
+/*******************************************************************************
+* File Name        : channel_plan.h
+*
+* Description      : This file contains the structures and functions of the
+*                    regulatory channel planner, which builds the channel lists of
+*                    the scans from the configured or inferred country.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_CHANNEL_PLAN_H_
+#define SOURCE_CHANNEL_PLAN_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bands of a plan. */
+#define CHANNEL_PLAN_BAND_2_4GHZ             (0x01U)
+#define CHANNEL_PLAN_BAND_5GHZ               (0x02U)
+#define CHANNEL_PLAN_BAND_6GHZ               (0x04U)
+#define CHANNEL_PLAN_BAND_ALL                (0x07U)
+
+/* 2.4 GHz channels 1-13 and the 20 MHz 5 GHz channels 36-165. */
+#define CHANNEL_PLAN_MAX_CHANNELS            (38U)
+
+/* Dwell times of the planned scans. They are the defaults of the WLAN
+ * firmware, so the planned and the default sweeps spend the same time on a
+ * channel and differ only in the channels they visit.
+ */
+#define CHANNEL_PLAN_ACTIVE_DWELL_MS         (40U)
+#define CHANNEL_PLAN_PASSIVE_DWELL_MS        (110U)
+
+/* A country is inferred once it is the most frequent Country IE with at least
+ * CHANNEL_PLAN_MIN_VOTES results in this many successive sweeps.
+ */
+#define CHANNEL_PLAN_INFER_SWEEPS            (2U)
+#define CHANNEL_PLAN_MIN_VOTES               (2U)
+#define CHANNEL_PLAN_MAX_CANDIDATES          (4U)
+
+/* Length of a country code without the environment character. */
+#define CHANNEL_PLAN_COUNTRY_LENGTH          (2U)
+
+/* Element ID of the Country IE and its minimum length (country string). */
+#define CHANNEL_PLAN_COUNTRY_IE_ID           (7U)
+#define CHANNEL_PLAN_COUNTRY_IE_MIN_LENGTH   (3U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+typedef enum
+{
+    CHANNEL_PLAN_SKIP = 0,
+    CHANNEL_PLAN_ACTIVE,
+    CHANNEL_PLAN_PASSIVE
+} channel_plan_scan_t;
+
+typedef enum
+{
+    CHANNEL_PLAN_REGION_WORLD = 0,
+    CHANNEL_PLAN_REGION_FCC,
+    CHANNEL_PLAN_REGION_ETSI,
+    CHANNEL_PLAN_REGION_JAPAN,
+    CHANNEL_PLAN_REGION_CHINA,
+    CHANNEL_PLAN_REGION_COUNT
+} channel_plan_region_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Channel lists of one sweep, terminated by 0 as the WHD scan expects them.
+ * Channels that may be probed are in 'active', DFS and passive-only channels
+ * in 'passive'. six_ghz is set if the plan includes the 6 GHz band, which
+ * the channel lists cannot describe.
+ */
+typedef struct
+{
+    uint16_t active[CHANNEL_PLAN_MAX_CHANNELS + 1U];
+    uint16_t passive[CHANNEL_PLAN_MAX_CHANNELS + 1U];
+    uint8_t  active_count;
+    uint8_t  passive_count;
+    bool     six_ghz;
+} channel_plan_t;
+
+/* Sweep durations, split into sweeps with the default channel list of the
+ * WLAN firmware and sweeps with a planned one.
+ */
+typedef struct
+{
+    uint32_t default_sweeps;
+    uint32_t default_ms;
+    uint32_t planned_sweeps;
+    uint32_t planned_ms;
+} channel_plan_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void channel_plan_init(void);
+bool channel_plan_set_country(const char *country);
+bool channel_plan_country(char *country, bool *inferred);
+channel_plan_region_t channel_plan_region(void);
+const char* channel_plan_region_name(channel_plan_region_t region);
+bool channel_plan_set_disabled(uint8_t channel, bool disabled);
+bool channel_plan_is_disabled(uint8_t channel);
+void channel_plan_begin(void);
+void channel_plan_observe(const uint8_t *ies, uint32_t ie_length);
+void channel_plan_commit(void);
+channel_plan_scan_t channel_plan_lookup(uint8_t channel);
+bool channel_plan_build(uint8_t bands, channel_plan_t *plan);
+uint32_t channel_plan_estimate_ms(uint8_t bands, bool planned);
+void channel_plan_account_sweep(bool planned, uint32_t duration_ms);
+void channel_plan_stats(channel_plan_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_CHANNEL_PLAN_H_ */
+
+/* [] END OF FILE */
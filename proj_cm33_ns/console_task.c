@@ -0,0 +1,2165 @@
+/*******************************************************************************
+* File Name        : console_task.c
+*
+* Description      : This file contains the task that reads commands from the
+*                    debug UART and prints the scan data requested by the user.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "cybsp.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "scan_task.h"
+#include "console_task.h"
+#include "bssid_table.h"
+#include "rssi_history.h"
+#include "series_codec.h"
+#include "perf_counter.h"
+#include "scan_log.h"
+#include "snapshot_ring.h"
+#include "presence_tracker.h"
+#include "proximity_zones.h"
+#include "anomaly_detector.h"
+#include "motion_sensor.h"
+#include "bssid_stability.h"
+#include "six_ghz_plan.h"
+#include "channel_plan.h"
+#include "ess_view.h"
+#include "planned_sweep.h"
+#include "interference_matrix.h"
+#include "occupancy_buckets.h"
+#include "load_shedder.h"
+#include "scan_output.h"
+#include "ssid_escape.h"
+#include "hash_service.h"
+#include "pseudonym.h"
+#include "secure_batch.h"
+#include "scan_sign.h"
+#include "uplink_task.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CONSOLE_PROMPT                       "\n> "
+#define CONSOLE_DEFAULT_MINUTES              (60U)
+#define CONSOLE_DEFAULT_HOURS                (24U)
+#define ASCII_BACKSPACE                      ('\b')
+#define ASCII_DELETE                         (0x7FU)
+
+/* Size of one uncompressed (timestamp, RSSI) record, used as the reference for
+ * the compression ratio.
+ */
+#define SERIES_RAW_RECORD_BYTES              (sizeof(uint32_t) + sizeof(uint8_t))
+#define HEX_BYTES_PER_LINE                   (32U)
+
+#define CONSOLE_INTERFERENCE_CANDIDATES      (5U)
+
+/* Input sizes and calls per size of the hash benchmark. */
+#define CONSOLE_HASH_MAX_SIZE                (256U)
+#define CONSOLE_HASH_CALLS                   (64U)
+#define CONSOLE_SECURE_CALLS                 (64U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    const char *usage;
+    void (*handler)(int argc, char **argv);
+} console_command_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void console_cmd_help(int argc, char **argv);
+static void console_cmd_hist(int argc, char **argv);
+static void console_cmd_zhist(int argc, char **argv);
+static void console_cmd_slog(int argc, char **argv);
+static void console_cmd_snap(int argc, char **argv);
+static void console_cmd_watch(int argc, char **argv);
+static void console_cmd_zone(int argc, char **argv);
+static void console_cmd_anom(int argc, char **argv);
+static void console_cmd_motion(int argc, char **argv);
+static void console_cmd_stab(int argc, char **argv);
+static void console_cmd_rnr(int argc, char **argv);
+static void console_cmd_chan(int argc, char **argv);
+static void console_cmd_ess(int argc, char **argv);
+static void console_cmd_intf(int argc, char **argv);
+static void console_cmd_occ(int argc, char **argv);
+static void console_cmd_shed(int argc, char **argv);
+static void console_cmd_out(int argc, char **argv);
+static void console_cmd_fields(int argc, char **argv);
+static void console_cmd_hash(int argc, char **argv);
+static void console_cmd_pseudo(int argc, char **argv);
+static void console_cmd_secure(int argc, char **argv);
+static void console_cmd_sign(int argc, char **argv);
+static void console_cmd_uplink(int argc, char **argv);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const console_command_t console_commands[] =
+{
+    { "help", "help",                              console_cmd_help },
+    { "hist", "hist [<bssid> [minutes] [hours]]",  console_cmd_hist },
+    { "zhist", "zhist <bssid> [dump]",             console_cmd_zhist },
+    { "slog", "slog [on|off]",                     console_cmd_slog },
+    { "snap", "snap [<age>|<bssid>]",              console_cmd_snap },
+    { "watch", "watch [add <bssid> [channel]|del <bssid>|reset]", console_cmd_watch },
+    { "zone", "zone [add <bssid>|<ssid> <near> <mid> <far> [enter exit dwell_ms]|del <n>]",
+      console_cmd_zone },
+    { "anom", "anom",                              console_cmd_anom },
+    { "motion", "motion [start|stop|threshold <dB^2>|trace <on|off>]", console_cmd_motion },
+    { "stab", "stab",                              console_cmd_stab },
+    { "rnr", "rnr",                                console_cmd_rnr },
+    { "chan", "chan [country <cc>|auto|disable <ch>|enable <ch>]", console_cmd_chan },
+    { "ess", "ess",                                console_cmd_ess },
+    { "intf", "intf [2.4|5|6] [20|40|80|160]",     console_cmd_intf },
+    { "occ", "occ [<day> <hour>|dump]",            console_cmd_occ },
+    { "shed", "shed",                              console_cmd_shed },
+    { "out", "out [auto|full|diff|summary|reset]", console_cmd_out },
+    { "fields", "fields [default|all|<field>,<field>...|packed|plain]", console_cmd_fields },
+    { "hash", "hash",                              console_cmd_hash },
+    { "pseudo", "pseudo [on|off|rotate]",         console_cmd_pseudo },
+    { "secure", "secure",                          console_cmd_secure },
+    { "sign", "sign [on|off|auto|<records>]",     console_cmd_sign },
+    { "uplink", "uplink [close|forget]",           console_cmd_uplink },
+};
+
+/* Buffers used to copy the data out of the scan modules while the scan data
+ * lock is held. They are static to keep the console task stack small.
+ */
+static uint8_t console_raw[RSSI_HISTORY_RAW_DEPTH];
+static rssi_history_agg_t console_aggs[RSSI_HISTORY_MINUTE_DEPTH];
+static uint8_t console_stream[RSSI_HISTORY_MINUTE_DEPTH * SERIES_CODEC_MAX_RECORD_BYTES];
+static snapshot_ring_ap_t console_snapshot[SNAPSHOT_RING_DICT_SIZE];
+static occupancy_bucket_t console_buckets[OCCUPANCY_BUCKETS];
+static uint8_t console_occupancy[OCCUPANCY_MAX_RECORD_SIZE];
+
+static const char *const console_days[OCCUPANCY_DAYS] =
+{
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: console_parse_mac
+********************************************************************************
+* Summary:
+* Parses a MAC address written as six hexadecimal octets separated by ':'.
+*
+* Parameters:
+*  const char *text: Text to parse
+*  uint8_t *mac: Parsed address (6 bytes)
+*
+* Return:
+*  bool: true if the text is a valid MAC address
+*
+*******************************************************************************/
+bool console_parse_mac(const char *text, uint8_t *mac)
+{
+    for (uint32_t i = 0; i < BSSID_LENGTH; i++)
+    {
+        char *end;
+        unsigned long octet = strtoul(text, &end, 16);
+
+        if ((end == text) || (octet > UINT8_MAX) ||
+            ((i < (BSSID_LENGTH - 1U)) && (':' != *end)) ||
+            ((i == (BSSID_LENGTH - 1U)) && ('\0' != *end)))
+        {
+            return false;
+        }
+
+        mac[i] = (uint8_t)octet;
+        text = end + 1;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: print_rssi_offset
+********************************************************************************
+* Summary:
+* Prints one RSSI sample stored as an 8-bit offset.
+*******************************************************************************/
+static void print_rssi_offset(uint8_t offset)
+{
+    if (RSSI_HISTORY_NO_SAMPLE == offset)
+    {
+        printf("  ---");
+    }
+    else
+    {
+        printf(" %4d", rssi_history_decode(offset));
+    }
+}
+
+/*******************************************************************************
+* Function Name: print_aggregates
+********************************************************************************
+* Summary:
+* Prints per-minute or per-hour aggregates as min/mean/max triplets.
+*******************************************************************************/
+static void print_aggregates(const char *title, const rssi_history_agg_t *aggs,
+                             uint32_t count)
+{
+    printf("\n%s (%"PRIu32", oldest first, min/mean/max dBm):\n", title, count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (RSSI_HISTORY_NO_SAMPLE == aggs[i].mean)
+        {
+            printf("     ---/---/--- ");
+        }
+        else
+        {
+            printf(" %4d/%4d/%4d ", rssi_history_decode(aggs[i].weakest),
+                   rssi_history_decode(aggs[i].mean),
+                   rssi_history_decode(aggs[i].strongest));
+        }
+
+        if (5U == (i % 6U))
+        {
+            printf("\n");
+        }
+    }
+
+    printf("\n");
+}
+
+/*******************************************************************************
+* Function Name: find_history_slot
+********************************************************************************
+* Summary:
+* Returns the history slot of a BSSID. Must be called with the scan data lock.
+*******************************************************************************/
+static int32_t find_history_slot(const uint8_t *bssid)
+{
+    uint16_t index = bssid_table_find(bssid);
+    const bssid_table_entry_t *entry = bssid_table_get(index);
+
+    return (NULL != entry) ? rssi_history_find(index, entry->generation) :
+                             RSSI_HISTORY_INVALID_SLOT;
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_help
+********************************************************************************
+* Summary:
+* Lists the available console commands.
+*******************************************************************************/
+static void console_cmd_help(int argc, char **argv)
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    printf("\nCommands:\n");
+
+    for (uint32_t i = 0; i < (sizeof(console_commands) / sizeof(console_commands[0])); i++)
+    {
+        printf("  %s\n", console_commands[i].usage);
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_hist
+********************************************************************************
+* Summary:
+* Without arguments, lists the BSSIDs that have an RSSI history. With a BSSID,
+* prints its raw, per-minute and per-hour history.
+*******************************************************************************/
+static void console_cmd_hist(int argc, char **argv)
+{
+    uint8_t bssid[BSSID_LENGTH];
+    uint32_t minutes = CONSOLE_DEFAULT_MINUTES;
+    uint32_t hours = CONSOLE_DEFAULT_HOURS;
+    uint32_t raw_count;
+    uint32_t agg_count;
+    int32_t slot;
+
+    if (argc < 2)
+    {
+        printf("\nRSSI history: %u bytes per BSSID, %u BSSIDs, %u bytes total\n",
+               (unsigned int)rssi_history_bytes_per_bssid(),
+               (unsigned int)RSSI_HISTORY_MAX_BSSIDS,
+               (unsigned int)rssi_history_total_bytes());
+
+        scan_data_lock();
+
+        for (uint16_t i = 0; i < bssid_table_count(); i++)
+        {
+            const bssid_table_entry_t *entry = bssid_table_get(i);
+
+            if ((NULL != entry) &&
+                (RSSI_HISTORY_INVALID_SLOT != rssi_history_find(i, entry->generation)))
+            {
+                printf("  %02X:%02X:%02X:%02X:%02X:%02X\n",
+                       entry->bssid[0], entry->bssid[1], entry->bssid[2],
+                       entry->bssid[3], entry->bssid[4], entry->bssid[5]);
+            }
+        }
+
+        scan_data_unlock();
+        return;
+    }
+
+    if (!console_parse_mac(argv[1], bssid))
+    {
+        printf("\nInvalid BSSID %s\n", argv[1]);
+        return;
+    }
+
+    if (argc > 2)
+    {
+        minutes = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+
+    if (argc > 3)
+    {
+        hours = (uint32_t)strtoul(argv[3], NULL, 10);
+    }
+
+    if (minutes > RSSI_HISTORY_MINUTE_DEPTH)
+    {
+        minutes = RSSI_HISTORY_MINUTE_DEPTH;
+    }
+
+    if (hours > RSSI_HISTORY_HOUR_DEPTH)
+    {
+        hours = RSSI_HISTORY_HOUR_DEPTH;
+    }
+
+    scan_data_lock();
+
+    slot = find_history_slot(bssid);
+    raw_count = rssi_history_read_raw(slot, console_raw, RSSI_HISTORY_RAW_DEPTH);
+
+    scan_data_unlock();
+
+    if (RSSI_HISTORY_INVALID_SLOT == slot)
+    {
+        printf("\nNo RSSI history for %s\n", argv[1]);
+        return;
+    }
+
+    printf("\nRaw (last %"PRIu32" scans, oldest first, dBm):\n", raw_count);
+
+    for (uint32_t i = 0; i < raw_count; i++)
+    {
+        print_rssi_offset(console_raw[i]);
+
+        if (15U == (i % 16U))
+        {
+            printf("\n");
+        }
+    }
+
+    /* The aggregates share one buffer so they are copied and printed one
+     * resolution at a time.
+     */
+    scan_data_lock();
+    agg_count = rssi_history_read_minutes(slot, console_aggs, minutes);
+    scan_data_unlock();
+    print_aggregates("Per-minute", console_aggs, agg_count);
+
+    scan_data_lock();
+    agg_count = rssi_history_read_hours(slot, console_aggs, hours);
+    scan_data_unlock();
+    print_aggregates("Per-hour", console_aggs, agg_count);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_zhist
+********************************************************************************
+* Summary:
+* Compresses the per-minute and per-hour history of a BSSID, decodes it back,
+* and prints the compression ratio and the encode and decode time. With the
+* 'dump' argument, the compressed streams are printed in hexadecimal.
+*******************************************************************************/
+static void console_cmd_zhist(int argc, char **argv)
+{
+    static const char * const names[] = { "Per-minute", "Per-hour" };
+    uint8_t bssid[BSSID_LENGTH];
+    series_encoder_t enc;
+    series_decoder_t dec;
+    uint32_t timestamp;
+    uint8_t value;
+
+    if ((argc < 2) || (!console_parse_mac(argv[1], bssid)))
+    {
+        printf("\nUsage: zhist <bssid> [dump]\n");
+        return;
+    }
+
+    for (uint32_t res = RSSI_HISTORY_MINUTES; res <= RSSI_HISTORY_HOURS; res++)
+    {
+        series_encoder_init(&enc, console_stream, sizeof(console_stream));
+
+        scan_data_lock();
+
+        int32_t slot = find_history_slot(bssid);
+        uint32_t start = perf_counter_now();
+        uint32_t records = rssi_history_export(slot, (rssi_history_resolution_t)res, &enc);
+        uint32_t length = series_encoder_finish(&enc);
+        uint32_t encode_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+        scan_data_unlock();
+
+        if (RSSI_HISTORY_INVALID_SLOT == slot)
+        {
+            printf("\nNo RSSI history for %s\n", argv[1]);
+            return;
+        }
+
+        uint32_t decoded = 0;
+
+        start = perf_counter_now();
+        series_decoder_init(&dec, console_stream, length);
+
+        while (series_decoder_next(&dec, &timestamp, &value))
+        {
+            decoded++;
+        }
+
+        uint32_t decode_ns = perf_counter_to_ns(perf_counter_now() - start);
+        uint32_t raw_bytes = records * SERIES_RAW_RECORD_BYTES;
+
+        printf("\n%s: %"PRIu32" records, %"PRIu32" -> %"PRIu32" bytes",
+               names[res], records, raw_bytes, length);
+
+        if (0U != length)
+        {
+            printf(" (%"PRIu32".%02"PRIu32"x)", raw_bytes / length,
+                   ((raw_bytes % length) * 100U) / length);
+        }
+
+        printf(", encode %"PRIu32" us, decode %"PRIu32" us, %"PRIu32" decoded\n",
+               encode_ns / PERF_COUNTER_NS_PER_US,
+               decode_ns / PERF_COUNTER_NS_PER_US, decoded);
+
+        if ((argc > 2) && (0 == strcmp(argv[2], "dump")))
+        {
+            for (uint32_t i = 0; i < length; i++)
+            {
+                printf("%02X", console_stream[i]);
+
+                if ((HEX_BYTES_PER_LINE - 1U) == (i % HEX_BYTES_PER_LINE))
+                {
+                    printf("\n");
+                }
+            }
+
+            printf("\n");
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_slog
+********************************************************************************
+* Summary:
+* Enables or disables printing of the binary scan log records on the debug
+* UART, or shows the current state.
+*******************************************************************************/
+static void console_cmd_slog(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1], "on"))
+        {
+            scan_log_set_sink(scan_sign_sink);
+        }
+        else if (0 == strcmp(argv[1], "off"))
+        {
+            scan_log_set_sink(NULL);
+        }
+        else
+        {
+            printf("\nUsage: slog [on|off]\n");
+            return;
+        }
+    }
+
+    printf("\nScan log records on UART: %s\n",
+           (NULL != scan_log_get_sink()) ? "on" : "off");
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_snap
+********************************************************************************
+* Summary:
+* Without arguments, lists the snapshots kept in RAM and their size. With an
+* age, prints the BSSIDs of that snapshot (0 is the most recent). With a
+* BSSID, prints its presence over the stored snapshots, most recent first.
+*******************************************************************************/
+static void console_cmd_snap(int argc, char **argv)
+{
+    snapshot_ring_info_t info;
+    snapshot_ring_stats_t stats;
+    uint8_t bssid[BSSID_LENGTH];
+
+    if (argc < 2)
+    {
+        scan_data_lock();
+
+        snapshot_ring_stats(&stats);
+        printf("\nSnapshots: %"PRIu32", %"PRIu32" bytes encoded, %"PRIu32
+               " dictionary entries, %"PRIu32" bytes reserved\n",
+               stats.count, stats.pool_used, stats.dict_used, stats.total_bytes);
+        printf("  Age  Sequence   Timestamp  BSSIDs  Bytes\n");
+
+        for (uint32_t age = 0; snapshot_ring_get(age, &info, NULL, 0U); age++)
+        {
+            printf("  %3"PRIu32"  %8"PRIu32"  %10"PRIu32"  %6u  %5u%s%s\n", age,
+                   info.sequence, info.timestamp, info.ap_count, info.bytes,
+                   (0U != (info.flags & SNAPSHOT_RING_FLAG_FULL_SWEEP)) ? "" : "  filtered",
+                   (0U != (info.flags & SNAPSHOT_RING_FLAG_TRUNCATED)) ? "  truncated" : "");
+        }
+
+        scan_data_unlock();
+        return;
+    }
+
+    if (NULL != strchr(argv[1], ':'))
+    {
+        if (!console_parse_mac(argv[1], bssid))
+        {
+            printf("\nInvalid BSSID %s\n", argv[1]);
+            return;
+        }
+
+        scan_data_lock();
+
+        uint32_t count = snapshot_ring_count();
+        uint32_t presence = snapshot_ring_presence(bssid);
+
+        scan_data_unlock();
+
+        printf("\nPresence in the last %"PRIu32" snapshots, most recent first:\n  ", count);
+
+        for (uint32_t age = 0; age < count; age++)
+        {
+            printf("%c", (0U != (presence & (1UL << age))) ? 'X' : '.');
+        }
+
+        printf("\n");
+        return;
+    }
+
+    uint32_t age = (uint32_t)strtoul(argv[1], NULL, 10);
+
+    scan_data_lock();
+
+    bool found = snapshot_ring_get(age, &info, console_snapshot,
+                                   SNAPSHOT_RING_DICT_SIZE);
+
+    scan_data_unlock();
+
+    if (!found)
+    {
+        printf("\nNo snapshot of age %"PRIu32"\n", age);
+        return;
+    }
+
+    printf("\nSnapshot %"PRIu32" (sequence %"PRIu32", timestamp %"PRIu32", %u bytes):\n",
+           age, info.sequence, info.timestamp, info.bytes);
+
+    for (uint32_t i = 0; i < info.ap_count; i++)
+    {
+        const snapshot_ring_ap_t *ap = &console_snapshot[i];
+
+        printf("  %02X:%02X:%02X:%02X:%02X:%02X  %4d dBm  channel %u\n",
+               ap->bssid[0], ap->bssid[1], ap->bssid[2], ap->bssid[3],
+               ap->bssid[4], ap->bssid[5], ap->rssi, ap->channel);
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_watch
+********************************************************************************
+* Summary:
+* Manages the presence watchlist. Without arguments, prints the state of the
+* watched BSSIDs, their probe statistics and the radio duty cycle.
+*******************************************************************************/
+static void console_cmd_watch(int argc, char **argv)
+{
+    presence_target_t target;
+    uint8_t bssid[BSSID_LENGTH];
+    uint32_t busy_ms;
+    uint32_t elapsed_ms;
+
+    if (argc < 2)
+    {
+        printf("\n  BSSID               Ch  State    RSSI  Probes    Hits  Failed  Revisit ms  Max revisit  Probe ms  Max probe\n");
+
+        scan_data_lock();
+
+        for (uint32_t i = 0; i < PRESENCE_MAX_TARGETS; i++)
+        {
+            if (!presence_tracker_get(i, &target))
+            {
+                continue;
+            }
+
+            printf("  %02X:%02X:%02X:%02X:%02X:%02X  %3u  %-7s  %4d  %6"PRIu32"  %6"PRIu32
+                   "  %6"PRIu32"  %10"PRIu32"  %11"PRIu32"  %8"PRIu32"  %9"PRIu32"\n",
+                   target.bssid[0], target.bssid[1], target.bssid[2],
+                   target.bssid[3], target.bssid[4], target.bssid[5],
+                   target.channel, target.present ? "present" : "absent",
+                   target.rssi, target.probes, target.hits, target.failed,
+                   target.last_revisit_ms, target.max_revisit_ms,
+                   (0U != target.probes) ? (target.total_probe_ms / target.probes) : 0U,
+                   target.max_probe_ms);
+        }
+
+        presence_tracker_duty_cycle(&busy_ms, &elapsed_ms);
+
+        scan_data_unlock();
+
+        printf("Radio busy %"PRIu32" ms of %"PRIu32" ms", busy_ms, elapsed_ms);
+
+        if (0U != elapsed_ms)
+        {
+            printf(" (%"PRIu32"%%)", (uint32_t)(((uint64_t)busy_ms * 100U) / elapsed_ms));
+        }
+
+        printf("\n");
+        return;
+    }
+
+    if (0 == strcmp(argv[1], "reset"))
+    {
+        scan_data_lock();
+        presence_tracker_reset_stats();
+        scan_data_unlock();
+        return;
+    }
+
+    if ((argc < 3) || (!console_parse_mac(argv[2], bssid)))
+    {
+        printf("\nUsage: watch [add <bssid> [channel]|del <bssid>|reset]\n");
+        return;
+    }
+
+    if (0 == strcmp(argv[1], "add"))
+    {
+        uint8_t channel = (argc > 3) ? (uint8_t)strtoul(argv[3], NULL, 10) :
+                                       PRESENCE_CHANNEL_UNKNOWN;
+
+        scan_data_lock();
+        bool added = presence_tracker_add(bssid, channel);
+        scan_data_unlock();
+
+        if (!added)
+        {
+            printf("\nWatchlist full (%u BSSIDs)\n", (unsigned int)PRESENCE_MAX_TARGETS);
+        }
+        else if (PRESENCE_CHANNEL_UNKNOWN == channel)
+        {
+            printf("\nThe channel will be learned from the next full sweep\n");
+        }
+    }
+    else if (0 == strcmp(argv[1], "del"))
+    {
+        scan_data_lock();
+        bool removed = presence_tracker_remove(bssid);
+        scan_data_unlock();
+
+        if (!removed)
+        {
+            printf("\n%s is not watched\n", argv[2]);
+        }
+    }
+    else
+    {
+        printf("\nUsage: watch [add <bssid> [channel]|del <bssid>|reset]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_zone
+********************************************************************************
+* Summary:
+* Manages the proximity zone rules. Without arguments, lists the rules and the
+* current zone of each target. The thresholds and hysteresis are in dBm.
+*******************************************************************************/
+static void console_cmd_zone(int argc, char **argv)
+{
+    proximity_rule_t rule;
+    proximity_zone_t zone;
+    int16_t rssi;
+
+    if (argc < 2)
+    {
+        printf("\n  #  Target                            Near   Mid   Far  Hyst  Dwell ms  Zone  RSSI\n");
+
+        scan_data_lock();
+
+        for (uint32_t i = 0; i < PROXIMITY_MAX_RULES; i++)
+        {
+            if (!proximity_zones_get(i, &rule, &zone, &rssi))
+            {
+                continue;
+            }
+
+            if (PROXIMITY_MATCH_BSSID == rule.match)
+            {
+                printf("  %"PRIu32"  %02X:%02X:%02X:%02X:%02X:%02X                 ", i,
+                       rule.bssid[0], rule.bssid[1], rule.bssid[2],
+                       rule.bssid[3], rule.bssid[4], rule.bssid[5]);
+            }
+            else
+            {
+                char ssid[SSID_ESCAPE_BUFFER_SIZE];
+                uint32_t columns;
+
+                (void)ssid_escape(rule.ssid, rule.ssid_length, SSID_ESCAPE_TERMINAL, ssid,
+                                  &columns);
+                printf("  %"PRIu32"  %s%*s ", i, ssid,
+                       ssid_escape_padding(columns, SSID_ESCAPE_MAX_SSID_LENGTH), "");
+            }
+
+            printf("%4d  %4d  %4d  %u/%u  %8"PRIu32"  %-4s  %4d\n",
+                   rule.threshold_dbm[PROXIMITY_ZONE_NEAR],
+                   rule.threshold_dbm[PROXIMITY_ZONE_MID],
+                   rule.threshold_dbm[PROXIMITY_ZONE_FAR],
+                   rule.enter_hyst_db, rule.exit_hyst_db, rule.dwell_ms,
+                   proximity_zone_name(zone), rssi);
+        }
+
+        scan_data_unlock();
+        return;
+    }
+
+    if ((0 == strcmp(argv[1], "del")) && (argc > 2))
+    {
+        scan_data_lock();
+        bool removed = proximity_zones_remove((uint32_t)strtoul(argv[2], NULL, 10));
+        scan_data_unlock();
+
+        if (!removed)
+        {
+            printf("\nNo rule %s\n", argv[2]);
+        }
+
+        return;
+    }
+
+    if ((0 != strcmp(argv[1], "add")) || (argc < 6))
+    {
+        printf("\nUsage: zone [add <bssid>|<ssid> <near> <mid> <far> [enter exit dwell_ms]|del <n>]\n");
+        return;
+    }
+
+    memset(&rule, 0, sizeof(rule));
+
+    if (console_parse_mac(argv[2], rule.bssid))
+    {
+        rule.match = PROXIMITY_MATCH_BSSID;
+    }
+    else
+    {
+        rule.match = PROXIMITY_MATCH_SSID;
+        rule.ssid_length = (uint8_t)strnlen(argv[2], PROXIMITY_SSID_MAX_LENGTH);
+        memcpy(rule.ssid, argv[2], rule.ssid_length);
+    }
+
+    for (uint32_t i = 0; i < (uint32_t)PROXIMITY_ZONE_OUT; i++)
+    {
+        rule.threshold_dbm[i] = (int8_t)strtol(argv[3U + i], NULL, 10);
+    }
+
+    rule.enter_hyst_db = (argc > 6) ? (uint8_t)strtoul(argv[6], NULL, 10) :
+                                      PROXIMITY_DEFAULT_ENTER_HYST_DB;
+    rule.exit_hyst_db = (argc > 7) ? (uint8_t)strtoul(argv[7], NULL, 10) :
+                                     PROXIMITY_DEFAULT_EXIT_HYST_DB;
+    rule.dwell_ms = (argc > 8) ? (uint32_t)strtoul(argv[8], NULL, 10) :
+                                 PROXIMITY_DEFAULT_DWELL_MS;
+
+    scan_data_lock();
+    int32_t index = proximity_zones_add(&rule);
+    scan_data_unlock();
+
+    if (PROXIMITY_INVALID_RULE == index)
+    {
+        printf("\nRule rejected: the thresholds must decrease from near to far and at most %u rules are allowed\n",
+               (unsigned int)PROXIMITY_MAX_RULES);
+    }
+    else
+    {
+        printf("\nRule %"PRId32" added\n", index);
+    }
+}
+
+/*******************************************************************************
+* Function Name: print_centi
+********************************************************************************
+* Summary:
+* Prints a value with two decimals without relying on floating-point support
+* in printf.
+*******************************************************************************/
+static void print_centi(float value)
+{
+    int32_t centi = (int32_t)((value * 100.0f) + ((value < 0.0f) ? -0.5f : 0.5f));
+    uint32_t magnitude = (uint32_t)((centi < 0) ? -centi : centi);
+
+    char text[16];
+
+    snprintf(text, sizeof(text), "%s%"PRIu32".%02"PRIu32, (centi < 0) ? "-" : "",
+             magnitude / 100U, magnitude % 100U);
+    printf(" %8s", text);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_anom
+********************************************************************************
+* Summary:
+* Prints the baseline and the last score of every anomaly feature and the
+* number of flagged full sweeps.
+*******************************************************************************/
+static void console_cmd_anom(int argc, char **argv)
+{
+    static const char * const feature_names[ANOMALY_FEATURE_COUNT] =
+    {
+        "BSSIDs", "Mean RSSI", "Dropout 0/00"
+    };
+    anomaly_status_t status;
+
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    scan_data_lock();
+    anomaly_detector_status(&status);
+    scan_data_unlock();
+
+    printf("\n  Feature          Last   Median    Scale        z\n");
+
+    for (uint32_t f = 0; f < ANOMALY_FEATURE_COUNT; f++)
+    {
+        const anomaly_baseline_t *b = &status.feature[f];
+
+        printf("  %-12s", feature_names[f]);
+        print_centi(b->last);
+        print_centi(b->median);
+        print_centi(b->scale);
+        print_centi(b->last_z);
+        printf("\n");
+    }
+
+    printf("CUSUM");
+    print_centi(status.cusum);
+    printf(", %"PRIu32" of %"PRIu32" full sweeps flagged\n",
+           status.flagged_scans, status.scans);
+
+    for (uint32_t i = 0; i < ANOMALY_FLAG_COUNT; i++)
+    {
+        printf("  %-18s %"PRIu32"\n", anomaly_flag_name((uint8_t)(1U << i)),
+               status.flag_counts[i]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_motion
+********************************************************************************
+* Summary:
+* Starts or stops motion sensing, sets its threshold or turns the tracing of
+* the samples on or off. Without arguments, prints the links, their last
+* features and the sampling jitter.
+*******************************************************************************/
+static void console_cmd_motion(int argc, char **argv)
+{
+    motion_status_t status;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "start")))
+    {
+        scan_data_lock();
+        bool started = motion_sensor_start();
+        scan_data_unlock();
+
+        if (!started)
+        {
+            printf("\nNo AP of at least %d dBm with a stability score of at least %u\n",
+                   MOTION_MIN_RSSI_DBM, (unsigned int)MOTION_MIN_STABILITY);
+        }
+
+        return;
+    }
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "stop")))
+    {
+        scan_data_lock();
+        motion_sensor_stop();
+        scan_data_unlock();
+        return;
+    }
+
+    if ((argc > 2) && (0 == strcmp(argv[1], "threshold")))
+    {
+        float threshold = strtof(argv[2], NULL);
+
+        scan_data_lock();
+        motion_features_set_threshold((uint32_t)((threshold * (float)MOTION_Q4_ONE) + 0.5f));
+        scan_data_unlock();
+        return;
+    }
+
+    if ((argc > 2) && (0 == strcmp(argv[1], "trace")))
+    {
+        scan_data_lock();
+        motion_sensor_set_trace(0 == strcmp(argv[2], "on"));
+        scan_data_unlock();
+        return;
+    }
+
+    if (argc > 1)
+    {
+        printf("\nUsage: motion [start|stop|threshold <dB^2>|trace <on|off>]\n");
+        return;
+    }
+
+    scan_data_lock();
+    motion_sensor_status(&status);
+    uint32_t threshold_q4 = motion_features_threshold();
+    scan_data_unlock();
+
+    printf("\nMotion sensing %s", status.active ? "on" : "off");
+
+    if (status.active)
+    {
+        printf(", channel %u, %s", status.channel, status.motion ? "motion" : "quiet");
+    }
+
+    printf(", threshold");
+    print_centi((float)threshold_q4 / (float)MOTION_Q4_ONE);
+    printf(" dB^2, %"PRIu32" events\n", status.events);
+
+    if (0U == status.links)
+    {
+        return;
+    }
+
+    printf("\n  BSSID               RSSI   Answers  Variance     Diff  Band %%  Misses\n");
+
+    for (uint32_t i = 0; i < status.links; i++)
+    {
+        const motion_link_t *link = &status.link[i];
+
+        printf("  %02X:%02X:%02X:%02X:%02X:%02X  %4d  %8"PRIu32,
+               link->bssid[0], link->bssid[1], link->bssid[2],
+               link->bssid[3], link->bssid[4], link->bssid[5],
+               link->rssi, link->answers);
+        print_centi((float)status.features.variance_q4[i] / (float)MOTION_Q4_ONE);
+        print_centi((float)status.features.diff_q4[i] / (float)MOTION_Q4_ONE);
+        printf("  %6u  %6u\n", status.features.band_percent[i], status.features.misses[i]);
+    }
+
+    printf("%"PRIu32" samples every %u ms, %"PRIu32" failed, jitter mean %"PRIu32" us max %"
+           PRIu32" us, %"PRIu32" overruns, probe max %"PRIu32" us\n",
+           status.samples, (unsigned int)MOTION_SAMPLE_PERIOD_MS, status.failed,
+           (0U != status.intervals) ? (uint32_t)(status.total_jitter_us / status.intervals) : 0U,
+           status.max_jitter_us, status.overruns, status.max_probe_us);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_stab
+********************************************************************************
+* Summary:
+* Prints the stability of every tracked BSSID over the last full sweeps.
+*******************************************************************************/
+static void console_cmd_stab(int argc, char **argv)
+{
+    bssid_stability_t stability;
+
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    printf("\n  BSSID               Ch  Window  Seen  Missed  Dropout  Longest  Ever  Ch chg  RSSI  Std dB  Score\n");
+
+    scan_data_lock();
+
+    for (uint16_t i = 0; i < BSSID_TABLE_MAX_ENTRIES; i++)
+    {
+        const bssid_table_entry_t *entry = bssid_table_get(i);
+
+        if ((NULL == entry) || (!bssid_stability_get(i, entry->generation, &stability)))
+        {
+            continue;
+        }
+
+        printf("  %02X:%02X:%02X:%02X:%02X:%02X  %3u  %6u  %4u  %6u  %7u  %7u  %4u  %6u  %4d  %3u.%02u  %5u\n",
+               entry->bssid[0], entry->bssid[1], entry->bssid[2],
+               entry->bssid[3], entry->bssid[4], entry->bssid[5],
+               stability.channel, stability.window, stability.seen, stability.missed,
+               stability.current_dropout, stability.longest_dropout,
+               stability.longest_dropout_ever, stability.channel_changes,
+               stability.mean_rssi, stability.rssi_std_centi_db / 100U,
+               stability.rssi_std_centi_db % 100U, stability.score);
+    }
+
+    scan_data_unlock();
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_rnr
+********************************************************************************
+* Summary:
+* Prints the 6 GHz APs announced in Reduced Neighbor Reports, the channels a
+* 6 GHz scan would be reduced to, and the discovery times of the scans.
+*******************************************************************************/
+static void console_cmd_rnr(int argc, char **argv)
+{
+    uint8_t channels[SIX_GHZ_PLAN_MAX_CHANNELS];
+    six_ghz_ap_t ap;
+    six_ghz_stats_t stats;
+
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    printf("\n  6 GHz BSSID         Ch  Short SSID  Announced by        Found ms\n");
+
+    scan_data_lock();
+
+    for (uint32_t i = 0; i < SIX_GHZ_PLAN_MAX_APS; i++)
+    {
+        if (!six_ghz_plan_get(i, &ap))
+        {
+            continue;
+        }
+
+        if (ap.has_bssid)
+        {
+            printf("  %02X:%02X:%02X:%02X:%02X:%02X", ap.bssid[0], ap.bssid[1],
+                   ap.bssid[2], ap.bssid[3], ap.bssid[4], ap.bssid[5]);
+        }
+        else
+        {
+            printf("  %-17s", "-");
+        }
+
+        printf("  %3u  %08"PRIX32"  %02X:%02X:%02X:%02X:%02X:%02X", ap.channel, ap.short_ssid,
+               ap.reporter[0], ap.reporter[1], ap.reporter[2],
+               ap.reporter[3], ap.reporter[4], ap.reporter[5]);
+
+        if (SIX_GHZ_PLAN_NOT_FOUND == ap.found_ms)
+        {
+            printf("  %8s\n", "-");
+        }
+        else
+        {
+            printf("  %8"PRIu32"\n", ap.found_ms);
+        }
+    }
+
+    uint32_t count = six_ghz_plan_channels(channels, SIX_GHZ_PLAN_MAX_CHANNELS);
+
+    six_ghz_plan_stats(&stats);
+
+    scan_data_unlock();
+
+    printf("6 GHz scan plan (%"PRIu32" of %u channels):", count,
+           (unsigned int)((RNR_6GHZ_MAX_CHANNEL + 3U) / 4U));
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        printf(" %u", channels[i]);
+    }
+
+    printf("\n%"PRIu32" scans, mean %"PRIu32" ms, last %"PRIu32" ms", stats.scans,
+           (0U != stats.scans) ? (stats.total_scan_ms / stats.scans) : 0U,
+           stats.last_scan_ms);
+
+    if (SIX_GHZ_PLAN_NOT_FOUND != stats.last_first_6ghz_ms)
+    {
+        printf(", first 6 GHz result after %"PRIu32" ms", stats.last_first_6ghz_ms);
+    }
+
+    printf("\n");
+    printf("Announced APs found %"PRIu32" of %"PRIu32" times, mean %"PRIu32" ms, max %"PRIu32
+           " ms after the scan start\n", stats.found, stats.announced,
+           (0U != stats.found) ? (uint32_t)(stats.total_discover_ms / stats.found) : 0U,
+           stats.max_discover_ms);
+}
+
+/*******************************************************************************
+* Function Name: print_channel_list
+********************************************************************************
+* Summary:
+* Prints a channel list of a plan.
+*******************************************************************************/
+static void print_channel_list(const char *name, const uint16_t *channels, uint32_t count)
+{
+    printf("%s (%"PRIu32"):", name, count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        printf(" %u", channels[i]);
+    }
+
+    printf("\n");
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_chan
+********************************************************************************
+* Summary:
+* Sets the country of the channel plan or returns to the inferred one, and
+* disables or enables channels. Without arguments, prints the channel lists of
+* an unfiltered sweep and the time they save.
+*******************************************************************************/
+static void console_cmd_chan(int argc, char **argv)
+{
+    static channel_plan_t plan;
+    uint16_t disabled[CHANNEL_PLAN_MAX_CHANNELS];
+    uint32_t disabled_count = 0U;
+    channel_plan_stats_t stats;
+    char country[CHANNEL_PLAN_COUNTRY_LENGTH + 1U];
+    bool inferred;
+    bool ok = true;
+
+    if ((argc > 2) && (0 == strcmp(argv[1], "country")))
+    {
+        scan_data_lock();
+        ok = channel_plan_set_country((0 == strcmp(argv[2], "auto")) ? NULL : argv[2]);
+        scan_data_unlock();
+    }
+    else if ((argc > 2) && ((0 == strcmp(argv[1], "disable")) ||
+                            (0 == strcmp(argv[1], "enable"))))
+    {
+        scan_data_lock();
+        ok = channel_plan_set_disabled((uint8_t)strtoul(argv[2], NULL, 10),
+                                       (0 == strcmp(argv[1], "disable")));
+        scan_data_unlock();
+    }
+    else if (argc > 1)
+    {
+        ok = false;
+    }
+
+    if (!ok)
+    {
+        printf("\nUsage: chan [country <cc>|auto|disable <ch>|enable <ch>]\n");
+        return;
+    }
+
+    if (argc > 1)
+    {
+        return;
+    }
+
+    scan_data_lock();
+    bool known = channel_plan_country(country, &inferred);
+    channel_plan_region_t region = channel_plan_region();
+    bool in_effect = channel_plan_build(CHANNEL_PLAN_BAND_ALL, &plan);
+    uint32_t planned_ms = channel_plan_estimate_ms(CHANNEL_PLAN_BAND_ALL, true);
+    uint32_t default_ms = channel_plan_estimate_ms(CHANNEL_PLAN_BAND_ALL, false);
+    channel_plan_stats(&stats);
+
+    for (uint32_t channel = 1U; channel <= UINT8_MAX; channel++)
+    {
+        if (channel_plan_is_disabled((uint8_t)channel))
+        {
+            disabled[disabled_count++] = (uint16_t)channel;
+        }
+    }
+
+    scan_data_unlock();
+
+    if (known)
+    {
+        printf("\nCountry %s (%s), %s rules\n", country, inferred ? "inferred" : "configured",
+               channel_plan_region_name(region));
+    }
+    else
+    {
+        printf("\nNo country configured or inferred yet\n");
+    }
+
+    if (!in_effect)
+    {
+        printf("Sweeps use the default channel list\n");
+        return;
+    }
+
+    print_channel_list("Active", plan.active, plan.active_count);
+    print_channel_list("Passive", plan.passive, plan.passive_count);
+
+    print_channel_list("Disabled", disabled, disabled_count);
+
+    printf("\n2.4 GHz and 5 GHz dwell %"PRIu32" ms, default %"PRIu32" ms (%"PRIu32"%% less)\n",
+           planned_ms, default_ms,
+           (0U != default_ms) ? (((default_ms - planned_ms) * 100U) / default_ms) : 0U);
+
+    if (plan.six_ghz)
+    {
+        printf("One sweep in %u uses the default list to cover the 6 GHz band\n",
+               (unsigned int)PLANNED_SWEEP_6GHZ_INTERVAL);
+    }
+
+    printf("Unfiltered sweeps: %"PRIu32" default, mean %"PRIu32" ms; %"PRIu32
+           " planned, mean %"PRIu32" ms\n",
+           stats.default_sweeps,
+           (0U != stats.default_sweeps) ? (stats.default_ms / stats.default_sweeps) : 0U,
+           stats.planned_sweeps,
+           (0U != stats.planned_sweeps) ? (stats.planned_ms / stats.planned_sweeps) : 0U);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_ess
+********************************************************************************
+* Summary:
+* Prints the networks of the last scan grouped by SSID and security.
+*******************************************************************************/
+static void console_cmd_ess(int argc, char **argv)
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    scan_data_lock();
+    ess_view_print(printf);
+    scan_data_unlock();
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_intf
+********************************************************************************
+* Summary:
+* Prints the interference matrix of a band from the last full sweep and the
+* least loaded channels of a width, 2.4 GHz and 20 MHz by default.
+*******************************************************************************/
+static void console_cmd_intf(int argc, char **argv)
+{
+    static interference_channel_t states[INTERFERENCE_6GHZ_CHANNELS];
+    static uint8_t channels[INTERFERENCE_6GHZ_CHANNELS];
+    interference_candidate_t candidates[CONSOLE_INTERFERENCE_CANDIDATES];
+    interference_stats_t stats;
+    uint8_t band = CY_WCM_WIFI_BAND_2_4GHZ;
+    uint16_t width_mhz = 20U;
+    uint32_t count = 0U;
+
+    if (argc > 1)
+    {
+        band = (0 == strcmp(argv[1], "2.4")) ? CY_WCM_WIFI_BAND_2_4GHZ :
+               (0 == strcmp(argv[1], "5")) ? CY_WCM_WIFI_BAND_5GHZ :
+               (0 == strcmp(argv[1], "6")) ? CY_WCM_WIFI_BAND_6GHZ : CY_WCM_WIFI_BAND_ANY;
+    }
+
+    if (argc > 2)
+    {
+        width_mhz = (uint16_t)strtoul(argv[2], NULL, 10);
+    }
+
+    if (CY_WCM_WIFI_BAND_ANY == band)
+    {
+        printf("\nUsage: intf [2.4|5|6] [20|40|80|160]\n");
+        return;
+    }
+
+    scan_data_lock();
+    interference_matrix_stats(&stats);
+
+    for (uint32_t channel = 1U; (channel <= UINT8_MAX) && (count < INTERFERENCE_6GHZ_CHANNELS); channel++)
+    {
+        if (interference_matrix_channel(band, (uint8_t)channel, &states[count]) &&
+            ((0U != states[count].bss) || (states[count].score >= 1.0f)))
+        {
+            channels[count++] = (uint8_t)channel;
+        }
+    }
+
+    uint32_t found = interference_matrix_recommend(band, width_mhz, candidates,
+                                                   CONSOLE_INTERFERENCE_CANDIDATES);
+    scan_data_unlock();
+
+    if (0U == stats.sweeps)
+    {
+        printf("\nNo full sweep yet\n");
+        return;
+    }
+
+    printf("\nScan %"PRIu32": %u BSSs, %u wider than 20 MHz\n", stats.sequence,
+           stats.bss, stats.wide);
+    printf("Channel  Primary  BSSs  Load dBm  Score dBm\n");
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        printf("%7u  %7u  %4u  %8d  %9d\n", channels[i], states[i].primary, states[i].bss,
+               interference_matrix_dbm(states[i].load), interference_matrix_dbm(states[i].score));
+    }
+
+    if (0U == found)
+    {
+        printf("No %u MHz channel to recommend in this band\n", width_mhz);
+        return;
+    }
+
+    printf("Best %u MHz channels:", width_mhz);
+
+    for (uint32_t i = 0; i < found; i++)
+    {
+        printf(" %u (%d dBm)", candidates[i].channel, interference_matrix_dbm(candidates[i].score));
+    }
+
+    printf("\n");
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_occ
+********************************************************************************
+* Summary:
+* Prints the mean number of BSSIDs of every hour of the week, or the details
+* of one hour (day 0 is Sunday), or dumps the occupancy record in hexadecimal.
+*******************************************************************************/
+static void console_cmd_occ(int argc, char **argv)
+{
+    uint32_t now_s = (uint32_t)time(NULL);
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "dump")))
+    {
+        scan_data_lock();
+        uint32_t length = occupancy_buckets_encode(console_occupancy, sizeof(console_occupancy),
+                                                   now_s);
+        scan_data_unlock();
+
+        printf("\n");
+
+        for (uint32_t i = 0; i < length; i++)
+        {
+            printf("%02X", console_occupancy[i]);
+
+            if ((HEX_BYTES_PER_LINE - 1U) == (i % HEX_BYTES_PER_LINE))
+            {
+                printf("\n");
+            }
+        }
+
+        printf("\n");
+        return;
+    }
+
+    if (argc > 2)
+    {
+        uint32_t day = strtoul(argv[1], NULL, 10);
+        uint32_t hour = strtoul(argv[2], NULL, 10);
+        occupancy_bucket_t bucket;
+
+        if ((day >= OCCUPANCY_DAYS) || (hour >= OCCUPANCY_HOURS))
+        {
+            printf("\nUsage: occ [<day> <hour>|dump], day 0-6 from Sunday, hour 0-23\n");
+            return;
+        }
+
+        scan_data_lock();
+        bool seen = occupancy_buckets_get((day * OCCUPANCY_HOURS) + hour, &bucket);
+        scan_data_unlock();
+
+        if (!seen)
+        {
+            printf("\n%s %02"PRIu32":00 not seen yet\n", console_days[day], hour);
+            return;
+        }
+
+        printf("\n%s %02"PRIu32":00, seen %u times\n", console_days[day], hour, bucket.visits);
+        printf("BSSIDs: 2.4 GHz ");
+        print_centi((float)bucket.aps_q4[0] / 16.0f);
+        printf(", 5 GHz ");
+        print_centi((float)bucket.aps_q4[1] / 16.0f);
+        printf(", 6 GHz ");
+        print_centi((float)bucket.aps_q4[2] / 16.0f);
+        printf("\nSpread ");
+        print_centi((float)bucket.spread_q4 / 16.0f);
+        printf(", churn ");
+        print_centi((float)bucket.churn_q4 / 16.0f);
+        printf(" per sweep, mean RSSI %d dBm\n", bucket.rssi);
+        printf("Load: 2.4 GHz %d dBm, 5 GHz %d dBm, 6 GHz %d dBm\n",
+               INTERFERENCE_FLOOR_DBM + bucket.load_db[0],
+               INTERFERENCE_FLOOR_DBM + bucket.load_db[1],
+               INTERFERENCE_FLOOR_DBM + bucket.load_db[2]);
+        printf("Top SSIDs:");
+
+        for (uint32_t t = 0; (t < OCCUPANCY_TOP_SSIDS) && (0U != bucket.top_ssids[t]); t++)
+        {
+            printf(" %08"PRIX32, bucket.top_ssids[t]);
+        }
+
+        printf("\n");
+        return;
+    }
+
+    if (argc > 1)
+    {
+        printf("\nUsage: occ [<day> <hour>|dump]\n");
+        return;
+    }
+
+    scan_data_lock();
+
+    for (uint32_t i = 0; i < OCCUPANCY_BUCKETS; i++)
+    {
+        if (!occupancy_buckets_get(i, &console_buckets[i]))
+        {
+            console_buckets[i].visits = 0U;
+        }
+    }
+
+    uint32_t current = occupancy_buckets_index(now_s);
+    uint32_t delay_ms = occupancy_buckets_scan_delay_ms(SCAN_DELAY_MS, now_s);
+    scan_data_unlock();
+
+    printf("\nMean BSSIDs per hour\n   ");
+
+    for (uint32_t hour = 0; hour < OCCUPANCY_HOURS; hour++)
+    {
+        printf(" %2"PRIu32, hour);
+    }
+
+    for (uint32_t i = 0; i < OCCUPANCY_BUCKETS; i++)
+    {
+        const occupancy_bucket_t *bucket = &console_buckets[i];
+
+        if (0U == (i % OCCUPANCY_HOURS))
+        {
+            printf("\n%s", console_days[i / OCCUPANCY_HOURS]);
+        }
+
+        if (0U == bucket->visits)
+        {
+            printf("  .");
+        }
+        else
+        {
+            uint32_t total_q4 = (uint32_t)bucket->aps_q4[0] + bucket->aps_q4[1] + bucket->aps_q4[2];
+
+            printf("%3"PRIu32, (total_q4 + 8U) / 16U);
+        }
+    }
+
+    printf("\nNow %s %02"PRIu32":00, sweeps every %"PRIu32" ms\n",
+           console_days[current / OCCUPANCY_HOURS], current % OCCUPANCY_HOURS, delay_ms);
+}
+
+/*******************************************************************************
+* Function Name: print_shed_counts
+********************************************************************************
+* Summary:
+* Prints the counts of the load shedder.
+*******************************************************************************/
+static void print_shed_counts(const char *label, const load_shedder_stats_t *stats)
+{
+    printf("%s: %"PRIu32" scans, %"PRIu32" overloaded, %"PRIu32" results\n", label,
+           stats->scans, stats->overloaded, stats->results);
+    printf("  kept %"PRIu32" watched, %"PRIu32" strong, %"PRIu32" repeated; sampled %"PRIu32
+           "; shed %"PRIu32" (2.4 GHz %"PRIu32", 5 GHz %"PRIu32", 6 GHz %"PRIu32")\n",
+           stats->watched, stats->strong, stats->repeated, stats->sampled, stats->shed,
+           stats->shed_by_band[0], stats->shed_by_band[1], stats->shed_by_band[2]);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_shed
+********************************************************************************
+* Summary:
+* Prints the counts of the load shedder for the last scan and since startup.
+*******************************************************************************/
+static void console_cmd_shed(int argc, char **argv)
+{
+    load_shedder_stats_t last;
+    load_shedder_stats_t total;
+
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    scan_data_lock();
+    load_shedder_stats(&last, &total);
+    scan_data_unlock();
+
+    printf("\nUp to %u BSSIDs per scan, results of %d dBm or more always kept\n",
+           (unsigned int)LOAD_SHEDDER_CAPACITY, LOAD_SHEDDER_STRONG_RSSI_DBM);
+    print_shed_counts("Last scan", &last);
+    print_shed_counts("Since startup", &total);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_out
+********************************************************************************
+* Summary:
+* Selects the output of the scans, or prints the backlog and freshness of the
+* scan output. An explicit mode turns off the automatic pacing.
+*******************************************************************************/
+static void console_cmd_out(int argc, char **argv)
+{
+    scan_output_stats_t stats;
+    bool automatic;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1], "reset"))
+        {
+            scan_output_reset_stats();
+        }
+        else if (0 == strcmp(argv[1], "auto"))
+        {
+            scan_output_set_mode(SCAN_OUTPUT_MODES, true);
+        }
+        else
+        {
+            scan_output_mode_t mode = SCAN_OUTPUT_FULL;
+
+            while ((mode < SCAN_OUTPUT_MODES) &&
+                   (0 != strcmp(argv[1], scan_output_mode_name(mode))))
+            {
+                mode++;
+            }
+
+            if (SCAN_OUTPUT_MODES == mode)
+            {
+                printf("\nUnknown output '%s'\n", argv[1]);
+                return;
+            }
+
+            scan_output_set_mode(mode, false);
+        }
+    }
+
+    scan_output_mode_t mode = scan_output_mode(&automatic);
+    scan_output_stats(&stats);
+
+    printf("\nScan output %s (%s), %"PRIu32" bytes queued (%"PRIu32" ms), peak %"PRIu32"\n",
+           scan_output_mode_name(mode), automatic ? "paced" : "fixed", stats.backlog_bytes,
+           scan_output_backlog_ms(), stats.peak_backlog_bytes);
+    printf("%"PRIu32" messages, %"PRIu32" bytes; dropped %"PRIu32" messages, %"PRIu32" bytes\n",
+           stats.messages, stats.bytes, stats.dropped, stats.dropped_bytes);
+    printf("Freshness %"PRIu32" ms, mean %"PRIu32" ms, max %"PRIu32" ms\n",
+           stats.freshness_last_ms, stats.freshness_mean_ms, stats.freshness_max_ms);
+    printf("%"PRIu32" reductions, %"PRIu32" restorations, %"PRIu32" scans waited "
+           "%"PRIu32" ms\n", stats.reductions, stats.restorations, stats.waits,
+           stats.waited_ms);
+}
+
+/*******************************************************************************
+* Function Name: parse_fields
+********************************************************************************
+* Summary:
+* Parses 'default', 'all' or a comma separated list of field names into
+* SCAN_LOG_FIELD_* flags. Returns false on an unknown name.
+*******************************************************************************/
+static bool parse_fields(char *text, uint16_t *fields)
+{
+    if (0 == strcmp(text, "default"))
+    {
+        *fields = SCAN_LOG_FIELDS_V1;
+        return true;
+    }
+
+    if (0 == strcmp(text, "all"))
+    {
+        *fields = SCAN_LOG_FIELDS_ALL;
+        return true;
+    }
+
+    *fields = SCAN_LOG_FIELD_BSSID;
+
+    for (char *name = text; NULL != name; )
+    {
+        char *next = strchr(name, ',');
+        uint32_t bit = 0U;
+
+        if (NULL != next)
+        {
+            *next++ = '\0';
+        }
+
+        while ((bit < SCAN_LOG_FIELD_COUNT) && (0 != strcmp(name, scan_log_field_name(bit))))
+        {
+            bit++;
+        }
+
+        if (SCAN_LOG_FIELD_COUNT == bit)
+        {
+            printf("\nUnknown field '%s'\n", name);
+            return false;
+        }
+
+        *fields |= (uint16_t)(1U << bit);
+        name = next;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: print_projection_size
+********************************************************************************
+* Summary:
+* Prints the bytes per AP, and per scan log record and hex line, that the
+* results of the last scan would take with the given fields, packed or not.
+*******************************************************************************/
+static void print_projection_size(const char *label, uint16_t fields, uint32_t aps,
+                                  uint32_t ssid_bytes, uint32_t bssid_bytes)
+{
+    uint32_t bytes = aps * scan_log_ap_size(fields & SCAN_LOG_FIELDS_ALL, 0U);
+
+    if (0U != (fields & SCAN_LOG_SCHEMA_PACKED_BSSID))
+    {
+        bytes = bytes - (aps * SCAN_LOG_BSSID_LENGTH) + bssid_bytes;
+    }
+
+    if (0U != (fields & SCAN_LOG_FIELD_SSID))
+    {
+        bytes += ssid_bytes;
+    }
+
+    uint32_t record = SCAN_LOG_HEADER_SIZE + SCAN_LOG_SCHEMA_SIZE + bytes;
+
+    printf("%-28s", label);
+    print_centi((0U != aps) ? ((float)bytes / (float)aps) :
+                (float)scan_log_ap_size(fields & SCAN_LOG_FIELDS_ALL, 0U));
+    printf(" %8"PRIu32" %8"PRIu32"\n", record,
+           (uint32_t)(sizeof(SCAN_LOG_UART_PREFIX) - 1U) + (2U * record) + 1U);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_fields
+********************************************************************************
+* Summary:
+* Selects the fields of the scan log records and the printed scan results, or
+* whether the BSSIDs of the records are packed, or prints them with the size
+* they and common projections take for the results of the last scan.
+*******************************************************************************/
+static void console_cmd_fields(int argc, char **argv)
+{
+    uint16_t fields;
+    uint16_t packed;
+    uint32_t aps;
+    uint32_t ssid_bytes;
+    uint32_t bssid_bytes;
+
+    if ((argc > 1) && ((0 == strcmp(argv[1], "packed")) || (0 == strcmp(argv[1], "plain"))))
+    {
+        scan_data_lock();
+        scan_log_set_packed(0 == strcmp(argv[1], "packed"));
+        scan_data_unlock();
+    }
+    else if (argc > 1)
+    {
+        if (!parse_fields(argv[1], &fields))
+        {
+            return;
+        }
+
+        scan_data_lock();
+        scan_log_set_fields(fields);
+        scan_data_unlock();
+    }
+
+    scan_data_lock();
+    fields = scan_log_get_fields();
+    scan_log_last_scan(&aps, &ssid_bytes, &bssid_bytes);
+    scan_data_unlock();
+
+    packed = fields & SCAN_LOG_SCHEMA_PACKED_BSSID;
+
+    printf("\nFields (schema %u, %04X):", SCAN_LOG_VERSION_SCHEMA, fields);
+
+    for (uint32_t bit = 0U; bit < SCAN_LOG_FIELD_COUNT; bit++)
+    {
+        if (0U != (fields & (1U << bit)))
+        {
+            printf(" %s", scan_log_field_name(bit));
+        }
+    }
+
+    printf("\nBSSIDs: %s, %"PRIu32" bytes packed for %"PRIu32" plain\n",
+           (0U != packed) ? "packed" : "plain", bssid_bytes, aps * SCAN_LOG_BSSID_LENGTH);
+    printf("\nSizes for the %"PRIu32" results of the last scan\n", aps);
+    printf("%-28s %8s %8s %8s\n", "Fields", "Per AP", "Record", "Hex line");
+    print_projection_size("Selected", fields, aps, ssid_bytes, bssid_bytes);
+    print_projection_size("bssid,rssi", packed | SCAN_LOG_FIELD_BSSID | SCAN_LOG_FIELD_RSSI,
+                          aps, ssid_bytes, bssid_bytes);
+    print_projection_size("bssid,rssi,channel", packed | SCAN_LOG_FIELD_BSSID |
+                          SCAN_LOG_FIELD_RSSI | SCAN_LOG_FIELD_CHANNEL, aps, ssid_bytes,
+                          bssid_bytes);
+    print_projection_size("bssid,rssi,channel,ssid", packed | SCAN_LOG_FIELD_BSSID |
+                          SCAN_LOG_FIELD_RSSI | SCAN_LOG_FIELD_CHANNEL | SCAN_LOG_FIELD_SSID,
+                          aps, ssid_bytes, bssid_bytes);
+    print_projection_size("default", packed | SCAN_LOG_FIELDS_V1, aps, ssid_bytes, bssid_bytes);
+    print_projection_size("all", packed | SCAN_LOG_FIELDS_ALL, aps, ssid_bytes, bssid_bytes);
+}
+
+/*******************************************************************************
+* Function Name: time_hash
+********************************************************************************
+* Summary:
+* Returns the mean time in nanoseconds of a CRC or hash function for inputs
+* of the given size.
+*******************************************************************************/
+static uint32_t time_hash(uint32_t (*hash)(const uint8_t *, uint32_t), const uint8_t *data,
+                          uint32_t size)
+{
+    volatile uint32_t sink = 0U;
+    uint32_t start = perf_counter_now();
+
+    for (uint32_t i = 0; i < CONSOLE_HASH_CALLS; i++)
+    {
+        sink ^= hash(data, size);
+    }
+
+    (void)sink;
+
+    return perf_counter_to_ns(perf_counter_now() - start) / CONSOLE_HASH_CALLS;
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_hash
+********************************************************************************
+* Summary:
+* Measures the CRC and hash functions of the hash service for the input sizes
+* of BSSIDs, SSIDs and records.
+*******************************************************************************/
+static void console_cmd_hash(int argc, char **argv)
+{
+    static const uint32_t sizes[] = { 6U, 8U, 16U, 32U, 64U, CONSOLE_HASH_MAX_SIZE };
+    uint8_t data[CONSOLE_HASH_MAX_SIZE];
+
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)((i * 131U) + 7U);
+    }
+
+    printf("\n%6s %10s %10s %10s  (ns per call)\n", "Bytes", "CRC-32", "Hash", "FNV-1a");
+
+    for (uint32_t i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        printf("%6"PRIu32" %10"PRIu32" %10"PRIu32" %10"PRIu32"\n", sizes[i],
+               time_hash(hash_service_crc32, data, sizes[i]),
+               time_hash(hash_service_hash32, data, sizes[i]),
+               time_hash(hash_service_fnv1a32, data, sizes[i]));
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_pseudo
+********************************************************************************
+* Summary:
+* Turns the pseudonyms of exported BSSIDs and SSIDs on or off or rotates their
+* key, and prints how often they were cached and what they cost per record.
+*******************************************************************************/
+static void console_cmd_pseudo(int argc, char **argv)
+{
+    pseudonym_stats_t stats;
+    bool keyed = true;
+
+    scan_data_lock();
+
+    if (argc > 1)
+    {
+        if ((0 == strcmp(argv[1], "on")) || (0 == strcmp(argv[1], "off")))
+        {
+            keyed = pseudonym_set_enabled(0 == strcmp(argv[1], "on"));
+        }
+        else if (0 == strcmp(argv[1], "rotate"))
+        {
+            keyed = pseudonym_rotate();
+        }
+        else
+        {
+            scan_data_unlock();
+            printf("\nUsage: pseudo [on|off|rotate]\n");
+            return;
+        }
+    }
+
+    bool enabled = pseudonym_enabled();
+    pseudonym_stats(&stats);
+    scan_data_unlock();
+
+    if (!keyed)
+    {
+        printf("\nNo pseudonym key: there is no random number generator\n");
+    }
+
+    printf("\nPseudonyms: %s, key epoch %"PRIu32", rotated every %"PRIu32" s\n",
+           enabled ? "on" : "off", stats.epoch, (uint32_t)PSEUDONYM_ROTATION_S);
+    printf("BSSIDs: %"PRIu32" cached, %"PRIu32" computed\n", stats.bssid_hits,
+           stats.bssid_misses);
+    printf("SSIDs: %"PRIu32" cached, %"PRIu32" computed\n", stats.ssid_hits, stats.ssid_misses);
+    printf("%"PRIu32" records, %"PRIu32" ns per record\n", stats.records,
+           (0U != stats.timed_records) ?
+           (uint32_t)(stats.timed_ns / stats.timed_records) : 0U);
+}
+
+/*******************************************************************************
+* Function Name: time_secure
+********************************************************************************
+* Summary:
+* Returns the mean time in nanoseconds per request of calls to the secure
+* service with the given number of requests each. The secure batch lock is
+* held across the calls, so that those of other tasks do not fall among them.
+*******************************************************************************/
+static uint32_t time_secure(uint8_t op, uint32_t size, const uint8_t *input, uint32_t length)
+{
+    secure_batch_t batch;
+
+    secure_batch_lock();
+
+    uint32_t start = perf_counter_now();
+
+    for (uint32_t call = 0; call < CONSOLE_SECURE_CALLS; call++)
+    {
+        secure_batch_begin(&batch);
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            (void)secure_batch_add(&batch, op, SECURE_SERVICE_KEY_SCRATCH, input, length);
+        }
+
+        (void)secure_batch_run(&batch);
+    }
+
+    uint32_t ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    secure_batch_unlock();
+
+    return ns / (CONSOLE_SECURE_CALLS * size);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_secure
+********************************************************************************
+* Summary:
+* Measures the calls to the secure service: empty requests give the cost of
+* entering and leaving the secure image, spread over the requests of a batch,
+* and keyed hashes of a BSSID the cost of a typical request. Runs without the
+* scan data lock: the calls are serialized by the secure batch lock alone.
+*******************************************************************************/
+static void console_cmd_secure(int argc, char **argv)
+{
+    static const uint32_t sizes[] = { 1U, 2U, 4U, 8U, 16U, SECURE_SERVICE_MAX_ITEMS };
+    static const uint8_t input[SECURE_SERVICE_KEY_SIZE] =
+    {
+        0x00U, 0x90U, 0x4CU, 0x12U, 0x34U, 0x56U, 0x01U, 0x02U,
+        0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU
+    };
+    secure_batch_t batch;
+    secure_batch_stats_t stats;
+    uint32_t single = 0U;
+
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    secure_batch_begin(&batch);
+    (void)secure_batch_add(&batch, SECURE_SERVICE_OP_SET_KEY, SECURE_SERVICE_KEY_SCRATCH,
+                           input, sizeof(input));
+    (void)secure_batch_run(&batch);
+
+    printf("\n%6s %10s %10s  (ns per request)\n", "Batch", "Empty", "SipHash");
+
+    for (uint32_t i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        uint32_t empty = time_secure(SECURE_SERVICE_OP_NOP, sizes[i], NULL, 0U);
+        uint32_t hash = time_secure(SECURE_SERVICE_OP_SIPHASH, sizes[i], input, BSSID_LENGTH);
+
+        single = (0U == i) ? hash : single;
+        printf("%6"PRIu32" %10"PRIu32" %10"PRIu32"  (%"PRIu32".%02"PRIu32"x)\n", sizes[i],
+               empty, hash, single / hash, ((100U * single) / hash) % 100U);
+    }
+
+    secure_batch_stats(&stats);
+
+    printf("Since startup: %"PRIu32" calls, %"PRIu32" requests, %"PRIu32" failed\n",
+           stats.calls, stats.items, stats.failed);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_sign
+********************************************************************************
+* Summary:
+* Turns the signing of the scan log records on or off, or sets the number of
+* records per batch. Prints the public key on a SCAN_SIGN_KEY_PREFIX line for
+* the host verifier, then the batches signed and the time they took.
+*******************************************************************************/
+static void console_cmd_sign(int argc, char **argv)
+{
+    scan_sign_stats_t stats;
+    uint8_t key[SCAN_SIGN_PUBLIC_KEY_SIZE];
+    bool keyed = true;
+
+    scan_data_lock();
+
+    if (argc > 1)
+    {
+        if ((0 == strcmp(argv[1], "on")) || (0 == strcmp(argv[1], "off")))
+        {
+            keyed = scan_sign_set_enabled(0 == strcmp(argv[1], "on"));
+        }
+        else if (0 == strcmp(argv[1], "auto"))
+        {
+            scan_sign_set_batch(0U);
+        }
+        else if (0U != strtoul(argv[1], NULL, 10))
+        {
+            scan_sign_set_batch((uint32_t)strtoul(argv[1], NULL, 10));
+        }
+        else
+        {
+            scan_data_unlock();
+            printf("\nUsage: sign [on|off|auto|<records>]\n");
+            return;
+        }
+    }
+
+    keyed = scan_sign_public_key(key) && keyed;
+    scan_sign_stats(&stats);
+    scan_data_unlock();
+
+    if (!keyed)
+    {
+        printf("\nNo signing key: the crypto library could not generate one\n");
+        return;
+    }
+
+    printf("\n" SCAN_SIGN_KEY_PREFIX);
+
+    for (uint32_t i = 0; i < SCAN_SIGN_PUBLIC_KEY_SIZE; i++)
+    {
+        printf("%02X", key[i]);
+    }
+
+    printf("\nSigning: %s, %s key, %u records per batch%s\n", stats.enabled ? "on" : "off",
+           stats.persistent ? "persistent" : "volatile", stats.batch_records,
+           stats.automatic ? " (auto)" : "");
+    printf("%"PRIu32" batches, %"PRIu32" records, %"PRIu32" failures\n", stats.batches,
+           stats.records, stats.failures);
+
+    if (0U == stats.batches)
+    {
+        return;
+    }
+
+    printf("Signature: mean %"PRIu32" us, max %"PRIu32" us, last %"PRIu32" us\n",
+           (uint32_t)(stats.sign_ns / stats.batches / PERF_COUNTER_NS_PER_US),
+           stats.max_sign_ns / PERF_COUNTER_NS_PER_US,
+           stats.last_sign_ns / PERF_COUNTER_NS_PER_US);
+    printf("Hashing: %"PRIu32" ns per record, %"PRIu32" ns per KB\n",
+           (uint32_t)(stats.hash_ns / stats.records),
+           (0U != stats.record_bytes) ? (uint32_t)((stats.hash_ns * 1024U) / stats.record_bytes) :
+           0U);
+
+    /* Share of the last batch's duration taken by its signature, in 1/100 %. */
+    if (0U != stats.last_batch_s)
+    {
+        uint32_t share = (uint32_t)(((uint64_t)stats.last_sign_ns * 10000U) /
+                                    ((uint64_t)stats.last_batch_s * PERF_COUNTER_NS_PER_S));
+
+        printf("Last batch: %"PRIu32" s, signature %"PRIu32".%02"PRIu32" %% of the CPU\n",
+               stats.last_batch_s, share / 100U, share % 100U);
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_uplink
+********************************************************************************
+* Summary:
+* Closes the uplink connection or forgets its TLS session, so that the next
+* publish makes a full handshake. Prints the batches waiting, the publishes
+* and the handshakes with the time they took.
+*******************************************************************************/
+static void console_cmd_uplink(int argc, char **argv)
+{
+    uplink_task_stats_t stats;
+    const uplink_stats_t *link = &stats.link;
+
+    if (argc > 1)
+    {
+        if ((0 == strcmp(argv[1], "close")) || (0 == strcmp(argv[1], "forget")))
+        {
+            uplink_task_request(true, 0 == strcmp(argv[1], "forget"));
+        }
+        else
+        {
+            printf("\nUsage: uplink [close|forget]\n");
+            return;
+        }
+    }
+
+    uplink_task_stats(&stats);
+
+    if (!stats.enabled)
+    {
+        printf("\nUplink off: no server configured (UPLINK_SERVER_ADDRESS)\n");
+        return;
+    }
+
+    printf("\nUplink to %s:%u: %s\n", UPLINK_SERVER_ADDRESS, (unsigned int)UPLINK_SERVER_PORT,
+           stats.connected ? "connected" : "not connected");
+    printf("%"PRIu32" bytes waiting, %"PRIu32" bytes unsent, %"PRIu32" records dropped\n",
+           stats.waiting_bytes, stats.unsent_bytes, stats.dropped_records);
+    printf("AP: %"PRIu32" connects, %"PRIu32" failures\n", stats.wifi_connects,
+           stats.wifi_failures);
+    printf("%"PRIu32" publishes, %"PRIu32" failures, %"PRIu32" KB, %"PRIu32" on a kept "
+           "connection, %"PRIu32" connections lost\n", link->publishes, link->failures,
+           (uint32_t)(link->bytes / 1024U), link->reused, link->lost);
+    printf("Handshakes: %"PRIu32" full, %"PRIu32" resumed, %"PRIu32" failed\n",
+           link->full_handshakes, link->resumed_handshakes, link->failed_handshakes);
+
+    if (0U != link->full_handshakes)
+    {
+        printf("Full handshake: mean %"PRIu32" ms\n",
+               (uint32_t)(link->full_handshake_ns / link->full_handshakes / 1000000U));
+    }
+
+    if (0U != link->resumed_handshakes)
+    {
+        printf("Resumed handshake: mean %"PRIu32" ms\n",
+               (uint32_t)(link->resumed_handshake_ns / link->resumed_handshakes / 1000000U));
+    }
+
+    if (0U != link->publishes)
+    {
+        printf("Publish: mean %"PRIu32" ms, slowest handshake %"PRIu32" ms\n",
+               (uint32_t)(link->publish_ns / link->publishes / 1000000U),
+               (uint32_t)(link->max_handshake_ns / 1000000U));
+    }
+
+    printf("Sessions: %"PRIu32" stored, %"PRIu32" loaded\n", link->sessions_stored,
+           link->sessions_loaded);
+}
+
+/*******************************************************************************
+* Function Name: console_execute
+********************************************************************************
+* Summary:
+* Splits a command line into arguments and runs the matching command.
+*******************************************************************************/
+static void console_execute(char *line)
+{
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    char *token = strtok(line, " ");
+
+    while ((NULL != token) && (argc < (int)CONSOLE_MAX_ARGS))
+    {
+        argv[argc++] = token;
+        token = strtok(NULL, " ");
+    }
+
+    if (0 == argc)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < (sizeof(console_commands) / sizeof(console_commands[0])); i++)
+    {
+        if (0 == strcmp(argv[0], console_commands[i].name))
+        {
+            console_commands[i].handler(argc, argv);
+            return;
+        }
+    }
+
+    printf("\nUnknown command '%s'. Type 'help' for the list of commands.\n",
+           argv[0]);
+}
+
+/*******************************************************************************
+* Function Name: console_task
+********************************************************************************
+* Summary: This task polls the debug UART for received characters, echoes them,
+* and executes a command when a complete line is received.
+*
+* Parameters:
+*  void* arg: Task parameter defined during task creation (unused).
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void console_task(void *arg)
+{
+    char line[CONSOLE_LINE_LENGTH];
+    uint32_t length = 0;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        uint32_t rx = Cy_SCB_UART_Get(CYBSP_DEBUG_UART_HW);
+
+        if (CY_SCB_UART_RX_NO_DATA == rx)
+        {
+            vTaskDelay(pdMS_TO_TICKS(CONSOLE_POLL_INTERVAL_MS));
+            continue;
+        }
+
+        char c = (char)rx;
+
+        if (('\r' == c) || ('\n' == c))
+        {
+            line[length] = '\0';
+            console_execute(line);
+            length = 0;
+            printf(CONSOLE_PROMPT);
+            fflush(stdout);
+        }
+        else if (((ASCII_BACKSPACE == c) || (ASCII_DELETE == (uint8_t)c)) &&
+                 (length > 0U))
+        {
+            length--;
+            printf("\b \b");
+            fflush(stdout);
+        }
+        else if ((length < (CONSOLE_LINE_LENGTH - 1U)) && (c >= ' '))
+        {
+            line[length++] = c;
+            putchar(c);
+            fflush(stdout);
+        }
+    }
+}
+
+/* [] END OF FILE */
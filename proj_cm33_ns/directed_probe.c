@@ -0,0 +1,219 @@
+/*******************************************************************************
+* File Name        : directed_probe.c
+*
+* Description      : This file contains the directed probe. A probe is an active scan
+*                    of a single channel, optionally restricted to one BSSID, which
+*                    completes in a few tens of milliseconds instead of the seconds
+*                    taken by a full sweep. It is shared by the presence tracker and
+*                    the motion sensor, which both run from the scan task.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "directed_probe.h"
+#include "bssid_table.h"
+#include "channel_plan.h"
+#include "scan_task.h"
+#include "retarget_io_init.h"
+#include "semphr.h"
+#include "whd_wifi_api.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PROBES_PER_CHANNEL                   (2)
+#define DWELL_DEFAULT                        (-1)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Probe in progress. The handler is called by the WHD thread while the caller
+ * waits on probe_done.
+ */
+static whd_interface_t probe_ifp;
+static SemaphoreHandle_t probe_done;
+static whd_scan_result_t probe_result;
+static whd_scan_extended_params_t probe_params;
+static directed_probe_handler_t probe_handler;
+static void *probe_user_data;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: probe_callback
+********************************************************************************
+* Summary:
+* WHD scan callback of a directed probe. Forwards each response to the handler
+* of the probe and signals the completion of the probe.
+*
+* Parameters:
+*  whd_scan_result_t **result_ptr: Pointer to the scan result
+*  void *user_data: User data (unused)
+*  whd_scan_status_t status: Status of the scan
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void probe_callback(whd_scan_result_t **result_ptr, void *user_data,
+                           whd_scan_status_t status)
+{
+    CY_UNUSED_PARAMETER(user_data);
+
+    if (WHD_SCAN_INCOMPLETE == status)
+    {
+        if ((NULL != result_ptr) && (NULL != *result_ptr))
+        {
+            probe_handler((*result_ptr)->BSSID.octet, (*result_ptr)->signal_strength,
+                          probe_user_data);
+        }
+    }
+    else
+    {
+        xSemaphoreGive(probe_done);
+    }
+}
+
+/*******************************************************************************
+* Function Name: directed_probe_init
+********************************************************************************
+* Summary:
+* Gets the WHD interface used for the probes. Must be called after
+* cy_wcm_init().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void directed_probe_init(void)
+{
+    probe_done = xSemaphoreCreateBinary();
+
+    if (NULL == probe_done)
+    {
+        handle_app_error();
+    }
+
+    if (CY_RSLT_SUCCESS != cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &probe_ifp))
+    {
+        handle_app_error();
+    }
+
+    probe_params.number_of_probes_per_channel = PROBES_PER_CHANNEL;
+    probe_params.scan_home_channel_dwell_time_between_channels_ms = DWELL_DEFAULT;
+}
+
+/*******************************************************************************
+* Function Name: directed_probe_run
+********************************************************************************
+* Summary:
+* Probes one channel and blocks until the probe completes or times out. On a
+* channel the channel plan scans passively, the probe listens for beacons
+* for at least CHANNEL_PLAN_PASSIVE_DWELL_MS instead. Must be called from the
+* scan task, outside a full sweep and without the scan data lock.
+*
+* Parameters:
+*  uint8_t channel: Channel to probe
+*  const uint8_t *bssid: BSSID to probe, or NULL for every BSSID on the channel
+*  uint32_t dwell_ms: Active dwell time on the channel
+*  directed_probe_handler_t handler: Called for each response
+*  void *user_data: Passed to the handler
+*
+* Return:
+*  bool: false if the channel plan skips the channel, or the probe could not
+*        be started or timed out. Responses received before a timeout are
+*        still passed to the handler.
+*
+*******************************************************************************/
+bool directed_probe_run(uint8_t channel, const uint8_t *bssid, uint32_t dwell_ms,
+                        directed_probe_handler_t handler, void *user_data)
+{
+    uint16_t channel_list[2] = { channel, 0U };
+    whd_mac_t mac;
+    bool started;
+
+    scan_data_lock();
+    channel_plan_scan_t scan = channel_plan_lookup(channel);
+    scan_data_unlock();
+
+    if (CHANNEL_PLAN_SKIP == scan)
+    {
+        return false;
+    }
+
+    probe_handler = handler;
+    probe_user_data = user_data;
+    probe_params.scan_active_dwell_time_per_channel_ms = (int32_t)dwell_ms;
+    probe_params.scan_passive_dwell_time_per_channel_ms =
+        (int32_t)((dwell_ms > CHANNEL_PLAN_PASSIVE_DWELL_MS) ? dwell_ms :
+                                                               CHANNEL_PLAN_PASSIVE_DWELL_MS);
+
+    if (NULL != bssid)
+    {
+        memcpy(mac.octet, bssid, BSSID_LENGTH);
+    }
+
+    /* Drop a completion left over from a probe that timed out. */
+    (void)xSemaphoreTake(probe_done, 0U);
+
+    started = (WHD_SUCCESS == whd_wifi_scan(probe_ifp,
+                                            (CHANNEL_PLAN_PASSIVE == scan) ?
+                                            WHD_SCAN_TYPE_PASSIVE : WHD_SCAN_TYPE_ACTIVE,
+                                            WHD_BSS_TYPE_ANY, NULL,
+                                            (NULL != bssid) ? &mac : NULL,
+                                            channel_list, &probe_params,
+                                            probe_callback, &probe_result, NULL));
+
+    if (started &&
+        (pdTRUE != xSemaphoreTake(probe_done, pdMS_TO_TICKS(DIRECTED_PROBE_TIMEOUT_MS))))
+    {
+        whd_wifi_stop_scan(probe_ifp);
+        (void)xSemaphoreTake(probe_done, pdMS_TO_TICKS(DIRECTED_PROBE_TIMEOUT_MS));
+        started = false;
+    }
+
+    return started;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,608 @@
+/*******************************************************************************
+* File Name        : ess_view.c
+*
+* Description      : This file contains the ESS view. It interns the SSIDs of the
+*                    scan results and groups the results of a scan by SSID and
+*                    security as they arrive, so the view of the networks is
+*                    complete when the scan completes, without a second pass.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "ess_view.h"
+#include "ssid_escape.h"
+#include "hash_service.h"
+#include "pseudonym.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SSID_SLOTS                           (2U * ESS_VIEW_MAX_SSIDS)
+#define SSID_SLOT_MASK                       (SSID_SLOTS - 1U)
+#define SSID_SLOT_EMPTY                      (0xFFU)
+#define SSID_NONE                            (0xFFU)
+
+/* RSSI is smoothed in 1/16 dB. */
+#define RSSI_Q4_SHIFT                        (4U)
+
+/* Channel bitmaps: 2.4 GHz channels 1-14, and the 20 MHz channels of the
+ * 5 GHz (36-177) and 6 GHz (1-233) bands, 4 apart.
+ */
+#define BAND_2_4GHZ                          (1U)
+#define BAND_5GHZ                            (2U)
+#define BAND_6GHZ                            (3U)
+#define CHANNEL_5GHZ_FIRST                   (36U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    uint32_t hash;
+    uint16_t offset;
+    uint8_t  length;
+} ssid_entry_t;
+
+/* Network of the scan in progress. */
+typedef struct
+{
+    ess_view_group_t group;
+    int16_t          best_rssi_q4;
+    uint8_t          ssid_id;
+    uint16_t         channels_2_4ghz;
+    uint64_t         channels_5ghz;
+    uint64_t         channels_6ghz;
+} ess_build_t;
+
+typedef struct
+{
+    int16_t  rssi_q4;
+    uint16_t generation;
+    bool     valid;
+} ess_bssid_t;
+
+/* SSID intern table: the pool holds each SSID once and the slots map the hash
+ * of an SSID to its entry.
+ */
+static MODULE_STATE uint8_t ess_pool[ESS_VIEW_SSID_POOL_SIZE];
+static MODULE_STATE uint32_t ess_pool_used;
+static MODULE_STATE ssid_entry_t ess_ssids[ESS_VIEW_MAX_SSIDS];
+static MODULE_STATE uint32_t ess_ssid_count;
+static MODULE_STATE uint8_t ess_ssid_slots[SSID_SLOTS];
+
+/* Smoothed RSSI of every tracked BSSID, parallel to the BSSID table. */
+static MODULE_STATE ess_bssid_t ess_bssids[BSSID_TABLE_MAX_ENTRIES];
+
+/* Networks of the scan in progress, and those of the last completed scan
+ * ordered by the RSSI of their best BSSID.
+ */
+static MODULE_STATE ess_build_t ess_building[ESS_VIEW_MAX_GROUPS];
+static MODULE_STATE uint32_t ess_building_count;
+static MODULE_STATE uint32_t ess_dropped;
+static MODULE_STATE ess_view_group_t ess_published[ESS_VIEW_MAX_GROUPS];
+static MODULE_STATE uint32_t ess_published_count;
+static MODULE_STATE uint32_t ess_published_dropped;
+static MODULE_STATE uint32_t ess_sequence;
+static MODULE_STATE uint32_t ess_timestamp;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: ssid_hash
+********************************************************************************
+* Summary:
+* Returns the hash of an SSID in the intern table.
+*******************************************************************************/
+static uint32_t ssid_hash(const uint8_t *ssid, uint8_t length)
+{
+    return hash_service_hash32(ssid, length);
+}
+
+/*******************************************************************************
+* Function Name: clear_ssids
+********************************************************************************
+* Summary:
+* Empties the SSID intern table.
+*******************************************************************************/
+static void clear_ssids(void)
+{
+    ess_pool_used = 0U;
+    ess_ssid_count = 0U;
+    memset(ess_ssid_slots, SSID_SLOT_EMPTY, sizeof(ess_ssid_slots));
+}
+
+/*******************************************************************************
+* Function Name: intern_ssid
+********************************************************************************
+* Summary:
+* Returns the ID of an SSID, adding it to the intern table if needed, or
+* SSID_NONE if the table is full.
+*******************************************************************************/
+static uint8_t intern_ssid(const uint8_t *ssid, uint8_t length)
+{
+    uint32_t hash = ssid_hash(ssid, length);
+    uint32_t slot = hash & SSID_SLOT_MASK;
+
+    while (SSID_SLOT_EMPTY != ess_ssid_slots[slot])
+    {
+        const ssid_entry_t *entry = &ess_ssids[ess_ssid_slots[slot]];
+
+        if ((entry->hash == hash) && (entry->length == length) &&
+            (0 == memcmp(&ess_pool[entry->offset], ssid, length)))
+        {
+            return ess_ssid_slots[slot];
+        }
+
+        slot = (slot + 1U) & SSID_SLOT_MASK;
+    }
+
+    if ((ess_ssid_count >= ESS_VIEW_MAX_SSIDS) ||
+        ((ess_pool_used + length) > ESS_VIEW_SSID_POOL_SIZE))
+    {
+        return SSID_NONE;
+    }
+
+    ssid_entry_t *entry = &ess_ssids[ess_ssid_count];
+
+    entry->hash = hash;
+    entry->offset = (uint16_t)ess_pool_used;
+    entry->length = length;
+    memcpy(&ess_pool[ess_pool_used], ssid, length);
+    ess_pool_used += length;
+    ess_ssid_slots[slot] = (uint8_t)ess_ssid_count;
+
+    return (uint8_t)ess_ssid_count++;
+}
+
+/*******************************************************************************
+* Function Name: popcount64
+********************************************************************************
+* Summary:
+* Returns the number of bits set.
+*******************************************************************************/
+static uint32_t popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return (uint32_t)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: add_channel
+********************************************************************************
+* Summary:
+* Adds a channel to the channel spread of a network.
+*******************************************************************************/
+static void add_channel(ess_build_t *build, uint8_t band, uint8_t channel)
+{
+    ess_view_group_t *group = &build->group;
+
+    if (BAND_2_4GHZ == band)
+    {
+        build->channels_2_4ghz |= (uint16_t)(1U << (channel & 0x0FU));
+    }
+    else if (BAND_6GHZ == band)
+    {
+        build->channels_6ghz |= (1ULL << (((uint32_t)channel / 4U) & 0x3FU));
+    }
+    else if (channel >= CHANNEL_5GHZ_FIRST)
+    {
+        build->channels_5ghz |= (1ULL << ((((uint32_t)channel - CHANNEL_5GHZ_FIRST) / 4U) & 0x3FU));
+    }
+
+    group->channels = (uint8_t)(popcount64(build->channels_2_4ghz) +
+                                popcount64(build->channels_5ghz) +
+                                popcount64(build->channels_6ghz));
+
+    if ((1U == group->bssids) || (channel < group->min_channel))
+    {
+        group->min_channel = channel;
+    }
+
+    if ((1U == group->bssids) || (channel > group->max_channel))
+    {
+        group->max_channel = channel;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ess_view_init
+********************************************************************************
+* Summary:
+* Clears the view, the intern table and the smoothed RSSI of the BSSIDs.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ess_view_init(void)
+{
+    clear_ssids();
+    memset(ess_bssids, 0, sizeof(ess_bssids));
+    ess_building_count = 0U;
+    ess_dropped = 0U;
+    ess_published_count = 0U;
+    ess_published_dropped = 0U;
+    ess_sequence = 0U;
+    ess_timestamp = 0U;
+}
+
+/*******************************************************************************
+* Function Name: ess_view_begin
+********************************************************************************
+* Summary:
+* Starts the networks of a new scan. The published view of the last scan is
+* kept until the new one is committed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ess_view_begin(void)
+{
+    /* The networks are rebuilt every scan and the published ones hold copies
+     * of their SSIDs, so the intern table can be emptied between scans.
+     */
+    if ((ess_ssid_count > (ESS_VIEW_MAX_SSIDS - ESS_VIEW_MAX_GROUPS)) ||
+        (ess_pool_used > (ESS_VIEW_SSID_POOL_SIZE -
+                          (ESS_VIEW_MAX_GROUPS * SCAN_LOG_SSID_MAX_LENGTH))))
+    {
+        clear_ssids();
+    }
+
+    ess_building_count = 0U;
+    ess_dropped = 0U;
+}
+
+/*******************************************************************************
+* Function Name: ess_view_observe
+********************************************************************************
+* Summary:
+* Adds a scan result to its network. A BSSID reported more than once in a scan
+* is counted once, but each report updates its smoothed RSSI.
+*
+* Parameters:
+*  uint16_t index: BSSID table index of the result
+*  uint16_t generation: Generation of the BSSID table entry
+*  bool first_in_scan: true if the BSSID was not reported before in this scan
+*  const scan_log_ap_t *ap: Scan result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ess_view_observe(uint16_t index, uint16_t generation, bool first_in_scan,
+                      const scan_log_ap_t *ap)
+{
+    ess_bssid_t *bssid = &ess_bssids[index];
+    int16_t rssi_q4 = (int16_t)(ap->rssi * (1 << RSSI_Q4_SHIFT));
+    uint8_t length = (ap->ssid_length > SCAN_LOG_SSID_MAX_LENGTH) ?
+                     SCAN_LOG_SSID_MAX_LENGTH : ap->ssid_length;
+
+    if (bssid->valid && (bssid->generation == generation))
+    {
+        bssid->rssi_q4 = (int16_t)(bssid->rssi_q4 +
+                                   ((rssi_q4 - bssid->rssi_q4) / (1 << ESS_VIEW_RSSI_SHIFT)));
+    }
+    else
+    {
+        bssid->rssi_q4 = rssi_q4;
+        bssid->generation = generation;
+        bssid->valid = true;
+    }
+
+    uint8_t ssid_id = intern_ssid(ap->ssid, length);
+    ess_build_t *build = NULL;
+
+    if (SSID_NONE == ssid_id)
+    {
+        ess_dropped++;
+        return;
+    }
+
+    for (uint32_t i = 0; i < ess_building_count; i++)
+    {
+        if ((ess_building[i].ssid_id == ssid_id) &&
+            (ess_building[i].group.security == ap->security))
+        {
+            build = &ess_building[i];
+            break;
+        }
+    }
+
+    if (NULL == build)
+    {
+        if (ess_building_count >= ESS_VIEW_MAX_GROUPS)
+        {
+            ess_dropped++;
+            return;
+        }
+
+        build = &ess_building[ess_building_count++];
+        memset(build, 0, sizeof(*build));
+        build->ssid_id = ssid_id;
+        build->group.security = ap->security;
+        build->group.ssid_length = length;
+        memcpy(build->group.ssid, ap->ssid, length);
+    }
+
+    ess_view_group_t *group = &build->group;
+
+    /* A BSSID whose first result of the scan was dropped is counted with
+     * the first result that makes it into a network.
+     */
+    if (first_in_scan || (0U == group->bssids))
+    {
+        group->bssids++;
+        group->bands |= (uint8_t)(1U << (ap->band & 0x07U));
+        add_channel(build, ap->band, ap->channel);
+    }
+
+    if ((1U == group->bssids) || (bssid->rssi_q4 > build->best_rssi_q4) ||
+        (0 == memcmp(group->best_bssid, ap->bssid, BSSID_LENGTH)))
+    {
+        build->best_rssi_q4 = bssid->rssi_q4;
+        group->best_rssi = (int8_t)(bssid->rssi_q4 / (1 << RSSI_Q4_SHIFT));
+        memcpy(group->best_bssid, ap->bssid, BSSID_LENGTH);
+    }
+}
+
+/*******************************************************************************
+* Function Name: ess_view_commit
+********************************************************************************
+* Summary:
+* Publishes the networks of the scan, ordered by the smoothed RSSI of their
+* best BSSID.
+*
+* Parameters:
+*  uint32_t sequence: Sequence number of the scan
+*  uint32_t timestamp: Time of scan completion in seconds
+*
+* Return:
+*  uint32_t: Number of networks
+*
+*******************************************************************************/
+uint32_t ess_view_commit(uint32_t sequence, uint32_t timestamp)
+{
+    /* Insertion sort: the networks are few and mostly in the same order from
+     * one scan to the next.
+     */
+    for (uint32_t i = 0; i < ess_building_count; i++)
+    {
+        const ess_view_group_t *group = &ess_building[i].group;
+        uint32_t j = i;
+
+        while ((j > 0U) && (ess_published[j - 1U].best_rssi < group->best_rssi))
+        {
+            ess_published[j] = ess_published[j - 1U];
+            j--;
+        }
+
+        ess_published[j] = *group;
+    }
+
+    ess_published_count = ess_building_count;
+    ess_published_dropped = ess_dropped;
+    ess_sequence = sequence;
+    ess_timestamp = timestamp;
+
+    return ess_published_count;
+}
+
+/*******************************************************************************
+* Function Name: ess_view_count
+********************************************************************************
+* Summary:
+* Returns the number of networks of the last completed scan.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: Number of networks
+*
+*******************************************************************************/
+uint32_t ess_view_count(void)
+{
+    return ess_published_count;
+}
+
+/*******************************************************************************
+* Function Name: ess_view_get
+********************************************************************************
+* Summary:
+* Returns a network of the last completed scan.
+*
+* Parameters:
+*  uint32_t rank: 0 for the network with the strongest best BSSID
+*  ess_view_group_t *group: Receives the network
+*
+* Return:
+*  bool: false if there is no such network
+*
+*******************************************************************************/
+bool ess_view_get(uint32_t rank, ess_view_group_t *group)
+{
+    if (rank >= ess_published_count)
+    {
+        return false;
+    }
+
+    *group = ess_published[rank];
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: ess_view_encode
+********************************************************************************
+* Summary:
+* Encodes the networks of the last completed scan as an ESS record (see
+* scan_log_format.h). Networks that do not fit are dropped and the record is
+* flagged as truncated. While pseudonyms are on, the record carries those of
+* the best BSSIDs and of the SSIDs.
+*
+* Parameters:
+*  uint8_t *record: Buffer of the record
+*  uint32_t size: Size of the buffer, at least SCAN_LOG_HEADER_SIZE
+*
+* Return:
+*  uint32_t: Length of the record
+*
+*******************************************************************************/
+uint32_t ess_view_encode(uint8_t *record, uint32_t size)
+{
+    uint32_t length = SCAN_LOG_HEADER_SIZE;
+    uint16_t count = 0U;
+    uint8_t flags = (0U != ess_published_dropped) ? SCAN_LOG_FLAG_TRUNCATED : 0U;
+
+    if (pseudonym_enabled())
+    {
+        flags |= SCAN_LOG_FLAG_PSEUDONYMS;
+    }
+
+    for (uint32_t i = 0; i < ess_published_count; i++)
+    {
+        const ess_view_group_t *group = &ess_published[i];
+        uint8_t *p = &record[length];
+        uint8_t ssid[SCAN_LOG_SSID_MAX_LENGTH];
+        uint8_t ssid_length = pseudonym_ssid(group->ssid, group->ssid_length, ssid);
+
+        if ((length + SCAN_LOG_ESS_FIXED_SIZE + ssid_length) > size)
+        {
+            flags |= SCAN_LOG_FLAG_TRUNCATED;
+            break;
+        }
+
+        pseudonym_bssid(group->best_bssid, p + SCAN_LOG_ESS_OFFSET_BSSID);
+        p[SCAN_LOG_ESS_OFFSET_RSSI] = (uint8_t)group->best_rssi;
+        p[SCAN_LOG_ESS_OFFSET_BANDS] = group->bands;
+        scan_log_put_u32(p + SCAN_LOG_ESS_OFFSET_SECURITY, group->security);
+        scan_log_put_u16(p + SCAN_LOG_ESS_OFFSET_BSSIDS, group->bssids);
+        p[SCAN_LOG_ESS_OFFSET_CHANNELS] = group->channels;
+        p[SCAN_LOG_ESS_OFFSET_MIN_CHANNEL] = group->min_channel;
+        p[SCAN_LOG_ESS_OFFSET_MAX_CHANNEL] = group->max_channel;
+        p[SCAN_LOG_ESS_OFFSET_SSID_LENGTH] = ssid_length;
+        memcpy(p + SCAN_LOG_ESS_OFFSET_SSID, ssid, ssid_length);
+
+        length += SCAN_LOG_ESS_FIXED_SIZE + ssid_length;
+        count++;
+    }
+
+    memset(record, 0, SCAN_LOG_HEADER_SIZE);
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_MAGIC], SCAN_LOG_ESS_MAGIC);
+    record[SCAN_LOG_OFFSET_VERSION] = SCAN_LOG_VERSION;
+    record[SCAN_LOG_OFFSET_FLAGS] = flags;
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_LENGTH], (uint16_t)length);
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_AP_COUNT], count);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_SEQUENCE], ess_sequence);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_TIMESTAMP], ess_timestamp);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_CRC],
+                     scan_log_crc32(&record[SCAN_LOG_HEADER_SIZE],
+                                    length - SCAN_LOG_HEADER_SIZE));
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: ess_view_print
+********************************************************************************
+* Summary:
+* Prints the networks of the last completed scan as a table, with the
+* pseudonyms of the SSIDs and of the best BSSIDs while they are on.
+*
+* Parameters:
+*  ess_view_printer_t print: printf() or a function like it
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ess_view_print(ess_view_printer_t print)
+{
+    print("\n  Networks of scan %"PRIu32": %"PRIu32, ess_sequence, ess_published_count);
+
+    if (0U != ess_published_dropped)
+    {
+        print(" (%"PRIu32" results dropped)", ess_published_dropped);
+    }
+
+    print("\n  %-32s  Security  BSSIDs  Bands  Best BSSID          RSSI  Channels\n", "SSID");
+
+    for (uint32_t i = 0; i < ess_published_count; i++)
+    {
+        const ess_view_group_t *group = &ess_published[i];
+        uint8_t exported[SCAN_LOG_SSID_MAX_LENGTH];
+        uint8_t bssid[BSSID_LENGTH];
+        char ssid[SSID_ESCAPE_BUFFER_SIZE];
+        uint32_t columns;
+
+        uint8_t length = pseudonym_ssid(group->ssid, group->ssid_length, exported);
+        pseudonym_bssid(group->best_bssid, bssid);
+        (void)ssid_escape(exported, length, SSID_ESCAPE_TERMINAL, ssid, &columns);
+
+        print("  %s%*s  %08"PRIX32"  %6u  %c%c%c    %02X:%02X:%02X:%02X:%02X:%02X  %4d  %u (%u-%u)\n",
+               ssid, ssid_escape_padding(columns, SSID_ESCAPE_MAX_SSID_LENGTH), "", group->security,
+               group->bssids,
+               (0U != (group->bands & (1U << BAND_2_4GHZ))) ? '2' : '-',
+               (0U != (group->bands & (1U << BAND_5GHZ))) ? '5' : '-',
+               (0U != (group->bands & (1U << BAND_6GHZ))) ? '6' : '-',
+               bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5],
+               group->best_rssi, group->channels, group->min_channel, group->max_channel);
+    }
+}
+
+/* [] END OF FILE */
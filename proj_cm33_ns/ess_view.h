@@ -0,0 +1,125 @@
+/*******************************************************************************
+* File Name        : ess_view.h
+*
+* Description      : This file contains the structures and functions of the ESS
+*                    view, which groups the scan results by network.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_ESS_VIEW_H_
+#define SOURCE_ESS_VIEW_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_log_format.h"
+#include "bssid_table.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Networks of one scan. Results of further networks are counted as dropped. */
+#define ESS_VIEW_MAX_GROUPS                  (32U)
+
+/* SSIDs interned at the same time, a power of two, and the bytes they share.
+ * The table is emptied at the start of a scan unless it has room for the
+ * SSIDs of ESS_VIEW_MAX_GROUPS new networks, so interning never fails.
+ */
+#define ESS_VIEW_MAX_SSIDS                   (64U)
+#define ESS_VIEW_SSID_POOL_SIZE              (2048U)
+
+/* Largest ESS record, with every network and the longest SSIDs. */
+#define ESS_VIEW_MAX_RECORD_SIZE             (SCAN_LOG_HEADER_SIZE + (ESS_VIEW_MAX_GROUPS * \
+                                              (SCAN_LOG_ESS_FIXED_SIZE + SCAN_LOG_SSID_MAX_LENGTH)))
+
+/* Weight of a new RSSI sample in the smoothed RSSI of a BSSID: 1 / 2^shift. */
+#define ESS_VIEW_RSSI_SHIFT                  (2U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* One network: the BSSIDs of a scan that share an SSID and a security type.
+ * 'bands' has bit (1 << band) set for every cy_wcm_wifi_band_t seen. The best
+ * BSSID is the one with the highest smoothed RSSI. 'channels' counts the
+ * distinct channels, which span min_channel to max_channel.
+ */
+typedef struct
+{
+    uint8_t  ssid[SCAN_LOG_SSID_MAX_LENGTH];
+    uint8_t  ssid_length;
+    uint32_t security;
+    uint16_t bssids;
+    uint8_t  bands;
+    uint8_t  best_bssid[BSSID_LENGTH];
+    int8_t   best_rssi;
+    uint8_t  channels;
+    uint8_t  min_channel;
+    uint8_t  max_channel;
+} ess_view_group_t;
+
+/* printf() or a function like it, which ess_view_print() prints with. */
+typedef int (*ess_view_printer_t)(const char *format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ess_view_init(void);
+void ess_view_begin(void);
+void ess_view_observe(uint16_t index, uint16_t generation, bool first_in_scan,
+                      const scan_log_ap_t *ap);
+uint32_t ess_view_commit(uint32_t sequence, uint32_t timestamp);
+uint32_t ess_view_count(void);
+bool ess_view_get(uint32_t rank, ess_view_group_t *group);
+uint32_t ess_view_encode(uint8_t *record, uint32_t size);
+void ess_view_print(ess_view_printer_t print);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_ESS_VIEW_H_ */
+
+/* [] END OF FILE */
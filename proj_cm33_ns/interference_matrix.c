@@ -0,0 +1,520 @@
+/*******************************************************************************
+* File Name        : interference_matrix.c
+*
+* Description      : This file contains the interference matrix. Every BSS of a
+*                    full sweep adds its power to the 20 MHz channels it occupies,
+*                    as decoded from its operation elements, and to the overlapping
+*                    2.4 GHz channels. The matrix is published at the end of the
+*                    sweep and ranks the channels a new BSS could use.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "interference_matrix.h"
+#include "channel_plan.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CHANNEL_NOT_TRACKED                  (0xFFU)
+
+/* Channel 14 is only allowed for 802.11b in Japan, so it is never recommended. */
+#define CHANNEL_2_4GHZ_LAST_RECOMMENDED      (13U)
+
+#define DB_PER_DECADE                        (10U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Runs of 20 MHz channels, 'step' channel numbers apart, that can be bonded
+ * into wider channels aligned to the first channel of the run.
+ */
+typedef struct
+{
+    uint8_t band;
+    uint8_t first;
+    uint8_t count;
+    uint8_t step;
+    uint8_t index;
+} channel_run_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const channel_run_t channel_runs[] =
+{
+    { BSS_WIDTH_BAND_2_4GHZ,   1U, INTERFERENCE_2_4GHZ_CHANNELS, 1U, 0U  },
+    { BSS_WIDTH_BAND_5GHZ,    36U,  8U, 4U, 14U },
+    { BSS_WIDTH_BAND_5GHZ,   100U, 12U, 4U, 22U },
+    { BSS_WIDTH_BAND_5GHZ,   149U,  8U, 4U, 34U },
+    { BSS_WIDTH_BAND_6GHZ,     1U, INTERFERENCE_6GHZ_CHANNELS, 4U, 42U },
+};
+
+#define CHANNEL_RUN_COUNT                    (sizeof(channel_runs) / sizeof(channel_runs[0]))
+
+/* 10^(n / 10) for n = 0 to 9. */
+static const float tenth_decades[DB_PER_DECADE] =
+{
+    1.0f, 1.2589254f, 1.5848932f, 1.9952623f, 2.5118864f,
+    3.1622777f, 3.9810717f, 5.0118723f, 6.3095734f, 7.9432823f
+};
+
+static MODULE_STATE interference_channel_t matrix_building[INTERFERENCE_CHANNELS];
+static MODULE_STATE interference_stats_t matrix_building_stats;
+static MODULE_STATE bool matrix_full_sweep;
+
+static MODULE_STATE interference_channel_t matrix_published[INTERFERENCE_CHANNELS];
+static MODULE_STATE interference_stats_t matrix_published_stats;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: channel_index
+********************************************************************************
+* Summary:
+* Returns the index of a 20 MHz channel in the matrix, or CHANNEL_NOT_TRACKED.
+*******************************************************************************/
+static uint8_t channel_index(uint8_t band, uint8_t channel)
+{
+    for (uint32_t i = 0; i < CHANNEL_RUN_COUNT; i++)
+    {
+        const channel_run_t *run = &channel_runs[i];
+
+        if ((run->band == band) && (channel >= run->first) &&
+            (0U == ((channel - run->first) % run->step)) &&
+            (((channel - run->first) / run->step) < run->count))
+        {
+            return (uint8_t)(run->index + ((channel - run->first) / run->step));
+        }
+    }
+
+    return CHANNEL_NOT_TRACKED;
+}
+
+/*******************************************************************************
+* Function Name: weight
+********************************************************************************
+* Summary:
+* Converts a signal level to power in mW relative to INTERFERENCE_FLOOR_DBM,
+* without the math library.
+*******************************************************************************/
+static float weight(int16_t rssi)
+{
+    int16_t level = (rssi < INTERFERENCE_FLOOR_DBM) ? INTERFERENCE_FLOOR_DBM :
+                    (rssi > INTERFERENCE_CEILING_DBM) ? INTERFERENCE_CEILING_DBM : rssi;
+    uint32_t db = (uint32_t)(level - INTERFERENCE_FLOOR_DBM);
+    float power = tenth_decades[db % DB_PER_DECADE];
+
+    for (uint32_t i = 0; i < (db / DB_PER_DECADE); i++)
+    {
+        power *= 10.0f;
+    }
+
+    return power;
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_init
+********************************************************************************
+* Summary:
+* Clears the matrix.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void interference_matrix_init(void)
+{
+    memset(matrix_building, 0, sizeof(matrix_building));
+    memset(matrix_published, 0, sizeof(matrix_published));
+    memset(&matrix_building_stats, 0, sizeof(matrix_building_stats));
+    memset(&matrix_published_stats, 0, sizeof(matrix_published_stats));
+    matrix_full_sweep = false;
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_begin
+********************************************************************************
+* Summary:
+* Starts a new scan. Only full sweeps see every BSS, so filtered scans leave
+* the published matrix as it is.
+*
+* Parameters:
+*  bool full_sweep: true if the scan covered all channels without filter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void interference_matrix_begin(bool full_sweep)
+{
+    matrix_full_sweep = full_sweep;
+
+    if (full_sweep)
+    {
+        memset(matrix_building, 0, sizeof(matrix_building));
+        memset(&matrix_building_stats, 0, sizeof(matrix_building_stats));
+    }
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_observe
+********************************************************************************
+* Summary:
+* Adds a BSS to the matrix being built. Its power is added to the load and the
+* score of every 20 MHz channel it occupies. In the 2.4 GHz band, where
+* channels are 5 MHz apart, it is also added to the score of every channel
+* within INTERFERENCE_COUPLING_MHZ, in proportion to the spectral overlap.
+*
+* Parameters:
+*  bool first_in_scan: false if the BSSID was already reported by this scan
+*  uint8_t band: Band of the BSS (cy_wcm_wifi_band_t)
+*  int16_t rssi: Signal level in dBm
+*  const bss_width_t *bss: Channels occupied by the BSS, see bss_width_decode
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void interference_matrix_observe(bool first_in_scan, uint8_t band, int16_t rssi,
+                                 const bss_width_t *bss)
+{
+    uint8_t primary = channel_index(band, bss->primary);
+
+    if ((!matrix_full_sweep) || (!first_in_scan) || (CHANNEL_NOT_TRACKED == primary))
+    {
+        return;
+    }
+
+    float power = weight(rssi);
+
+    matrix_building[primary].primary++;
+    matrix_building_stats.bss++;
+
+    if (bss->width_mhz > 20U)
+    {
+        matrix_building_stats.wide++;
+    }
+
+    for (uint32_t i = 0; i < bss->count; i++)
+    {
+        uint8_t index = channel_index(band, bss->subchannels[i]);
+
+        if (CHANNEL_NOT_TRACKED == index)
+        {
+            continue;
+        }
+
+        matrix_building[index].load += power;
+        matrix_building[index].bss++;
+
+        if (BSS_WIDTH_BAND_2_4GHZ != band)
+        {
+            /* 5 GHz and 6 GHz channels do not overlap. */
+            matrix_building[index].score += power;
+            continue;
+        }
+
+        uint32_t frequency = bss_width_frequency(band, bss->subchannels[i]);
+
+        for (uint8_t other = 1U; other <= INTERFERENCE_2_4GHZ_CHANNELS; other++)
+        {
+            uint32_t other_frequency = bss_width_frequency(band, other);
+            uint32_t distance = (other_frequency > frequency) ? (other_frequency - frequency) :
+                                                                (frequency - other_frequency);
+
+            if (distance < INTERFERENCE_COUPLING_MHZ)
+            {
+                matrix_building[other - 1U].score += (power * (float)(INTERFERENCE_COUPLING_MHZ - distance)) /
+                                                     (float)INTERFERENCE_COUPLING_MHZ;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_commit
+********************************************************************************
+* Summary:
+* Publishes the matrix built from a full sweep.
+*
+* Parameters:
+*  uint32_t sequence: Sequence number of the scan
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void interference_matrix_commit(uint32_t sequence)
+{
+    if (!matrix_full_sweep)
+    {
+        return;
+    }
+
+    matrix_building_stats.sweeps = matrix_published_stats.sweeps + 1U;
+    matrix_building_stats.sequence = sequence;
+    memcpy(matrix_published, matrix_building, sizeof(matrix_published));
+    matrix_published_stats = matrix_building_stats;
+    matrix_full_sweep = false;
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_channel
+********************************************************************************
+* Summary:
+* Returns the published state of a 20 MHz channel.
+*
+* Parameters:
+*  uint8_t band: Band of the channel (cy_wcm_wifi_band_t)
+*  uint8_t channel: Channel
+*  interference_channel_t *state: Receives the state of the channel
+*
+* Return:
+*  bool: false if the channel is not tracked
+*
+*******************************************************************************/
+bool interference_matrix_channel(uint8_t band, uint8_t channel, interference_channel_t *state)
+{
+    uint8_t index = channel_index(band, channel);
+
+    if (CHANNEL_NOT_TRACKED == index)
+    {
+        return false;
+    }
+
+    *state = matrix_published[index];
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_recommend
+********************************************************************************
+* Summary:
+* Ranks the channels of a band and width by the published score, lowest
+* first. Wide channels are the aligned 40, 80 and 160 MHz channels of the
+* 5 GHz and 6 GHz bands; only 20 MHz channels are recommended in the 2.4 GHz
+* band. Channels the channel plan skips are left out. Must be called with the
+* scan data locked.
+*
+* Parameters:
+*  uint8_t band: Band (cy_wcm_wifi_band_t)
+*  uint16_t width_mhz: Channel width, 20, 40, 80 or 160 MHz
+*  interference_candidate_t *candidates: Receives the best channels
+*  uint32_t max: Size of the candidates array
+*
+* Return:
+*  uint32_t: Number of candidates returned
+*
+*******************************************************************************/
+uint32_t interference_matrix_recommend(uint8_t band, uint16_t width_mhz,
+                                       interference_candidate_t *candidates, uint32_t max)
+{
+    uint32_t span = width_mhz / 20U;
+    uint32_t found = 0U;
+
+    if (((20U != width_mhz) && (40U != width_mhz) && (80U != width_mhz) && (160U != width_mhz)) ||
+        ((BSS_WIDTH_BAND_2_4GHZ == band) && (20U != width_mhz)))
+    {
+        return 0U;
+    }
+
+    for (uint32_t r = 0; r < CHANNEL_RUN_COUNT; r++)
+    {
+        const channel_run_t *run = &channel_runs[r];
+
+        if (run->band != band)
+        {
+            continue;
+        }
+
+        for (uint32_t start = 0; (start + span) <= run->count; start += span)
+        {
+            interference_candidate_t candidate;
+            bool allowed = true;
+
+            candidate.band = band;
+            candidate.width_mhz = width_mhz;
+            candidate.score = 0.0f;
+            candidate.channel = (uint8_t)(run->first + (start * run->step) +
+                                          (((span - 1U) * run->step) / 2U));
+
+            for (uint32_t i = 0; i < span; i++)
+            {
+                uint8_t channel = (uint8_t)(run->first + ((start + i) * run->step));
+
+                if ((BSS_WIDTH_BAND_6GHZ != band) &&
+                    (CHANNEL_PLAN_SKIP == channel_plan_lookup(channel)))
+                {
+                    allowed = false;
+                }
+
+                candidate.score += matrix_published[run->index + start + i].score;
+            }
+
+            if ((!allowed) || ((BSS_WIDTH_BAND_2_4GHZ == band) &&
+                               (candidate.channel > CHANNEL_2_4GHZ_LAST_RECOMMENDED)))
+            {
+                continue;
+            }
+
+            /* Insertion into the sorted candidates, keeping the lower channel
+             * first on equal scores.
+             */
+            uint32_t position = found;
+
+            while ((position > 0U) && (candidate.score < candidates[position - 1U].score))
+            {
+                if (position < max)
+                {
+                    candidates[position] = candidates[position - 1U];
+                }
+
+                position--;
+            }
+
+            if (position < max)
+            {
+                candidates[position] = candidate;
+
+                if (found < max)
+                {
+                    found++;
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_band_load
+********************************************************************************
+* Summary:
+* Returns the published load of a band, the sum of the loads of its 20 MHz
+* channels.
+*
+* Parameters:
+*  uint8_t band: Band (cy_wcm_wifi_band_t)
+*
+* Return:
+*  float: Load in mW relative to INTERFERENCE_FLOOR_DBM
+*
+*******************************************************************************/
+float interference_matrix_band_load(uint8_t band)
+{
+    float load = 0.0f;
+
+    for (uint32_t r = 0; r < CHANNEL_RUN_COUNT; r++)
+    {
+        const channel_run_t *run = &channel_runs[r];
+
+        for (uint32_t i = 0; (run->band == band) && (i < run->count); i++)
+        {
+            load += matrix_published[run->index + i].load;
+        }
+    }
+
+    return load;
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_stats
+********************************************************************************
+* Summary:
+* Returns the totals of the published sweep.
+*
+* Parameters:
+*  interference_stats_t *stats: Receives the totals
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void interference_matrix_stats(interference_stats_t *stats)
+{
+    *stats = matrix_published_stats;
+}
+
+/*******************************************************************************
+* Function Name: interference_matrix_dbm
+********************************************************************************
+* Summary:
+* Converts a load or a score back to dBm, rounded down, without the math
+* library.
+*
+* Parameters:
+*  float power: Power in mW relative to INTERFERENCE_FLOOR_DBM
+*
+* Return:
+*  int16_t: Power in dBm, INTERFERENCE_FLOOR_DBM if there is none
+*
+*******************************************************************************/
+int16_t interference_matrix_dbm(float power)
+{
+    int16_t db = 0;
+    uint32_t tenths = DB_PER_DECADE - 1U;
+
+    if (power < 1.0f)
+    {
+        return INTERFERENCE_FLOOR_DBM;
+    }
+
+    while (power >= 10.0f)
+    {
+        power /= 10.0f;
+        db += (int16_t)DB_PER_DECADE;
+    }
+
+    while ((tenths > 0U) && (power < tenth_decades[tenths]))
+    {
+        tenths--;
+    }
+
+    return (int16_t)(INTERFERENCE_FLOOR_DBM + db + (int16_t)tenths);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+/*******************************************************************************
+* File Name        : interference_matrix.h
+*
+* Description      : This file contains the structures and functions of the
+*                    interference matrix, which scores the co-channel and
+*                    adjacent-channel interference on every 20 MHz channel.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_INTERFERENCE_MATRIX_H_
+#define SOURCE_INTERFERENCE_MATRIX_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "bss_width.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 20 MHz channels tracked: 2.4 GHz channels 1-14, 5 GHz channels 36-64,
+ * 100-144 and 149-177, and 6 GHz channels 1-233.
+ */
+#define INTERFERENCE_2_4GHZ_CHANNELS         (14U)
+#define INTERFERENCE_5GHZ_CHANNELS           (28U)
+#define INTERFERENCE_6GHZ_CHANNELS           (59U)
+#define INTERFERENCE_CHANNELS                (INTERFERENCE_2_4GHZ_CHANNELS + \
+                                              INTERFERENCE_5GHZ_CHANNELS + \
+                                              INTERFERENCE_6GHZ_CHANNELS)
+
+/* Signal levels are clamped to this range before they are weighted. */
+#define INTERFERENCE_FLOOR_DBM               (-100)
+#define INTERFERENCE_CEILING_DBM             (-10)
+
+/* Two 20 MHz channels whose centers are closer than this interfere. */
+#define INTERFERENCE_COUPLING_MHZ            (20U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Published state of one 20 MHz channel. 'load' is the power, in mW relative
+ * to INTERFERENCE_FLOOR_DBM, of the BSSs occupying the channel, either as their
+ * primary channel or as part of a 40, 80 or 160 MHz channel. 'score' adds the
+ * power of the BSSs on overlapping 2.4 GHz channels, weighted by the overlap.
+ */
+typedef struct
+{
+    float    load;
+    float    score;
+    uint16_t bss;
+    uint16_t primary;
+} interference_channel_t;
+
+/* A channel a new BSS could use: the primary channel of a 20 MHz BSS or the
+ * center channel of a wider one. The score is the sum of the scores of the
+ * 20 MHz channels it occupies.
+ */
+typedef struct
+{
+    uint8_t  band;
+    uint8_t  channel;
+    uint16_t width_mhz;
+    float    score;
+} interference_candidate_t;
+
+/* Totals of the published sweep. */
+typedef struct
+{
+    uint32_t sweeps;
+    uint16_t bss;
+    uint16_t wide;
+    uint32_t sequence;
+} interference_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void interference_matrix_init(void);
+void interference_matrix_begin(bool full_sweep);
+void interference_matrix_observe(bool first_in_scan, uint8_t band, int16_t rssi,
+                                 const bss_width_t *bss);
+void interference_matrix_commit(uint32_t sequence);
+bool interference_matrix_channel(uint8_t band, uint8_t channel, interference_channel_t *state);
+uint32_t interference_matrix_recommend(uint8_t band, uint16_t width_mhz,
+                                       interference_candidate_t *candidates, uint32_t max);
+float interference_matrix_band_load(uint8_t band);
+void interference_matrix_stats(interference_stats_t *stats);
+int16_t interference_matrix_dbm(float power);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_INTERFERENCE_MATRIX_H_ */
+
+/* [] END OF FILE */
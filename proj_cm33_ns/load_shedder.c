@@ -0,0 +1,404 @@
+/*******************************************************************************
+* File Name        : load_shedder.c
+*
+* Description      : This file contains the load shedder. In dense places a scan can
+*                    report more BSSIDs than the per-BSSID trackers hold. Watched,
+*                    strong and repeated BSSIDs are always passed on as they arrive.
+*                    The others are held in a reservoir, weighted by signal level, and
+*                    a representative sample of them fills the remaining room when the
+*                    scan completes.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "load_shedder.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SHEDDER_RNG_SEED                     (0x9E3779B9UL)
+
+/* log2(1 + f) is approximated by f * (1 + c * (1 - f)) for f in [0, 1),
+ * within 0.005.
+ */
+#define LOG2_CORRECTION                      (0.346607f)
+#define MANTISSA_SCALE                       (2147483648.0f)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    scan_log_ap_t ap;
+    bss_width_t   bss;
+    float         key;
+} held_result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE held_result_t shedder_held[LOAD_SHEDDER_RESERVOIR_SIZE];
+static MODULE_STATE uint32_t shedder_held_count;
+static MODULE_STATE uint32_t shedder_kept;
+static MODULE_STATE uint32_t shedder_rng;
+
+static MODULE_STATE load_shedder_stats_t shedder_scan;
+static MODULE_STATE load_shedder_stats_t shedder_last;
+static MODULE_STATE load_shedder_stats_t shedder_total;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: exponential_key
+********************************************************************************
+* Summary:
+* Returns an exponentially distributed random key with rate 'weight'. Keeping
+* the results with the smallest keys samples them without replacement with
+* probabilities proportional to their weights (Efraimidis-Spirakis). The key
+* is -log2(u) / weight, computed without the math library.
+*******************************************************************************/
+static float exponential_key(float weight)
+{
+    uint32_t r = shedder_rng;
+
+    /* xorshift32 never returns 0. */
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    shedder_rng = r;
+
+    uint32_t msb = 31U - (uint32_t)__builtin_clz(r);
+    float fraction = (float)((r << (31U - msb)) & 0x7FFFFFFFUL) / MANTISSA_SCALE;
+    float log2_r = (float)msb + (fraction * (1.0f + (LOG2_CORRECTION * (1.0f - fraction))));
+
+    return (32.0f - log2_r) / weight;
+}
+
+/*******************************************************************************
+* Function Name: count_shed
+********************************************************************************
+* Summary:
+* Counts a result that is not passed on.
+*******************************************************************************/
+static void count_shed(const scan_log_ap_t *ap)
+{
+    shedder_scan.shed++;
+
+    if ((0U != ap->band) && (ap->band <= LOAD_SHEDDER_BANDS))
+    {
+        shedder_scan.shed_by_band[ap->band - 1U]++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: load_shedder_init
+********************************************************************************
+* Summary:
+* Clears the reservoir and the counts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_shedder_init(void)
+{
+    shedder_held_count = 0U;
+    shedder_kept = 0U;
+    shedder_rng = SHEDDER_RNG_SEED;
+    memset(&shedder_scan, 0, sizeof(shedder_scan));
+    memset(&shedder_last, 0, sizeof(shedder_last));
+    memset(&shedder_total, 0, sizeof(shedder_total));
+}
+
+/*******************************************************************************
+* Function Name: load_shedder_begin
+********************************************************************************
+* Summary:
+* Starts a new scan with an empty reservoir.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_shedder_begin(void)
+{
+    shedder_held_count = 0U;
+    shedder_kept = 0U;
+    memset(&shedder_scan, 0, sizeof(shedder_scan));
+}
+
+/*******************************************************************************
+* Function Name: load_shedder_offer
+********************************************************************************
+* Summary:
+* Decides whether a result is passed on now. Watched BSSIDs, results of at
+* least LOAD_SHEDDER_STRONG_RSSI_DBM and BSSIDs already passed on by this scan
+* are. Other results are held in the reservoir. When it is full, the result
+* with the largest key is shed, so the reservoir always holds a weighted
+* sample of the results so far. A result of a BSSID already held replaces it
+* if it is stronger. The cost is bounded by the size of the reservoir.
+*
+* Parameters:
+*  const scan_log_ap_t *ap: Scan result
+*  const bss_width_t *bss: Channels occupied by the BSS
+*  bool watched: true if the BSSID is on the watchlist
+*  bool repeated: true if the BSSID was already passed on by this scan
+*
+* Return:
+*  bool: true if the result must be passed on now
+*
+*******************************************************************************/
+bool load_shedder_offer(const scan_log_ap_t *ap, const bss_width_t *bss, bool watched,
+                        bool repeated)
+{
+    shedder_scan.results++;
+
+    if (repeated)
+    {
+        shedder_scan.repeated++;
+        return true;
+    }
+
+    if (watched || (ap->rssi >= LOAD_SHEDDER_STRONG_RSSI_DBM))
+    {
+        if (watched)
+        {
+            shedder_scan.watched++;
+        }
+        else
+        {
+            shedder_scan.strong++;
+        }
+
+        /* An earlier, weaker result of the BSSID is no longer needed. */
+        for (uint32_t i = 0; i < shedder_held_count; i++)
+        {
+            if (0 == memcmp(shedder_held[i].ap.bssid, ap->bssid, BSSID_LENGTH))
+            {
+                shedder_held[i] = shedder_held[--shedder_held_count];
+                shedder_scan.repeated++;
+                break;
+            }
+        }
+
+        shedder_kept++;
+        return true;
+    }
+
+    held_result_t *largest = NULL;
+
+    for (uint32_t i = 0; i < shedder_held_count; i++)
+    {
+        held_result_t *held = &shedder_held[i];
+
+        if (0 == memcmp(held->ap.bssid, ap->bssid, BSSID_LENGTH))
+        {
+            if (ap->rssi > held->ap.rssi)
+            {
+                held->ap = *ap;
+                held->bss = *bss;
+            }
+
+            shedder_scan.repeated++;
+            return false;
+        }
+
+        if ((NULL == largest) || (held->key > largest->key))
+        {
+            largest = held;
+        }
+    }
+
+    int32_t level = (int32_t)ap->rssi - LOAD_SHEDDER_FLOOR_DBM;
+    float key = exponential_key((level > 1) ? (float)level : 1.0f);
+
+    if (shedder_held_count < LOAD_SHEDDER_RESERVOIR_SIZE)
+    {
+        largest = &shedder_held[shedder_held_count++];
+    }
+    else if (key < largest->key)
+    {
+        count_shed(&largest->ap);
+    }
+    else
+    {
+        count_shed(ap);
+        return false;
+    }
+
+    largest->ap = *ap;
+    largest->bss = *bss;
+    largest->key = key;
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: load_shedder_commit
+********************************************************************************
+* Summary:
+* Completes the scan: the held results with the smallest keys fill the room
+* left by the results already passed on, up to LOAD_SHEDDER_CAPACITY BSSIDs,
+* and the others are shed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: Number of held results to pass on, see load_shedder_get
+*
+*******************************************************************************/
+uint32_t load_shedder_commit(void)
+{
+    uint32_t room = (shedder_kept < LOAD_SHEDDER_CAPACITY) ?
+                    (LOAD_SHEDDER_CAPACITY - shedder_kept) : 0U;
+
+    if (shedder_held_count > room)
+    {
+        /* Insertion sort by key; the reservoir is small. */
+        for (uint32_t i = 1; i < shedder_held_count; i++)
+        {
+            held_result_t held = shedder_held[i];
+            uint32_t j = i;
+
+            while ((j > 0U) && (shedder_held[j - 1U].key > held.key))
+            {
+                shedder_held[j] = shedder_held[j - 1U];
+                j--;
+            }
+
+            shedder_held[j] = held;
+        }
+
+        for (uint32_t i = room; i < shedder_held_count; i++)
+        {
+            count_shed(&shedder_held[i].ap);
+        }
+
+        shedder_held_count = room;
+    }
+
+    shedder_scan.scans = 1U;
+    shedder_scan.sampled = shedder_held_count;
+    shedder_scan.overloaded = (0U != shedder_scan.shed) ? 1U : 0U;
+
+    shedder_total.scans += shedder_scan.scans;
+    shedder_total.overloaded += shedder_scan.overloaded;
+    shedder_total.results += shedder_scan.results;
+    shedder_total.watched += shedder_scan.watched;
+    shedder_total.strong += shedder_scan.strong;
+    shedder_total.repeated += shedder_scan.repeated;
+    shedder_total.sampled += shedder_scan.sampled;
+    shedder_total.shed += shedder_scan.shed;
+
+    for (uint32_t b = 0; b < LOAD_SHEDDER_BANDS; b++)
+    {
+        shedder_total.shed_by_band[b] += shedder_scan.shed_by_band[b];
+    }
+
+    shedder_last = shedder_scan;
+
+    return shedder_held_count;
+}
+
+/*******************************************************************************
+* Function Name: load_shedder_get
+********************************************************************************
+* Summary:
+* Returns a held result to pass on after load_shedder_commit.
+*
+* Parameters:
+*  uint32_t index: Index of the result, below the count load_shedder_commit
+*                  returned
+*  scan_log_ap_t *ap: Receives the scan result
+*  bss_width_t *bss: Receives the channels occupied by the BSS
+*
+* Return:
+*  bool: false if the index is out of range
+*
+*******************************************************************************/
+bool load_shedder_get(uint32_t index, scan_log_ap_t *ap, bss_width_t *bss)
+{
+    if (index >= shedder_held_count)
+    {
+        return false;
+    }
+
+    *ap = shedder_held[index].ap;
+    *bss = shedder_held[index].bss;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: load_shedder_stats
+********************************************************************************
+* Summary:
+* Returns the counts of the last completed scan and since startup.
+*
+* Parameters:
+*  load_shedder_stats_t *last: Receives the counts of the last scan, may be NULL
+*  load_shedder_stats_t *total: Receives the counts since startup, may be NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_shedder_stats(load_shedder_stats_t *last, load_shedder_stats_t *total)
+{
+    if (NULL != last)
+    {
+        *last = shedder_last;
+    }
+
+    if (NULL != total)
+    {
+        *total = shedder_total;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* File Name        : load_shedder.h
+*
+* Description      : This file contains the structures and functions of the load
+*                    shedder, which bounds the number of BSSIDs a scan adds to the
+*                    per-BSSID trackers.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_LOAD_SHEDDER_H_
+#define SOURCE_LOAD_SHEDDER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_log_format.h"
+#include "bss_width.h"
+#include "bssid_table.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* BSSIDs a scan may add to the trackers, so that the BSSIDs of one scan never
+ * recycle each other in the BSSID table.
+ */
+#define LOAD_SHEDDER_CAPACITY                (BSSID_TABLE_MAX_ENTRIES)
+
+/* Other results held until the scan completes, which then fill the room the
+ * kept results leave.
+ */
+#define LOAD_SHEDDER_RESERVOIR_SIZE          (BSSID_TABLE_MAX_ENTRIES)
+
+/* Results at least this strong are always kept. */
+#define LOAD_SHEDDER_STRONG_RSSI_DBM         (-60)
+
+/* Sampling weights are the signal level in dB above this floor. */
+#define LOAD_SHEDDER_FLOOR_DBM               (-100)
+
+#define LOAD_SHEDDER_BANDS                   (3U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Counts of results. Kept results are watched, strong or repeated BSSIDs,
+ * passed on as they arrive. Sampled results are the others that were passed
+ * on when the scan completed; shed results were not passed on at all, and are
+ * also counted by band (cy_wcm_wifi_band_t - 1).
+ */
+typedef struct
+{
+    uint32_t scans;
+    uint32_t overloaded;
+    uint32_t results;
+    uint32_t watched;
+    uint32_t strong;
+    uint32_t repeated;
+    uint32_t sampled;
+    uint32_t shed;
+    uint32_t shed_by_band[LOAD_SHEDDER_BANDS];
+} load_shedder_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void load_shedder_init(void);
+void load_shedder_begin(void);
+bool load_shedder_offer(const scan_log_ap_t *ap, const bss_width_t *bss, bool watched,
+                        bool repeated);
+uint32_t load_shedder_commit(void);
+bool load_shedder_get(uint32_t index, scan_log_ap_t *ap, bss_width_t *bss);
+void load_shedder_stats(load_shedder_stats_t *last, load_shedder_stats_t *total);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_LOAD_SHEDDER_H_ */
+
+/* [] END OF FILE */
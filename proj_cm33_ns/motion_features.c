@@ -0,0 +1,390 @@
+/*******************************************************************************
+* File Name        : motion_features.c
+*
+* Description      : This file contains the motion features. Every MOTION_HOP samples,
+*                    the last MOTION_WINDOW samples of each link are reduced to their
+*                    variance, the energy of their first difference and the share of
+*                    their energy in the motion band, computed with a DFT restricted
+*                    to the bins of the band. The largest variance is compared to a
+*                    threshold with hysteresis.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "motion_features.h"
+#include "motion_kernels.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define Q15_ONE                              (32767.0)
+/* The DFT sums are scaled down by this shift before squaring. Dropping all
+ * 15 fraction bits would round away the band energy of a quiet window.
+ */
+#define DFT_SHIFT                            (8)
+#define DFT_SCALE_SHIFT                      (2 * (15 - DFT_SHIFT))
+#define PERCENT                              (100U)
+#define TWO_PI                               (6.283185307179586)
+#define SERIES_TERMS                         (8U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    int16_t  samples[MOTION_WINDOW];
+    bool     missed[MOTION_WINDOW];
+    int16_t  last;
+    bool     valid;
+} link_window_t;
+
+static MODULE_STATE link_window_t motion_windows[MOTION_MAX_LINKS];
+static MODULE_STATE uint32_t motion_links;
+static MODULE_STATE uint32_t motion_head;
+static MODULE_STATE uint32_t motion_count;
+static MODULE_STATE uint32_t motion_since_evaluation;
+static MODULE_STATE uint32_t motion_threshold_q4 = MOTION_DEFAULT_THRESHOLD_Q4;
+static MODULE_STATE uint32_t motion_quiet_evaluations;
+static MODULE_STATE bool motion_detected;
+
+/* Cosine and sine of the band bins in Q15, computed once. */
+static MODULE_STATE int16_t band_cos[MOTION_BAND_BINS][MOTION_WINDOW];
+static MODULE_STATE int16_t band_sin[MOTION_BAND_BINS][MOTION_WINDOW];
+static MODULE_STATE bool band_tables_ready;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: to_q15
+********************************************************************************
+* Summary:
+* Rounds a value between -1 and 1 to Q15.
+*******************************************************************************/
+static int16_t to_q15(double value)
+{
+    return (int16_t)((value * Q15_ONE) + ((value < 0.0) ? -0.5 : 0.5));
+}
+
+/*******************************************************************************
+* Function Name: build_band_tables
+********************************************************************************
+* Summary:
+* Computes the DFT coefficients of the motion band. The unit circle is walked
+* in steps of 2 * pi / MOTION_WINDOW, with the cosine and sine of the step
+* taken from their series, so that no math library is needed.
+*******************************************************************************/
+static void build_band_tables(void)
+{
+    double step = TWO_PI / (double)MOTION_WINDOW;
+    double step_cos = 1.0;
+    double step_sin = step;
+    double term_cos = 1.0;
+    double term_sin = step;
+    double unit_cos[MOTION_WINDOW];
+    double unit_sin[MOTION_WINDOW];
+    double c = 1.0;
+    double s = 0.0;
+
+    for (uint32_t i = 1; i <= SERIES_TERMS; i++)
+    {
+        term_cos *= -(step * step) / (double)((2U * i - 1U) * (2U * i));
+        term_sin *= -(step * step) / (double)((2U * i) * (2U * i + 1U));
+        step_cos += term_cos;
+        step_sin += term_sin;
+    }
+
+    for (uint32_t n = 0; n < MOTION_WINDOW; n++)
+    {
+        double next_c = (c * step_cos) - (s * step_sin);
+
+        unit_cos[n] = c;
+        unit_sin[n] = s;
+        s = (c * step_sin) + (s * step_cos);
+        c = next_c;
+    }
+
+    for (uint32_t b = 0; b < MOTION_BAND_BINS; b++)
+    {
+        uint32_t k = MOTION_BAND_FIRST_BIN + b;
+
+        for (uint32_t n = 0; n < MOTION_WINDOW; n++)
+        {
+            band_cos[b][n] = to_q15(unit_cos[(k * n) % MOTION_WINDOW]);
+            band_sin[b][n] = to_q15(unit_sin[(k * n) % MOTION_WINDOW]);
+        }
+    }
+
+    band_tables_ready = true;
+}
+
+/*******************************************************************************
+* Function Name: evaluate_link
+********************************************************************************
+* Summary:
+* Computes the features of the window of one link.
+*******************************************************************************/
+static void evaluate_link(uint32_t link, motion_features_result_t *result)
+{
+    const link_window_t *window = &motion_windows[link];
+    int16_t ordered[MOTION_WINDOW];
+    uint32_t misses = 0;
+    int32_t sum;
+    int32_t sum_sq;
+
+    /* Oldest sample first, so that the phase of the DFT is consistent. */
+    for (uint32_t i = 0; i < MOTION_WINDOW; i++)
+    {
+        uint32_t index = (motion_head + i) % MOTION_WINDOW;
+
+        ordered[i] = window->samples[index];
+        misses += window->missed[index] ? 1U : 0U;
+    }
+
+    motion_kernel_sums(ordered, MOTION_WINDOW, &sum, &sum_sq);
+
+    int64_t spread = ((int64_t)MOTION_WINDOW * sum_sq) - ((int64_t)sum * sum);
+
+    result->variance_q4[link] = (uint32_t)((spread * MOTION_Q4_ONE) /
+                                           ((int64_t)MOTION_WINDOW * MOTION_WINDOW));
+    result->diff_q4[link] = (uint32_t)(((int64_t)motion_kernel_diff_energy(ordered, MOTION_WINDOW) *
+                                        MOTION_Q4_ONE) / (MOTION_WINDOW - 1U));
+    result->misses[link] = (uint8_t)misses;
+
+    /* Remove the mean, then compare the energy of the band bins to the total
+     * energy given by Parseval's theorem. Each band bin stands for itself and
+     * its mirror image, hence the factor of two.
+     */
+    int16_t mean = (int16_t)((sum >= 0) ? ((sum + (int32_t)(MOTION_WINDOW / 2U)) / (int32_t)MOTION_WINDOW) :
+                                          ((sum - (int32_t)(MOTION_WINDOW / 2U)) / (int32_t)MOTION_WINDOW));
+
+    motion_kernel_offset(ordered, mean, ordered, MOTION_WINDOW);
+    motion_kernel_sums(ordered, MOTION_WINDOW, &sum, &sum_sq);
+
+    int64_t band = 0;
+
+    for (uint32_t b = 0; b < MOTION_BAND_BINS; b++)
+    {
+        int64_t re = motion_kernel_dot(ordered, band_cos[b], MOTION_WINDOW) >> DFT_SHIFT;
+        int64_t im = motion_kernel_dot(ordered, band_sin[b], MOTION_WINDOW) >> DFT_SHIFT;
+
+        band += (re * re) + (im * im);
+    }
+
+    /* The mean was rounded to whole dB, so its remainder is removed here. */
+    int64_t total = (((int64_t)MOTION_WINDOW * sum_sq) - ((int64_t)sum * sum)) << DFT_SCALE_SHIFT;
+    uint32_t percent = 0;
+
+    if (total > 0)
+    {
+        percent = (uint32_t)((2 * PERCENT * band) / total);
+    }
+
+    result->band_percent[link] = (uint8_t)((percent > PERCENT) ? PERCENT : percent);
+
+    if (misses <= MOTION_MAX_MISSES)
+    {
+        result->scored_links++;
+
+        if (result->variance_q4[link] > result->score_q4)
+        {
+            result->score_q4 = result->variance_q4[link];
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: motion_features_init
+********************************************************************************
+* Summary:
+* Clears the windows and the motion state. The threshold is kept.
+*
+* Parameters:
+*  uint32_t links: Number of links sampled, 1 to MOTION_MAX_LINKS
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_features_init(uint32_t links)
+{
+    if (!band_tables_ready)
+    {
+        build_band_tables();
+    }
+
+    memset(motion_windows, 0, sizeof(motion_windows));
+    motion_links = (links > MOTION_MAX_LINKS) ? MOTION_MAX_LINKS : links;
+    motion_head = 0;
+    motion_count = 0;
+    motion_since_evaluation = 0;
+    motion_quiet_evaluations = 0;
+    motion_detected = false;
+}
+
+/*******************************************************************************
+* Function Name: motion_features_set_threshold
+********************************************************************************
+* Summary:
+* Sets the variance at which motion is detected.
+*
+* Parameters:
+*  uint32_t threshold_q4: Threshold in 1/16 dB^2
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_features_set_threshold(uint32_t threshold_q4)
+{
+    motion_threshold_q4 = threshold_q4;
+}
+
+/*******************************************************************************
+* Function Name: motion_features_threshold
+********************************************************************************
+* Summary:
+* Returns the variance at which motion is detected.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: Threshold in 1/16 dB^2
+*
+*******************************************************************************/
+uint32_t motion_features_threshold(void)
+{
+    return motion_threshold_q4;
+}
+
+/*******************************************************************************
+* Function Name: motion_features_push
+********************************************************************************
+* Summary:
+* Adds one sample of every link. Once the windows are full, the features are
+* evaluated every MOTION_HOP samples.
+*
+* Parameters:
+*  const int16_t *rssi: RSSI of each link in dBm, or MOTION_NO_SAMPLE
+*  motion_features_result_t *result: Features, set if true is returned
+*
+* Return:
+*  bool: true if the features were evaluated
+*
+*******************************************************************************/
+bool motion_features_push(const int16_t *rssi, motion_features_result_t *result)
+{
+    for (uint32_t link = 0; link < motion_links; link++)
+    {
+        link_window_t *window = &motion_windows[link];
+        bool missed = (MOTION_NO_SAMPLE == rssi[link]);
+
+        if (!missed)
+        {
+            /* Back-fill the window with the first answer of a link so that
+             * the samples missed before it do not read as a step.
+             */
+            if (!window->valid)
+            {
+                for (uint32_t i = 0; i < MOTION_WINDOW; i++)
+                {
+                    window->samples[i] = rssi[link];
+                }
+            }
+
+            window->last = rssi[link];
+            window->valid = true;
+        }
+
+        window->samples[motion_head] = window->last;
+        window->missed[motion_head] = missed;
+    }
+
+    motion_head = (motion_head + 1U) % MOTION_WINDOW;
+
+    if (motion_count < MOTION_WINDOW)
+    {
+        motion_count++;
+    }
+
+    if ((motion_count < MOTION_WINDOW) || (++motion_since_evaluation < MOTION_HOP))
+    {
+        return false;
+    }
+
+    motion_since_evaluation = 0;
+    memset(result, 0, sizeof(*result));
+
+    for (uint32_t link = 0; link < motion_links; link++)
+    {
+        evaluate_link(link, result);
+    }
+
+    bool was_detected = motion_detected;
+
+    if ((result->scored_links > 0U) && (result->score_q4 >= motion_threshold_q4))
+    {
+        motion_detected = true;
+        motion_quiet_evaluations = 0;
+    }
+    else if (motion_detected &&
+             ((result->scored_links == 0U) ||
+              ((result->score_q4 * PERCENT) < (motion_threshold_q4 * MOTION_EXIT_PERCENT))))
+    {
+        if (++motion_quiet_evaluations >= MOTION_HOLD_EVALUATIONS)
+        {
+            motion_detected = false;
+            motion_quiet_evaluations = 0;
+        }
+    }
+    else
+    {
+        motion_quiet_evaluations = 0;
+    }
+
+    result->motion = motion_detected;
+    result->changed = (was_detected != motion_detected);
+
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,128 @@
+/*******************************************************************************
+* File Name        : motion_features.h
+*
+* Description      : This file contains the structures and function prototypes of the
+*                    motion features, which turn windows of RSSI samples of a few links
+*                    into variance and spectral features and a motion decision.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_MOTION_FEATURES_H_
+#define SOURCE_MOTION_FEATURES_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of links (BSSIDs) sampled together. */
+#define MOTION_MAX_LINKS                     (3U)
+
+/* Samples per window and samples between two evaluations. The window is a
+ * power of two so that the DFT bins below fall on exact frequencies.
+ */
+#define MOTION_WINDOW                        (32U)
+#define MOTION_HOP                           (8U)
+
+/* DFT bins of the motion band. Bin k is at k * rate / MOTION_WINDOW, so at
+ * 10 samples per second bins 2 to 7 cover 0.6 Hz to 2.2 Hz, the range of a
+ * person walking or waving in front of a link.
+ */
+#define MOTION_BAND_FIRST_BIN                (2U)
+#define MOTION_BAND_LAST_BIN                 (7U)
+#define MOTION_BAND_BINS                     (MOTION_BAND_LAST_BIN - MOTION_BAND_FIRST_BIN + 1U)
+
+/* Sample value of a link that did not answer. The previous sample is held. */
+#define MOTION_NO_SAMPLE                     (INT16_MIN)
+
+/* A link that missed more samples than this in a window is not scored. */
+#define MOTION_MAX_MISSES                    (MOTION_WINDOW / 4U)
+
+/* Variances are in units of 1/16 dB^2. Motion starts when the score reaches
+ * the threshold and stops after MOTION_HOLD_EVALUATIONS evaluations below
+ * MOTION_EXIT_PERCENT of the threshold.
+ */
+#define MOTION_Q4_ONE                        (16U)
+#define MOTION_DEFAULT_THRESHOLD_Q4          (2U * MOTION_Q4_ONE)
+#define MOTION_EXIT_PERCENT                  (50U)
+#define MOTION_HOLD_EVALUATIONS              (2U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Features of one evaluation. band_percent is the share of the signal
+ * energy, without its mean, in the motion band. score_q4 is the largest
+ * variance of the scored links.
+ */
+typedef struct
+{
+    uint32_t variance_q4[MOTION_MAX_LINKS];
+    uint32_t diff_q4[MOTION_MAX_LINKS];
+    uint8_t  band_percent[MOTION_MAX_LINKS];
+    uint8_t  misses[MOTION_MAX_LINKS];
+    uint8_t  scored_links;
+    uint32_t score_q4;
+    bool     motion;
+    bool     changed;
+} motion_features_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void motion_features_init(uint32_t links);
+void motion_features_set_threshold(uint32_t threshold_q4);
+uint32_t motion_features_threshold(void);
+bool motion_features_push(const int16_t *rssi, motion_features_result_t *result);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_MOTION_FEATURES_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,164 @@
+/*******************************************************************************
+* File Name        : motion_kernels.c
+*
+* Description      : This file contains the signal kernels of the motion sensor: sums,
+*                    first-difference energy, dot products and offset removal over
+*                    windows of 16-bit samples, with 32-bit accumulators. The same
+*                    code is built for the firmware and the host tools.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "motion_kernels.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: motion_kernel_sums
+********************************************************************************
+* Summary:
+* Computes the sum and the sum of squares of a window.
+*
+* Parameters:
+*  const int16_t *x: Samples
+*  uint32_t n: Number of samples
+*  int32_t *sum: Sum of the samples
+*  int32_t *sum_sq: Sum of the squared samples
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_kernel_sums(const int16_t *x, uint32_t n, int32_t *sum, int32_t *sum_sq)
+{
+    int32_t s = 0;
+    int32_t s2 = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        s += x[i];
+        s2 += (int32_t)x[i] * x[i];
+    }
+
+    *sum = s;
+    *sum_sq = s2;
+}
+
+/*******************************************************************************
+* Function Name: motion_kernel_diff_energy
+********************************************************************************
+* Summary:
+* Computes the energy of the first difference of a window, the sum of
+* (x[i + 1] - x[i])^2. It is large when the samples change quickly.
+*
+* Parameters:
+*  const int16_t *x: Samples
+*  uint32_t n: Number of samples
+*
+* Return:
+*  int32_t: Energy of the first difference
+*
+*******************************************************************************/
+int32_t motion_kernel_diff_energy(const int16_t *x, uint32_t n)
+{
+    int32_t e = 0;
+
+    for (uint32_t i = 1; i < n; i++)
+    {
+        int32_t d = (int32_t)x[i] - x[i - 1U];
+
+        e += d * d;
+    }
+
+    return e;
+}
+
+/*******************************************************************************
+* Function Name: motion_kernel_dot
+********************************************************************************
+* Summary:
+* Computes the dot product of two windows.
+*
+* Parameters:
+*  const int16_t *x: First window
+*  const int16_t *y: Second window
+*  uint32_t n: Number of samples
+*
+* Return:
+*  int32_t: Dot product
+*
+*******************************************************************************/
+int32_t motion_kernel_dot(const int16_t *x, const int16_t *y, uint32_t n)
+{
+    int32_t acc = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        acc += (int32_t)x[i] * y[i];
+    }
+
+    return acc;
+}
+
+/*******************************************************************************
+* Function Name: motion_kernel_offset
+********************************************************************************
+* Summary:
+* Subtracts a constant from every sample of a window.
+*
+* Parameters:
+*  const int16_t *x: Samples
+*  int16_t offset: Value to subtract
+*  int16_t *out: Result, may be equal to x
+*  uint32_t n: Number of samples
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_kernel_offset(const int16_t *x, int16_t offset, int16_t *out, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out[i] = (int16_t)(x[i] - offset);
+    }
+}
+
+/* [] END OF FILE */
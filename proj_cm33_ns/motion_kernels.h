@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name        : motion_kernels.h
+*
+* Description      : This file contains the function prototypes of the signal kernels
+*                    of the motion sensor. The kernels work on 16-bit samples with
+*                    32-bit accumulators.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_MOTION_KERNELS_H_
+#define SOURCE_MOTION_KERNELS_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The 32-bit accumulators cannot overflow for samples of up to 8 bits of
+ * magnitude multiplied by Q15 coefficients over up to this many elements.
+ */
+#define MOTION_KERNELS_MAX_LENGTH            (256U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void motion_kernel_sums(const int16_t *x, uint32_t n, int32_t *sum, int32_t *sum_sq);
+int32_t motion_kernel_diff_energy(const int16_t *x, uint32_t n);
+int32_t motion_kernel_dot(const int16_t *x, const int16_t *y, uint32_t n);
+void motion_kernel_offset(const int16_t *x, int16_t offset, int16_t *out, uint32_t n);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_MOTION_KERNELS_H_ */
+
+/* [] END OF FILE */
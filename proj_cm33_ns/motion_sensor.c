@@ -0,0 +1,490 @@
+/*******************************************************************************
+* File Name        : motion_sensor.c
+*
+* Description      : This file contains the motion sensor. It picks up to
+*                    MOTION_MAX_LINKS strong APs with a high stability score that
+*                    share a channel, then samples them every
+*                    MOTION_SAMPLE_PERIOD_MS with one directed probe of that channel.
+*                    The samples are fed to the motion features, and the interval
+*                    between samples is measured with the cycle counter to report the
+*                    jitter of the sampling.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <inttypes.h>
+#include <string.h>
+#include "motion_sensor.h"
+#include "bssid_stability.h"
+#include "directed_probe.h"
+#include "channel_plan.h"
+#include "perf_counter.h"
+#include "snapshot_ring.h"
+#include "scan_task.h"
+#include "retarget_io_init.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_MS                            (1000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sensor state, protected by the scan data lock. */
+static motion_status_t motion_state;
+static bool motion_trace;
+static uint32_t motion_trace_us;
+
+/* Samples of the probe in progress, written by the probe handler while the
+ * scan task waits for the probe.
+ */
+static uint8_t probe_links[MOTION_MAX_LINKS][BSSID_LENGTH];
+static uint32_t probe_link_count;
+static volatile int16_t probe_samples[MOTION_MAX_LINKS];
+
+/* Last full sweep, used to pick the links. */
+static snapshot_ring_ap_t motion_candidates[SNAPSHOT_RING_DICT_SIZE];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: probe_handler
+********************************************************************************
+* Summary:
+* Records the RSSI of the links that answered a sampling probe.
+*******************************************************************************/
+static void probe_handler(const uint8_t *bssid, int16_t rssi, void *user_data)
+{
+    CY_UNUSED_PARAMETER(user_data);
+
+    for (uint32_t i = 0; i < probe_link_count; i++)
+    {
+        if ((0 == memcmp(bssid, probe_links[i], BSSID_LENGTH)) &&
+            ((MOTION_NO_SAMPLE == probe_samples[i]) || (rssi > probe_samples[i])))
+        {
+            probe_samples[i] = rssi;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: is_stable
+********************************************************************************
+* Summary:
+* Returns true if a BSSID of the last full sweep can be used as a link. Its
+* channel must be probed actively: a passive probe takes longer than the
+* sample period.
+*******************************************************************************/
+static bool is_stable(const snapshot_ring_ap_t *ap)
+{
+    return (ap->rssi >= MOTION_MIN_RSSI_DBM) &&
+           (CHANNEL_PLAN_ACTIVE == channel_plan_lookup(ap->channel)) &&
+           (bssid_stability_score(ap->bssid) >= MOTION_MIN_STABILITY);
+}
+
+/*******************************************************************************
+* Function Name: print_motion_event
+********************************************************************************
+* Summary:
+* Reports the start or the end of motion.
+*******************************************************************************/
+static void print_motion_event(bool motion, uint32_t score_q4)
+{
+    APP_INFO(("Motion %s, variance %"PRIu32".%02"PRIu32" dB^2\n",
+              motion ? "detected" : "ended", score_q4 / MOTION_Q4_ONE,
+              ((score_q4 % MOTION_Q4_ONE) * 100U) / MOTION_Q4_ONE));
+}
+
+/*******************************************************************************
+* Function Name: print_trace
+********************************************************************************
+* Summary:
+* Prints the time in microseconds and the samples of one probe. A link that
+* did not answer has an empty field.
+*******************************************************************************/
+static void print_trace(uint32_t time_us, const int16_t *samples, uint32_t links)
+{
+    printf(MOTION_TRACE_PREFIX "%"PRIu32, time_us);
+
+    for (uint32_t i = 0; i < links; i++)
+    {
+        if (MOTION_NO_SAMPLE == samples[i])
+        {
+            printf(",");
+        }
+        else
+        {
+            printf(",%d", samples[i]);
+        }
+    }
+
+    printf("\n");
+}
+
+/*******************************************************************************
+* Function Name: motion_sensor_init
+********************************************************************************
+* Summary:
+* Stops the sensor.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_sensor_init(void)
+{
+    memset(&motion_state, 0, sizeof(motion_state));
+}
+
+/*******************************************************************************
+* Function Name: motion_sensor_start
+********************************************************************************
+* Summary:
+* Picks the links from the last full sweep and starts sampling them. The strongest
+* stable AP of the last full sweep sets the channel, and the strongest stable
+* APs on the same channel are added to it. Must be called with the scan data
+* lock.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: false if there is no full sweep or no stable AP
+*
+*******************************************************************************/
+bool motion_sensor_start(void)
+{
+    snapshot_ring_info_t info;
+    uint32_t count = 0;
+    uint32_t age = 0;
+
+    while (snapshot_ring_get(age, &info, NULL, 0U) &&
+           (0U == (info.flags & SNAPSHOT_RING_FLAG_FULL_SWEEP)))
+    {
+        age++;
+    }
+
+    if (!snapshot_ring_get(age, &info, motion_candidates, SNAPSHOT_RING_DICT_SIZE))
+    {
+        return false;
+    }
+
+    count = (info.ap_count < SNAPSHOT_RING_DICT_SIZE) ? info.ap_count : SNAPSHOT_RING_DICT_SIZE;
+
+    memset(&motion_state, 0, sizeof(motion_state));
+
+    /* Selection by repeated maximum: the links are few and the sweep is
+     * small, and picked candidates are disqualified by clearing their RSSI.
+     */
+    while (motion_state.links < MOTION_MAX_LINKS)
+    {
+        snapshot_ring_ap_t *best = NULL;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            snapshot_ring_ap_t *ap = &motion_candidates[i];
+
+            if (((0U == motion_state.links) || (ap->channel == motion_state.channel)) &&
+                is_stable(ap) && ((NULL == best) || (ap->rssi > best->rssi)))
+            {
+                best = ap;
+            }
+        }
+
+        if (NULL == best)
+        {
+            break;
+        }
+
+        motion_link_t *link = &motion_state.link[motion_state.links++];
+
+        memcpy(link->bssid, best->bssid, BSSID_LENGTH);
+        link->rssi = best->rssi;
+        motion_state.channel = best->channel;
+        best->rssi = INT8_MIN;
+    }
+
+    if (0U == motion_state.links)
+    {
+        return false;
+    }
+
+    motion_features_init(motion_state.links);
+    motion_state.active = true;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: motion_sensor_stop
+********************************************************************************
+* Summary:
+* Stops sampling. Must be called with the scan data lock.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_sensor_stop(void)
+{
+    motion_state.active = false;
+    motion_state.motion = false;
+}
+
+/*******************************************************************************
+* Function Name: motion_sensor_active
+********************************************************************************
+* Summary:
+* Returns true if the sensor is sampling.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if the sensor is sampling
+*
+*******************************************************************************/
+bool motion_sensor_active(void)
+{
+    scan_data_lock();
+    bool active = motion_state.active;
+    scan_data_unlock();
+
+    return active;
+}
+
+/*******************************************************************************
+* Function Name: motion_sensor_status
+********************************************************************************
+* Summary:
+* Copies the state of the sensor. Must be called with the scan data lock.
+*
+* Parameters:
+*  motion_status_t *status: Copy of the state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_sensor_status(motion_status_t *status)
+{
+    *status = motion_state;
+}
+
+/*******************************************************************************
+* Function Name: motion_sensor_set_trace
+********************************************************************************
+* Summary:
+* Enables or disables the printing of every sample. Must be called with the
+* scan data lock.
+*
+* Parameters:
+*  bool enable: true to print the samples
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_sensor_set_trace(bool enable)
+{
+    motion_trace = enable;
+    motion_trace_us = 0;
+}
+
+/*******************************************************************************
+* Function Name: motion_sensor_run
+********************************************************************************
+* Summary:
+* Samples the links every MOTION_SAMPLE_PERIOD_MS until the time to spend has
+* elapsed or the sensor is stopped. The wake-up times are absolute, so the
+* duration of a probe does not shift the following samples.
+*
+* Parameters:
+*  uint32_t period_ms: Time to spend
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void motion_sensor_run(uint32_t period_ms)
+{
+    const uint32_t period_us = MOTION_SAMPLE_PERIOD_MS * US_PER_MS;
+    TickType_t wake = xTaskGetTickCount();
+    TickType_t start = wake;
+    uint32_t last = 0;
+    bool first = true;
+    uint8_t channel;
+
+    while (((xTaskGetTickCount() - start) * portTICK_PERIOD_MS) < period_ms)
+    {
+        scan_data_lock();
+
+        bool active = motion_state.active;
+
+        channel = motion_state.channel;
+        probe_link_count = motion_state.links;
+
+        for (uint32_t i = 0; i < probe_link_count; i++)
+        {
+            memcpy(probe_links[i], motion_state.link[i].bssid, BSSID_LENGTH);
+            probe_samples[i] = MOTION_NO_SAMPLE;
+        }
+
+        scan_data_unlock();
+
+        if (!active)
+        {
+            break;
+        }
+
+        uint32_t now = perf_counter_now();
+        uint32_t interval_us = perf_counter_to_ns(now - last) / PERF_COUNTER_NS_PER_US;
+
+        bool probed = directed_probe_run(channel, NULL, MOTION_PROBE_DWELL_MS, probe_handler,
+                                         NULL);
+
+        uint32_t probe_us = perf_counter_to_ns(perf_counter_now() - now) / PERF_COUNTER_NS_PER_US;
+        int16_t samples[MOTION_MAX_LINKS];
+        motion_features_result_t features;
+        bool evaluated;
+        bool changed = false;
+        bool trace = false;
+        bool answered = false;
+
+        for (uint32_t i = 0; i < probe_link_count; i++)
+        {
+            samples[i] = probe_samples[i];
+            answered = answered || (MOTION_NO_SAMPLE != samples[i]);
+        }
+
+        scan_data_lock();
+
+        /* The sensor may have been restarted from the console during the
+         * probe, in which case the samples belong to other links.
+         */
+        bool same = motion_state.active && (motion_state.channel == channel);
+
+        if (same && (!probed) && (!answered))
+        {
+            /* The radio was busy or the probe timed out. This is not a
+             * sample in which no link answered, so none is taken.
+             */
+            motion_state.failed++;
+        }
+        else if (same)
+        {
+            if (!first)
+            {
+                uint32_t jitter_us = (interval_us > period_us) ? (interval_us - period_us) :
+                                                                 (period_us - interval_us);
+
+                motion_state.intervals++;
+                motion_state.total_jitter_us += jitter_us;
+
+                if (jitter_us > motion_state.max_jitter_us)
+                {
+                    motion_state.max_jitter_us = jitter_us;
+                }
+
+                if ((2U * interval_us) > (3U * period_us))
+                {
+                    motion_state.overruns++;
+                }
+            }
+
+            if (probe_us > motion_state.max_probe_us)
+            {
+                motion_state.max_probe_us = probe_us;
+            }
+
+            for (uint32_t i = 0; i < motion_state.links; i++)
+            {
+                if (MOTION_NO_SAMPLE != samples[i])
+                {
+                    motion_state.link[i].rssi = samples[i];
+                    motion_state.link[i].answers++;
+                }
+            }
+
+            motion_state.samples++;
+            trace = motion_trace;
+
+            /* The trace time advances by the measured interval, so that the
+             * jitter can be reproduced on the host.
+             */
+            motion_trace_us += first ? period_us : interval_us;
+            evaluated = motion_features_push(samples, &features);
+
+            if (evaluated)
+            {
+                motion_state.features = features;
+                changed = features.changed;
+                motion_state.motion = features.motion;
+                motion_state.events += changed ? 1U : 0U;
+            }
+        }
+
+        scan_data_unlock();
+
+        if (trace)
+        {
+            print_trace(motion_trace_us, samples, probe_link_count);
+        }
+
+        if (changed)
+        {
+            print_motion_event(features.motion, features.score_q4);
+        }
+
+        last = now;
+        first = false;
+
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(MOTION_SAMPLE_PERIOD_MS));
+    }
+}
+
+/* [] END OF FILE */
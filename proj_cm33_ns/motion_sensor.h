@@ -0,0 +1,137 @@
+/*******************************************************************************
+* File Name        : motion_sensor.h
+*
+* Description      : This file contains the structures and function prototypes of the
+*                    motion sensor, which samples the RSSI of a few strong, stable APs
+*                    at a fixed rate and detects the fluctuations caused by motion.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_MOTION_SENSOR_H_
+#define SOURCE_MOTION_SENSOR_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "bssid_table.h"
+#include "motion_features.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Sampling period. One directed probe of the channel of the links is started
+ * every period, so the period must exceed the probe time.
+ */
+#define MOTION_SAMPLE_PERIOD_MS              (100U)
+
+/* Active dwell time of a sampling probe. */
+#define MOTION_PROBE_DWELL_MS                (15U)
+
+/* Time between full sweeps while sensing. Sampling pauses during a sweep. */
+#define MOTION_SWEEP_PERIOD_MS               (60000U)
+
+/* A link must have at least this stability score (see bssid_stability.h)
+ * and be at least this strong in the last full sweep.
+ */
+#define MOTION_MIN_STABILITY                 (60U)
+#define MOTION_MIN_RSSI_DBM                  (-75)
+
+/* Prefix of the sample lines printed while tracing. A capture of the UART
+ * can be replayed on the host with tools/host/motion_replay.c.
+ */
+#define MOTION_TRACE_PREFIX                  "#MT "
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint8_t  bssid[BSSID_LENGTH];
+    int16_t  rssi;
+    uint32_t answers;
+} motion_link_t;
+
+/* State of the motion sensor. The jitter is the deviation of the interval
+ * between two samples from MOTION_SAMPLE_PERIOD_MS. An overrun is an interval
+ * longer than 1.5 periods. Intervals across a full sweep are not counted.
+ * 'failed' counts the probes that could not run, which give no sample.
+ */
+typedef struct
+{
+    bool     active;
+    bool     motion;
+    uint8_t  channel;
+    uint8_t  links;
+    motion_link_t link[MOTION_MAX_LINKS];
+    uint32_t samples;
+    uint32_t failed;
+    uint32_t intervals;
+    uint32_t overruns;
+    uint64_t total_jitter_us;
+    uint32_t max_jitter_us;
+    uint32_t max_probe_us;
+    uint32_t events;
+    motion_features_result_t features;
+} motion_status_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void motion_sensor_init(void);
+bool motion_sensor_start(void);
+void motion_sensor_stop(void);
+bool motion_sensor_active(void);
+void motion_sensor_status(motion_status_t *status);
+void motion_sensor_set_trace(bool enable);
+void motion_sensor_run(uint32_t period_ms);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_MOTION_SENSOR_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,712 @@
+/*******************************************************************************
+* File Name        : occupancy_buckets.c
+*
+* Description      : This file contains the time-of-day occupancy buckets. The
+*                    unfiltered sweeps of an hour are accumulated and, when the hour
+*                    is over, folded into the bucket of that hour of the week as an
+*                    average over the weeks. The buckets tell how many BSSIDs, how
+*                    much load and which networks to expect, and how volatile the
+*                    environment is, at any time of the week.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "occupancy_buckets.h"
+#include "interference_matrix.h"
+#include "hash_service.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SECONDS_PER_HOUR                     (3600U)
+
+/* 1 January 1970 was a Thursday. */
+#define EPOCH_DAY_OF_WEEK                    (4U)
+
+#define Q4_SHIFT                             (4U)
+#define Q2_TO_Q4_SHIFT                       (2U)
+
+#define SSID_HASH_NONE                       (0U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t hash;
+    uint32_t count;
+} ssid_counter_t;
+
+/* Totals of the sweeps of the hour in progress. */
+typedef struct
+{
+    uint32_t hour;
+    uint32_t sweeps;
+    uint32_t aps[OCCUPANCY_BANDS];
+    uint64_t total_squares;
+    uint32_t churn;
+    int32_t  rssi_sum;
+    uint32_t rssi_count;
+    uint32_t load_db[OCCUPANCY_BANDS];
+    ssid_counter_t ssids[OCCUPANCY_SSID_COUNTERS];
+} hour_totals_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE occupancy_bucket_t occupancy_buckets[OCCUPANCY_BUCKETS];
+static MODULE_STATE uint32_t occupancy_hours_folded;
+static MODULE_STATE hour_totals_t occupancy_hour;
+static MODULE_STATE bool occupancy_folded;
+
+static MODULE_STATE bool occupancy_full_sweep;
+static MODULE_STATE uint32_t occupancy_sweep_aps[OCCUPANCY_BANDS];
+static MODULE_STATE int32_t occupancy_sweep_rssi_sum;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bucket_of_hour
+********************************************************************************
+* Summary:
+* Returns the bucket of an hour counted from the epoch in local time.
+*******************************************************************************/
+static uint32_t bucket_of_hour(uint32_t hour)
+{
+    uint32_t day = ((hour / OCCUPANCY_HOURS) + EPOCH_DAY_OF_WEEK) % OCCUPANCY_DAYS;
+
+    return (day * OCCUPANCY_HOURS) + (hour % OCCUPANCY_HOURS);
+}
+
+/*******************************************************************************
+* Function Name: local_hour
+********************************************************************************
+* Summary:
+* Returns the number of hours from the epoch to a time, in local time.
+*******************************************************************************/
+static uint32_t local_hour(uint32_t now_s)
+{
+    return (uint32_t)((int64_t)now_s + OCCUPANCY_UTC_OFFSET_S) / SECONDS_PER_HOUR;
+}
+
+/*******************************************************************************
+* Function Name: isqrt
+********************************************************************************
+* Summary:
+* Returns the integer square root of a number, rounded down.
+*******************************************************************************/
+static uint32_t isqrt(uint32_t value)
+{
+    uint32_t root = 0U;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (0U != bit)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/*******************************************************************************
+* Function Name: saturate_u8
+********************************************************************************
+* Summary:
+* Rounds a Q value to an integer after a right shift and saturates it to 255.
+*******************************************************************************/
+static uint8_t saturate_u8(uint32_t value, uint32_t shift)
+{
+    uint32_t rounded = (0U != shift) ? ((value + (1UL << (shift - 1U))) >> shift) : value;
+
+    return (rounded > UINT8_MAX) ? UINT8_MAX : (uint8_t)rounded;
+}
+
+/*******************************************************************************
+* Function Name: blend
+********************************************************************************
+* Summary:
+* Moves an averaged value towards the value of a new week.
+*******************************************************************************/
+static int32_t blend(int32_t average, int32_t value)
+{
+    return average + ((value - average) / (int32_t)(1L << OCCUPANCY_WEEK_SHIFT));
+}
+
+/*******************************************************************************
+* Function Name: count_ssid
+********************************************************************************
+* Summary:
+* Counts an SSID with the Space-Saving algorithm: when no counter is free, the
+* least counted SSID is replaced and its count inherited, so an SSID seen more
+* than 1 / OCCUPANCY_SSID_COUNTERS of the time is never missed.
+*******************************************************************************/
+static void count_ssid(uint32_t hash)
+{
+    ssid_counter_t *least = &occupancy_hour.ssids[0];
+
+    for (uint32_t i = 0; i < OCCUPANCY_SSID_COUNTERS; i++)
+    {
+        ssid_counter_t *counter = &occupancy_hour.ssids[i];
+
+        if ((counter->hash == hash) || (0U == counter->count))
+        {
+            counter->hash = hash;
+            counter->count++;
+            return;
+        }
+
+        if (counter->count < least->count)
+        {
+            least = counter;
+        }
+    }
+
+    least->hash = hash;
+    least->count++;
+}
+
+/*******************************************************************************
+* Function Name: fold_hour
+********************************************************************************
+* Summary:
+* Folds the totals of the hour in progress into the bucket of that hour.
+*******************************************************************************/
+static void fold_hour(void)
+{
+    occupancy_bucket_t *bucket = &occupancy_buckets[bucket_of_hour(occupancy_hour.hour)];
+    occupancy_bucket_t week;
+    uint32_t sweeps = occupancy_hour.sweeps;
+    uint32_t total = 0U;
+
+    memset(&week, 0, sizeof(week));
+
+    for (uint32_t b = 0; b < OCCUPANCY_BANDS; b++)
+    {
+        week.aps_q4[b] = (uint16_t)(((occupancy_hour.aps[b] << Q4_SHIFT) + (sweeps / 2U)) / sweeps);
+        week.load_db[b] = (uint8_t)(occupancy_hour.load_db[b] / sweeps);
+        total += occupancy_hour.aps[b];
+    }
+
+    /* Variance in Q8: mean of the squares minus the square of the mean. */
+    uint32_t mean_q4 = (total << Q4_SHIFT) / sweeps;
+    uint64_t squares_q8 = (occupancy_hour.total_squares << (2U * Q4_SHIFT)) / sweeps;
+    uint64_t mean_squared_q8 = (uint64_t)mean_q4 * mean_q4;
+
+    week.spread_q4 = (uint16_t)isqrt((squares_q8 > mean_squared_q8) ?
+                                     (uint32_t)(squares_q8 - mean_squared_q8) : 0U);
+    week.churn_q4 = (uint16_t)((occupancy_hour.churn << Q4_SHIFT) / sweeps);
+    week.rssi = (0U != occupancy_hour.rssi_count) ?
+                (int8_t)(occupancy_hour.rssi_sum / (int32_t)occupancy_hour.rssi_count) :
+                INT8_MIN;
+
+    /* Most seen SSIDs, by selection from the few counters. */
+    for (uint32_t t = 0; t < OCCUPANCY_TOP_SSIDS; t++)
+    {
+        ssid_counter_t *best = NULL;
+
+        for (uint32_t i = 0; i < OCCUPANCY_SSID_COUNTERS; i++)
+        {
+            ssid_counter_t *counter = &occupancy_hour.ssids[i];
+
+            if ((0U != counter->count) && ((NULL == best) || (counter->count > best->count)))
+            {
+                best = counter;
+            }
+        }
+
+        if (NULL != best)
+        {
+            week.top_ssids[t] = best->hash;
+            best->count = 0U;
+        }
+    }
+
+    if (0U == bucket->visits)
+    {
+        *bucket = week;
+    }
+    else
+    {
+        for (uint32_t b = 0; b < OCCUPANCY_BANDS; b++)
+        {
+            bucket->aps_q4[b] = (uint16_t)blend(bucket->aps_q4[b], week.aps_q4[b]);
+            bucket->load_db[b] = (uint8_t)blend(bucket->load_db[b], week.load_db[b]);
+        }
+
+        bucket->spread_q4 = (uint16_t)blend(bucket->spread_q4, week.spread_q4);
+        bucket->churn_q4 = (uint16_t)blend(bucket->churn_q4, week.churn_q4);
+
+        if (INT8_MIN != week.rssi)
+        {
+            bucket->rssi = (INT8_MIN == bucket->rssi) ? week.rssi :
+                           (int8_t)blend(bucket->rssi, week.rssi);
+        }
+
+        memcpy(bucket->top_ssids, week.top_ssids, sizeof(bucket->top_ssids));
+    }
+
+    if (bucket->visits < UINT8_MAX)
+    {
+        bucket->visits++;
+    }
+
+    occupancy_hours_folded++;
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_init
+********************************************************************************
+* Summary:
+* Clears the buckets.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void occupancy_buckets_init(void)
+{
+    memset(occupancy_buckets, 0, sizeof(occupancy_buckets));
+    memset(&occupancy_hour, 0, sizeof(occupancy_hour));
+    occupancy_hours_folded = 0U;
+    occupancy_folded = false;
+    occupancy_full_sweep = false;
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_begin
+********************************************************************************
+* Summary:
+* Starts a new scan. If the hour of the sweeps accumulated so far is over, it
+* is folded into its bucket, so a sweep counts towards the hour it starts in.
+* Filtered scans do not see every BSSID and are not counted.
+*
+* Parameters:
+*  bool full_sweep: true if the scan covered all channels without filter
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void occupancy_buckets_begin(bool full_sweep, uint32_t now_s)
+{
+    uint32_t hour = local_hour(now_s);
+
+    if ((0U != occupancy_hour.sweeps) && (hour != occupancy_hour.hour))
+    {
+        fold_hour();
+        memset(&occupancy_hour, 0, sizeof(occupancy_hour));
+        occupancy_folded = true;
+    }
+
+    if (0U == occupancy_hour.sweeps)
+    {
+        occupancy_hour.hour = hour;
+    }
+
+    occupancy_full_sweep = full_sweep;
+    occupancy_sweep_rssi_sum = 0;
+    memset(occupancy_sweep_aps, 0, sizeof(occupancy_sweep_aps));
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_observe
+********************************************************************************
+* Summary:
+* Counts a BSSID of the scan in progress in its band and its SSID, unless it
+* is hidden.
+*
+* Parameters:
+*  bool first_in_scan: false if the BSSID was already reported by this scan
+*  const scan_log_ap_t *ap: Scan result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void occupancy_buckets_observe(bool first_in_scan, const scan_log_ap_t *ap)
+{
+    if ((!occupancy_full_sweep) || (!first_in_scan) || (0U == ap->band) ||
+        (ap->band > OCCUPANCY_BANDS))
+    {
+        return;
+    }
+
+    occupancy_sweep_aps[ap->band - 1U]++;
+    occupancy_sweep_rssi_sum += ap->rssi;
+
+    uint32_t hash = occupancy_buckets_ssid_hash(ap->ssid, ap->ssid_length);
+
+    if (SSID_HASH_NONE != hash)
+    {
+        count_ssid(hash);
+    }
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_commit
+********************************************************************************
+* Summary:
+* Adds the scan to the hour in progress, with the band loads of the
+* interference matrix, which must be committed first.
+*
+* Parameters:
+*  uint16_t churn: BSSIDs appeared or disappeared since the previous sweep
+*
+* Return:
+*  bool: true if an hour was folded into its bucket since the previous call
+*
+*******************************************************************************/
+bool occupancy_buckets_commit(uint16_t churn)
+{
+    bool folded = occupancy_folded;
+
+    if (occupancy_full_sweep)
+    {
+        uint32_t total = 0U;
+
+        for (uint32_t b = 0; b < OCCUPANCY_BANDS; b++)
+        {
+            int16_t dbm = interference_matrix_dbm(interference_matrix_band_load((uint8_t)(b + 1U)));
+
+            occupancy_hour.aps[b] += occupancy_sweep_aps[b];
+            occupancy_hour.load_db[b] += (uint32_t)(dbm - INTERFERENCE_FLOOR_DBM);
+            total += occupancy_sweep_aps[b];
+        }
+
+        occupancy_hour.total_squares += (uint64_t)total * total;
+        occupancy_hour.churn += churn;
+        occupancy_hour.rssi_sum += occupancy_sweep_rssi_sum;
+        occupancy_hour.rssi_count += total;
+        occupancy_hour.sweeps++;
+        occupancy_full_sweep = false;
+    }
+
+    occupancy_folded = false;
+
+    return folded;
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_index
+********************************************************************************
+* Summary:
+* Returns the bucket of a time.
+*
+* Parameters:
+*  uint32_t now_s: Time in seconds
+*
+* Return:
+*  uint32_t: Bucket, day * OCCUPANCY_HOURS + hour, day 0 is Sunday
+*
+*******************************************************************************/
+uint32_t occupancy_buckets_index(uint32_t now_s)
+{
+    return bucket_of_hour(local_hour(now_s));
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_get
+********************************************************************************
+* Summary:
+* Returns a bucket.
+*
+* Parameters:
+*  uint32_t index: Bucket, day * OCCUPANCY_HOURS + hour
+*  occupancy_bucket_t *bucket: Receives the bucket
+*
+* Return:
+*  bool: false if the index is out of range or the hour was never seen
+*
+*******************************************************************************/
+bool occupancy_buckets_get(uint32_t index, occupancy_bucket_t *bucket)
+{
+    if ((index >= OCCUPANCY_BUCKETS) || (0U == occupancy_buckets[index].visits))
+    {
+        return false;
+    }
+
+    *bucket = occupancy_buckets[index];
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_scan_delay_ms
+********************************************************************************
+* Summary:
+* Adapts the delay between sweeps to the volatility of the current hour in
+* the previous weeks: BSSIDs appearing, disappearing or deviating from the
+* mean, relative to the number of BSSIDs. Volatile hours are scanned more
+* often and quiet ones less.
+*
+* Parameters:
+*  uint32_t base_ms: Delay between sweeps
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  uint32_t: Adapted delay in milliseconds
+*
+*******************************************************************************/
+uint32_t occupancy_buckets_scan_delay_ms(uint32_t base_ms, uint32_t now_s)
+{
+    const occupancy_bucket_t *bucket = &occupancy_buckets[occupancy_buckets_index(now_s)];
+    uint32_t total_q4 = 0U;
+
+    if (bucket->visits < OCCUPANCY_MIN_VISITS)
+    {
+        return base_ms;
+    }
+
+    for (uint32_t b = 0; b < OCCUPANCY_BANDS; b++)
+    {
+        total_q4 += bucket->aps_q4[b];
+    }
+
+    uint32_t permille = (((uint32_t)bucket->churn_q4 + bucket->spread_q4) * 1000U) /
+                        ((total_q4 > (1UL << Q4_SHIFT)) ? total_q4 : (1UL << Q4_SHIFT));
+    uint32_t delay_ms = (permille >= OCCUPANCY_VERY_VOLATILE_PERMILLE) ? (base_ms / 4U) :
+                        (permille >= OCCUPANCY_VOLATILE_PERMILLE) ? (base_ms / 2U) :
+                        (permille < OCCUPANCY_QUIET_PERMILLE) ? (base_ms * 2U) : base_ms;
+
+    return (delay_ms < OCCUPANCY_MIN_DELAY_MS) ? OCCUPANCY_MIN_DELAY_MS : delay_ms;
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_ssid_hash
+********************************************************************************
+* Summary:
+* Returns the FNV-1a hash of an SSID, as stored in the buckets.
+*
+* Parameters:
+*  const uint8_t *ssid: SSID bytes
+*  uint8_t length: SSID length
+*
+* Return:
+*  uint32_t: Hash, 0 for a hidden SSID
+*
+*******************************************************************************/
+uint32_t occupancy_buckets_ssid_hash(const uint8_t *ssid, uint8_t length)
+{
+    uint32_t hash = hash_service_fnv1a32(ssid, length);
+    bool hidden = true;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        hidden &= (0U == ssid[i]);
+    }
+
+    if (hidden)
+    {
+        return SSID_HASH_NONE;
+    }
+
+    return (SSID_HASH_NONE == hash) ? 1U : hash;
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_encode
+********************************************************************************
+* Summary:
+* Encodes the visited buckets as an occupancy record (see scan_log_format.h).
+* The record keeps whole BSSID counts and quarters of the spread and churn.
+*
+* Parameters:
+*  uint8_t *record: Buffer of the record
+*  uint32_t size: Size of the buffer, at least OCCUPANCY_MAX_RECORD_SIZE
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  uint32_t: Length of the record, 0 if the buffer is too small
+*
+*******************************************************************************/
+uint32_t occupancy_buckets_encode(uint8_t *record, uint32_t size, uint32_t now_s)
+{
+    uint32_t length = SCAN_LOG_HEADER_SIZE;
+    uint16_t count = 0U;
+
+    if (size < OCCUPANCY_MAX_RECORD_SIZE)
+    {
+        return 0U;
+    }
+
+    for (uint32_t i = 0; i < OCCUPANCY_BUCKETS; i++)
+    {
+        const occupancy_bucket_t *bucket = &occupancy_buckets[i];
+        uint8_t *p = &record[length];
+
+        if (0U == bucket->visits)
+        {
+            continue;
+        }
+
+        p[SCAN_LOG_OCCUPANCY_OFFSET_BUCKET] = (uint8_t)i;
+        p[SCAN_LOG_OCCUPANCY_OFFSET_VISITS] = bucket->visits;
+
+        for (uint32_t b = 0; b < OCCUPANCY_BANDS; b++)
+        {
+            p[SCAN_LOG_OCCUPANCY_OFFSET_APS + b] = saturate_u8(bucket->aps_q4[b], Q4_SHIFT);
+            p[SCAN_LOG_OCCUPANCY_OFFSET_LOAD + b] = bucket->load_db[b];
+        }
+
+        p[SCAN_LOG_OCCUPANCY_OFFSET_SPREAD] = saturate_u8(bucket->spread_q4, Q2_TO_Q4_SHIFT);
+        p[SCAN_LOG_OCCUPANCY_OFFSET_CHURN] = saturate_u8(bucket->churn_q4, Q2_TO_Q4_SHIFT);
+        p[SCAN_LOG_OCCUPANCY_OFFSET_RSSI] = (uint8_t)bucket->rssi;
+
+        for (uint32_t t = 0; t < OCCUPANCY_TOP_SSIDS; t++)
+        {
+            scan_log_put_u32(p + SCAN_LOG_OCCUPANCY_OFFSET_SSIDS + (t * sizeof(uint32_t)),
+                             bucket->top_ssids[t]);
+        }
+
+        length += SCAN_LOG_OCCUPANCY_ENTRY_SIZE;
+        count++;
+    }
+
+    memset(record, 0, SCAN_LOG_HEADER_SIZE);
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_MAGIC], SCAN_LOG_OCCUPANCY_MAGIC);
+    record[SCAN_LOG_OFFSET_VERSION] = SCAN_LOG_VERSION;
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_LENGTH], (uint16_t)length);
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_AP_COUNT], count);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_SEQUENCE], occupancy_hours_folded);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_TIMESTAMP], now_s);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_CRC],
+                     scan_log_crc32(&record[SCAN_LOG_HEADER_SIZE],
+                                    length - SCAN_LOG_HEADER_SIZE));
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: occupancy_buckets_restore
+********************************************************************************
+* Summary:
+* Replaces the buckets with those of an occupancy record, for example the one
+* last persisted. The hour in progress is kept.
+*
+* Parameters:
+*  const uint8_t *record: Occupancy record
+*  uint32_t length: Length of the record
+*
+* Return:
+*  bool: false if the record is not a valid occupancy record
+*
+*******************************************************************************/
+bool occupancy_buckets_restore(const uint8_t *record, uint32_t length)
+{
+    if ((length < SCAN_LOG_HEADER_SIZE) ||
+        (SCAN_LOG_OCCUPANCY_MAGIC != scan_log_get_u16(&record[SCAN_LOG_OFFSET_MAGIC])) ||
+        (SCAN_LOG_VERSION != record[SCAN_LOG_OFFSET_VERSION]))
+    {
+        return false;
+    }
+
+    uint16_t count = scan_log_get_u16(&record[SCAN_LOG_OFFSET_AP_COUNT]);
+
+    if ((length != scan_log_get_u16(&record[SCAN_LOG_OFFSET_LENGTH])) ||
+        (length != (SCAN_LOG_HEADER_SIZE + ((uint32_t)count * SCAN_LOG_OCCUPANCY_ENTRY_SIZE))) ||
+        (scan_log_get_u32(&record[SCAN_LOG_OFFSET_CRC]) !=
+         scan_log_crc32(&record[SCAN_LOG_HEADER_SIZE], length - SCAN_LOG_HEADER_SIZE)))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint8_t *p = &record[SCAN_LOG_HEADER_SIZE + (i * SCAN_LOG_OCCUPANCY_ENTRY_SIZE)];
+
+        if ((p[SCAN_LOG_OCCUPANCY_OFFSET_BUCKET] >= OCCUPANCY_BUCKETS) ||
+            (0U == p[SCAN_LOG_OCCUPANCY_OFFSET_VISITS]))
+        {
+            return false;
+        }
+    }
+
+    memset(occupancy_buckets, 0, sizeof(occupancy_buckets));
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint8_t *p = &record[SCAN_LOG_HEADER_SIZE + (i * SCAN_LOG_OCCUPANCY_ENTRY_SIZE)];
+        occupancy_bucket_t *bucket = &occupancy_buckets[p[SCAN_LOG_OCCUPANCY_OFFSET_BUCKET]];
+
+        bucket->visits = p[SCAN_LOG_OCCUPANCY_OFFSET_VISITS];
+
+        for (uint32_t b = 0; b < OCCUPANCY_BANDS; b++)
+        {
+            bucket->aps_q4[b] = (uint16_t)(p[SCAN_LOG_OCCUPANCY_OFFSET_APS + b] << Q4_SHIFT);
+            bucket->load_db[b] = p[SCAN_LOG_OCCUPANCY_OFFSET_LOAD + b];
+        }
+
+        bucket->spread_q4 = (uint16_t)(p[SCAN_LOG_OCCUPANCY_OFFSET_SPREAD] << Q2_TO_Q4_SHIFT);
+        bucket->churn_q4 = (uint16_t)(p[SCAN_LOG_OCCUPANCY_OFFSET_CHURN] << Q2_TO_Q4_SHIFT);
+        bucket->rssi = (int8_t)p[SCAN_LOG_OCCUPANCY_OFFSET_RSSI];
+
+        for (uint32_t t = 0; t < OCCUPANCY_TOP_SSIDS; t++)
+        {
+            bucket->top_ssids[t] = scan_log_get_u32(p + SCAN_LOG_OCCUPANCY_OFFSET_SSIDS +
+                                                    (t * sizeof(uint32_t)));
+        }
+    }
+
+    occupancy_hours_folded = scan_log_get_u32(&record[SCAN_LOG_OFFSET_SEQUENCE]);
+
+    return true;
+}
+
+/* [] END OF FILE */
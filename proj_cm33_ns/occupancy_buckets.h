@@ -0,0 +1,147 @@
+/*******************************************************************************
+* File Name        : occupancy_buckets.h
+*
+* Description      : This file contains the structures and functions of the
+*                    time-of-day occupancy buckets, which summarize the scans of every
+*                    hour of the week.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_OCCUPANCY_BUCKETS_H_
+#define SOURCE_OCCUPANCY_BUCKETS_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_log_format.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define OCCUPANCY_HOURS                      (24U)
+#define OCCUPANCY_DAYS                       (7U)
+#define OCCUPANCY_BUCKETS                    (OCCUPANCY_HOURS * OCCUPANCY_DAYS)
+
+/* 2.4 GHz, 5 GHz and 6 GHz, indexed by cy_wcm_wifi_band_t - 1. */
+#define OCCUPANCY_BANDS                      (3U)
+#define OCCUPANCY_TOP_SSIDS                  (3U)
+
+/* SSIDs counted during an hour to find the most seen ones. */
+#define OCCUPANCY_SSID_COUNTERS              (8U)
+
+/* Offset of the local time from the RTC time, which is taken as UTC. */
+#define OCCUPANCY_UTC_OFFSET_S               (0)
+
+/* Weight of a new week in the buckets: 1 / 2^shift. */
+#define OCCUPANCY_WEEK_SHIFT                 (2U)
+
+/* Number of times an hour must have been seen before it changes the scan
+ * delay, and the volatility, in BSSIDs appeared, disappeared or deviating
+ * from the mean per 1000 BSSIDs, at which the delay is doubled, halved or
+ * quartered.
+ */
+#define OCCUPANCY_MIN_VISITS                 (2U)
+#define OCCUPANCY_QUIET_PERMILLE             (20U)
+#define OCCUPANCY_VOLATILE_PERMILLE          (100U)
+#define OCCUPANCY_VERY_VOLATILE_PERMILLE     (250U)
+#define OCCUPANCY_MIN_DELAY_MS               (1000U)
+
+/* Hours folded between two writes of the buckets to the storage. */
+#define OCCUPANCY_PERSIST_HOURS              (6U)
+
+#define OCCUPANCY_MAX_RECORD_SIZE            (SCAN_LOG_HEADER_SIZE + \
+                                              (OCCUPANCY_BUCKETS * SCAN_LOG_OCCUPANCY_ENTRY_SIZE))
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* One hour of the week, averaged over the weeks it was seen. Values in Q4 are
+ * in 1/16. The spread is the standard deviation of the number of BSSIDs
+ * during the hour, and the churn the number of BSSIDs appeared or disappeared
+ * per sweep. The band loads are in dB above INTERFERENCE_FLOOR_DBM. The top
+ * SSIDs are FNV-1a hashes, most seen first, from the last week.
+ */
+typedef struct
+{
+    uint8_t  visits;
+    uint16_t aps_q4[OCCUPANCY_BANDS];
+    uint16_t spread_q4;
+    uint16_t churn_q4;
+    int8_t   rssi;
+    uint8_t  load_db[OCCUPANCY_BANDS];
+    uint32_t top_ssids[OCCUPANCY_TOP_SSIDS];
+} occupancy_bucket_t;
+
+/* Persistent storage of the buckets. 'load' copies the last stored record to
+ * the buffer and returns its length, 0 if there is none.
+ */
+typedef struct
+{
+    uint32_t (*load)(uint8_t *record, uint32_t size);
+    bool (*store)(const uint8_t *record, uint32_t length);
+} occupancy_storage_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void occupancy_buckets_init(void);
+void occupancy_buckets_begin(bool full_sweep, uint32_t now_s);
+void occupancy_buckets_observe(bool first_in_scan, const scan_log_ap_t *ap);
+bool occupancy_buckets_commit(uint16_t churn);
+uint32_t occupancy_buckets_index(uint32_t now_s);
+bool occupancy_buckets_get(uint32_t index, occupancy_bucket_t *bucket);
+uint32_t occupancy_buckets_scan_delay_ms(uint32_t base_ms, uint32_t now_s);
+uint32_t occupancy_buckets_ssid_hash(const uint8_t *ssid, uint8_t length);
+uint32_t occupancy_buckets_encode(uint8_t *record, uint32_t size, uint32_t now_s);
+bool occupancy_buckets_restore(const uint8_t *record, uint32_t length);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_OCCUPANCY_BUCKETS_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,125 @@
+/*******************************************************************************
+* File Name        : perf_counter.h
+*
+* Description      : This file contains the inline functions used to time code
+*                    sections with the CPU cycle counter, or with the monotonic
+*                    clock when the sources are built on a host.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_PERF_COUNTER_H_
+#define SOURCE_PERF_COUNTER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+
+#if defined(__ARM_ARCH)
+#include "cybsp.h"
+#else
+#include <time.h>
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PERF_COUNTER_NS_PER_US               (1000U)
+#define PERF_COUNTER_NS_PER_S                (1000000000ULL)
+
+/*******************************************************************************
+* Inline functions
+*******************************************************************************/
+#if defined(__ARM_ARCH)
+
+/* Enables the DWT cycle counter. */
+static inline void perf_counter_init(void)
+{
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* Returns the current count in CPU cycles. */
+static inline uint32_t perf_counter_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+/* Converts a difference of two counts to nanoseconds. */
+static inline uint32_t perf_counter_to_ns(uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * PERF_COUNTER_NS_PER_S) / SystemCoreClock);
+}
+
+#else
+
+static inline void perf_counter_init(void)
+{
+}
+
+static inline uint32_t perf_counter_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * PERF_COUNTER_NS_PER_S) +
+                      (uint64_t)ts.tv_nsec);
+}
+
+static inline uint32_t perf_counter_to_ns(uint32_t ticks)
+{
+    return ticks;
+}
+
+#endif /* defined(__ARM_ARCH) */
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_PERF_COUNTER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,318 @@
+/*******************************************************************************
+* File Name        : planned_sweep.c
+*
+* Description      : This file contains the planned sweep. It scans the active
+*                    channel list of a channel plan with probe requests and then
+*                    listens on the passive channel list, and hands the results to
+*                    the scan callback as cy_wcm_start_scan would.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "planned_sweep.h"
+#include "bssid_table.h"
+#include "retarget_io_init.h"
+#include "semphr.h"
+#include "whd_wifi_api.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DWELL_DEFAULT                        (-1)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sweep in progress. The results are converted and filtered on the WHD thread
+ * while the scan task waits on sweep_done.
+ */
+static whd_interface_t sweep_ifp;
+static SemaphoreHandle_t sweep_done;
+static whd_scan_result_t sweep_result;
+static whd_scan_extended_params_t sweep_params;
+static cy_wcm_scan_result_t sweep_converted;
+static const cy_wcm_scan_filter_t *sweep_filter;
+static cy_wcm_scan_result_callback_t sweep_callback_fn;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: convert_band
+********************************************************************************
+* Summary:
+* Converts a WHD band to the WCM band.
+*******************************************************************************/
+static cy_wcm_wifi_band_t convert_band(whd_802_11_band_t band)
+{
+    switch (band)
+    {
+        case WHD_802_11_BAND_2_4GHZ:
+            return CY_WCM_WIFI_BAND_2_4GHZ;
+
+        case WHD_802_11_BAND_5GHZ:
+            return CY_WCM_WIFI_BAND_5GHZ;
+
+        case WHD_802_11_BAND_6GHZ:
+            return CY_WCM_WIFI_BAND_6GHZ;
+
+        default:
+            return CY_WCM_WIFI_BAND_ANY;
+    }
+}
+
+/*******************************************************************************
+* Function Name: passes_filter
+********************************************************************************
+* Summary:
+* Applies the scan filter to a converted result, as WCM does for its scans.
+* The band filter is already applied through the channel lists.
+*******************************************************************************/
+static bool passes_filter(const cy_wcm_scan_result_t *result)
+{
+    if (NULL == sweep_filter)
+    {
+        return true;
+    }
+
+    switch (sweep_filter->mode)
+    {
+        case CY_WCM_SCAN_FILTER_TYPE_SSID:
+            return (0 == strcmp((const char *)result->SSID,
+                                (const char *)sweep_filter->param.SSID));
+
+        case CY_WCM_SCAN_FILTER_TYPE_MAC:
+            return (0 == memcmp(result->BSSID, sweep_filter->param.BSSID, BSSID_LENGTH));
+
+        case CY_WCM_SCAN_FILTER_TYPE_RSSI:
+            return (result->signal_strength >= (int16_t)sweep_filter->param.rssi_range);
+
+        default:
+            return true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: sweep_callback
+********************************************************************************
+* Summary:
+* WHD scan callback of a pass. Converts each result to a WCM scan result,
+* forwards it to the scan callback if it passes the filter and signals the
+* completion of the pass.
+*
+* Parameters:
+*  whd_scan_result_t **result_ptr: Pointer to the scan result
+*  void *user_data: User data (unused)
+*  whd_scan_status_t status: Status of the scan
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sweep_callback(whd_scan_result_t **result_ptr, void *user_data,
+                           whd_scan_status_t status)
+{
+    CY_UNUSED_PARAMETER(user_data);
+
+    if (WHD_SCAN_INCOMPLETE != status)
+    {
+        xSemaphoreGive(sweep_done);
+        return;
+    }
+
+    if ((NULL == result_ptr) || (NULL == *result_ptr))
+    {
+        return;
+    }
+
+    const whd_scan_result_t *result = *result_ptr;
+    uint8_t ssid_length = (result->SSID.length < sizeof(result->SSID.value)) ?
+                          result->SSID.length : (uint8_t)sizeof(result->SSID.value);
+
+    memset(&sweep_converted, 0, sizeof(sweep_converted));
+    memcpy(sweep_converted.SSID, result->SSID.value, ssid_length);
+    memcpy(sweep_converted.BSSID, result->BSSID.octet, BSSID_LENGTH);
+    sweep_converted.signal_strength = result->signal_strength;
+    sweep_converted.max_data_rate = result->max_data_rate;
+    sweep_converted.bss_type = (cy_wcm_bss_type_t)result->bss_type;
+
+    /* The WCM security types have the values of the WHD ones. */
+    sweep_converted.security = (cy_wcm_security_t)result->security;
+    sweep_converted.channel = result->channel;
+    sweep_converted.band = convert_band(result->band);
+    memcpy(sweep_converted.ccode, result->ccode, sizeof(sweep_converted.ccode));
+    sweep_converted.flags = result->flags;
+    sweep_converted.ie_ptr = result->ie_ptr;
+    sweep_converted.ie_len = result->ie_len;
+
+    if (passes_filter(&sweep_converted))
+    {
+        sweep_callback_fn(&sweep_converted, NULL, CY_WCM_SCAN_INCOMPLETE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_pass
+********************************************************************************
+* Summary:
+* Scans one channel list and blocks until the scan completes or times out.
+*******************************************************************************/
+static bool run_pass(whd_scan_type_t type, const uint16_t *channels)
+{
+    whd_ssid_t ssid;
+    whd_mac_t mac;
+    const whd_ssid_t *optional_ssid = NULL;
+    const whd_mac_t *optional_mac = NULL;
+
+    /* The SSID and MAC filters restrict the probe requests as well. */
+    if ((NULL != sweep_filter) && (CY_WCM_SCAN_FILTER_TYPE_SSID == sweep_filter->mode))
+    {
+        ssid.length = (uint8_t)strnlen((const char *)sweep_filter->param.SSID,
+                                       sizeof(ssid.value));
+        memcpy(ssid.value, sweep_filter->param.SSID, ssid.length);
+        optional_ssid = &ssid;
+    }
+    else if ((NULL != sweep_filter) && (CY_WCM_SCAN_FILTER_TYPE_MAC == sweep_filter->mode))
+    {
+        memcpy(mac.octet, sweep_filter->param.BSSID, BSSID_LENGTH);
+        optional_mac = &mac;
+    }
+
+    /* Drop a completion left over from a pass that timed out. */
+    (void)xSemaphoreTake(sweep_done, 0U);
+
+    if (WHD_SUCCESS != whd_wifi_scan(sweep_ifp, type, WHD_BSS_TYPE_ANY, optional_ssid,
+                                     optional_mac, channels, &sweep_params,
+                                     sweep_callback, &sweep_result, NULL))
+    {
+        return false;
+    }
+
+    if (pdTRUE != xSemaphoreTake(sweep_done, pdMS_TO_TICKS(PLANNED_SWEEP_PASS_TIMEOUT_MS)))
+    {
+        whd_wifi_stop_scan(sweep_ifp);
+        (void)xSemaphoreTake(sweep_done, pdMS_TO_TICKS(PLANNED_SWEEP_PASS_TIMEOUT_MS));
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: planned_sweep_init
+********************************************************************************
+* Summary:
+* Gets the WHD interface used for the planned sweeps. Must be called after
+* cy_wcm_init().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void planned_sweep_init(void)
+{
+    sweep_done = xSemaphoreCreateBinary();
+
+    if (NULL == sweep_done)
+    {
+        handle_app_error();
+    }
+
+    if (CY_RSLT_SUCCESS != cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &sweep_ifp))
+    {
+        handle_app_error();
+    }
+
+    sweep_params.number_of_probes_per_channel = DWELL_DEFAULT;
+    sweep_params.scan_active_dwell_time_per_channel_ms = CHANNEL_PLAN_ACTIVE_DWELL_MS;
+    sweep_params.scan_passive_dwell_time_per_channel_ms = CHANNEL_PLAN_PASSIVE_DWELL_MS;
+    sweep_params.scan_home_channel_dwell_time_between_channels_ms = DWELL_DEFAULT;
+}
+
+/*******************************************************************************
+* Function Name: planned_sweep_run
+********************************************************************************
+* Summary:
+* Scans the active channels of a plan with probe requests, then listens on
+* its passive channels, and blocks until both passes complete. Each result
+* that passes the filter is handed to the callback with
+* CY_WCM_SCAN_INCOMPLETE, followed by CY_WCM_SCAN_COMPLETE at the end, so
+* the callback of cy_wcm_start_scan can be used unchanged. Must be called from
+* the scan task.
+*
+* Parameters:
+*  const channel_plan_t *plan: Channel lists to scan
+*  const cy_wcm_scan_filter_t *filter: Scan filter, or NULL
+*  cy_wcm_scan_result_callback_t callback: Scan callback
+*
+* Return:
+*  bool: false if no pass could be started, in which case the callback is
+*        not called
+*
+*******************************************************************************/
+bool planned_sweep_run(const channel_plan_t *plan, const cy_wcm_scan_filter_t *filter,
+                       cy_wcm_scan_result_callback_t callback)
+{
+    bool started = false;
+
+    sweep_filter = filter;
+    sweep_callback_fn = callback;
+
+    if (0U != plan->active_count)
+    {
+        started |= run_pass(WHD_SCAN_TYPE_ACTIVE, plan->active);
+    }
+
+    if (0U != plan->passive_count)
+    {
+        started |= run_pass(WHD_SCAN_TYPE_PASSIVE, plan->passive);
+    }
+
+    if (started)
+    {
+        callback(NULL, NULL, CY_WCM_SCAN_COMPLETE);
+    }
+
+    return started;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* File Name        : planned_sweep.h
+*
+* Description      : This file contains the functions of the planned sweep, which
+*                    scans the channel lists of the channel planner.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_PLANNED_SWEEP_H_
+#define SOURCE_PLANNED_SWEEP_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include "cy_wcm.h"
+#include "channel_plan.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A pass of a planned sweep that has not completed after this time is
+ * aborted. It covers every channel of the plan at the passive dwell time.
+ */
+#define PLANNED_SWEEP_PASS_TIMEOUT_MS        (CHANNEL_PLAN_MAX_CHANNELS * \
+                                              CHANNEL_PLAN_PASSIVE_DWELL_MS * 2U)
+
+/* While the plan includes the 6 GHz band, which the planned channel lists
+ * cannot describe, every this many sweeps is a default sweep instead.
+ */
+#define PLANNED_SWEEP_6GHZ_INTERVAL          (4U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void planned_sweep_init(void);
+bool planned_sweep_run(const channel_plan_t *plan, const cy_wcm_scan_filter_t *filter,
+                       cy_wcm_scan_result_callback_t callback);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_PLANNED_SWEEP_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,581 @@
+/*******************************************************************************
+* File Name        : presence_tracker.c
+*
+* Description      : This file contains the presence tracker. Between full sweeps,
+*                    the scan task probes each watchlisted BSSID round robin with a
+*                    directed probe restricted to the BSSID and its channel.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "presence_tracker.h"
+#include "directed_probe.h"
+#include "channel_plan.h"
+#include "proximity_zones.h"
+#include "pseudonym.h"
+#include "scan_task.h"
+#include "retarget_io_init.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Watchlist and statistics, protected by the scan data lock. */
+static presence_target_t presence_targets[PRESENCE_MAX_TARGETS];
+static uint32_t presence_cursor;
+static uint32_t presence_busy_ms;
+static uint32_t presence_stats_start_ms;
+
+/* Probe in progress. Written by the probe handler while the scan task waits
+ * for the probe, and read by the scan task once the probe has completed.
+ */
+static uint8_t probe_bssid[BSSID_LENGTH];
+static volatile bool probe_hit;
+static volatile int16_t probe_rssi;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: now_ms
+********************************************************************************
+* Summary:
+* Returns the time since the scheduler started in milliseconds.
+*******************************************************************************/
+static uint32_t now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/*******************************************************************************
+* Function Name: find_target
+********************************************************************************
+* Summary:
+* Returns the watchlist entry of a BSSID, or NULL.
+*******************************************************************************/
+static presence_target_t* find_target(const uint8_t *bssid)
+{
+    for (uint32_t i = 0; i < PRESENCE_MAX_TARGETS; i++)
+    {
+        if (presence_targets[i].in_use &&
+            (0 == memcmp(presence_targets[i].bssid, bssid, BSSID_LENGTH)))
+        {
+            return &presence_targets[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: print_transition
+********************************************************************************
+* Summary:
+* Reports a target that became present or absent.
+*******************************************************************************/
+static void print_transition(const uint8_t *bssid, bool present, int16_t rssi)
+{
+    if (present)
+    {
+        SCAN_OUTPUT_INFO(("%02X:%02X:%02X:%02X:%02X:%02X present, %d dBm\n",
+                          bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], rssi));
+    }
+    else
+    {
+        SCAN_OUTPUT_INFO(("%02X:%02X:%02X:%02X:%02X:%02X absent\n",
+                          bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]));
+    }
+}
+
+/*******************************************************************************
+* Function Name: probe_handler
+********************************************************************************
+* Summary:
+* Records whether the probed target answered.
+*******************************************************************************/
+static void probe_handler(const uint8_t *bssid, int16_t rssi, void *user_data)
+{
+    CY_UNUSED_PARAMETER(user_data);
+
+    if (0 == memcmp(bssid, probe_bssid, BSSID_LENGTH))
+    {
+        if ((!probe_hit) || (rssi > probe_rssi))
+        {
+            probe_rssi = rssi;
+        }
+
+        probe_hit = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: probe_next
+********************************************************************************
+* Summary:
+* Probes the next watched BSSID whose channel is known and not skipped by the
+* channel plan, and updates its state. Blocks until the probe completes or
+* times out. A probe that could not run is counted as failed, not as a miss.
+*
+* Return:
+*  bool: false if no target can be probed
+*
+*******************************************************************************/
+static bool probe_next(void)
+{
+    uint8_t channel = PRESENCE_CHANNEL_UNKNOWN;
+    uint32_t index = PRESENCE_MAX_TARGETS;
+
+    scan_data_lock();
+
+    for (uint32_t i = 1; i <= PRESENCE_MAX_TARGETS; i++)
+    {
+        uint32_t candidate = (presence_cursor + i) % PRESENCE_MAX_TARGETS;
+
+        if (presence_targets[candidate].in_use &&
+            (PRESENCE_CHANNEL_UNKNOWN != presence_targets[candidate].channel) &&
+            (CHANNEL_PLAN_SKIP != channel_plan_lookup(presence_targets[candidate].channel)))
+        {
+            index = candidate;
+            break;
+        }
+    }
+
+    if (PRESENCE_MAX_TARGETS != index)
+    {
+        presence_cursor = index;
+        memcpy(probe_bssid, presence_targets[index].bssid, BSSID_LENGTH);
+        channel = presence_targets[index].channel;
+    }
+
+    scan_data_unlock();
+
+    if (PRESENCE_MAX_TARGETS == index)
+    {
+        return false;
+    }
+
+    probe_hit = false;
+
+    uint32_t start = now_ms();
+
+    bool probed = directed_probe_run(channel, probe_bssid, PRESENCE_PROBE_DWELL_MS,
+                                     probe_handler, NULL);
+
+    uint32_t end = now_ms();
+    bool hit = probe_hit;
+    int16_t rssi = probe_rssi;
+    bool changed = false;
+    bool present = false;
+
+    scan_data_lock();
+
+    presence_target_t *target = &presence_targets[index];
+
+    /* The target may have been removed from the console during the probe. */
+    bool watched = target->in_use && (0 == memcmp(target->bssid, probe_bssid, BSSID_LENGTH));
+
+    if (watched && (!probed) && (!hit))
+    {
+        /* The radio was busy or the probe timed out: this says nothing about
+         * the target, which is probed again on the next round.
+         */
+        target->failed++;
+    }
+    else if (watched)
+    {
+        if (0U != target->probes)
+        {
+            target->last_revisit_ms = start - target->last_probe_ms;
+
+            if (target->last_revisit_ms > target->max_revisit_ms)
+            {
+                target->max_revisit_ms = target->last_revisit_ms;
+            }
+        }
+
+        target->probes++;
+        target->last_probe_ms = start;
+        target->total_probe_ms += end - start;
+
+        if ((end - start) > target->max_probe_ms)
+        {
+            target->max_probe_ms = end - start;
+        }
+
+        if (hit)
+        {
+            target->hits++;
+            target->misses = 0;
+            target->rssi = rssi;
+            target->last_seen_ms = end;
+            changed = !target->present;
+            target->present = true;
+        }
+        else
+        {
+            if (target->misses < UINT8_MAX)
+            {
+                target->misses++;
+            }
+
+            if (target->present && (target->misses >= PRESENCE_MISS_LIMIT))
+            {
+                target->present = false;
+                changed = true;
+            }
+        }
+
+        present = target->present;
+
+        proximity_zones_probe(probe_bssid, hit, rssi, end);
+    }
+
+    presence_busy_ms += end - start;
+
+    /* Transitions are output, so they name the pseudonym of the target. */
+    uint8_t shown[BSSID_LENGTH];
+    pseudonym_bssid(probe_bssid, shown);
+
+    scan_data_unlock();
+
+    if (changed)
+    {
+        print_transition(shown, present, rssi);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_init
+********************************************************************************
+* Summary:
+* Clears the watchlist. Must be called after directed_probe_init().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void presence_tracker_init(void)
+{
+    memset(presence_targets, 0, sizeof(presence_targets));
+    presence_cursor = 0;
+
+    presence_tracker_reset_stats();
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_add
+********************************************************************************
+* Summary:
+* Adds a BSSID to the watchlist. Must be called with the scan data lock.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID to watch
+*  uint8_t channel: Channel of the BSSID or PRESENCE_CHANNEL_UNKNOWN
+*
+* Return:
+*  bool: false if the watchlist is full
+*
+*******************************************************************************/
+bool presence_tracker_add(const uint8_t *bssid, uint8_t channel)
+{
+    presence_target_t *target = find_target(bssid);
+
+    for (uint32_t i = 0; (NULL == target) && (i < PRESENCE_MAX_TARGETS); i++)
+    {
+        if (!presence_targets[i].in_use)
+        {
+            target = &presence_targets[i];
+        }
+    }
+
+    if (NULL == target)
+    {
+        return false;
+    }
+
+    memset(target, 0, sizeof(*target));
+    memcpy(target->bssid, bssid, BSSID_LENGTH);
+    target->channel = channel;
+    target->in_use = true;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_remove
+********************************************************************************
+* Summary:
+* Removes a BSSID from the watchlist. Must be called with the scan data lock.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID
+*
+* Return:
+*  bool: false if the BSSID is not watched
+*
+*******************************************************************************/
+bool presence_tracker_remove(const uint8_t *bssid)
+{
+    presence_target_t *target = find_target(bssid);
+
+    if (NULL == target)
+    {
+        return false;
+    }
+
+    target->in_use = false;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_get
+********************************************************************************
+* Summary:
+* Copies a watchlist entry. Must be called with the scan data lock.
+*
+* Parameters:
+*  uint32_t index: Watchlist entry, 0 to PRESENCE_MAX_TARGETS - 1
+*  presence_target_t *target: Copy of the entry
+*
+* Return:
+*  bool: false if the entry is not in use
+*
+*******************************************************************************/
+bool presence_tracker_get(uint32_t index, presence_target_t *target)
+{
+    if ((index >= PRESENCE_MAX_TARGETS) || (!presence_targets[index].in_use))
+    {
+        return false;
+    }
+
+    *target = presence_targets[index];
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_active
+********************************************************************************
+* Summary:
+* Returns true if at least one BSSID is watched.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if the watchlist is not empty
+*
+*******************************************************************************/
+bool presence_tracker_active(void)
+{
+    bool active = false;
+
+    scan_data_lock();
+
+    for (uint32_t i = 0; (!active) && (i < PRESENCE_MAX_TARGETS); i++)
+    {
+        active = presence_targets[i].in_use;
+    }
+
+    scan_data_unlock();
+
+    return active;
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_is_watched
+********************************************************************************
+* Summary:
+* Returns true if a BSSID is on the watchlist. Must be called with the scan
+* data lock.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID
+*
+* Return:
+*  bool: true if the BSSID is watched
+*
+*******************************************************************************/
+bool presence_tracker_is_watched(const uint8_t *bssid)
+{
+    return (NULL != find_target(bssid));
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_observe
+********************************************************************************
+* Summary:
+* Updates a watched BSSID reported by a full sweep: its channel is learned or
+* updated, and it is marked present. Must be called with the scan data lock.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID of the scan result
+*  uint8_t channel: Channel of the scan result
+*  int16_t rssi: RSSI of the scan result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void presence_tracker_observe(const uint8_t *bssid, uint8_t channel, int16_t rssi)
+{
+    presence_target_t *target = find_target(bssid);
+
+    if (NULL != target)
+    {
+        target->channel = channel;
+        target->rssi = rssi;
+        target->misses = 0;
+        target->present = true;
+        target->last_seen_ms = now_ms();
+    }
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_account_sweep
+********************************************************************************
+* Summary:
+* Adds the radio time of a full sweep to the duty cycle.
+*
+* Parameters:
+*  uint32_t busy_ms: Duration of the sweep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void presence_tracker_account_sweep(uint32_t busy_ms)
+{
+    scan_data_lock();
+    presence_busy_ms += busy_ms;
+    scan_data_unlock();
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_duty_cycle
+********************************************************************************
+* Summary:
+* Returns the radio time spent in probes and sweeps and the time elapsed since
+* the statistics were reset. Must be called with the scan data lock.
+*
+* Parameters:
+*  uint32_t *busy_ms: Radio time
+*  uint32_t *elapsed_ms: Elapsed time
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void presence_tracker_duty_cycle(uint32_t *busy_ms, uint32_t *elapsed_ms)
+{
+    *busy_ms = presence_busy_ms;
+    *elapsed_ms = now_ms() - presence_stats_start_ms;
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_reset_stats
+********************************************************************************
+* Summary:
+* Clears the probe statistics and the duty cycle. Must be called with the scan
+* data lock, except from presence_tracker_init().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void presence_tracker_reset_stats(void)
+{
+    for (uint32_t i = 0; i < PRESENCE_MAX_TARGETS; i++)
+    {
+        presence_target_t *target = &presence_targets[i];
+
+        target->probes = 0;
+        target->hits = 0;
+        target->last_revisit_ms = 0;
+        target->max_revisit_ms = 0;
+        target->max_probe_ms = 0;
+        target->total_probe_ms = 0;
+    }
+
+    presence_busy_ms = 0;
+    presence_stats_start_ms = now_ms();
+}
+
+/*******************************************************************************
+* Function Name: presence_tracker_run
+********************************************************************************
+* Summary:
+* Spends the time until the next full sweep probing the watched BSSIDs round
+* robin. Sleeps if no BSSID with a known channel is watched.
+*
+* Parameters:
+*  uint32_t period_ms: Time to spend
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void presence_tracker_run(uint32_t period_ms)
+{
+    uint32_t start = now_ms();
+    uint32_t elapsed = 0;
+
+    while (elapsed < period_ms)
+    {
+        if (!probe_next())
+        {
+            vTaskDelay(pdMS_TO_TICKS(period_ms - elapsed));
+            break;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(PRESENCE_PROBE_GAP_MS));
+        elapsed = now_ms() - start;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,131 @@
+/*******************************************************************************
+* File Name        : presence_tracker.h
+*
+* Description      : This file contains the structures and function prototypes of
+*                    the presence tracker, which probes watchlisted BSSIDs with
+*                    short directed scans between full sweeps.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_PRESENCE_TRACKER_H_
+#define SOURCE_PRESENCE_TRACKER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "bssid_table.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PRESENCE_MAX_TARGETS                 (8U)
+
+/* Time between full sweeps while at least one target is watched. The time in
+ * between is spent probing the targets round robin.
+ */
+#define PRESENCE_SWEEP_PERIOD_MS             (30000U)
+
+/* Active dwell time of a directed probe on the target channel. */
+#define PRESENCE_PROBE_DWELL_MS              (20U)
+
+/* Radio idle time between two probes. */
+#define PRESENCE_PROBE_GAP_MS                (5U)
+
+/* Consecutive missed probes after which a target is reported absent. A single
+ * probe response can be lost, so one miss is not enough.
+ */
+#define PRESENCE_MISS_LIMIT                  (2U)
+
+/* A target added without a channel is probed once a full sweep reports it. */
+#define PRESENCE_CHANNEL_UNKNOWN             (0U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* A watched BSSID and its probe statistics. Times are in milliseconds. The
+ * worst-case detection latency of a target is max_revisit_ms + max_probe_ms.
+ */
+typedef struct
+{
+    uint8_t  bssid[BSSID_LENGTH];
+    uint8_t  channel;
+    bool     in_use;
+    bool     present;
+    uint8_t  misses;
+    int16_t  rssi;
+    uint32_t probes;
+    uint32_t hits;
+    uint32_t failed;
+    uint32_t last_probe_ms;
+    uint32_t last_seen_ms;
+    uint32_t last_revisit_ms;
+    uint32_t max_revisit_ms;
+    uint32_t max_probe_ms;
+    uint32_t total_probe_ms;
+} presence_target_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void presence_tracker_init(void);
+bool presence_tracker_add(const uint8_t *bssid, uint8_t channel);
+bool presence_tracker_remove(const uint8_t *bssid);
+bool presence_tracker_get(uint32_t index, presence_target_t *target);
+bool presence_tracker_active(void);
+bool presence_tracker_is_watched(const uint8_t *bssid);
+void presence_tracker_observe(const uint8_t *bssid, uint8_t channel, int16_t rssi);
+void presence_tracker_account_sweep(uint32_t busy_ms);
+void presence_tracker_duty_cycle(uint32_t *busy_ms, uint32_t *elapsed_ms);
+void presence_tracker_reset_stats(void);
+void presence_tracker_run(uint32_t period_ms);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_PRESENCE_TRACKER_H_ */
+
+/* [] END OF FILE */
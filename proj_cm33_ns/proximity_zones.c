@@ -0,0 +1,442 @@
+/*******************************************************************************
+* File Name        : proximity_zones.c
+*
+* Description      : This file contains the RSSI proximity zones. Scan results are
+*                    matched against the rules as they arrive and every rule is
+*                    evaluated once per scan, so the cost of a scan is O(rules)
+*                    on top of the matching.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "proximity_zones.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    proximity_rule_t rule;
+    bool     in_use;
+    bool     seen;
+    int16_t  best_rssi;
+    int16_t  rssi;
+    proximity_zone_t zone;
+    proximity_zone_t pending_zone;
+    uint32_t pending_since_ms;
+} proximity_slot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE proximity_slot_t proximity_slots[PROXIMITY_MAX_RULES];
+static MODULE_STATE proximity_event_handler_t proximity_handler;
+
+static const char * const zone_names[PROXIMITY_ZONE_COUNT] =
+{
+    [PROXIMITY_ZONE_NEAR] = "near",
+    [PROXIMITY_ZONE_MID]  = "mid",
+    [PROXIMITY_ZONE_FAR]  = "far",
+    [PROXIMITY_ZONE_OUT]  = "out"
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: candidate_zone
+********************************************************************************
+* Summary:
+* Returns the zone indicated by an RSSI sample, applying the hysteresis around
+* the current zone.
+*******************************************************************************/
+static proximity_zone_t candidate_zone(const proximity_rule_t *rule,
+                                       proximity_zone_t zone, int16_t rssi)
+{
+    uint32_t candidate = (uint32_t)zone;
+
+    while ((candidate > 0U) &&
+           (rssi >= (rule->threshold_dbm[candidate - 1U] + rule->enter_hyst_db)))
+    {
+        candidate--;
+    }
+
+    if (candidate == (uint32_t)zone)
+    {
+        while ((candidate < (uint32_t)PROXIMITY_ZONE_OUT) &&
+               (rssi < (rule->threshold_dbm[candidate] - rule->exit_hyst_db)))
+        {
+            candidate++;
+        }
+    }
+
+    return (proximity_zone_t)candidate;
+}
+
+/*******************************************************************************
+* Function Name: slot_update
+********************************************************************************
+* Summary:
+* Applies the candidate zone of a rule with the dwell-time debounce and
+* reports a transition.
+*******************************************************************************/
+static void slot_update(uint32_t index, proximity_zone_t candidate,
+                        int16_t rssi, uint32_t now_ms)
+{
+    proximity_slot_t *slot = &proximity_slots[index];
+
+    if (candidate == slot->zone)
+    {
+        slot->pending_zone = slot->zone;
+        return;
+    }
+
+    if (candidate != slot->pending_zone)
+    {
+        slot->pending_zone = candidate;
+        slot->pending_since_ms = now_ms;
+    }
+
+    if ((now_ms - slot->pending_since_ms) >= slot->rule.dwell_ms)
+    {
+        proximity_event_t event =
+        {
+            .rule = index,
+            .from = slot->zone,
+            .to = candidate,
+            .rssi = rssi,
+            .time_ms = now_ms
+        };
+
+        slot->zone = candidate;
+
+        if (NULL != proximity_handler)
+        {
+            proximity_handler(&event);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_init
+********************************************************************************
+* Summary:
+* Removes all the rules.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void proximity_zones_init(void)
+{
+    memset(proximity_slots, 0, sizeof(proximity_slots));
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_set_handler
+********************************************************************************
+* Summary:
+* Sets the function called on every zone transition.
+*
+* Parameters:
+*  proximity_event_handler_t handler: Event handler, NULL to disable events
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void proximity_zones_set_handler(proximity_event_handler_t handler)
+{
+    proximity_handler = handler;
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_add
+********************************************************************************
+* Summary:
+* Adds a rule. The target starts in PROXIMITY_ZONE_OUT.
+*
+* Parameters:
+*  const proximity_rule_t *rule: Rule to add
+*
+* Return:
+*  int32_t: Index of the rule, or PROXIMITY_INVALID_RULE if the rule is invalid
+*           or all the rules are in use
+*
+*******************************************************************************/
+int32_t proximity_zones_add(const proximity_rule_t *rule)
+{
+    if ((rule->threshold_dbm[PROXIMITY_ZONE_NEAR] <= rule->threshold_dbm[PROXIMITY_ZONE_MID]) ||
+        (rule->threshold_dbm[PROXIMITY_ZONE_MID] <= rule->threshold_dbm[PROXIMITY_ZONE_FAR]) ||
+        (rule->ssid_length > PROXIMITY_SSID_MAX_LENGTH))
+    {
+        return PROXIMITY_INVALID_RULE;
+    }
+
+    for (uint32_t i = 0; i < PROXIMITY_MAX_RULES; i++)
+    {
+        proximity_slot_t *slot = &proximity_slots[i];
+
+        if (!slot->in_use)
+        {
+            memset(slot, 0, sizeof(*slot));
+            slot->rule = *rule;
+            slot->in_use = true;
+            slot->zone = PROXIMITY_ZONE_OUT;
+            slot->pending_zone = PROXIMITY_ZONE_OUT;
+
+            return (int32_t)i;
+        }
+    }
+
+    return PROXIMITY_INVALID_RULE;
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_remove
+********************************************************************************
+* Summary:
+* Removes a rule.
+*
+* Parameters:
+*  uint32_t index: Index of the rule
+*
+* Return:
+*  bool: false if the rule does not exist
+*
+*******************************************************************************/
+bool proximity_zones_remove(uint32_t index)
+{
+    if ((index >= PROXIMITY_MAX_RULES) || (!proximity_slots[index].in_use))
+    {
+        return false;
+    }
+
+    proximity_slots[index].in_use = false;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_get
+********************************************************************************
+* Summary:
+* Returns a rule, its current zone and the last RSSI used to evaluate it.
+*
+* Parameters:
+*  uint32_t index: Index of the rule
+*  proximity_rule_t *rule: Copy of the rule
+*  proximity_zone_t *zone: Current zone
+*  int16_t *rssi: Last RSSI
+*
+* Return:
+*  bool: false if the rule does not exist
+*
+*******************************************************************************/
+bool proximity_zones_get(uint32_t index, proximity_rule_t *rule,
+                         proximity_zone_t *zone, int16_t *rssi)
+{
+    if ((index >= PROXIMITY_MAX_RULES) || (!proximity_slots[index].in_use))
+    {
+        return false;
+    }
+
+    *rule = proximity_slots[index].rule;
+    *zone = proximity_slots[index].zone;
+    *rssi = proximity_slots[index].rssi;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_observe
+********************************************************************************
+* Summary:
+* Matches a result of the scan in progress against the rules. A rule keeps
+* the strongest RSSI of the results it matches until it is evaluated.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID of the result
+*  const uint8_t *ssid: SSID of the result
+*  uint8_t ssid_length: Length of the SSID
+*  int16_t rssi: RSSI of the result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void proximity_zones_observe(const uint8_t *bssid, const uint8_t *ssid,
+                             uint8_t ssid_length, int16_t rssi)
+{
+    for (uint32_t i = 0; i < PROXIMITY_MAX_RULES; i++)
+    {
+        proximity_slot_t *slot = &proximity_slots[i];
+        bool match;
+
+        if (!slot->in_use)
+        {
+            continue;
+        }
+
+        if (PROXIMITY_MATCH_BSSID == slot->rule.match)
+        {
+            match = (0 == memcmp(slot->rule.bssid, bssid, BSSID_LENGTH));
+        }
+        else
+        {
+            match = (slot->rule.ssid_length == ssid_length) &&
+                    (0 == memcmp(slot->rule.ssid, ssid, ssid_length));
+        }
+
+        if (match && ((!slot->seen) || (rssi > slot->best_rssi)))
+        {
+            slot->seen = true;
+            slot->best_rssi = rssi;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_evaluate
+********************************************************************************
+* Summary:
+* Evaluates every rule at the end of a scan. After a full sweep, a rule
+* without a matching result moves towards PROXIMITY_ZONE_OUT; after a filtered
+* scan it is left unchanged.
+*
+* Parameters:
+*  uint32_t now_ms: Current time in milliseconds
+*  bool full_sweep: true if the scan covered all channels without filter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void proximity_zones_evaluate(uint32_t now_ms, bool full_sweep)
+{
+    for (uint32_t i = 0; i < PROXIMITY_MAX_RULES; i++)
+    {
+        proximity_slot_t *slot = &proximity_slots[i];
+
+        if (!slot->in_use)
+        {
+            continue;
+        }
+
+        if (slot->seen)
+        {
+            slot->rssi = slot->best_rssi;
+            slot_update(i, candidate_zone(&slot->rule, slot->zone, slot->best_rssi),
+                        slot->best_rssi, now_ms);
+        }
+        else if (full_sweep)
+        {
+            slot_update(i, PROXIMITY_ZONE_OUT, slot->rssi, now_ms);
+        }
+
+        slot->seen = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: proximity_zones_probe
+********************************************************************************
+* Summary:
+* Evaluates the BSSID rules of a BSSID after a directed probe. This gives the
+* rules of watched BSSIDs a sample between full sweeps.
+*
+* Parameters:
+*  const uint8_t *bssid: Probed BSSID
+*  bool seen: true if the BSSID answered the probe
+*  int16_t rssi: RSSI of the answer
+*  uint32_t now_ms: Current time in milliseconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void proximity_zones_probe(const uint8_t *bssid, bool seen, int16_t rssi,
+                           uint32_t now_ms)
+{
+    for (uint32_t i = 0; i < PROXIMITY_MAX_RULES; i++)
+    {
+        proximity_slot_t *slot = &proximity_slots[i];
+
+        if ((!slot->in_use) || (PROXIMITY_MATCH_BSSID != slot->rule.match) ||
+            (0 != memcmp(slot->rule.bssid, bssid, BSSID_LENGTH)))
+        {
+            continue;
+        }
+
+        if (seen)
+        {
+            slot->rssi = rssi;
+            slot_update(i, candidate_zone(&slot->rule, slot->zone, rssi), rssi, now_ms);
+        }
+        else
+        {
+            slot_update(i, PROXIMITY_ZONE_OUT, slot->rssi, now_ms);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: proximity_zone_name
+********************************************************************************
+* Summary:
+* Returns the name of a zone.
+*
+* Parameters:
+*  proximity_zone_t zone: Zone
+*
+* Return:
+*  const char*: Name of the zone
+*
+*******************************************************************************/
+const char* proximity_zone_name(proximity_zone_t zone)
+{
+    return (zone < PROXIMITY_ZONE_COUNT) ? zone_names[zone] : "?";
+}
+
+/* [] END OF FILE */
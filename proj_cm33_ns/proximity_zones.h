@@ -0,0 +1,149 @@
+/*******************************************************************************
+* File Name        : proximity_zones.h
+*
+* Description      : This file contains the structures and function prototypes of
+*                    the RSSI proximity zones.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_PROXIMITY_ZONES_H_
+#define SOURCE_PROXIMITY_ZONES_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "bssid_table.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PROXIMITY_MAX_RULES                  (8U)
+#define PROXIMITY_SSID_MAX_LENGTH            (32U)
+
+/* Defaults used by the console when a rule is added without them. */
+#define PROXIMITY_DEFAULT_ENTER_HYST_DB      (3U)
+#define PROXIMITY_DEFAULT_EXIT_HYST_DB       (3U)
+#define PROXIMITY_DEFAULT_DWELL_MS           (1000U)
+
+#define PROXIMITY_INVALID_RULE               (-1)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Zones from the closest to the farthest. PROXIMITY_ZONE_OUT is used when the
+ * RSSI is below the far threshold or the target was not seen by a scan that
+ * covered it.
+ */
+typedef enum
+{
+    PROXIMITY_ZONE_NEAR = 0,
+    PROXIMITY_ZONE_MID,
+    PROXIMITY_ZONE_FAR,
+    PROXIMITY_ZONE_OUT,
+    PROXIMITY_ZONE_COUNT
+} proximity_zone_t;
+
+typedef enum
+{
+    PROXIMITY_MATCH_BSSID = 0,
+    PROXIMITY_MATCH_SSID
+} proximity_match_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* A target and its zones. Zone n (near, mid, far) is entered when the RSSI
+ * reaches threshold_dbm[n] + enter_hyst_db and left when it drops below
+ * threshold_dbm[n] - exit_hyst_db. A new zone is reported only after it has
+ * been observed continuously for dwell_ms. The thresholds must decrease from
+ * near to far.
+ */
+typedef struct
+{
+    proximity_match_t match;
+    uint8_t  bssid[BSSID_LENGTH];
+    uint8_t  ssid_length;
+    uint8_t  ssid[PROXIMITY_SSID_MAX_LENGTH];
+    int8_t   threshold_dbm[PROXIMITY_ZONE_OUT];
+    uint8_t  enter_hyst_db;
+    uint8_t  exit_hyst_db;
+    uint32_t dwell_ms;
+} proximity_rule_t;
+
+typedef struct
+{
+    uint32_t rule;
+    proximity_zone_t from;
+    proximity_zone_t to;
+    int16_t  rssi;
+    uint32_t time_ms;
+} proximity_event_t;
+
+typedef void (*proximity_event_handler_t)(const proximity_event_t *event);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void proximity_zones_init(void);
+void proximity_zones_set_handler(proximity_event_handler_t handler);
+int32_t proximity_zones_add(const proximity_rule_t *rule);
+bool proximity_zones_remove(uint32_t index);
+bool proximity_zones_get(uint32_t index, proximity_rule_t *rule,
+                         proximity_zone_t *zone, int16_t *rssi);
+void proximity_zones_observe(const uint8_t *bssid, const uint8_t *ssid,
+                             uint8_t ssid_length, int16_t rssi);
+void proximity_zones_evaluate(uint32_t now_ms, bool full_sweep);
+void proximity_zones_probe(const uint8_t *bssid, bool seen, int16_t rssi,
+                           uint32_t now_ms);
+const char* proximity_zone_name(proximity_zone_t zone);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_PROXIMITY_ZONES_H_ */
+
+/* [] END OF FILE */
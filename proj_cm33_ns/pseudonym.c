@@ -0,0 +1,742 @@
+/*******************************************************************************
+* File Name        : pseudonym.c
+*
+* Description      : This file contains the keyed-hash pseudonyms that replace
+*                    BSSIDs and SSIDs before scan data leaves the device.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "pseudonym.h"
+#include "bssid_table.h"
+#include "hash_service.h"
+#include "secure_batch.h"
+#include "module_state.h"
+#include "perf_counter.h"
+
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "psa/crypto.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Every keyed hash starts with a domain byte, so that the parts of a
+ * pseudonym are independent of each other.
+ */
+#define DOMAIN_OUI                           (0x01U)
+#define DOMAIN_NIC                           (0x02U)
+#define DOMAIN_SSID                          (0x03U)
+
+#define PRF_MAX_INPUT                        (1U + SCAN_LOG_SSID_MAX_LENGTH)
+
+/* Locally administered, unicast. */
+#define BSSID_LOCAL_BIT                      (0x02U)
+#define BSSID_GROUP_BIT                      (0x01U)
+
+#define SSID_SLOTS                           (2U * PSEUDONYM_MAX_SSIDS)
+#define SSID_SLOT_MASK                       (SSID_SLOTS - 1U)
+#define SSID_SLOT_EMPTY                      (0xFFU)
+
+#define SSID_PREFIX_LENGTH                   (sizeof(PSEUDONYM_SSID_PREFIX) - 1U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    uint8_t  pseudonym[BSSID_LENGTH];
+    uint16_t generation;
+    bool     valid;
+} pseudonym_bssid_t;
+
+typedef struct
+{
+    uint32_t hash;
+    uint8_t  length;
+    uint8_t  ssid[SCAN_LOG_SSID_MAX_LENGTH];
+    uint8_t  pseudonym[PSEUDONYM_SSID_LENGTH];
+} pseudonym_ssid_t;
+
+/* The key itself is kept by the secure service. */
+static MODULE_STATE bool pseudonym_keyed;
+static MODULE_STATE bool pseudonym_on;
+static MODULE_STATE bool pseudonym_clock_started;
+static MODULE_STATE uint32_t pseudonym_rotated_s;
+static MODULE_STATE pseudonym_stats_t pseudonym_counters;
+
+/* Pseudonyms of the tracked BSSIDs, parallel to the BSSID table, and of the
+ * SSIDs seen since the key was last changed.
+ */
+static MODULE_STATE pseudonym_bssid_t pseudonym_bssids[BSSID_TABLE_MAX_ENTRIES];
+static MODULE_STATE pseudonym_ssid_t pseudonym_ssids[PSEUDONYM_MAX_SSIDS];
+static MODULE_STATE uint32_t pseudonym_ssid_count;
+static MODULE_STATE uint8_t pseudonym_ssid_slots[SSID_SLOTS];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: clear_caches
+********************************************************************************
+* Summary:
+* Forgets the cached pseudonyms, which were made with a previous key.
+*******************************************************************************/
+static void clear_caches(void)
+{
+    memset(pseudonym_bssids, 0, sizeof(pseudonym_bssids));
+    pseudonym_ssid_count = 0U;
+    memset(pseudonym_ssid_slots, SSID_SLOT_EMPTY, sizeof(pseudonym_ssid_slots));
+}
+
+/*******************************************************************************
+* Function Name: get_random
+********************************************************************************
+* Summary:
+* Fills a key-sized buffer with random bytes. Returns false if there is no
+* random number generator.
+*******************************************************************************/
+static bool get_random(uint8_t *random)
+{
+#if defined(__ARM_ARCH)
+    return (PSA_SUCCESS == psa_crypto_init()) &&
+           (PSA_SUCCESS == psa_generate_random(random, PSEUDONYM_KEY_SIZE));
+#else
+    (void)random;
+
+    return false;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: change_key
+********************************************************************************
+* Summary:
+* Sets or rotates the key in the secure service and starts the epoch it
+* returns.
+*******************************************************************************/
+static bool change_key(uint8_t op, const uint8_t *input, uint32_t length)
+{
+    secure_batch_t batch;
+
+    secure_batch_begin(&batch);
+    const secure_service_item_t *item = secure_batch_add(&batch, op,
+                                                         SECURE_SERVICE_KEY_PSEUDONYM,
+                                                         input, length);
+
+    if ((NULL == item) || (!secure_batch_run(&batch)))
+    {
+        return false;
+    }
+
+    pseudonym_counters.epoch = (uint32_t)item->output;
+    pseudonym_keyed = true;
+    clear_caches();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_init
+********************************************************************************
+* Summary:
+* Empties the caches and, where there is a random number generator, has the
+* secure service derive a new random key. Pseudonyms are off until
+* pseudonym_set_enabled() is called.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pseudonym_init(void)
+{
+    uint8_t random[PSEUDONYM_KEY_SIZE];
+
+    memset(&pseudonym_counters, 0, sizeof(pseudonym_counters));
+    pseudonym_on = false;
+    pseudonym_clock_started = false;
+    pseudonym_keyed = false;
+    clear_caches();
+
+    if (get_random(random))
+    {
+        (void)change_key(SECURE_SERVICE_OP_ROTATE_KEY, random, sizeof(random));
+        memset(random, 0, sizeof(random));
+    }
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_set_key
+********************************************************************************
+* Summary:
+* Sets the key, for instance one shared with the host that correlates data
+* from several devices, and starts a new epoch.
+*
+* Parameters:
+*  const uint8_t *key: PSEUDONYM_KEY_SIZE bytes of key
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pseudonym_set_key(const uint8_t *key)
+{
+    (void)change_key(SECURE_SERVICE_OP_SET_KEY, key, PSEUDONYM_KEY_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_set_enabled
+********************************************************************************
+* Summary:
+* Turns the pseudonyms on or off.
+*
+* Parameters:
+*  bool enabled: true to replace BSSIDs and SSIDs with pseudonyms
+*
+* Return:
+*  bool: false if they cannot be turned on because there is no key
+*
+*******************************************************************************/
+bool pseudonym_set_enabled(bool enabled)
+{
+    if (enabled && (!pseudonym_keyed))
+    {
+        return false;
+    }
+
+    pseudonym_on = enabled;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_enabled
+********************************************************************************
+* Summary:
+* Returns whether BSSIDs and SSIDs are replaced with pseudonyms.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if pseudonyms are on
+*
+*******************************************************************************/
+bool pseudonym_enabled(void)
+{
+    return pseudonym_on;
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_rotate
+********************************************************************************
+* Summary:
+* Replaces the key and starts a new epoch, whose pseudonyms cannot be linked
+* to those of the previous one. The secure service derives the new key from
+* the old one and fresh random bytes, where available, so it cannot be used
+* to recover the old key.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: false if there is no key to rotate
+*
+*******************************************************************************/
+bool pseudonym_rotate(void)
+{
+    uint8_t random[PSEUDONYM_KEY_SIZE];
+    bool rotated;
+
+    if (!pseudonym_keyed)
+    {
+        return false;
+    }
+
+    if (get_random(random))
+    {
+        rotated = change_key(SECURE_SERVICE_OP_ROTATE_KEY, random, sizeof(random));
+        memset(random, 0, sizeof(random));
+    }
+    else
+    {
+        rotated = change_key(SECURE_SERVICE_OP_ROTATE_KEY, NULL, 0U);
+    }
+
+    return rotated;
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_tick
+********************************************************************************
+* Summary:
+* Rotates the key every PSEUDONYM_ROTATION_S while pseudonyms are on.
+*
+* Parameters:
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  bool: true if the key was rotated
+*
+*******************************************************************************/
+bool pseudonym_tick(uint32_t now_s)
+{
+    if (!pseudonym_on)
+    {
+        return false;
+    }
+
+    if (!pseudonym_clock_started)
+    {
+        pseudonym_clock_started = true;
+        pseudonym_rotated_s = now_s;
+
+        return false;
+    }
+
+    if ((now_s - pseudonym_rotated_s) < PSEUDONYM_ROTATION_S)
+    {
+        return false;
+    }
+
+    pseudonym_rotated_s = now_s;
+
+    return pseudonym_rotate();
+}
+
+/*******************************************************************************
+* Function Name: queue_prf
+********************************************************************************
+* Summary:
+* Adds the keyed hash of a domain byte followed by the data to a batch.
+*******************************************************************************/
+static const secure_service_item_t* queue_prf(secure_batch_t *batch, uint8_t *input,
+                                              uint8_t domain, const uint8_t *data,
+                                              uint32_t length)
+{
+    input[0] = domain;
+    memcpy(&input[1], data, length);
+
+    return secure_batch_add(batch, SECURE_SERVICE_OP_SIPHASH, SECURE_SERVICE_KEY_PSEUDONYM,
+                            input, 1U + length);
+}
+
+/*******************************************************************************
+* Function Name: find_bssid
+********************************************************************************
+* Summary:
+* Copies the cached pseudonym of a BSSID. Returns false if there is none.
+*******************************************************************************/
+static bool find_bssid(const uint8_t *bssid, uint8_t *out)
+{
+    uint16_t index = bssid_table_find(bssid);
+    const bssid_table_entry_t *entry = bssid_table_get(index);
+
+    if ((NULL == entry) || (!pseudonym_bssids[index].valid) ||
+        (pseudonym_bssids[index].generation != entry->generation))
+    {
+        return false;
+    }
+
+    memcpy(out, pseudonym_bssids[index].pseudonym, BSSID_LENGTH);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: store_bssid
+********************************************************************************
+* Summary:
+* Caches the pseudonym of a BSSID if the BSSID table tracks it.
+*******************************************************************************/
+static void store_bssid(const uint8_t *bssid, const uint8_t *pseudonym)
+{
+    uint16_t index = bssid_table_find(bssid);
+    const bssid_table_entry_t *entry = bssid_table_get(index);
+
+    if (NULL != entry)
+    {
+        memcpy(pseudonym_bssids[index].pseudonym, pseudonym, BSSID_LENGTH);
+        pseudonym_bssids[index].generation = entry->generation;
+        pseudonym_bssids[index].valid = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: make_bssid
+********************************************************************************
+* Summary:
+* Makes the pseudonym of a BSSID from the keyed hashes of its OUI and of its
+* first five bytes. The OUI and the rest are replaced separately, so that the
+* BSSIDs of one vendor share a pseudonymous OUI and those of one access point
+* differ only in the last byte, as they did: packed BSSIDs (see
+* scan_log_format.h) stay compact.
+*******************************************************************************/
+static void make_bssid(const uint8_t *bssid, uint64_t oui, uint64_t nic, uint8_t *out)
+{
+    out[0] = (uint8_t)(((uint8_t)oui & ~BSSID_GROUP_BIT) | BSSID_LOCAL_BIT);
+    out[1] = (uint8_t)(oui >> 8);
+    out[2] = (uint8_t)(oui >> 16);
+    out[3] = (uint8_t)nic;
+    out[4] = (uint8_t)(nic >> 8);
+    out[5] = (uint8_t)(bssid[5] ^ (uint8_t)(nic >> 16));
+}
+
+/*******************************************************************************
+* Function Name: is_hidden
+********************************************************************************
+* Summary:
+* Returns whether an SSID is empty or all zeros, as hidden networks report it.
+*******************************************************************************/
+static bool is_hidden(const uint8_t *ssid, uint8_t length)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (0U != ssid[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: find_ssid
+********************************************************************************
+* Summary:
+* Copies the cached pseudonym of an SSID. Returns false if there is none.
+*******************************************************************************/
+static bool find_ssid(const uint8_t *ssid, uint8_t length, uint32_t hash, uint8_t *out)
+{
+    uint32_t slot = hash & SSID_SLOT_MASK;
+
+    while (SSID_SLOT_EMPTY != pseudonym_ssid_slots[slot])
+    {
+        const pseudonym_ssid_t *entry = &pseudonym_ssids[pseudonym_ssid_slots[slot]];
+
+        if ((entry->hash == hash) && (entry->length == length) &&
+            (0 == memcmp(entry->ssid, ssid, length)))
+        {
+            memcpy(out, entry->pseudonym, PSEUDONYM_SSID_LENGTH);
+            return true;
+        }
+
+        slot = (slot + 1U) & SSID_SLOT_MASK;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: store_ssid
+********************************************************************************
+* Summary:
+* Caches the pseudonym of an SSID. The cache is emptied when it is full.
+*******************************************************************************/
+static void store_ssid(const uint8_t *ssid, uint8_t length, uint32_t hash,
+                       const uint8_t *pseudonym)
+{
+    uint32_t slot = hash & SSID_SLOT_MASK;
+
+    if (pseudonym_ssid_count >= PSEUDONYM_MAX_SSIDS)
+    {
+        pseudonym_ssid_count = 0U;
+        memset(pseudonym_ssid_slots, SSID_SLOT_EMPTY, sizeof(pseudonym_ssid_slots));
+    }
+
+    while (SSID_SLOT_EMPTY != pseudonym_ssid_slots[slot])
+    {
+        slot = (slot + 1U) & SSID_SLOT_MASK;
+    }
+
+    pseudonym_ssid_t *entry = &pseudonym_ssids[pseudonym_ssid_count];
+
+    entry->hash = hash;
+    entry->length = length;
+    memcpy(entry->ssid, ssid, length);
+    memcpy(entry->pseudonym, pseudonym, PSEUDONYM_SSID_LENGTH);
+    pseudonym_ssid_slots[slot] = (uint8_t)pseudonym_ssid_count++;
+}
+
+/*******************************************************************************
+* Function Name: make_ssid
+********************************************************************************
+* Summary:
+* Makes the pseudonym of an SSID from its keyed hash.
+*******************************************************************************/
+static void make_ssid(uint64_t value, uint8_t *out)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    memcpy(out, PSEUDONYM_SSID_PREFIX, SSID_PREFIX_LENGTH);
+
+    for (uint32_t i = SSID_PREFIX_LENGTH; i < PSEUDONYM_SSID_LENGTH; i++)
+    {
+        out[i] = (uint8_t)hex[value & 0x0FU];
+        value >>= 4;
+    }
+}
+
+/*******************************************************************************
+* Function Name: replace
+********************************************************************************
+* Summary:
+* Replaces a BSSID, an SSID or both with their pseudonyms. Those that are not
+* cached are computed together in one call to the secure service. If the call
+* fails, fixed placeholders are output instead and nothing is cached: the real
+* values, or any part of them, are never output.
+*******************************************************************************/
+static void replace(const uint8_t *bssid, uint8_t *bssid_out, const uint8_t *ssid,
+                    uint8_t length, uint8_t *ssid_out, uint8_t *ssid_out_length)
+{
+    uint8_t oui_input[PRF_MAX_INPUT];
+    uint8_t nic_input[PRF_MAX_INPUT];
+    uint8_t ssid_input[PRF_MAX_INPUT];
+    const secure_service_item_t *oui = NULL;
+    const secure_service_item_t *nic = NULL;
+    const secure_service_item_t *name = NULL;
+    uint32_t hash = 0U;
+    secure_batch_t batch;
+
+    secure_batch_begin(&batch);
+
+    if (NULL != bssid)
+    {
+        if (find_bssid(bssid, bssid_out))
+        {
+            pseudonym_counters.bssid_hits++;
+        }
+        else
+        {
+            pseudonym_counters.bssid_misses++;
+            oui = queue_prf(&batch, oui_input, DOMAIN_OUI, bssid, 3U);
+            nic = queue_prf(&batch, nic_input, DOMAIN_NIC, bssid, BSSID_LENGTH - 1U);
+        }
+    }
+
+    if (NULL != ssid)
+    {
+        *ssid_out_length = (uint8_t)PSEUDONYM_SSID_LENGTH;
+
+        if (is_hidden(ssid, length))
+        {
+            memmove(ssid_out, ssid, length);
+            *ssid_out_length = length;
+        }
+        else
+        {
+            hash = hash_service_hash32(ssid, length);
+
+            if (find_ssid(ssid, length, hash, ssid_out))
+            {
+                pseudonym_counters.ssid_hits++;
+            }
+            else
+            {
+                pseudonym_counters.ssid_misses++;
+                name = queue_prf(&batch, ssid_input, DOMAIN_SSID, ssid, length);
+            }
+        }
+    }
+
+    if (0U == batch.count)
+    {
+        return;
+    }
+
+    bool computed = secure_batch_run(&batch);
+
+    if ((NULL != oui) && (NULL != nic))
+    {
+        uint8_t pseudonym[BSSID_LENGTH];
+
+        if (computed)
+        {
+            make_bssid(bssid, oui->output, nic->output, pseudonym);
+            store_bssid(bssid, pseudonym);
+        }
+        else
+        {
+            /* A locally administered address with zero NIC bytes, which
+             * keeps nothing of the BSSID, not even its last byte.
+             */
+            memset(pseudonym, 0, BSSID_LENGTH);
+            pseudonym[0] = BSSID_LOCAL_BIT;
+        }
+
+        memcpy(bssid_out, pseudonym, BSSID_LENGTH);
+    }
+
+    if (NULL != name)
+    {
+        uint8_t pseudonym[PSEUDONYM_SSID_LENGTH];
+
+        make_ssid(computed ? name->output : 0U, pseudonym);
+
+        if (computed)
+        {
+            store_ssid(ssid, length, hash, pseudonym);
+        }
+
+        memcpy(ssid_out, pseudonym, PSEUDONYM_SSID_LENGTH);
+    }
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_bssid
+********************************************************************************
+* Summary:
+* Returns the pseudonym of a BSSID, or the BSSID itself while pseudonyms are
+* off. The pseudonym of a tracked BSSID is computed once per key.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID
+*  uint8_t *out: Set to the pseudonym, may be the BSSID
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pseudonym_bssid(const uint8_t *bssid, uint8_t *out)
+{
+    if (!pseudonym_on)
+    {
+        memmove(out, bssid, BSSID_LENGTH);
+        return;
+    }
+
+    replace(bssid, out, NULL, 0U, NULL, NULL);
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_ssid
+********************************************************************************
+* Summary:
+* Returns the pseudonym of an SSID, or the SSID itself while pseudonyms are off
+* or if it is hidden. The pseudonym of an SSID is computed once per key, as
+* long as the cache does not fill up.
+*
+* Parameters:
+*  const uint8_t *ssid: SSID
+*  uint8_t length: Length of the SSID, at most SCAN_LOG_SSID_MAX_LENGTH
+*  uint8_t *out: Set to the pseudonym, may be the SSID. At least
+*   PSEUDONYM_SSID_LENGTH bytes.
+*
+* Return:
+*  uint8_t: Length of the pseudonym
+*
+*******************************************************************************/
+uint8_t pseudonym_ssid(const uint8_t *ssid, uint8_t length, uint8_t *out)
+{
+    uint8_t out_length = length;
+
+    if (!pseudonym_on)
+    {
+        memmove(out, ssid, length);
+        return length;
+    }
+
+    replace(NULL, NULL, ssid, length, out, &out_length);
+
+    return out_length;
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_ap
+********************************************************************************
+* Summary:
+* Replaces the BSSID and the SSID of a scan result with their pseudonyms,
+* with at most one call to the secure service. Every
+* PSEUDONYM_TIMING_INTERVAL-th call is timed.
+*
+* Parameters:
+*  scan_log_ap_t *ap: Scan result
+*
+* Return:
+*  bool: true if pseudonyms are on and the scan result was changed
+*
+*******************************************************************************/
+bool pseudonym_ap(scan_log_ap_t *ap)
+{
+    if (!pseudonym_on)
+    {
+        return false;
+    }
+
+    bool timed = (0U == (pseudonym_counters.records++ % PSEUDONYM_TIMING_INTERVAL));
+    uint32_t start = timed ? perf_counter_now() : 0U;
+    uint8_t length = (ap->ssid_length > SCAN_LOG_SSID_MAX_LENGTH) ?
+                     (uint8_t)SCAN_LOG_SSID_MAX_LENGTH : ap->ssid_length;
+
+    replace(ap->bssid, ap->bssid, ap->ssid, length, ap->ssid, &ap->ssid_length);
+
+    if (timed)
+    {
+        pseudonym_counters.timed_records++;
+        pseudonym_counters.timed_ns += perf_counter_to_ns(perf_counter_now() - start);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: pseudonym_stats
+********************************************************************************
+* Summary:
+* Returns the key epoch and the cache and timing counters.
+*
+* Parameters:
+*  pseudonym_stats_t *stats: Set to the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pseudonym_stats(pseudonym_stats_t *stats)
+{
+    *stats = pseudonym_counters;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,125 @@
+/*******************************************************************************
+* File Name        : pseudonym.h
+*
+* Description      : This file contains the public interface of the export
+*                    pseudonyms of BSSIDs and SSIDs.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_PSEUDONYM_H_
+#define SOURCE_PSEUDONYM_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_log_format.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PSEUDONYM_KEY_SIZE                   (16U)
+
+/* An SSID pseudonym is the prefix followed by 48 bits of the keyed hash in
+ * hexadecimal.
+ */
+#define PSEUDONYM_SSID_PREFIX                "~"
+#define PSEUDONYM_SSID_LENGTH                (13U)
+
+/* The key is rotated after this time, so that pseudonyms cannot be linked
+ * across longer periods.
+ */
+#ifndef PSEUDONYM_ROTATION_S
+#define PSEUDONYM_ROTATION_S                 (24UL * 60UL * 60UL)
+#endif
+
+/* Number of distinct SSIDs whose pseudonyms are cached. The cache is emptied
+ * when it is full.
+ */
+#ifndef PSEUDONYM_MAX_SSIDS
+#define PSEUDONYM_MAX_SSIDS                  (64U)
+#endif
+
+/* One record in this many is timed, so that reading the clock does not add
+ * to what is measured.
+ */
+#define PSEUDONYM_TIMING_INTERVAL            (16U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t epoch;
+    uint32_t records;
+    uint32_t timed_records;
+    uint32_t bssid_hits;
+    uint32_t bssid_misses;
+    uint32_t ssid_hits;
+    uint32_t ssid_misses;
+    uint64_t timed_ns;
+} pseudonym_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void pseudonym_init(void);
+void pseudonym_set_key(const uint8_t *key);
+bool pseudonym_set_enabled(bool enabled);
+bool pseudonym_enabled(void);
+bool pseudonym_rotate(void);
+bool pseudonym_tick(uint32_t now_s);
+void pseudonym_bssid(const uint8_t *bssid, uint8_t *out);
+uint8_t pseudonym_ssid(const uint8_t *ssid, uint8_t length, uint8_t *out);
+bool pseudonym_ap(scan_log_ap_t *ap);
+void pseudonym_stats(pseudonym_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_PSEUDONYM_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,267 @@
+/*******************************************************************************
+* File Name        : rnr_parser.c
+*
+* Description      : This file contains the Reduced Neighbor Report (RNR) parser
+*                    (IEEE 802.11ax, 9.4.2.170). An RNR element holds Neighbor AP
+*                    Information fields, each made of a TBTT Information Header, an
+*                    operating class, a channel and a list of TBTT Information fields
+*                    whose length tells which optional subfields they carry. Every
+*                    length is checked against the element, so a truncated or malformed
+*                    element only loses its last entries.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "rnr_parser.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IE_HEADER_LENGTH                     (2U)
+
+/* Neighbor AP Information field header: TBTT Information Header (2 bytes),
+ * operating class and channel number.
+ */
+#define NEIGHBOR_HEADER_LENGTH               (4U)
+#define TBTT_FIELD_TYPE_MASK                 (0x03U)
+#define TBTT_FIELD_TYPE_NEIGHBOR             (0x00U)
+#define TBTT_COUNT_SHIFT                     (4U)
+#define TBTT_COUNT_MASK                      (0x0FU)
+
+/* Layouts of the TBTT Information field by length. Byte 0 is the TBTT
+ * offset of the neighbor in all of them.
+ */
+#define TBTT_OFFSET_LENGTH                   (1U)
+#define SHORT_SSID_LENGTH                    (4U)
+#define TBTT_LEN_OFFSET_PARAMS               (2U)
+#define TBTT_LEN_SHORT_SSID                  (5U)
+#define TBTT_LEN_SHORT_SSID_PARAMS           (6U)
+#define TBTT_LEN_BSSID                       (7U)
+#define TBTT_LEN_BSSID_PARAMS                (8U)
+#define TBTT_LEN_BSSID_PARAMS_PSD            (9U)
+#define TBTT_LEN_BSSID_SHORT_SSID            (11U)
+#define TBTT_LEN_BSSID_SHORT_SSID_PARAMS     (12U)
+
+/* Global operating classes of the 6 GHz band (IEEE 802.11ax, Table E-4). */
+#define OP_CLASS_6GHZ_FIRST                  (131U)
+#define OP_CLASS_6GHZ_LAST                   (137U)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: parse_tbtt_info
+********************************************************************************
+* Summary:
+* Decodes the optional subfields of one TBTT Information field.
+*******************************************************************************/
+static void parse_tbtt_info(const uint8_t *info, uint32_t length, rnr_neighbor_t *neighbor)
+{
+    const uint8_t *p = info + TBTT_OFFSET_LENGTH;
+
+    neighbor->has_bssid = (length >= TBTT_LEN_BSSID) && (length != 10U);
+    neighbor->has_short_ssid = ((length >= TBTT_LEN_SHORT_SSID) && (length <= TBTT_LEN_SHORT_SSID_PARAMS)) ||
+                               (length >= TBTT_LEN_BSSID_SHORT_SSID);
+    neighbor->has_bss_params = (TBTT_LEN_OFFSET_PARAMS == length) ||
+                               (TBTT_LEN_SHORT_SSID_PARAMS == length) ||
+                               (TBTT_LEN_BSSID_PARAMS == length) ||
+                               (TBTT_LEN_BSSID_PARAMS_PSD == length) ||
+                               (length >= TBTT_LEN_BSSID_SHORT_SSID_PARAMS);
+
+    if (neighbor->has_bssid)
+    {
+        memcpy(neighbor->bssid, p, RNR_BSSID_LENGTH);
+        p += RNR_BSSID_LENGTH;
+    }
+
+    if (neighbor->has_short_ssid)
+    {
+        neighbor->short_ssid = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+                               ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        p += SHORT_SSID_LENGTH;
+    }
+
+    if (neighbor->has_bss_params)
+    {
+        neighbor->bss_params = *p;
+    }
+}
+
+/*******************************************************************************
+* Function Name: parse_element
+********************************************************************************
+* Summary:
+* Reports the neighbors of one RNR element body and returns their number.
+*******************************************************************************/
+static uint32_t parse_element(const uint8_t *body, uint32_t length, rnr_handler_t handler,
+                              void *user_data)
+{
+    uint32_t offset = 0;
+    uint32_t count = 0;
+
+    while ((offset + NEIGHBOR_HEADER_LENGTH) <= length)
+    {
+        const uint8_t *header = &body[offset];
+        uint32_t tbtt_count = ((uint32_t)(header[0] >> TBTT_COUNT_SHIFT) & TBTT_COUNT_MASK) + 1U;
+        uint32_t tbtt_length = header[1];
+        rnr_neighbor_t neighbor;
+
+        offset += NEIGHBOR_HEADER_LENGTH;
+
+        if ((0U == tbtt_length) || ((offset + (tbtt_count * tbtt_length)) > length))
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i < tbtt_count; i++)
+        {
+            memset(&neighbor, 0, sizeof(neighbor));
+            neighbor.op_class = header[2];
+            neighbor.channel = header[3];
+            neighbor.is_6ghz = rnr_is_6ghz_op_class(header[2]);
+
+            /* Other field types are reserved; skip their contents. */
+            if (TBTT_FIELD_TYPE_NEIGHBOR == (header[0] & TBTT_FIELD_TYPE_MASK))
+            {
+                parse_tbtt_info(&body[offset], tbtt_length, &neighbor);
+
+                if (NULL != handler)
+                {
+                    handler(&neighbor, user_data);
+                }
+
+                count++;
+            }
+
+            offset += tbtt_length;
+        }
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: rnr_parse
+********************************************************************************
+* Summary:
+* Walks the information elements of a scan result and reports every neighbor
+* AP of its RNR elements.
+*
+* Parameters:
+*  const uint8_t *ies: Information elements
+*  uint32_t length: Length of the information elements
+*  rnr_handler_t handler: Called for each neighbor, may be NULL
+*  void *user_data: Passed to the handler
+*
+* Return:
+*  uint32_t: Number of neighbors reported
+*
+*******************************************************************************/
+uint32_t rnr_parse(const uint8_t *ies, uint32_t length, rnr_handler_t handler,
+                   void *user_data)
+{
+    uint32_t offset = 0;
+    uint32_t count = 0;
+
+    if (NULL == ies)
+    {
+        return 0;
+    }
+
+    while ((offset + IE_HEADER_LENGTH) <= length)
+    {
+        uint32_t id = ies[offset];
+        uint32_t ie_length = ies[offset + 1U];
+
+        if ((offset + IE_HEADER_LENGTH + ie_length) > length)
+        {
+            break;
+        }
+
+        if (RNR_ELEMENT_ID == id)
+        {
+            count += parse_element(&ies[offset + IE_HEADER_LENGTH], ie_length,
+                                   handler, user_data);
+        }
+
+        offset += IE_HEADER_LENGTH + ie_length;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: rnr_is_6ghz_op_class
+********************************************************************************
+* Summary:
+* Returns true if an operating class is in the 6 GHz band.
+*
+* Parameters:
+*  uint8_t op_class: Global operating class
+*
+* Return:
+*  bool: true for the 6 GHz band
+*
+*******************************************************************************/
+bool rnr_is_6ghz_op_class(uint8_t op_class)
+{
+    return (op_class >= OP_CLASS_6GHZ_FIRST) && (op_class <= OP_CLASS_6GHZ_LAST);
+}
+
+/*******************************************************************************
+* Function Name: rnr_is_psc
+********************************************************************************
+* Summary:
+* Returns true if a 6 GHz channel is a preferred scanning channel.
+*
+* Parameters:
+*  uint8_t channel: 6 GHz channel number
+*
+* Return:
+*  bool: true for a PSC
+*
+*******************************************************************************/
+bool rnr_is_psc(uint8_t channel)
+{
+    return (channel >= RNR_PSC_FIRST_CHANNEL) && (channel <= RNR_6GHZ_MAX_CHANNEL) &&
+           (((uint32_t)channel % RNR_PSC_SPACING) == RNR_PSC_FIRST_CHANNEL);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* File Name        : rnr_parser.h
+*
+* Description      : This file contains the structures and function prototypes of the
+*                    Reduced Neighbor Report (RNR) parser, which lists the neighbor APs
+*                    announced in the information elements of a scan result.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_RNR_PARSER_H_
+#define SOURCE_RNR_PARSER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RNR_ELEMENT_ID                       (201U)
+#define RNR_BSSID_LENGTH                     (6U)
+
+/* 6 GHz channels are 1 to 233. Preferred scanning channels (PSC), on which
+ * stations may probe without prior knowledge of an AP, are every fourth
+ * 80 MHz primary channel: 5, 21, 37, ... 229.
+ */
+#define RNR_6GHZ_MAX_CHANNEL                 (233U)
+#define RNR_PSC_FIRST_CHANNEL                (5U)
+#define RNR_PSC_SPACING                      (16U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* One neighbor AP of an RNR element. The BSSID and the short SSID (CRC-32 of
+ * the SSID) are optional in the element.
+ */
+typedef struct
+{
+    uint8_t  op_class;
+    uint8_t  channel;
+    bool     is_6ghz;
+    bool     has_bssid;
+    bool     has_short_ssid;
+    bool     has_bss_params;
+    uint8_t  bssid[RNR_BSSID_LENGTH];
+    uint32_t short_ssid;
+    uint8_t  bss_params;
+} rnr_neighbor_t;
+
+typedef void (*rnr_handler_t)(const rnr_neighbor_t *neighbor, void *user_data);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t rnr_parse(const uint8_t *ies, uint32_t length, rnr_handler_t handler,
+                   void *user_data);
+bool rnr_is_6ghz_op_class(uint8_t op_class);
+bool rnr_is_psc(uint8_t channel);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_RNR_PARSER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,674 @@
+/*******************************************************************************
+* File Name        : rssi_history.c
+*
+* Description      : This file contains the fixed-size rings that keep the RSSI
+*                    history of the tracked BSSIDs at three resolutions: raw
+*                    per-scan samples, per-minute and per-hour aggregates.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "rssi_history.h"
+#include "bssid_table.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SECONDS_PER_MINUTE                   (60U)
+#define SECONDS_PER_HOUR                     (3600U)
+#define RSSI_HISTORY_NO_OWNER                (0xFFFFU)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Running min/mean/max of the interval that is currently open. */
+typedef struct
+{
+    uint8_t  weakest;
+    uint8_t  strongest;
+    uint16_t count;
+    uint32_t sum;
+} rssi_accumulator_t;
+
+/* History of one BSSID. The fields updated on every scan are grouped at the
+ * start of the structure, followed by the raw ring which fits in two cache
+ * lines, and the large aggregate rings which are written at most once per
+ * minute.
+ */
+typedef struct
+{
+    uint16_t table_index;
+    uint16_t generation;
+    bool     in_use;
+    uint8_t  pending;
+    uint8_t  raw_head;
+    uint8_t  raw_count;
+    uint32_t last_seen_s;
+    uint32_t minute_epoch;
+    uint32_t hour_epoch;
+    uint16_t minute_head;
+    uint16_t minute_count;
+    uint16_t hour_head;
+    uint16_t hour_count;
+    rssi_accumulator_t minute_acc;
+    rssi_accumulator_t hour_acc;
+    uint8_t  raw[RSSI_HISTORY_RAW_DEPTH];
+    rssi_history_agg_t minutes[RSSI_HISTORY_MINUTE_DEPTH];
+    rssi_history_agg_t hours[RSSI_HISTORY_HOUR_DEPTH];
+} rssi_history_slot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE rssi_history_slot_t history_slots[RSSI_HISTORY_MAX_BSSIDS];
+
+/* Maps a BSSID table index to its history slot. The mapping is validated
+ * against the slot's table index and generation before use.
+ */
+static MODULE_STATE uint16_t history_slot_of_entry[BSSID_TABLE_MAX_ENTRIES];
+
+static const rssi_history_agg_t empty_agg =
+{
+    .weakest   = RSSI_HISTORY_NO_SAMPLE,
+    .mean      = RSSI_HISTORY_NO_SAMPLE,
+    .strongest = RSSI_HISTORY_NO_SAMPLE
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: accumulator_reset
+********************************************************************************
+* Summary:
+* Clears the running aggregate of an interval.
+*******************************************************************************/
+static void accumulator_reset(rssi_accumulator_t *acc)
+{
+    acc->weakest = 0;
+    acc->strongest = RSSI_HISTORY_MAX_OFFSET;
+    acc->count = 0;
+    acc->sum = 0;
+}
+
+/*******************************************************************************
+* Function Name: accumulator_add
+********************************************************************************
+* Summary:
+* Adds one sample to the running aggregate of an interval.
+*******************************************************************************/
+static void accumulator_add(rssi_accumulator_t *acc, uint8_t offset)
+{
+    if (offset > acc->weakest)
+    {
+        acc->weakest = offset;
+    }
+
+    if (offset < acc->strongest)
+    {
+        acc->strongest = offset;
+    }
+
+    if (acc->count < UINT16_MAX)
+    {
+        acc->count++;
+        acc->sum += offset;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ring_push
+********************************************************************************
+* Summary:
+* Appends an aggregate to a ring, overwriting the oldest one when full.
+*******************************************************************************/
+static void ring_push(rssi_history_agg_t *ring, uint16_t depth, uint16_t *head,
+                      uint16_t *count, const rssi_history_agg_t *agg)
+{
+    ring[*head] = *agg;
+    *head = (uint16_t)((*head + 1U) % depth);
+
+    if (*count < depth)
+    {
+        (*count)++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: interval_close
+********************************************************************************
+* Summary:
+* Closes the intervals between 'epoch' and 'new_epoch'. The interval that was
+* open is pushed with its aggregate and any fully skipped interval is pushed
+* as empty. The number of pushed intervals is bounded by the ring depth.
+*******************************************************************************/
+static void interval_close(rssi_history_agg_t *ring, uint16_t depth,
+                           uint16_t *head, uint16_t *count,
+                           rssi_accumulator_t *acc, uint32_t *epoch,
+                           uint32_t new_epoch)
+{
+    if (new_epoch <= *epoch)
+    {
+        return;
+    }
+
+    if (0U != acc->count)
+    {
+        rssi_history_agg_t agg =
+        {
+            .weakest   = acc->weakest,
+            .mean      = (uint8_t)((acc->sum + (acc->count / 2U)) / acc->count),
+            .strongest = acc->strongest
+        };
+
+        ring_push(ring, depth, head, count, &agg);
+    }
+    else
+    {
+        ring_push(ring, depth, head, count, &empty_agg);
+    }
+
+    uint32_t skipped = new_epoch - *epoch - 1U;
+
+    if (skipped > depth)
+    {
+        skipped = depth;
+    }
+
+    while (0U != skipped--)
+    {
+        ring_push(ring, depth, head, count, &empty_agg);
+    }
+
+    accumulator_reset(acc);
+    *epoch = new_epoch;
+}
+
+/*******************************************************************************
+* Function Name: slot_claim
+********************************************************************************
+* Summary:
+* Assigns a history slot to a BSSID table entry. A free slot is used first,
+* then the slot of a recycled table entry, and finally the slot whose owner
+* has not been seen for the longest time beyond RSSI_HISTORY_STALE_S.
+*******************************************************************************/
+static int32_t slot_claim(uint16_t table_index, uint16_t generation,
+                          uint32_t now_s)
+{
+    int32_t victim = RSSI_HISTORY_INVALID_SLOT;
+    uint32_t victim_age = 0;
+
+    for (uint32_t i = 0; i < RSSI_HISTORY_MAX_BSSIDS; i++)
+    {
+        rssi_history_slot_t *slot = &history_slots[i];
+        uint32_t age;
+
+        if ((!slot->in_use) ||
+            (!bssid_table_is_current(slot->table_index, slot->generation)))
+        {
+            victim = (int32_t)i;
+            break;
+        }
+
+        age = now_s - slot->last_seen_s;
+
+        if ((age >= RSSI_HISTORY_STALE_S) && (age > victim_age))
+        {
+            victim = (int32_t)i;
+            victim_age = age;
+        }
+    }
+
+    if (RSSI_HISTORY_INVALID_SLOT != victim)
+    {
+        rssi_history_slot_t *slot = &history_slots[victim];
+
+        if (slot->in_use)
+        {
+            history_slot_of_entry[slot->table_index] = RSSI_HISTORY_NO_OWNER;
+        }
+
+        memset(slot, 0, offsetof(rssi_history_slot_t, raw));
+        slot->table_index = table_index;
+        slot->generation = generation;
+        slot->in_use = true;
+        slot->pending = RSSI_HISTORY_NO_SAMPLE;
+        slot->last_seen_s = now_s;
+        slot->minute_epoch = now_s / SECONDS_PER_MINUTE;
+        slot->hour_epoch = now_s / SECONDS_PER_HOUR;
+        accumulator_reset(&slot->minute_acc);
+        accumulator_reset(&slot->hour_acc);
+
+        history_slot_of_entry[table_index] = (uint16_t)victim;
+    }
+
+    return victim;
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_init
+********************************************************************************
+* Summary:
+* Clears the history of all the BSSIDs.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rssi_history_init(void)
+{
+    memset(history_slots, 0, sizeof(history_slots));
+    memset(history_slot_of_entry, 0xFF, sizeof(history_slot_of_entry));
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_find
+********************************************************************************
+* Summary:
+* Returns the history slot of a BSSID table entry.
+*
+* Parameters:
+*  uint16_t table_index: Index of the BSSID in the BSSID table
+*  uint16_t generation: Generation of the BSSID table entry
+*
+* Return:
+*  int32_t: Slot number or RSSI_HISTORY_INVALID_SLOT if not tracked
+*
+*******************************************************************************/
+int32_t rssi_history_find(uint16_t table_index, uint16_t generation)
+{
+    if (table_index >= BSSID_TABLE_MAX_ENTRIES)
+    {
+        return RSSI_HISTORY_INVALID_SLOT;
+    }
+
+    uint16_t slot = history_slot_of_entry[table_index];
+
+    if ((RSSI_HISTORY_NO_OWNER == slot) ||
+        (history_slots[slot].table_index != table_index) ||
+        (history_slots[slot].generation != generation))
+    {
+        return RSSI_HISTORY_INVALID_SLOT;
+    }
+
+    return (int32_t)slot;
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_observe
+********************************************************************************
+* Summary:
+* Records the RSSI of a BSSID seen in the scan that is in progress. The value
+* is applied to the rings by rssi_history_commit(). If the BSSID is reported
+* more than once in the same scan, the strongest value is kept.
+*
+* Parameters:
+*  uint16_t table_index: Index of the BSSID in the BSSID table
+*  uint16_t generation: Generation of the BSSID table entry
+*  int16_t rssi_dbm: RSSI of the scan result
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rssi_history_observe(uint16_t table_index, uint16_t generation,
+                          int16_t rssi_dbm, uint32_t now_s)
+{
+    int32_t slot = rssi_history_find(table_index, generation);
+
+    if (RSSI_HISTORY_INVALID_SLOT == slot)
+    {
+        slot = slot_claim(table_index, generation, now_s);
+
+        if (RSSI_HISTORY_INVALID_SLOT == slot)
+        {
+            return;
+        }
+    }
+
+    uint8_t offset = rssi_history_encode(rssi_dbm);
+
+    if (offset < history_slots[slot].pending)
+    {
+        history_slots[slot].pending = offset;
+    }
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_commit
+********************************************************************************
+* Summary:
+* Applies the samples of the completed scan to every tracked BSSID in O(1) per
+* BSSID. After a full sweep, a BSSID that was not seen gets a missing sample in
+* its raw ring; after a filtered scan only the BSSIDs that were seen are
+* updated.
+*
+* Parameters:
+*  uint32_t now_s: Time of scan completion in seconds
+*  bool full_sweep: true if the scan covered all channels without filter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rssi_history_commit(uint32_t now_s, bool full_sweep)
+{
+    for (uint32_t i = 0; i < RSSI_HISTORY_MAX_BSSIDS; i++)
+    {
+        rssi_history_slot_t *slot = &history_slots[i];
+        uint8_t offset = slot->pending;
+
+        if (!slot->in_use)
+        {
+            continue;
+        }
+
+        slot->pending = RSSI_HISTORY_NO_SAMPLE;
+
+        if ((RSSI_HISTORY_NO_SAMPLE == offset) && (!full_sweep))
+        {
+            continue;
+        }
+
+        interval_close(slot->minutes, RSSI_HISTORY_MINUTE_DEPTH,
+                       &slot->minute_head, &slot->minute_count,
+                       &slot->minute_acc, &slot->minute_epoch,
+                       now_s / SECONDS_PER_MINUTE);
+        interval_close(slot->hours, RSSI_HISTORY_HOUR_DEPTH,
+                       &slot->hour_head, &slot->hour_count,
+                       &slot->hour_acc, &slot->hour_epoch,
+                       now_s / SECONDS_PER_HOUR);
+
+        slot->raw[slot->raw_head] = offset;
+        slot->raw_head = (uint8_t)((slot->raw_head + 1U) % RSSI_HISTORY_RAW_DEPTH);
+
+        if (slot->raw_count < RSSI_HISTORY_RAW_DEPTH)
+        {
+            slot->raw_count++;
+        }
+
+        if (RSSI_HISTORY_NO_SAMPLE != offset)
+        {
+            accumulator_add(&slot->minute_acc, offset);
+            accumulator_add(&slot->hour_acc, offset);
+            slot->last_seen_s = now_s;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: ring_read
+********************************************************************************
+* Summary:
+* Copies the newest 'max' aggregates of a ring, oldest first.
+*******************************************************************************/
+static uint32_t ring_read(const rssi_history_agg_t *ring, uint16_t depth,
+                          uint16_t head, uint16_t count,
+                          rssi_history_agg_t *out, uint32_t max)
+{
+    uint32_t n = (count < max) ? count : max;
+    uint32_t pos = (head + depth - n) % depth;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out[i] = ring[pos];
+        pos = (pos + 1U) % depth;
+    }
+
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_read_raw
+********************************************************************************
+* Summary:
+* Copies the raw per-scan samples of a BSSID, oldest first. Each sample is an
+* offset below 0 dBm or RSSI_HISTORY_NO_SAMPLE.
+*
+* Parameters:
+*  int32_t slot: Slot returned by rssi_history_find
+*  uint8_t *out: Destination buffer
+*  uint32_t max: Capacity of the destination buffer
+*
+* Return:
+*  uint32_t: Number of samples copied
+*
+*******************************************************************************/
+uint32_t rssi_history_read_raw(int32_t slot, uint8_t *out, uint32_t max)
+{
+    if ((slot < 0) || (slot >= (int32_t)RSSI_HISTORY_MAX_BSSIDS))
+    {
+        return 0;
+    }
+
+    const rssi_history_slot_t *s = &history_slots[slot];
+    uint32_t n = (s->raw_count < max) ? s->raw_count : max;
+    uint32_t pos = (s->raw_head + RSSI_HISTORY_RAW_DEPTH - n) %
+                   RSSI_HISTORY_RAW_DEPTH;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out[i] = s->raw[pos];
+        pos = (pos + 1U) % RSSI_HISTORY_RAW_DEPTH;
+    }
+
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_read_minutes
+********************************************************************************
+* Summary:
+* Copies the newest completed per-minute aggregates of a BSSID, oldest first.
+*
+* Parameters:
+*  int32_t slot: Slot returned by rssi_history_find
+*  rssi_history_agg_t *out: Destination buffer
+*  uint32_t max: Capacity of the destination buffer
+*
+* Return:
+*  uint32_t: Number of aggregates copied
+*
+*******************************************************************************/
+uint32_t rssi_history_read_minutes(int32_t slot, rssi_history_agg_t *out,
+                                   uint32_t max)
+{
+    if ((slot < 0) || (slot >= (int32_t)RSSI_HISTORY_MAX_BSSIDS))
+    {
+        return 0;
+    }
+
+    const rssi_history_slot_t *s = &history_slots[slot];
+
+    return ring_read(s->minutes, RSSI_HISTORY_MINUTE_DEPTH, s->minute_head,
+                     s->minute_count, out, max);
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_read_hours
+********************************************************************************
+* Summary:
+* Copies the newest completed per-hour aggregates of a BSSID, oldest first.
+*
+* Parameters:
+*  int32_t slot: Slot returned by rssi_history_find
+*  rssi_history_agg_t *out: Destination buffer
+*  uint32_t max: Capacity of the destination buffer
+*
+* Return:
+*  uint32_t: Number of aggregates copied
+*
+*******************************************************************************/
+uint32_t rssi_history_read_hours(int32_t slot, rssi_history_agg_t *out,
+                                 uint32_t max)
+{
+    if ((slot < 0) || (slot >= (int32_t)RSSI_HISTORY_MAX_BSSIDS))
+    {
+        return 0;
+    }
+
+    const rssi_history_slot_t *s = &history_slots[slot];
+
+    return ring_read(s->hours, RSSI_HISTORY_HOUR_DEPTH, s->hour_head,
+                     s->hour_count, out, max);
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_export
+********************************************************************************
+* Summary:
+* Appends the mean RSSI of the completed minutes or hours of a BSSID to a
+* compressed series stream, oldest first. The timestamp of each record is the
+* start of the interval in seconds. Intervals in which the BSSID was not seen
+* are skipped; the gap shows up in the timestamps.
+*
+* Parameters:
+*  int32_t slot: Slot returned by rssi_history_find
+*  rssi_history_resolution_t resolution: Minutes or hours
+*  series_encoder_t *enc: Encoder to append to
+*
+* Return:
+*  uint32_t: Number of records appended
+*
+*******************************************************************************/
+uint32_t rssi_history_export(int32_t slot, rssi_history_resolution_t resolution,
+                             series_encoder_t *enc)
+{
+    const rssi_history_agg_t *ring;
+    uint32_t depth;
+    uint32_t head;
+    uint32_t count;
+    uint32_t interval_s;
+    uint32_t epoch;
+    uint32_t written = 0;
+
+    if ((slot < 0) || (slot >= (int32_t)RSSI_HISTORY_MAX_BSSIDS))
+    {
+        return 0;
+    }
+
+    const rssi_history_slot_t *s = &history_slots[slot];
+
+    if (RSSI_HISTORY_MINUTES == resolution)
+    {
+        ring = s->minutes;
+        depth = RSSI_HISTORY_MINUTE_DEPTH;
+        head = s->minute_head;
+        count = s->minute_count;
+        interval_s = SECONDS_PER_MINUTE;
+        epoch = s->minute_epoch;
+    }
+    else
+    {
+        ring = s->hours;
+        depth = RSSI_HISTORY_HOUR_DEPTH;
+        head = s->hour_head;
+        count = s->hour_count;
+        interval_s = SECONDS_PER_HOUR;
+        epoch = s->hour_epoch;
+    }
+
+    /* The newest completed interval is the one just before the open one. */
+    uint32_t pos = (head + depth - count) % depth;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const rssi_history_agg_t *agg = &ring[pos];
+
+        if (RSSI_HISTORY_NO_SAMPLE != agg->mean)
+        {
+            uint32_t timestamp = (epoch - count + i) * interval_s;
+
+            if (!series_encoder_put(enc, timestamp, agg->mean))
+            {
+                break;
+            }
+
+            written++;
+        }
+
+        pos = (pos + 1U) % depth;
+    }
+
+    return written;
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_bytes_per_bssid
+********************************************************************************
+* Summary:
+* Returns the RAM used by the history of one BSSID.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  size_t: Bytes per tracked BSSID
+*
+*******************************************************************************/
+size_t rssi_history_bytes_per_bssid(void)
+{
+    return sizeof(rssi_history_slot_t);
+}
+
+/*******************************************************************************
+* Function Name: rssi_history_total_bytes
+********************************************************************************
+* Summary:
+* Returns the RAM used by the history of all the BSSIDs.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  size_t: Total bytes
+*
+*******************************************************************************/
+size_t rssi_history_total_bytes(void)
+{
+    return sizeof(history_slots) + sizeof(history_slot_of_entry);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,162 @@
+/*******************************************************************************
+* File Name        : rssi_history.h
+*
+* Description      : This file contains the macros, structures, and function
+*                    prototypes of the multi-resolution per-BSSID RSSI history.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_RSSI_HISTORY_H_
+#define SOURCE_RSSI_HISTORY_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "series_codec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of BSSIDs for which the history is kept. Each BSSID costs
+ * rssi_history_bytes_per_bssid() bytes of RAM.
+ */
+#ifndef RSSI_HISTORY_MAX_BSSIDS
+#define RSSI_HISTORY_MAX_BSSIDS              (8U)
+#endif
+
+/* Depth of the three resolutions: raw samples of the last 64 scans, per-minute
+ * aggregates of the last 24 hours and per-hour aggregates of the last 30 days.
+ */
+#define RSSI_HISTORY_RAW_DEPTH               (64U)
+#define RSSI_HISTORY_MINUTE_DEPTH            (24U * 60U)
+#define RSSI_HISTORY_HOUR_DEPTH              (30U * 24U)
+
+/* A BSSID history slot is handed over to a new BSSID only if the current
+ * owner has not been seen for this long.
+ */
+#define RSSI_HISTORY_STALE_S                 (60U * 60U)
+
+/* RSSI values are stored as 8-bit offsets below 0 dBm. This value marks a
+ * scan or an interval in which the BSSID was not seen.
+ */
+#define RSSI_HISTORY_NO_SAMPLE               (0xFFU)
+#define RSSI_HISTORY_MAX_OFFSET              (127)
+
+#define RSSI_HISTORY_INVALID_SLOT            (-1)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Resolution of the aggregates exported by rssi_history_export. */
+typedef enum
+{
+    RSSI_HISTORY_MINUTES = 0,
+    RSSI_HISTORY_HOURS
+} rssi_history_resolution_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Aggregate of one minute or one hour. All fields are 8-bit offsets below
+ * 0 dBm, so 'weakest' holds the largest offset.
+ */
+typedef struct
+{
+    uint8_t weakest;
+    uint8_t mean;
+    uint8_t strongest;
+} rssi_history_agg_t;
+
+/*******************************************************************************
+* Inline functions
+*******************************************************************************/
+static inline uint8_t rssi_history_encode(int16_t rssi_dbm)
+{
+    int32_t offset = -(int32_t)rssi_dbm;
+
+    if (offset < 0)
+    {
+        offset = 0;
+    }
+    else if (offset > RSSI_HISTORY_MAX_OFFSET)
+    {
+        offset = RSSI_HISTORY_MAX_OFFSET;
+    }
+
+    return (uint8_t)offset;
+}
+
+static inline int16_t rssi_history_decode(uint8_t offset)
+{
+    return (int16_t)(-(int16_t)offset);
+}
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void rssi_history_init(void);
+void rssi_history_observe(uint16_t table_index, uint16_t generation,
+                          int16_t rssi_dbm, uint32_t now_s);
+void rssi_history_commit(uint32_t now_s, bool full_sweep);
+int32_t rssi_history_find(uint16_t table_index, uint16_t generation);
+uint32_t rssi_history_read_raw(int32_t slot, uint8_t *out, uint32_t max);
+uint32_t rssi_history_read_minutes(int32_t slot, rssi_history_agg_t *out,
+                                   uint32_t max);
+uint32_t rssi_history_read_hours(int32_t slot, rssi_history_agg_t *out,
+                                 uint32_t max);
+uint32_t rssi_history_export(int32_t slot, rssi_history_resolution_t resolution,
+                             series_encoder_t *enc);
+size_t rssi_history_bytes_per_bssid(void);
+size_t rssi_history_total_bytes(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_RSSI_HISTORY_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,393 @@
+/*******************************************************************************
+* File Name        : scan_log.c
+*
+* Description      : This file contains the writer that builds one binary scan
+*                    log record per scan and passes it to the selected sink.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include "scan_log.h"
+#include "scan_output.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Record bytes converted to hexadecimal digits at a time. */
+#define SCAN_LOG_UART_CHUNK_SIZE             (32U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t scan_log_record[SCAN_LOG_MAX_RECORD_SIZE];
+static uint32_t scan_log_length;
+static uint16_t scan_log_ap_count;
+static scan_log_sink_t scan_log_sink;
+
+/* Fields selected for the records, and the fields and OUI dictionary of the
+ * record in progress.
+ */
+static uint16_t scan_log_fields = SCAN_LOG_FIELDS_V1 | SCAN_LOG_SCHEMA_PACKED_BSSID;
+static uint16_t scan_log_record_fields;
+static scan_log_oui_dict_t scan_log_record_dict;
+
+/* Results, SSID bytes and packed BSSID bytes of the scan in progress and of
+ * the last scan, counted whether or not logging and packing are on.
+ */
+static uint32_t scan_log_scan_aps;
+static uint32_t scan_log_scan_ssid_bytes;
+static uint32_t scan_log_scan_bssid_bytes;
+static scan_log_oui_dict_t scan_log_scan_dict;
+static uint32_t scan_log_last_aps;
+static uint32_t scan_log_last_ssid_bytes;
+static uint32_t scan_log_last_bssid_bytes;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: scan_log_set_sink
+********************************************************************************
+* Summary:
+* Selects where the completed records are sent. Logging is disabled when the
+* sink is NULL.
+*
+* Parameters:
+*  scan_log_sink_t sink: Sink function or NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_set_sink(scan_log_sink_t sink)
+{
+    scan_log_sink = sink;
+}
+
+/*******************************************************************************
+* Function Name: scan_log_get_sink
+********************************************************************************
+* Summary:
+* Returns the sink selected by scan_log_set_sink.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  scan_log_sink_t: Current sink or NULL
+*
+*******************************************************************************/
+scan_log_sink_t scan_log_get_sink(void)
+{
+    return scan_log_sink;
+}
+
+/*******************************************************************************
+* Function Name: scan_log_set_fields
+********************************************************************************
+* Summary:
+* Selects the fields of the AP entries of the records, from the next scan on.
+* The BSSID is always included and unknown fields are ignored. Whether the
+* BSSIDs are packed is kept.
+*
+* Parameters:
+*  uint16_t fields: SCAN_LOG_FIELD_* flags
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_set_fields(uint16_t fields)
+{
+    scan_log_fields = (fields & SCAN_LOG_FIELDS_ALL) | SCAN_LOG_FIELD_BSSID |
+                      (scan_log_fields & SCAN_LOG_SCHEMA_PACKED_BSSID);
+}
+
+/*******************************************************************************
+* Function Name: scan_log_set_packed
+********************************************************************************
+* Summary:
+* Selects whether the BSSIDs of the records are packed against an OUI
+* dictionary, from the next scan on.
+*
+* Parameters:
+*  bool packed: true to pack the BSSIDs
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_set_packed(bool packed)
+{
+    if (packed)
+    {
+        scan_log_fields |= SCAN_LOG_SCHEMA_PACKED_BSSID;
+    }
+    else
+    {
+        scan_log_fields &= (uint16_t)~SCAN_LOG_SCHEMA_PACKED_BSSID;
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_log_get_fields
+********************************************************************************
+* Summary:
+* Returns the fields selected by scan_log_set_fields, with
+* SCAN_LOG_SCHEMA_PACKED_BSSID if the BSSIDs are packed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint16_t: SCAN_LOG_FIELD_* flags
+*
+*******************************************************************************/
+uint16_t scan_log_get_fields(void)
+{
+    return scan_log_fields;
+}
+
+/*******************************************************************************
+* Function Name: scan_log_last_scan
+********************************************************************************
+* Summary:
+* Returns the number of results of the last completed scan, the bytes of
+* their SSIDs and the bytes of their packed BSSIDs, from which the size of the
+* records with any fields follows.
+*
+* Parameters:
+*  uint32_t *aps: Set to the number of results
+*  uint32_t *ssid_bytes: Set to the total length of their SSIDs
+*  uint32_t *bssid_bytes: Set to the total size of their packed BSSIDs
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_last_scan(uint32_t *aps, uint32_t *ssid_bytes, uint32_t *bssid_bytes)
+{
+    *aps = scan_log_last_aps;
+    *ssid_bytes = scan_log_last_ssid_bytes;
+    *bssid_bytes = scan_log_last_bssid_bytes;
+}
+
+/*******************************************************************************
+* Function Name: scan_log_begin
+********************************************************************************
+* Summary:
+* Starts the record of a new scan, with a schema of the fields its AP entries
+* carry.
+*
+* Parameters:
+*  uint32_t sequence: Sequence number of the scan
+*  bool full_sweep: true if the scan covered all channels without filter
+*  uint16_t fields: SCAN_LOG_FIELD_* flags of the AP entries, with
+*   SCAN_LOG_SCHEMA_PACKED_BSSID to pack the BSSIDs
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_begin(uint32_t sequence, bool full_sweep, uint16_t fields)
+{
+    scan_log_record_fields = (fields & (SCAN_LOG_FIELDS_ALL | SCAN_LOG_SCHEMA_PACKED_BSSID)) |
+                             SCAN_LOG_FIELD_BSSID;
+    scan_log_record_dict.count = 0U;
+
+    memset(scan_log_record, 0, SCAN_LOG_HEADER_SIZE);
+    scan_log_put_u16(&scan_log_record[SCAN_LOG_OFFSET_MAGIC], SCAN_LOG_MAGIC);
+    scan_log_record[SCAN_LOG_OFFSET_VERSION] = SCAN_LOG_VERSION_SCHEMA;
+    scan_log_record[SCAN_LOG_OFFSET_FLAGS] = full_sweep ? SCAN_LOG_FLAG_FULL_SWEEP : 0U;
+    scan_log_put_u32(&scan_log_record[SCAN_LOG_OFFSET_SEQUENCE], sequence);
+    scan_log_put_u16(&scan_log_record[SCAN_LOG_OFFSET_SCHEMA], scan_log_record_fields);
+
+    scan_log_length = SCAN_LOG_HEADER_SIZE + SCAN_LOG_SCHEMA_SIZE;
+    scan_log_ap_count = 0;
+    scan_log_scan_aps = 0U;
+    scan_log_scan_ssid_bytes = 0U;
+    scan_log_scan_bssid_bytes = 0U;
+    scan_log_scan_dict.count = 0U;
+}
+
+/*******************************************************************************
+* Function Name: scan_log_add
+********************************************************************************
+* Summary:
+* Appends an AP entry to the record of the scan in progress. An entry that
+* does not fit is dropped and the record is flagged as truncated. Its room is
+* checked before packing, so that a dropped entry does not enter the OUI
+* dictionary.
+*
+* Parameters:
+*  const scan_log_ap_t *ap: AP to append
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_add(const scan_log_ap_t *ap)
+{
+    uint32_t ssid_length = (ap->ssid_length > SCAN_LOG_SSID_MAX_LENGTH) ?
+                           SCAN_LOG_SSID_MAX_LENGTH : ap->ssid_length;
+    uint8_t packed[SCAN_LOG_PACKED_BSSID_MAX_SIZE];
+
+    scan_log_scan_aps++;
+    scan_log_scan_ssid_bytes += ssid_length;
+    scan_log_scan_bssid_bytes += scan_log_pack_bssid(&scan_log_scan_dict, ap->bssid, packed);
+
+    if (NULL == scan_log_sink)
+    {
+        return;
+    }
+
+    if ((scan_log_length + scan_log_ap_size(scan_log_record_fields, ssid_length)) >
+        SCAN_LOG_MAX_RECORD_SIZE)
+    {
+        scan_log_record[SCAN_LOG_OFFSET_FLAGS] |= SCAN_LOG_FLAG_TRUNCATED;
+        return;
+    }
+
+    scan_log_length += scan_log_encode_ap(&scan_log_record[scan_log_length],
+                                          scan_log_record_fields, &scan_log_record_dict, ap);
+    scan_log_ap_count++;
+}
+
+/*******************************************************************************
+* Function Name: scan_log_flag
+********************************************************************************
+* Summary:
+* Sets flags of the record of the scan in progress.
+*
+* Parameters:
+*  uint8_t flags: SCAN_LOG_FLAG_* flags to set
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_flag(uint8_t flags)
+{
+    scan_log_record[SCAN_LOG_OFFSET_FLAGS] |= flags;
+}
+
+/*******************************************************************************
+* Function Name: scan_log_end
+********************************************************************************
+* Summary:
+* Completes the record of the scan and passes it to the sink.
+*
+* Parameters:
+*  uint32_t timestamp: Time of scan completion in seconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_end(uint32_t timestamp)
+{
+    scan_log_last_aps = scan_log_scan_aps;
+    scan_log_last_ssid_bytes = scan_log_scan_ssid_bytes;
+    scan_log_last_bssid_bytes = scan_log_scan_bssid_bytes;
+
+    if (NULL == scan_log_sink)
+    {
+        return;
+    }
+
+    scan_log_put_u16(&scan_log_record[SCAN_LOG_OFFSET_LENGTH], (uint16_t)scan_log_length);
+    scan_log_put_u16(&scan_log_record[SCAN_LOG_OFFSET_AP_COUNT], scan_log_ap_count);
+    scan_log_put_u32(&scan_log_record[SCAN_LOG_OFFSET_TIMESTAMP], timestamp);
+    scan_log_put_u32(&scan_log_record[SCAN_LOG_OFFSET_CRC],
+                     scan_log_crc32(&scan_log_record[SCAN_LOG_HEADER_SIZE],
+                                    scan_log_length - SCAN_LOG_HEADER_SIZE));
+
+    scan_log_sink(scan_log_record, scan_log_length);
+}
+
+/*******************************************************************************
+* Function Name: scan_log_uart_sink
+********************************************************************************
+* Summary:
+* Prints a record on the debug UART as one line of hexadecimal digits after
+* SCAN_LOG_UART_PREFIX, so that it can be recovered from a terminal capture.
+* The line is queued with the scan output as one message, so a record that
+* does not fit in the queue is dropped whole rather than cut.
+*
+* Parameters:
+*  const uint8_t *record: Record to print
+*  uint32_t length: Length of the record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_log_uart_sink(const uint8_t *record, uint32_t length)
+{
+    static const char prefix[] = "\n" SCAN_LOG_UART_PREFIX;
+    static const char digits[] = "0123456789ABCDEF";
+    char hex[SCAN_LOG_UART_CHUNK_SIZE * 2U];
+
+    if (!scan_output_begin((sizeof(prefix) - 1U) + (2U * length) + 1U))
+    {
+        return;
+    }
+
+    scan_output_append(prefix, sizeof(prefix) - 1U);
+
+    for (uint32_t i = 0; i < length; i += SCAN_LOG_UART_CHUNK_SIZE)
+    {
+        uint32_t count = ((length - i) < SCAN_LOG_UART_CHUNK_SIZE) ?
+                         (length - i) : SCAN_LOG_UART_CHUNK_SIZE;
+
+        for (uint32_t j = 0; j < count; j++)
+        {
+            hex[2U * j] = digits[record[i + j] >> 4];
+            hex[(2U * j) + 1U] = digits[record[i + j] & 0x0FU];
+        }
+
+        scan_output_append(hex, 2U * count);
+    }
+
+    scan_output_append("\n", 1U);
+    scan_output_end();
+}
+
+/* [] END OF FILE */
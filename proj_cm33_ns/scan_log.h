@@ -0,0 +1,99 @@
+/*******************************************************************************
+* File Name        : scan_log.h
+*
+* Description      : This file contains the function prototypes of the writer
+*                    that serializes every scan into a binary scan log record.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SCAN_LOG_H_
+#define SOURCE_SCAN_LOG_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "scan_log_format.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Prefix of the lines carrying a hex encoded record on the debug UART. The
+ * host indexer imports such lines from a terminal capture.
+ */
+#define SCAN_LOG_UART_PREFIX                 "#SL "
+
+/* Prefix of the line that precedes scan results printed with other fields
+ * than SCAN_LOG_FIELDS_V1. It is followed by the schema version and the
+ * SCAN_LOG_FIELD_* flags in hexadecimal, and the columns are in field order.
+ */
+#define SCAN_LOG_SCHEMA_PREFIX               "#SS "
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Receives every completed record. */
+typedef void (*scan_log_sink_t)(const uint8_t *record, uint32_t length);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void scan_log_set_sink(scan_log_sink_t sink);
+scan_log_sink_t scan_log_get_sink(void);
+void scan_log_set_fields(uint16_t fields);
+void scan_log_set_packed(bool packed);
+uint16_t scan_log_get_fields(void);
+void scan_log_last_scan(uint32_t *aps, uint32_t *ssid_bytes, uint32_t *bssid_bytes);
+void scan_log_begin(uint32_t sequence, bool full_sweep, uint16_t fields);
+void scan_log_add(const scan_log_ap_t *ap);
+void scan_log_flag(uint8_t flags);
+void scan_log_end(uint32_t timestamp);
+void scan_log_uart_sink(const uint8_t *record, uint32_t length);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SCAN_LOG_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,714 @@
+/*******************************************************************************
+* File Name        : scan_log_format.h
+*
+* Description      : This file defines the binary scan log record format. It is
+*                    shared by the firmware writer and the host tools, so it only
+*                    uses C99 and explicit little-endian byte access.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SCAN_LOG_FORMAT_H_
+#define SOURCE_SCAN_LOG_FORMAT_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "hash_service.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* One record is written per scan (a snapshot). All multi-byte fields are
+ * little-endian and records are not padded.
+ *
+ * Snapshot header (SCAN_LOG_HEADER_SIZE bytes):
+ *   offset  size  field
+ *        0     2  magic (SCAN_LOG_MAGIC, "SL")
+ *        2     1  version (SCAN_LOG_VERSION)
+ *        3     1  flags (SCAN_LOG_FLAG_*)
+ *        4     2  length of the whole record including this header
+ *        6     2  number of AP entries
+ *        8     4  scan sequence number
+ *       12     4  timestamp of scan completion (seconds)
+ *       16     4  CRC-32 of the bytes following the header
+ *
+ * AP entry (SCAN_LOG_AP_FIXED_SIZE bytes followed by the SSID):
+ *        0     6  BSSID
+ *        6     1  RSSI in dBm (signed)
+ *        7     1  channel
+ *        8     1  band (cy_wcm_wifi_band_t)
+ *        9     4  security (cy_wcm_security_t)
+ *       13     1  SSID length (0 to 32)
+ *       14     n  SSID bytes, not NUL terminated
+ *
+ * Snapshots of version SCAN_LOG_VERSION_SCHEMA carry a schema after the
+ * header, and their AP entries only the fields it selects, in this order:
+ *       20     2  schema: SCAN_LOG_FIELD_* flags of the fields present
+ *
+ *   field     size  SCAN_LOG_FIELD_
+ *   BSSID        6  BSSID, always present
+ *   RSSI         1  RSSI
+ *   channel      1  CHANNEL
+ *   band         1  BAND
+ *   security     4  SECURITY
+ *   SSID       1+n  SSID, length then bytes
+ *   width        1  WIDTH, channel width of the BSS in units of 20 MHz
+ *
+ * A snapshot of version SCAN_LOG_VERSION has no schema and the fields of
+ * SCAN_LOG_FIELDS_V1, so its AP entries are laid out as above.
+ *
+ * With SCAN_LOG_SCHEMA_PACKED_BSSID in the schema, the BSSIDs are packed
+ * against the earlier BSSIDs of the record. The record carries a dictionary
+ * of up to SCAN_LOG_OUI_DICT_SIZE OUIs, each added by the first BSSID with
+ * it, and remembers the 4th and 5th bytes of the last BSSID of each OUI. A
+ * packed BSSID starts with a tag:
+ *   0x00-0x3F  4 bytes: OUI index, then the last 3 bytes
+ *   0x40-0x7F  2 bytes: 0x40 + OUI index, then the last byte; the 4th and 5th
+ *              bytes are those of the last BSSID of the OUI (a sibling BSSID
+ *              of the same AP)
+ *   0x80-0xBF  3 bytes: 0x80 + OUI index, the first byte, then the last byte;
+ *              as a sibling, but with another first byte, as for locally
+ *              administered virtual BSSIDs derived from the OUI
+ *   0xFE       7 bytes: the BSSID, whose OUI is added to the dictionary
+ *   0xFF       7 bytes: the BSSID, with the dictionary full
+ */
+#define SCAN_LOG_MAGIC                       (0x4C53U)
+#define SCAN_LOG_VERSION                     (1U)
+#define SCAN_LOG_VERSION_SCHEMA              (2U)
+
+#define SCAN_LOG_HEADER_SIZE                 (20U)
+#define SCAN_LOG_OFFSET_MAGIC                (0U)
+#define SCAN_LOG_OFFSET_VERSION              (2U)
+#define SCAN_LOG_OFFSET_FLAGS                (3U)
+#define SCAN_LOG_OFFSET_LENGTH               (4U)
+#define SCAN_LOG_OFFSET_AP_COUNT             (6U)
+#define SCAN_LOG_OFFSET_SEQUENCE             (8U)
+#define SCAN_LOG_OFFSET_TIMESTAMP            (12U)
+#define SCAN_LOG_OFFSET_CRC                  (16U)
+
+#define SCAN_LOG_SCHEMA_SIZE                 (2U)
+#define SCAN_LOG_OFFSET_SCHEMA               (20U)
+
+#define SCAN_LOG_FIELD_BSSID                 (0x0001U)
+#define SCAN_LOG_FIELD_RSSI                  (0x0002U)
+#define SCAN_LOG_FIELD_CHANNEL               (0x0004U)
+#define SCAN_LOG_FIELD_BAND                  (0x0008U)
+#define SCAN_LOG_FIELD_SECURITY              (0x0010U)
+#define SCAN_LOG_FIELD_SSID                  (0x0020U)
+#define SCAN_LOG_FIELD_WIDTH                 (0x0040U)
+#define SCAN_LOG_FIELD_COUNT                 (7U)
+
+#define SCAN_LOG_FIELDS_V1                   (0x003FU)
+#define SCAN_LOG_FIELDS_ALL                  (0x007FU)
+
+#define SCAN_LOG_WIDTH_UNIT_MHZ              (20U)
+
+#define SCAN_LOG_SCHEMA_PACKED_BSSID         (0x8000U)
+#define SCAN_LOG_OUI_DICT_SIZE               (64U)
+#define SCAN_LOG_OUI_LENGTH                  (3U)
+#define SCAN_LOG_PACKED_BSSID_MAX_SIZE       (1U + SCAN_LOG_BSSID_LENGTH)
+
+#define SCAN_LOG_PACKED_TAG_NIC              (0x00U)
+#define SCAN_LOG_PACKED_TAG_SIBLING          (0x40U)
+#define SCAN_LOG_PACKED_TAG_LOCAL_SIBLING    (0x80U)
+#define SCAN_LOG_PACKED_TAG_NEW_OUI          (0xFEU)
+#define SCAN_LOG_PACKED_TAG_LITERAL          (0xFFU)
+#define SCAN_LOG_PACKED_INDEX_MASK           (0x3FU)
+
+#define SCAN_LOG_AP_FIXED_SIZE               (14U)
+#define SCAN_LOG_AP_OFFSET_BSSID             (0U)
+#define SCAN_LOG_AP_OFFSET_RSSI              (6U)
+#define SCAN_LOG_AP_OFFSET_CHANNEL           (7U)
+#define SCAN_LOG_AP_OFFSET_BAND              (8U)
+#define SCAN_LOG_AP_OFFSET_SECURITY          (9U)
+#define SCAN_LOG_AP_OFFSET_SSID_LENGTH       (13U)
+#define SCAN_LOG_AP_OFFSET_SSID              (14U)
+
+#define SCAN_LOG_BSSID_LENGTH                (6U)
+#define SCAN_LOG_SSID_MAX_LENGTH             (32U)
+#define SCAN_LOG_AP_MAX_SIZE                 (SCAN_LOG_AP_FIXED_SIZE + SCAN_LOG_SSID_MAX_LENGTH)
+
+/* ESS record, written after the snapshot of a scan. Its header has the layout
+ * of the snapshot header with SCAN_LOG_ESS_MAGIC ("SE") and the number of
+ * network entries in place of the number of AP entries.
+ *
+ * Network entry (SCAN_LOG_ESS_FIXED_SIZE bytes followed by the SSID):
+ *        0     6  best BSSID
+ *        6     1  smoothed RSSI of the best BSSID in dBm (signed)
+ *        7     1  bands (bit 1 << cy_wcm_wifi_band_t for each band seen)
+ *        8     4  security (cy_wcm_security_t)
+ *       12     2  number of BSSIDs
+ *       14     1  number of distinct channels
+ *       15     1  lowest channel
+ *       16     1  highest channel
+ *       17     1  SSID length (0 to 32)
+ *       18     n  SSID bytes, not NUL terminated
+ */
+#define SCAN_LOG_ESS_MAGIC                   (0x4553U)
+
+#define SCAN_LOG_ESS_FIXED_SIZE              (18U)
+#define SCAN_LOG_ESS_OFFSET_BSSID            (0U)
+#define SCAN_LOG_ESS_OFFSET_RSSI             (6U)
+#define SCAN_LOG_ESS_OFFSET_BANDS            (7U)
+#define SCAN_LOG_ESS_OFFSET_SECURITY         (8U)
+#define SCAN_LOG_ESS_OFFSET_BSSIDS           (12U)
+#define SCAN_LOG_ESS_OFFSET_CHANNELS         (14U)
+#define SCAN_LOG_ESS_OFFSET_MIN_CHANNEL      (15U)
+#define SCAN_LOG_ESS_OFFSET_MAX_CHANNEL      (16U)
+#define SCAN_LOG_ESS_OFFSET_SSID_LENGTH      (17U)
+#define SCAN_LOG_ESS_OFFSET_SSID             (18U)
+
+/* Occupancy record, written when an hour of scans is folded into the
+ * time-of-day buckets and used to persist them. Its header has the layout of
+ * the snapshot header with SCAN_LOG_OCCUPANCY_MAGIC ("CO"), the number of
+ * bucket entries in place of the number of AP entries and the number of hours
+ * folded so far in place of the sequence number.
+ *
+ * Bucket entry (SCAN_LOG_OCCUPANCY_ENTRY_SIZE bytes), for visited buckets only:
+ *        0     1  bucket: day * 24 + hour, day 0 is Sunday
+ *        1     1  number of weeks the hour was seen, saturating at 255
+ *        2     3  mean number of BSSIDs in the 2.4, 5 and 6 GHz bands
+ *        5     1  standard deviation of the number of BSSIDs, in 1/4
+ *        6     1  BSSIDs appeared or disappeared per sweep, in 1/4
+ *        7     1  mean RSSI in dBm (signed)
+ *        8     3  load of the 2.4, 5 and 6 GHz bands in dB above -100 dBm
+ *       11    12  FNV-1a hashes of the three most seen SSIDs, 0 if none
+ */
+#define SCAN_LOG_OCCUPANCY_MAGIC             (0x4F43U)
+
+#define SCAN_LOG_OCCUPANCY_ENTRY_SIZE        (23U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_BUCKET     (0U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_VISITS     (1U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_APS        (2U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_SPREAD     (5U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_CHURN      (6U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_RSSI       (7U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_LOAD       (8U)
+#define SCAN_LOG_OCCUPANCY_OFFSET_SSIDS      (11U)
+
+/* Signature record, written after each batch of records when signing is on
+ * (see scan_sign.h). Its header has the layout of the snapshot header with
+ * SCAN_LOG_SIGNATURE_MAGIC ("SB"), the number of records of the batch in
+ * place of the number of AP entries, the batch number in place of the
+ * sequence number and the timestamp of the last record of the batch.
+ *
+ * Body (SCAN_LOG_SIGNATURE_BODY_SIZE bytes):
+ *        0     8  key identifier: first bytes of the SHA-256 of the public key
+ *        8    64  ECDSA P-256 signature, r then s, big-endian
+ *
+ * The signature is over the SHA-256 of the records of the batch, whole and in
+ * output order, followed by the first SCAN_LOG_OFFSET_CRC bytes of the
+ * signature record and the key identifier. Batch numbers start at 0 when the
+ * device starts.
+ */
+#define SCAN_LOG_SIGNATURE_MAGIC             (0x4253U)
+
+#define SCAN_LOG_SIGNATURE_KEY_ID_SIZE       (8U)
+#define SCAN_LOG_SIGNATURE_SIZE              (64U)
+#define SCAN_LOG_SIGNATURE_BODY_SIZE         (SCAN_LOG_SIGNATURE_KEY_ID_SIZE + \
+                                              SCAN_LOG_SIGNATURE_SIZE)
+#define SCAN_LOG_SIGNATURE_RECORD_SIZE       (SCAN_LOG_HEADER_SIZE + SCAN_LOG_SIGNATURE_BODY_SIZE)
+#define SCAN_LOG_SIGNATURE_OFFSET_KEY_ID     (0U)
+#define SCAN_LOG_SIGNATURE_OFFSET_SIGNATURE  (8U)
+
+/* Largest record the firmware writes. APs that do not fit are dropped and
+ * the record is flagged SCAN_LOG_FLAG_TRUNCATED.
+ */
+#define SCAN_LOG_MAX_RECORD_SIZE             (4096U)
+
+/* The scan covered all channels without filter, so an AP missing from the
+ * record was not seen.
+ */
+#define SCAN_LOG_FLAG_FULL_SWEEP             (0x01U)
+/* Some results of the scan did not fit in the record. */
+#define SCAN_LOG_FLAG_TRUNCATED              (0x02U)
+/* The BSSIDs and SSIDs are keyed-hash pseudonyms (see pseudonym.h). */
+#define SCAN_LOG_FLAG_PSEUDONYMS             (0x04U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* OUI dictionary of a record with packed BSSIDs, and the 4th and 5th bytes
+ * of the last BSSID of each OUI.
+ */
+typedef struct
+{
+    uint8_t count;
+    uint8_t oui[SCAN_LOG_OUI_DICT_SIZE][SCAN_LOG_OUI_LENGTH];
+    uint8_t nic[SCAN_LOG_OUI_DICT_SIZE][2];
+} scan_log_oui_dict_t;
+
+/* Decoded snapshot header. 'fields' are the SCAN_LOG_FIELD_* flags of the AP
+ * entries, with SCAN_LOG_SCHEMA_PACKED_BSSID, and the entries start at offset
+ * 'body'. 'dict' is the OUI dictionary of the entries decoded so far.
+ */
+typedef struct
+{
+    uint8_t  version;
+    uint8_t  flags;
+    uint16_t length;
+    uint16_t ap_count;
+    uint32_t sequence;
+    uint32_t timestamp;
+    uint32_t crc;
+    uint16_t fields;
+    uint16_t body;
+    scan_log_oui_dict_t dict;
+} scan_log_header_t;
+
+/* Decoded AP entry. */
+typedef struct
+{
+    uint8_t  bssid[SCAN_LOG_BSSID_LENGTH];
+    int8_t   rssi;
+    uint8_t  channel;
+    uint8_t  band;
+    uint32_t security;
+    uint8_t  ssid_length;
+    uint8_t  ssid[SCAN_LOG_SSID_MAX_LENGTH];
+    uint16_t width_mhz;
+} scan_log_ap_t;
+
+/*******************************************************************************
+* Inline functions
+*******************************************************************************/
+static inline uint16_t scan_log_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static inline uint32_t scan_log_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void scan_log_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void scan_log_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* CRC-32 (IEEE 802.3, reflected), from the hash service. */
+static inline uint32_t scan_log_crc32(const uint8_t *data, uint32_t length)
+{
+    return hash_service_crc32(data, length);
+}
+
+/* Size of an AP entry with the given fields and SSID length, at most with
+ * packed BSSIDs.
+ */
+static inline uint32_t scan_log_ap_size(uint16_t fields, uint32_t ssid_length)
+{
+    return ((0U != (fields & SCAN_LOG_SCHEMA_PACKED_BSSID)) ?
+            SCAN_LOG_PACKED_BSSID_MAX_SIZE : SCAN_LOG_BSSID_LENGTH) +
+           ((0U != (fields & SCAN_LOG_FIELD_RSSI)) ? 1U : 0U) +
+           ((0U != (fields & SCAN_LOG_FIELD_CHANNEL)) ? 1U : 0U) +
+           ((0U != (fields & SCAN_LOG_FIELD_BAND)) ? 1U : 0U) +
+           ((0U != (fields & SCAN_LOG_FIELD_SECURITY)) ? 4U : 0U) +
+           ((0U != (fields & SCAN_LOG_FIELD_SSID)) ? (1U + ssid_length) : 0U) +
+           ((0U != (fields & SCAN_LOG_FIELD_WIDTH)) ? 1U : 0U);
+}
+
+/* Decodes and validates a snapshot header. 'available' is the number of bytes
+ * from 'p' to the end of the log. The CRC is not checked. A schema with
+ * fields this decoder does not know is rejected, as their size is unknown.
+ */
+static inline bool scan_log_parse_header(const uint8_t *p, uint32_t available,
+                                         scan_log_header_t *hdr)
+{
+    if ((available < SCAN_LOG_HEADER_SIZE) ||
+        (SCAN_LOG_MAGIC != scan_log_get_u16(p + SCAN_LOG_OFFSET_MAGIC)) ||
+        ((SCAN_LOG_VERSION != p[SCAN_LOG_OFFSET_VERSION]) &&
+         (SCAN_LOG_VERSION_SCHEMA != p[SCAN_LOG_OFFSET_VERSION])))
+    {
+        return false;
+    }
+
+    hdr->version = p[SCAN_LOG_OFFSET_VERSION];
+    hdr->flags = p[SCAN_LOG_OFFSET_FLAGS];
+    hdr->length = scan_log_get_u16(p + SCAN_LOG_OFFSET_LENGTH);
+    hdr->ap_count = scan_log_get_u16(p + SCAN_LOG_OFFSET_AP_COUNT);
+    hdr->sequence = scan_log_get_u32(p + SCAN_LOG_OFFSET_SEQUENCE);
+    hdr->timestamp = scan_log_get_u32(p + SCAN_LOG_OFFSET_TIMESTAMP);
+    hdr->crc = scan_log_get_u32(p + SCAN_LOG_OFFSET_CRC);
+    hdr->fields = SCAN_LOG_FIELDS_V1;
+    hdr->body = SCAN_LOG_HEADER_SIZE;
+    hdr->dict.count = 0U;
+
+    if (SCAN_LOG_VERSION_SCHEMA == hdr->version)
+    {
+        if ((hdr->length < (SCAN_LOG_HEADER_SIZE + SCAN_LOG_SCHEMA_SIZE)) ||
+            (available < (SCAN_LOG_HEADER_SIZE + SCAN_LOG_SCHEMA_SIZE)))
+        {
+            return false;
+        }
+
+        hdr->fields = scan_log_get_u16(p + SCAN_LOG_OFFSET_SCHEMA);
+        hdr->body = SCAN_LOG_HEADER_SIZE + SCAN_LOG_SCHEMA_SIZE;
+
+        if ((0U != (hdr->fields &
+                    (uint16_t)~(SCAN_LOG_FIELDS_ALL | SCAN_LOG_SCHEMA_PACKED_BSSID))) ||
+            (0U == (hdr->fields & SCAN_LOG_FIELD_BSSID)))
+        {
+            return false;
+        }
+    }
+
+    return ((hdr->length >= hdr->body) &&
+            (hdr->length <= SCAN_LOG_MAX_RECORD_SIZE) &&
+            (hdr->length <= available));
+}
+
+/* Checks the CRC of a record whose header was accepted by
+ * scan_log_parse_header.
+ */
+static inline bool scan_log_check_crc(const uint8_t *p, const scan_log_header_t *hdr)
+{
+    return (hdr->crc == scan_log_crc32(p + SCAN_LOG_HEADER_SIZE,
+                                       (uint32_t)hdr->length - SCAN_LOG_HEADER_SIZE));
+}
+
+/* Name of the field with flag 1 << 'bit', as used by the console and the
+ * host tools.
+ */
+static inline const char *scan_log_field_name(uint32_t bit)
+{
+    static const char *const names[SCAN_LOG_FIELD_COUNT] =
+    {
+        "bssid", "rssi", "channel", "band", "security", "ssid", "width"
+    };
+
+    return (bit < SCAN_LOG_FIELD_COUNT) ? names[bit] : "?";
+}
+
+/* Packs a BSSID against the dictionary of the record, which it updates, and
+ * returns the size of the packed BSSID, at most SCAN_LOG_PACKED_BSSID_MAX_SIZE.
+ */
+static inline uint32_t scan_log_pack_bssid(scan_log_oui_dict_t *dict, const uint8_t *bssid,
+                                           uint8_t *p)
+{
+    uint32_t local = SCAN_LOG_OUI_DICT_SIZE;
+
+    for (uint32_t i = 0; i < dict->count; i++)
+    {
+        bool sibling = (0 == memcmp(dict->nic[i], &bssid[3], 2));
+
+        if (0 != memcmp(&dict->oui[i][1], &bssid[1], SCAN_LOG_OUI_LENGTH - 1U))
+        {
+            continue;
+        }
+
+        if (dict->oui[i][0] == bssid[0])
+        {
+            if (sibling)
+            {
+                p[0] = (uint8_t)(SCAN_LOG_PACKED_TAG_SIBLING | i);
+                p[1] = bssid[5];
+                return 2U;
+            }
+
+            p[0] = (uint8_t)(SCAN_LOG_PACKED_TAG_NIC | i);
+            memcpy(&p[1], &bssid[3], 3);
+            memcpy(dict->nic[i], &bssid[3], 2);
+            return 4U;
+        }
+
+        if (sibling && (SCAN_LOG_OUI_DICT_SIZE == local))
+        {
+            local = i;
+        }
+    }
+
+    /* An exact OUI is searched first, as its first byte is not repeated. */
+    if (SCAN_LOG_OUI_DICT_SIZE != local)
+    {
+        p[0] = (uint8_t)(SCAN_LOG_PACKED_TAG_LOCAL_SIBLING | local);
+        p[1] = bssid[0];
+        p[2] = bssid[5];
+        return 3U;
+    }
+
+    if (dict->count < SCAN_LOG_OUI_DICT_SIZE)
+    {
+        memcpy(dict->oui[dict->count], bssid, SCAN_LOG_OUI_LENGTH);
+        memcpy(dict->nic[dict->count], &bssid[3], 2);
+        dict->count++;
+        p[0] = SCAN_LOG_PACKED_TAG_NEW_OUI;
+    }
+    else
+    {
+        p[0] = SCAN_LOG_PACKED_TAG_LITERAL;
+    }
+
+    memcpy(&p[1], bssid, SCAN_LOG_BSSID_LENGTH);
+
+    return SCAN_LOG_PACKED_BSSID_MAX_SIZE;
+}
+
+/* Unpacks a BSSID of at most 'available' bytes, updating the dictionary like
+ * scan_log_pack_bssid(). Returns its size, or 0 if it is invalid.
+ */
+static inline uint32_t scan_log_unpack_bssid(scan_log_oui_dict_t *dict, const uint8_t *p,
+                                             uint32_t available, uint8_t *bssid)
+{
+    uint8_t tag = (available > 0U) ? p[0] : SCAN_LOG_PACKED_TAG_LITERAL;
+    uint32_t i = tag & SCAN_LOG_PACKED_INDEX_MASK;
+    uint32_t size;
+
+    if ((SCAN_LOG_PACKED_TAG_NEW_OUI == tag) || (SCAN_LOG_PACKED_TAG_LITERAL == tag))
+    {
+        size = SCAN_LOG_PACKED_BSSID_MAX_SIZE;
+
+        if ((available < size) ||
+            ((SCAN_LOG_PACKED_TAG_NEW_OUI == tag) && (dict->count >= SCAN_LOG_OUI_DICT_SIZE)))
+        {
+            return 0U;
+        }
+
+        memcpy(bssid, &p[1], SCAN_LOG_BSSID_LENGTH);
+
+        if (SCAN_LOG_PACKED_TAG_NEW_OUI == tag)
+        {
+            memcpy(dict->oui[dict->count], bssid, SCAN_LOG_OUI_LENGTH);
+            memcpy(dict->nic[dict->count], &bssid[3], 2);
+            dict->count++;
+        }
+
+        return size;
+    }
+
+    size = (tag < SCAN_LOG_PACKED_TAG_SIBLING) ? 4U :
+           (tag < SCAN_LOG_PACKED_TAG_LOCAL_SIBLING) ? 2U : 3U;
+
+    if ((tag >= (SCAN_LOG_PACKED_TAG_LOCAL_SIBLING + SCAN_LOG_OUI_DICT_SIZE)) ||
+        (i >= dict->count) || (available < size))
+    {
+        return 0U;
+    }
+
+    memcpy(bssid, dict->oui[i], SCAN_LOG_OUI_LENGTH);
+
+    if (tag < SCAN_LOG_PACKED_TAG_SIBLING)
+    {
+        memcpy(&bssid[3], &p[1], 3);
+        memcpy(dict->nic[i], &bssid[3], 2);
+    }
+    else
+    {
+        memcpy(&bssid[3], dict->nic[i], 2);
+        bssid[5] = p[size - 1U];
+
+        if (tag >= SCAN_LOG_PACKED_TAG_LOCAL_SIBLING)
+        {
+            bssid[0] = p[1];
+        }
+    }
+
+    return size;
+}
+
+/* Encodes the given fields of an AP entry at 'p', which must have room for
+ * scan_log_ap_size() bytes, and returns its size. 'dict' is the dictionary
+ * of the record, used with SCAN_LOG_SCHEMA_PACKED_BSSID.
+ */
+static inline uint32_t scan_log_encode_ap(uint8_t *p, uint16_t fields, scan_log_oui_dict_t *dict,
+                                          const scan_log_ap_t *ap)
+{
+    uint8_t *start = p;
+    uint8_t ssid_length = (ap->ssid_length > SCAN_LOG_SSID_MAX_LENGTH) ?
+                          SCAN_LOG_SSID_MAX_LENGTH : ap->ssid_length;
+
+    if (0U != (fields & SCAN_LOG_SCHEMA_PACKED_BSSID))
+    {
+        p += scan_log_pack_bssid(dict, ap->bssid, p);
+    }
+    else
+    {
+        memcpy(p, ap->bssid, SCAN_LOG_BSSID_LENGTH);
+        p += SCAN_LOG_BSSID_LENGTH;
+    }
+
+    if (0U != (fields & SCAN_LOG_FIELD_RSSI))
+    {
+        *p++ = (uint8_t)ap->rssi;
+    }
+
+    if (0U != (fields & SCAN_LOG_FIELD_CHANNEL))
+    {
+        *p++ = ap->channel;
+    }
+
+    if (0U != (fields & SCAN_LOG_FIELD_BAND))
+    {
+        *p++ = ap->band;
+    }
+
+    if (0U != (fields & SCAN_LOG_FIELD_SECURITY))
+    {
+        scan_log_put_u32(p, ap->security);
+        p += 4;
+    }
+
+    if (0U != (fields & SCAN_LOG_FIELD_SSID))
+    {
+        *p++ = ssid_length;
+        memcpy(p, ap->ssid, ssid_length);
+        p += ssid_length;
+    }
+
+    if (0U != (fields & SCAN_LOG_FIELD_WIDTH))
+    {
+        *p++ = (uint8_t)(ap->width_mhz / SCAN_LOG_WIDTH_UNIT_MHZ);
+    }
+
+    return (uint32_t)(p - start);
+}
+
+/* Decodes the AP entry at '*offset' of a record and advances the offset.
+ * Fields the record does not carry are zero. Packed BSSIDs refer to earlier
+ * entries, so the entries must be decoded in order from 'body'. Returns false
+ * if the entry is invalid or overruns the record.
+ */
+static inline bool scan_log_parse_ap(const uint8_t *record, scan_log_header_t *hdr,
+                                     uint32_t *offset, scan_log_ap_t *ap)
+{
+    const uint8_t *p = record + *offset;
+    uint32_t bssid_size = SCAN_LOG_BSSID_LENGTH;
+
+    if (*offset > hdr->length)
+    {
+        return false;
+    }
+
+    memset(ap, 0, sizeof(*ap));
+
+    if (0U != (hdr->fields & SCAN_LOG_SCHEMA_PACKED_BSSID))
+    {
+        bssid_size = scan_log_unpack_bssid(&hdr->dict, p, hdr->length - *offset, ap->bssid);
+
+        if (0U == bssid_size)
+        {
+            return false;
+        }
+    }
+    else if ((*offset + SCAN_LOG_BSSID_LENGTH) <= hdr->length)
+    {
+        memcpy(ap->bssid, p, SCAN_LOG_BSSID_LENGTH);
+    }
+
+    uint32_t end = *offset + bssid_size + scan_log_ap_size(hdr->fields & SCAN_LOG_FIELDS_ALL, 0U) -
+                   SCAN_LOG_BSSID_LENGTH;
+
+    if (end > hdr->length)
+    {
+        return false;
+    }
+
+    p += bssid_size;
+
+    if (0U != (hdr->fields & SCAN_LOG_FIELD_RSSI))
+    {
+        ap->rssi = (int8_t)*p++;
+    }
+
+    if (0U != (hdr->fields & SCAN_LOG_FIELD_CHANNEL))
+    {
+        ap->channel = *p++;
+    }
+
+    if (0U != (hdr->fields & SCAN_LOG_FIELD_BAND))
+    {
+        ap->band = *p++;
+    }
+
+    if (0U != (hdr->fields & SCAN_LOG_FIELD_SECURITY))
+    {
+        ap->security = scan_log_get_u32(p);
+        p += 4;
+    }
+
+    if (0U != (hdr->fields & SCAN_LOG_FIELD_SSID))
+    {
+        uint8_t ssid_length = *p++;
+
+        if ((ssid_length > SCAN_LOG_SSID_MAX_LENGTH) || ((end + ssid_length) > hdr->length))
+        {
+            return false;
+        }
+
+        ap->ssid_length = ssid_length;
+        memcpy(ap->ssid, p, ssid_length);
+        p += ssid_length;
+        end += ssid_length;
+    }
+
+    if (0U != (hdr->fields & SCAN_LOG_FIELD_WIDTH))
+    {
+        ap->width_mhz = (uint16_t)(*p * SCAN_LOG_WIDTH_UNIT_MHZ);
+    }
+
+    *offset = end;
+
+    return true;
+}
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SCAN_LOG_FORMAT_H_ */
+
+/* [] END OF FILE */
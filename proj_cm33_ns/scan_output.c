@@ -0,0 +1,695 @@
+/*******************************************************************************
+* File Name        : scan_output.c
+*
+* Description      : This file contains the scan output queue. The scan results
+*                    used to be printed from the scan callback, so a dense place or a
+*                    slow terminal held up the scans. They are now queued in a ring
+*                    buffer, drained to the debug UART by a low priority task, and the
+*                    scans reduce their output while the UART falls behind.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "scan_output.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define OUTPUT_RING_MASK                     (SCAN_OUTPUT_RING_SIZE - 1U)
+
+/* Weight of a new freshness in its moving average, as a shift. */
+#define OUTPUT_FRESHNESS_SHIFT               (3U)
+
+/* A reduced output is restored at the latest after this many scans, so that
+ * it follows a place that got quieter.
+ */
+#define OUTPUT_RETRY_SCANS                   (10U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE uint8_t output_ring[SCAN_OUTPUT_RING_SIZE];
+
+/* Free running positions in the ring: messages are written at output_reserve,
+ * published up to output_head and drained from output_tail.
+ */
+static MODULE_STATE volatile uint32_t output_reserve;
+static MODULE_STATE volatile uint32_t output_head;
+static MODULE_STATE volatile uint32_t output_tail;
+
+static MODULE_STATE uint32_t output_start;
+static MODULE_STATE uint32_t output_remaining;
+static MODULE_STATE TickType_t output_tick;
+
+static MODULE_STATE SemaphoreHandle_t output_mutex;
+static MODULE_STATE TaskHandle_t output_task_handle;
+static MODULE_STATE scan_output_stats_t output_stats;
+static MODULE_STATE uint32_t output_drops;
+static MODULE_STATE uint32_t output_drop_bytes;
+
+static MODULE_STATE scan_output_mode_t output_mode;
+static MODULE_STATE bool output_automatic;
+static MODULE_STATE uint32_t output_mode_scans;
+static MODULE_STATE uint32_t output_mode_bytes[SCAN_OUTPUT_MODES];
+static MODULE_STATE uint32_t output_paced_bytes;
+static MODULE_STATE uint32_t output_paced_dropped;
+static MODULE_STATE TickType_t output_paced_tick;
+
+static const char *const output_mode_names[SCAN_OUTPUT_MODES] =
+{
+    "full", "diff", "summary"
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: ring_copy_in
+********************************************************************************
+* Summary:
+* Copies bytes into the ring at a free running position, wrapping at its end.
+*******************************************************************************/
+static void ring_copy_in(uint32_t position, const void *data, uint32_t length)
+{
+    uint32_t offset = position & OUTPUT_RING_MASK;
+    uint32_t first = SCAN_OUTPUT_RING_SIZE - offset;
+
+    if (first > length)
+    {
+        first = length;
+    }
+
+    memcpy(&output_ring[offset], data, first);
+    memcpy(output_ring, (const uint8_t *)data + first, length - first);
+}
+
+/*******************************************************************************
+* Function Name: ring_copy_out
+********************************************************************************
+* Summary:
+* Copies bytes out of the ring from a free running position.
+*******************************************************************************/
+static void ring_copy_out(uint32_t position, void *data, uint32_t length)
+{
+    uint32_t offset = position & OUTPUT_RING_MASK;
+    uint32_t first = SCAN_OUTPUT_RING_SIZE - offset;
+
+    if (first > length)
+    {
+        first = length;
+    }
+
+    memcpy(data, &output_ring[offset], first);
+    memcpy((uint8_t *)data + first, output_ring, length - first);
+}
+
+/*******************************************************************************
+* Function Name: drain_ms
+********************************************************************************
+* Summary:
+* Returns the time the UART takes to send a number of bytes.
+*******************************************************************************/
+static uint32_t drain_ms(uint32_t bytes)
+{
+    return (uint32_t)(((uint64_t)bytes * SCAN_OUTPUT_BITS_PER_BYTE * 1000U) /
+                      SCAN_OUTPUT_BAUD_RATE);
+}
+
+/*******************************************************************************
+* Function Name: count_drop
+********************************************************************************
+* Summary:
+* Counts a message that did not fit in the ring.
+*******************************************************************************/
+static void count_drop(uint32_t length)
+{
+    output_stats.dropped++;
+    output_stats.dropped_bytes += length;
+    output_drops++;
+    output_drop_bytes += length;
+}
+
+/*******************************************************************************
+* Function Name: scan_output_task
+********************************************************************************
+* Summary:
+* Writes the queued messages to the debug UART in order. The space of a
+* message is released after it is written, so that the backlog includes the
+* message on the wire.
+*******************************************************************************/
+static void scan_output_task(void *arg)
+{
+    (void)arg;
+
+    while (true)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (output_tail != output_head)
+        {
+            uint32_t header[SCAN_OUTPUT_HEADER_SIZE / sizeof(uint32_t)];
+
+            ring_copy_out(output_tail, header, SCAN_OUTPUT_HEADER_SIZE);
+
+            uint32_t position = output_tail + SCAN_OUTPUT_HEADER_SIZE;
+            uint32_t remaining = header[0];
+
+            while (0U != remaining)
+            {
+                uint32_t offset = position & OUTPUT_RING_MASK;
+                uint32_t length = SCAN_OUTPUT_RING_SIZE - offset;
+
+                if (length > remaining)
+                {
+                    length = remaining;
+                }
+
+                (void)fwrite(&output_ring[offset], 1U, length, stdout);
+                position += length;
+                remaining -= length;
+            }
+
+            (void)fflush(stdout);
+
+            uint32_t freshness_ms = (uint32_t)(xTaskGetTickCount() - (TickType_t)header[1]) *
+                                    portTICK_PERIOD_MS;
+
+            xSemaphoreTake(output_mutex, portMAX_DELAY);
+
+            if (0U == output_stats.messages)
+            {
+                output_stats.freshness_mean_ms = freshness_ms;
+            }
+            else
+            {
+                output_stats.freshness_mean_ms = (uint32_t)((int32_t)output_stats.freshness_mean_ms +
+                    (((int32_t)freshness_ms - (int32_t)output_stats.freshness_mean_ms) /
+                     (int32_t)(1U << OUTPUT_FRESHNESS_SHIFT)));
+            }
+
+            output_stats.messages++;
+            output_stats.bytes += header[0];
+            output_stats.freshness_last_ms = freshness_ms;
+
+            if (freshness_ms > output_stats.freshness_max_ms)
+            {
+                output_stats.freshness_max_ms = freshness_ms;
+            }
+
+            output_tail = position;
+            xSemaphoreGive(output_mutex);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_output_init
+********************************************************************************
+* Summary:
+* Empties the queue, selects the full output with automatic pacing and starts
+* the task that drains the queue.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: false if the mutex or the task could not be created
+*
+*******************************************************************************/
+bool scan_output_init(void)
+{
+    output_reserve = 0U;
+    output_head = 0U;
+    output_tail = 0U;
+    output_remaining = 0U;
+    memset(&output_stats, 0, sizeof(output_stats));
+    output_drops = 0U;
+    output_drop_bytes = 0U;
+    memset(output_mode_bytes, 0, sizeof(output_mode_bytes));
+    output_mode = SCAN_OUTPUT_FULL;
+    output_automatic = true;
+    output_mode_scans = 0U;
+    output_paced_bytes = 0U;
+    output_paced_dropped = 0U;
+    output_paced_tick = xTaskGetTickCount();
+
+    output_mutex = xSemaphoreCreateMutex();
+
+    if (NULL == output_mutex)
+    {
+        return false;
+    }
+
+    return (pdPASS == xTaskCreate(scan_output_task, "Output task", SCAN_OUTPUT_TASK_STACK_SIZE,
+                                  NULL, SCAN_OUTPUT_TASK_PRIORITY, &output_task_handle));
+}
+
+/*******************************************************************************
+* Function Name: scan_output_begin
+********************************************************************************
+* Summary:
+* Starts a message of the given length, which is queued whole or not at all:
+* if the ring has no room for it, it is dropped and counted. A message that
+* was started holds the queue until scan_output_end(), so the messages of
+* different tasks are never interleaved. The queuing time of the message is
+* the start of its freshness.
+*
+* Parameters:
+*  uint32_t length: Length of the text of the message
+*
+* Return:
+*  bool: true if the message was started
+*
+*******************************************************************************/
+bool scan_output_begin(uint32_t length)
+{
+    xSemaphoreTake(output_mutex, portMAX_DELAY);
+
+    if ((SCAN_OUTPUT_RING_SIZE - (output_reserve - output_tail)) <
+        (SCAN_OUTPUT_HEADER_SIZE + length))
+    {
+        count_drop(length);
+        xSemaphoreGive(output_mutex);
+
+        return false;
+    }
+
+    output_start = output_reserve;
+    output_remaining = length;
+    output_tick = xTaskGetTickCount();
+    output_reserve += SCAN_OUTPUT_HEADER_SIZE;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: scan_output_append
+********************************************************************************
+* Summary:
+* Appends text to the started message, up to the length it was started with.
+*
+* Parameters:
+*  const char *data: Text to append
+*  uint32_t length: Length of the text
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_output_append(const char *data, uint32_t length)
+{
+    if (length > output_remaining)
+    {
+        length = output_remaining;
+    }
+
+    ring_copy_in(output_reserve, data, length);
+    output_reserve += length;
+    output_remaining -= length;
+}
+
+/*******************************************************************************
+* Function Name: scan_output_end
+********************************************************************************
+* Summary:
+* Publishes the started message to the task that drains the queue.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_output_end(void)
+{
+    uint32_t header[SCAN_OUTPUT_HEADER_SIZE / sizeof(uint32_t)];
+
+    header[0] = output_reserve - output_start - SCAN_OUTPUT_HEADER_SIZE;
+    header[1] = (uint32_t)output_tick;
+    ring_copy_in(output_start, header, SCAN_OUTPUT_HEADER_SIZE);
+
+    output_head = output_reserve;
+
+    if ((output_reserve - output_tail) > output_stats.peak_backlog_bytes)
+    {
+        output_stats.peak_backlog_bytes = output_reserve - output_tail;
+    }
+
+    xSemaphoreGive(output_mutex);
+    (void)xTaskNotifyGive(output_task_handle);
+}
+
+/*******************************************************************************
+* Function Name: scan_output_write
+********************************************************************************
+* Summary:
+* Queues a message.
+*
+* Parameters:
+*  const char *data: Text of the message
+*  uint32_t length: Length of the text
+*
+* Return:
+*  bool: true if the message was queued, false if it was dropped
+*
+*******************************************************************************/
+bool scan_output_write(const char *data, uint32_t length)
+{
+    if (!scan_output_begin(length))
+    {
+        return false;
+    }
+
+    scan_output_append(data, length);
+    scan_output_end();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: scan_output_text
+********************************************************************************
+* Summary:
+* Queues a string as a message.
+*
+* Parameters:
+*  const char *text: String to queue
+*
+* Return:
+*  bool: true if the message was queued, false if it was dropped
+*
+*******************************************************************************/
+bool scan_output_text(const char *text)
+{
+    return scan_output_write(text, (uint32_t)strlen(text));
+}
+
+/*******************************************************************************
+* Function Name: scan_output_printf
+********************************************************************************
+* Summary:
+* Formats a message of up to SCAN_OUTPUT_LINE_SIZE - 1 characters, longer ones
+* being truncated, and queues it. It can replace printf() for the output of
+* the scans.
+*
+* Parameters:
+*  const char *format: printf() format
+*  ...: Arguments of the format
+*
+* Return:
+*  int: Number of characters queued, or -1 if the message was dropped
+*
+*******************************************************************************/
+int scan_output_printf(const char *format, ...)
+{
+    char line[SCAN_OUTPUT_LINE_SIZE];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return -1;
+    }
+
+    if ((uint32_t)length >= sizeof(line))
+    {
+        length = (int)sizeof(line) - 1;
+    }
+
+    return scan_output_write(line, (uint32_t)length) ? length : -1;
+}
+
+/*******************************************************************************
+* Function Name: scan_output_backlog_ms
+********************************************************************************
+* Summary:
+* Returns the time the debug UART needs to send what is queued.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: Backlog in milliseconds
+*
+*******************************************************************************/
+uint32_t scan_output_backlog_ms(void)
+{
+    return drain_ms(output_head - output_tail);
+}
+
+/*******************************************************************************
+* Function Name: scan_output_pace
+********************************************************************************
+* Summary:
+* Selects the output of the next scan, to be called before each scan starts.
+* With automatic pacing, the output is reduced by one step while the backlog
+* exceeds SCAN_OUTPUT_HIGH_MS or messages were dropped, and once it is down
+* to summaries the scan is delayed instead until the backlog drains. The
+* output is restored by one step when the backlog is at most
+* SCAN_OUTPUT_LOW_MS and the restored output of the last such scan would
+* have drained in the time between the scans, or after OUTPUT_RETRY_SCANS
+* reduced scans.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  scan_output_mode_t: Output of the next scan
+*
+*******************************************************************************/
+scan_output_mode_t scan_output_pace(void)
+{
+    uint32_t backlog_ms = scan_output_backlog_ms();
+    TickType_t now = xTaskGetTickCount();
+
+    xSemaphoreTake(output_mutex, portMAX_DELAY);
+
+    /* The output of the scan that completed, queued or not, is measured
+     * against the time it had to drain.
+     */
+    uint32_t queued = (output_reserve + output_drop_bytes) - output_paced_bytes;
+    uint32_t interval_ms = (uint32_t)(now - output_paced_tick) * portTICK_PERIOD_MS;
+    bool dropped = (output_drops != output_paced_dropped);
+    scan_output_mode_t previous = output_mode;
+
+    output_mode_bytes[output_mode] = queued;
+    output_mode_scans++;
+
+    if (output_automatic && ((backlog_ms > SCAN_OUTPUT_HIGH_MS) || dropped))
+    {
+        if (SCAN_OUTPUT_SUMMARY != output_mode)
+        {
+            output_mode++;
+            output_stats.reductions++;
+        }
+    }
+    else if (output_automatic && (SCAN_OUTPUT_FULL != output_mode) &&
+             (backlog_ms <= SCAN_OUTPUT_LOW_MS) &&
+             ((drain_ms(output_mode_bytes[output_mode - 1]) <= interval_ms) ||
+              (output_mode_scans >= OUTPUT_RETRY_SCANS)))
+    {
+        output_mode--;
+        output_stats.restorations++;
+    }
+
+    if (previous != output_mode)
+    {
+        output_mode_scans = 0U;
+    }
+
+    xSemaphoreGive(output_mutex);
+
+    if (previous != output_mode)
+    {
+        SCAN_OUTPUT_INFO(("Scan output %s, %lu ms queued\n",
+                          output_mode_names[output_mode], (unsigned long)backlog_ms));
+    }
+    else if (output_automatic && (SCAN_OUTPUT_SUMMARY == output_mode) &&
+             (backlog_ms > SCAN_OUTPUT_HIGH_MS))
+    {
+        /* Summaries cannot be reduced any further, so the scan waits. */
+        TickType_t wait_start = xTaskGetTickCount();
+        uint32_t waited_ms = 0U;
+
+        while ((scan_output_backlog_ms() > SCAN_OUTPUT_HIGH_MS) &&
+               (waited_ms < SCAN_OUTPUT_MAX_WAIT_MS))
+        {
+            vTaskDelay(pdMS_TO_TICKS(SCAN_OUTPUT_POLL_MS));
+            waited_ms = (uint32_t)(xTaskGetTickCount() - wait_start) * portTICK_PERIOD_MS;
+        }
+
+        xSemaphoreTake(output_mutex, portMAX_DELAY);
+        output_stats.waits++;
+        output_stats.waited_ms += waited_ms;
+        xSemaphoreGive(output_mutex);
+    }
+
+    xSemaphoreTake(output_mutex, portMAX_DELAY);
+    output_paced_bytes = output_reserve + output_drop_bytes;
+    output_paced_dropped = output_drops;
+    output_paced_tick = xTaskGetTickCount();
+    xSemaphoreGive(output_mutex);
+
+    return output_mode;
+}
+
+/*******************************************************************************
+* Function Name: scan_output_set_mode
+********************************************************************************
+* Summary:
+* Selects the output of the scans. With automatic pacing, the mode is only
+* the starting point, adapted before each scan.
+*
+* Parameters:
+*  scan_output_mode_t mode: Output of the scans, SCAN_OUTPUT_MODES to keep it
+*  bool automatic: true to pace the output to the backlog
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_output_set_mode(scan_output_mode_t mode, bool automatic)
+{
+    xSemaphoreTake(output_mutex, portMAX_DELAY);
+
+    if (mode < SCAN_OUTPUT_MODES)
+    {
+        output_mode = mode;
+        output_mode_scans = 0U;
+    }
+
+    output_automatic = automatic;
+    xSemaphoreGive(output_mutex);
+}
+
+/*******************************************************************************
+* Function Name: scan_output_mode
+********************************************************************************
+* Summary:
+* Returns the output selected for the scans.
+*
+* Parameters:
+*  bool *automatic: Set to true if the output is paced, can be NULL
+*
+* Return:
+*  scan_output_mode_t: Output of the scans
+*
+*******************************************************************************/
+scan_output_mode_t scan_output_mode(bool *automatic)
+{
+    if (NULL != automatic)
+    {
+        *automatic = output_automatic;
+    }
+
+    return output_mode;
+}
+
+/*******************************************************************************
+* Function Name: scan_output_mode_name
+********************************************************************************
+* Summary:
+* Returns the name of an output mode.
+*
+* Parameters:
+*  scan_output_mode_t mode: Output mode
+*
+* Return:
+*  const char *: Name of the mode
+*
+*******************************************************************************/
+const char *scan_output_mode_name(scan_output_mode_t mode)
+{
+    return (mode < SCAN_OUTPUT_MODES) ? output_mode_names[mode] : "?";
+}
+
+/*******************************************************************************
+* Function Name: scan_output_stats
+********************************************************************************
+* Summary:
+* Returns the counts of the output queue.
+*
+* Parameters:
+*  scan_output_stats_t *stats: Set to the counts
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_output_stats(scan_output_stats_t *stats)
+{
+    xSemaphoreTake(output_mutex, portMAX_DELAY);
+    *stats = output_stats;
+    stats->backlog_bytes = output_head - output_tail;
+    xSemaphoreGive(output_mutex);
+}
+
+/*******************************************************************************
+* Function Name: scan_output_reset_stats
+********************************************************************************
+* Summary:
+* Clears the counts of the output queue.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_output_reset_stats(void)
+{
+    xSemaphoreTake(output_mutex, portMAX_DELAY);
+    memset(&output_stats, 0, sizeof(output_stats));
+    output_stats.peak_backlog_bytes = output_head - output_tail;
+    xSemaphoreGive(output_mutex);
+}
+
+/* [] END OF FILE */
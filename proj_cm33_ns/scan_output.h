@@ -0,0 +1,169 @@
+/*******************************************************************************
+* File Name        : scan_output.h
+*
+* Description      : This file contains the structures and functions of the scan
+*                    output queue, which decouples the scan results from the debug
+*                    UART and paces the scans to what it can carry.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SCAN_OUTPUT_H_
+#define SOURCE_SCAN_OUTPUT_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bytes queued for the debug UART. It must be a power of two, and a message
+ * longer than it minus SCAN_OUTPUT_HEADER_SIZE is never queued.
+ */
+#define SCAN_OUTPUT_RING_SIZE                (16384U)
+
+/* Queued bytes of a message besides its text: its length and queuing tick. */
+#define SCAN_OUTPUT_HEADER_SIZE              (8U)
+
+/* Longest message of scan_output_printf(), which fits a scan result row with
+ * an SSID whose 32 bytes are all escaped.
+ */
+#define SCAN_OUTPUT_LINE_SIZE                (256U)
+
+/* Baud rate of the debug UART, used to convert the backlog to a drain time.
+ * It must match the debug UART configuration of the BSP.
+ */
+#define SCAN_OUTPUT_BAUD_RATE                (115200U)
+
+/* Bits on the wire per byte: start, 8 data bits and stop. */
+#define SCAN_OUTPUT_BITS_PER_BYTE            (10U)
+
+/* When a scan starts with more than SCAN_OUTPUT_HIGH_MS of output still
+ * queued, its output is reduced by one step; when it starts with at most
+ * SCAN_OUTPUT_LOW_MS queued, it is restored by one step.
+ */
+#define SCAN_OUTPUT_HIGH_MS                  (500U)
+#define SCAN_OUTPUT_LOW_MS                   (100U)
+
+/* Once the output is down to summaries, a scan waits up to this long for the
+ * backlog to drain below SCAN_OUTPUT_HIGH_MS before it starts.
+ */
+#define SCAN_OUTPUT_MAX_WAIT_MS              (10000U)
+#define SCAN_OUTPUT_POLL_MS                  (50U)
+
+#define SCAN_OUTPUT_TASK_STACK_SIZE          (1024U)
+#define SCAN_OUTPUT_TASK_PRIORITY            (1U)
+
+/* Queued counterpart of APP_INFO, which keeps the information in order with
+ * the scan results around it.
+ */
+#define SCAN_OUTPUT_INFO( x )   do { (void)scan_output_text("\nInfo: "); (void)scan_output_printf x;} while(0);
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Output of a scan. SCAN_OUTPUT_FULL prints every result and the networks,
+ * SCAN_OUTPUT_DIFF only the results of BSSIDs that were not seen in the
+ * previous scan and SCAN_OUTPUT_SUMMARY only one line of counts per scan.
+ */
+typedef enum
+{
+    SCAN_OUTPUT_FULL,
+    SCAN_OUTPUT_DIFF,
+    SCAN_OUTPUT_SUMMARY,
+    SCAN_OUTPUT_MODES
+} scan_output_mode_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Counts of the output queue. Freshness is the time from queuing a message,
+ * which for a scan result is its arrival, to its last byte being handed to
+ * the UART; the mean is an exponentially weighted moving average over
+ * messages. Waits are the scans delayed for the backlog to drain.
+ */
+typedef struct
+{
+    uint32_t messages;
+    uint32_t bytes;
+    uint32_t dropped;
+    uint32_t dropped_bytes;
+    uint32_t backlog_bytes;
+    uint32_t peak_backlog_bytes;
+    uint32_t freshness_last_ms;
+    uint32_t freshness_mean_ms;
+    uint32_t freshness_max_ms;
+    uint32_t reductions;
+    uint32_t restorations;
+    uint32_t waits;
+    uint32_t waited_ms;
+} scan_output_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool scan_output_init(void);
+bool scan_output_begin(uint32_t length);
+void scan_output_append(const char *data, uint32_t length);
+void scan_output_end(void);
+bool scan_output_write(const char *data, uint32_t length);
+bool scan_output_text(const char *text);
+int scan_output_printf(const char *format, ...);
+uint32_t scan_output_backlog_ms(void);
+scan_output_mode_t scan_output_pace(void);
+void scan_output_set_mode(scan_output_mode_t mode, bool automatic);
+scan_output_mode_t scan_output_mode(bool *automatic);
+const char *scan_output_mode_name(scan_output_mode_t mode);
+void scan_output_stats(scan_output_stats_t *stats);
+void scan_output_reset_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SCAN_OUTPUT_H_ */
+
+/* [] END OF FILE */
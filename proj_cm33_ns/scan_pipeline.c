@@ -0,0 +1,263 @@
+/*******************************************************************************
+* File Name        : scan_pipeline.c
+*
+* Description      : This file contains the scan pipeline. The firmware feeds it
+*                    with live scan results and the host tools replay scan logs
+*                    through it, so both run the same analytics.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "scan_pipeline.h"
+#include "module_state.h"
+#include "bssid_table.h"
+#include "rssi_history.h"
+#include "snapshot_ring.h"
+#include "anomaly_detector.h"
+#include "bssid_stability.h"
+#include "ess_view.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sequence number of the scan in progress. */
+static MODULE_STATE uint32_t pipeline_sequence;
+
+/* true if the scan in progress is not filtered, so a BSSID missing from its
+ * results was really not visible.
+ */
+static MODULE_STATE bool pipeline_full_sweep;
+
+static MODULE_STATE scan_pipeline_summary_t pipeline_summary;
+static MODULE_STATE int32_t pipeline_rssi_sum;
+
+/* Unique BSSIDs of the previous scan, the reference of the dropout rate. */
+static MODULE_STATE uint16_t pipeline_previous_unique;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: scan_pipeline_init
+********************************************************************************
+* Summary:
+* Initializes the pipeline and all the modules it feeds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_pipeline_init(void)
+{
+    bssid_table_init();
+    rssi_history_init();
+    snapshot_ring_init();
+    anomaly_detector_init();
+    bssid_stability_init();
+    ess_view_init();
+
+    /* Sequence numbers start at 1 so that a BSSID table entry last seen in
+     * scan 0 is never mistaken for one seen in the previous scan.
+     */
+    pipeline_sequence = 1;
+    pipeline_full_sweep = false;
+    pipeline_previous_unique = 0;
+    memset(&pipeline_summary, 0, sizeof(pipeline_summary));
+}
+
+/*******************************************************************************
+* Function Name: scan_pipeline_begin
+********************************************************************************
+* Summary:
+* Starts a new scan.
+*
+* Parameters:
+*  bool full_sweep: true if the scan covered all channels without filter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_pipeline_begin(bool full_sweep)
+{
+    pipeline_full_sweep = full_sweep;
+    pipeline_rssi_sum = 0;
+    memset(&pipeline_summary, 0, sizeof(pipeline_summary));
+    pipeline_summary.sequence = pipeline_sequence;
+    pipeline_summary.full_sweep = full_sweep;
+
+    snapshot_ring_begin(pipeline_sequence, full_sweep);
+    bssid_stability_begin(full_sweep);
+    ess_view_begin();
+}
+
+/*******************************************************************************
+* Function Name: scan_pipeline_add
+********************************************************************************
+* Summary:
+* Feeds one scan result to the per-BSSID trackers and the ESS view.
+*
+* Parameters:
+*  const scan_log_ap_t *ap: Scan result
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  bool: false if the BSSID was already reported by this scan
+*
+*******************************************************************************/
+bool scan_pipeline_add(const scan_log_ap_t *ap, uint32_t now_s)
+{
+    uint16_t index = bssid_table_find(ap->bssid);
+    const bssid_table_entry_t *entry = bssid_table_get(index);
+    bool first_in_scan = (NULL == entry) || (entry->last_seen_scan != pipeline_sequence);
+
+    pipeline_summary.results++;
+    pipeline_rssi_sum += ap->rssi;
+
+    if (first_in_scan)
+    {
+        pipeline_summary.unique++;
+
+        if ((NULL == entry) || ((entry->last_seen_scan + 1U) != pipeline_sequence))
+        {
+            pipeline_summary.appeared++;
+        }
+    }
+
+    index = bssid_table_insert(ap->bssid, pipeline_sequence);
+    entry = bssid_table_get(index);
+
+    rssi_history_observe(index, entry->generation, ap->rssi, now_s);
+    snapshot_ring_observe(index, entry->generation, ap->bssid, ap->rssi,
+                          ap->channel);
+    bssid_stability_observe(index, entry->generation, ap->rssi, ap->channel);
+    ess_view_observe(index, entry->generation, first_in_scan, ap);
+
+    return first_in_scan;
+}
+
+/*******************************************************************************
+* Function Name: scan_pipeline_commit
+********************************************************************************
+* Summary:
+* Completes the scan in progress: applies the results to the trackers and
+* computes the summary of the scan.
+*
+* Parameters:
+*  uint32_t now_s: Time of scan completion in seconds
+*  scan_pipeline_summary_t *summary: Summary of the scan, may be NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_pipeline_commit(uint32_t now_s, scan_pipeline_summary_t *summary)
+{
+    rssi_history_commit(now_s, pipeline_full_sweep);
+    snapshot_ring_commit(now_s);
+    bssid_stability_commit();
+
+    if (pipeline_full_sweep)
+    {
+        for (uint16_t i = 0; i < bssid_table_count(); i++)
+        {
+            const bssid_table_entry_t *entry = bssid_table_get(i);
+
+            if ((NULL != entry) && ((entry->last_seen_scan + 1U) == pipeline_sequence))
+            {
+                pipeline_summary.disappeared++;
+            }
+        }
+    }
+
+    pipeline_summary.timestamp = now_s;
+    pipeline_summary.networks = (uint16_t)ess_view_commit(pipeline_sequence, now_s);
+    pipeline_summary.mean_rssi = (0U != pipeline_summary.results) ?
+                                 (int16_t)(pipeline_rssi_sum / (int32_t)pipeline_summary.results) :
+                                 SCAN_PIPELINE_NO_SIGNAL_DBM;
+
+    /* The anomaly baselines only make sense for scans that cover the same
+     * channels and BSSIDs every time.
+     */
+    if (pipeline_full_sweep)
+    {
+        float features[ANOMALY_FEATURE_COUNT];
+
+        features[ANOMALY_FEATURE_AP_COUNT] = (float)pipeline_summary.unique;
+        features[ANOMALY_FEATURE_MEAN_RSSI] = (float)pipeline_summary.mean_rssi;
+        features[ANOMALY_FEATURE_DROPOUT] = (0U != pipeline_previous_unique) ?
+            ((1000.0f * (float)pipeline_summary.disappeared) / (float)pipeline_previous_unique) :
+            0.0f;
+
+        pipeline_summary.anomalies = anomaly_detector_update(features);
+    }
+
+    pipeline_previous_unique = pipeline_summary.unique;
+
+    if (NULL != summary)
+    {
+        *summary = pipeline_summary;
+    }
+
+    pipeline_sequence++;
+}
+
+/*******************************************************************************
+* Function Name: scan_pipeline_sequence
+********************************************************************************
+* Summary:
+* Returns the sequence number of the scan in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: Scan sequence number
+*
+*******************************************************************************/
+uint32_t scan_pipeline_sequence(void)
+{
+    return pipeline_sequence;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/*******************************************************************************
+* File Name        : scan_pipeline.h
+*
+* Description      : This file contains the structures and function prototypes of
+*                    the scan pipeline that feeds every scan result to the
+*                    per-BSSID trackers and analytics.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SCAN_PIPELINE_H_
+#define SOURCE_SCAN_PIPELINE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_log_format.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Mean RSSI reported for a scan without results. */
+#define SCAN_PIPELINE_NO_SIGNAL_DBM          (-100)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Summary of one completed scan. 'appeared' counts BSSIDs that were not seen
+ * in the previous scan and 'disappeared' counts BSSIDs of the previous scan
+ * that a full sweep did not see. Duplicate results of a BSSID within the scan
+ * are counted in 'results' but not in 'unique'. 'networks' is the number of
+ * networks of the ESS view. 'anomalies' holds the ANOMALY_* flags raised by a
+ * full sweep.
+ */
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t timestamp;
+    uint16_t results;
+    uint16_t unique;
+    uint16_t appeared;
+    uint16_t disappeared;
+    uint16_t networks;
+    int16_t  mean_rssi;
+    uint8_t  anomalies;
+    bool     full_sweep;
+} scan_pipeline_summary_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void scan_pipeline_init(void);
+void scan_pipeline_begin(bool full_sweep);
+bool scan_pipeline_add(const scan_log_ap_t *ap, uint32_t now_s);
+void scan_pipeline_commit(uint32_t now_s, scan_pipeline_summary_t *summary);
+uint32_t scan_pipeline_sequence(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SCAN_PIPELINE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,631 @@
+/*******************************************************************************
+* File Name        : scan_sign.c
+*
+* Description      : This file signs the scan log records in batches. Each record
+*                    is hashed as it is output and the digest of a batch is signed
+*                    once, in a signature record that follows the batch.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "scan_sign.h"
+#include "module_state.h"
+#include "perf_counter.h"
+
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "psa/crypto.h"
+#else
+#include <openssl/core_names.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SHA256_SIZE                          (32U)
+#define P256_COORDINATE_SIZE                 (32U)
+
+/* Persistent key of the device, kept across resets when the PSA crypto
+ * storage is available. The ID is in the range of the application keys,
+ * PSA_KEY_ID_USER_MIN to PSA_KEY_ID_USER_MAX.
+ */
+#define SCAN_SIGN_KEY_ID                     (0x00005343UL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if defined(__ARM_ARCH)
+static MODULE_STATE psa_key_id_t scan_sign_key;
+static MODULE_STATE psa_hash_operation_t scan_sign_hash;
+#else
+static EVP_PKEY *scan_sign_key;
+static EVP_MD_CTX *scan_sign_hash;
+#endif
+
+static MODULE_STATE scan_log_sink_t scan_sign_output;
+static MODULE_STATE uint8_t scan_sign_public[SCAN_SIGN_PUBLIC_KEY_SIZE];
+static MODULE_STATE uint8_t scan_sign_key_id[SCAN_LOG_SIGNATURE_KEY_ID_SIZE];
+static MODULE_STATE scan_sign_stats_t scan_sign_counters;
+
+/* Batch in progress: its records are hashed, but not yet signed. */
+static MODULE_STATE bool scan_sign_open;
+static MODULE_STATE uint32_t scan_sign_batch_count;
+static MODULE_STATE uint32_t scan_sign_batch_number;
+static MODULE_STATE uint32_t scan_sign_first_s;
+static MODULE_STATE uint32_t scan_sign_last_s;
+static MODULE_STATE uint32_t scan_sign_signed_s;
+static MODULE_STATE uint8_t scan_sign_record[SCAN_LOG_SIGNATURE_RECORD_SIZE];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+#if defined(__ARM_ARCH)
+
+/*******************************************************************************
+* Function Name: key_init
+********************************************************************************
+* Summary:
+* Opens the persistent signing key, or generates it. Without the crypto
+* storage, a volatile key is generated, so the device gets a new key at each
+* reset. Exports the public key.
+*******************************************************************************/
+static bool key_init(void)
+{
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    size_t length;
+
+    if (PSA_SUCCESS != psa_crypto_init())
+    {
+        return false;
+    }
+
+    scan_sign_key = SCAN_SIGN_KEY_ID;
+    scan_sign_counters.persistent = false;
+
+    if (PSA_SUCCESS == psa_export_public_key(scan_sign_key, scan_sign_public,
+                                             sizeof(scan_sign_public), &length))
+    {
+        scan_sign_counters.persistent = true;
+        return (SCAN_SIGN_PUBLIC_KEY_SIZE == length);
+    }
+
+    psa_set_key_id(&attributes, SCAN_SIGN_KEY_ID);
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_HASH);
+    psa_set_key_algorithm(&attributes, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+    psa_set_key_bits(&attributes, 8U * P256_COORDINATE_SIZE);
+
+    if (PSA_SUCCESS == psa_generate_key(&attributes, &scan_sign_key))
+    {
+        scan_sign_counters.persistent = true;
+    }
+    else
+    {
+        psa_set_key_lifetime(&attributes, PSA_KEY_LIFETIME_VOLATILE);
+
+        if (PSA_SUCCESS != psa_generate_key(&attributes, &scan_sign_key))
+        {
+            return false;
+        }
+    }
+
+    return (PSA_SUCCESS == psa_export_public_key(scan_sign_key, scan_sign_public,
+                                                 sizeof(scan_sign_public), &length)) &&
+           (SCAN_SIGN_PUBLIC_KEY_SIZE == length);
+}
+
+/*******************************************************************************
+* Function Name: sha256
+********************************************************************************
+* Summary:
+* Computes the SHA-256 of a buffer.
+*******************************************************************************/
+static bool sha256(const uint8_t *data, uint32_t length, uint8_t *digest)
+{
+    size_t digest_length;
+
+    return (PSA_SUCCESS == psa_hash_compute(PSA_ALG_SHA_256, data, length, digest,
+                                            SHA256_SIZE, &digest_length));
+}
+
+/*******************************************************************************
+* Function Name: hash_begin
+********************************************************************************
+* Summary:
+* Starts the digest of a batch.
+*******************************************************************************/
+static bool hash_begin(void)
+{
+    scan_sign_hash = psa_hash_operation_init();
+
+    return (PSA_SUCCESS == psa_hash_setup(&scan_sign_hash, PSA_ALG_SHA_256));
+}
+
+/*******************************************************************************
+* Function Name: hash_update
+********************************************************************************
+* Summary:
+* Adds bytes to the digest of the batch.
+*******************************************************************************/
+static bool hash_update(const uint8_t *data, uint32_t length)
+{
+    return (PSA_SUCCESS == psa_hash_update(&scan_sign_hash, data, length));
+}
+
+/*******************************************************************************
+* Function Name: hash_sign
+********************************************************************************
+* Summary:
+* Completes the digest of the batch and signs it.
+*******************************************************************************/
+static bool hash_sign(uint8_t *signature)
+{
+    uint8_t digest[SHA256_SIZE];
+    size_t length;
+
+    if (PSA_SUCCESS != psa_hash_finish(&scan_sign_hash, digest, sizeof(digest), &length))
+    {
+        return false;
+    }
+
+    return (PSA_SUCCESS == psa_sign_hash(scan_sign_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), digest,
+                                         sizeof(digest), signature, SCAN_LOG_SIGNATURE_SIZE,
+                                         &length)) &&
+           (SCAN_LOG_SIGNATURE_SIZE == length);
+}
+
+/*******************************************************************************
+* Function Name: hash_abort
+********************************************************************************
+* Summary:
+* Drops the digest of a batch that cannot be signed.
+*******************************************************************************/
+static void hash_abort(void)
+{
+    (void)psa_hash_abort(&scan_sign_hash);
+}
+
+#else
+
+/* The host tools sign with OpenSSL and a key generated for the process. */
+static bool key_init(void)
+{
+    size_t length = 0U;
+
+    EVP_PKEY_free(scan_sign_key);
+    EVP_MD_CTX_free(scan_sign_hash);
+    scan_sign_key = EVP_PKEY_Q_keygen(NULL, NULL, "EC", "P-256");
+    scan_sign_hash = EVP_MD_CTX_new();
+    scan_sign_counters.persistent = false;
+
+    return (NULL != scan_sign_key) && (NULL != scan_sign_hash) &&
+           (1 == EVP_PKEY_get_octet_string_param(scan_sign_key,
+                                                 OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY,
+                                                 scan_sign_public, sizeof(scan_sign_public),
+                                                 &length)) &&
+           (SCAN_SIGN_PUBLIC_KEY_SIZE == length);
+}
+
+static bool sha256(const uint8_t *data, uint32_t length, uint8_t *digest)
+{
+    return (1 == EVP_Digest(data, length, digest, NULL, EVP_sha256(), NULL));
+}
+
+static bool hash_begin(void)
+{
+    return (1 == EVP_DigestInit_ex(scan_sign_hash, EVP_sha256(), NULL));
+}
+
+static bool hash_update(const uint8_t *data, uint32_t length)
+{
+    return (1 == EVP_DigestUpdate(scan_sign_hash, data, length));
+}
+
+static bool hash_sign(uint8_t *signature)
+{
+    uint8_t digest[SHA256_SIZE];
+    uint8_t der[EVP_MAX_MD_SIZE * 3U];
+    size_t der_length = sizeof(der);
+    const uint8_t *p = der;
+    bool signed_ok = false;
+
+    if (1 != EVP_DigestFinal_ex(scan_sign_hash, digest, NULL))
+    {
+        return false;
+    }
+
+    EVP_PKEY_CTX *context = EVP_PKEY_CTX_new(scan_sign_key, NULL);
+
+    if ((NULL != context) && (1 == EVP_PKEY_sign_init(context)) &&
+        (1 == EVP_PKEY_sign(context, der, &der_length, digest, sizeof(digest))))
+    {
+        ECDSA_SIG *sig = d2i_ECDSA_SIG(NULL, &p, (long)der_length);
+
+        signed_ok = (NULL != sig) &&
+                    (BN_bn2binpad(ECDSA_SIG_get0_r(sig), signature,
+                                  P256_COORDINATE_SIZE) == (int)P256_COORDINATE_SIZE) &&
+                    (BN_bn2binpad(ECDSA_SIG_get0_s(sig), signature + P256_COORDINATE_SIZE,
+                                  P256_COORDINATE_SIZE) == (int)P256_COORDINATE_SIZE);
+        ECDSA_SIG_free(sig);
+    }
+
+    EVP_PKEY_CTX_free(context);
+
+    return signed_ok;
+}
+
+static void hash_abort(void)
+{
+}
+
+#endif /* defined(__ARM_ARCH) */
+
+/*******************************************************************************
+* Function Name: tune_batch
+********************************************************************************
+* Summary:
+* Sizes the next batch so that its signature takes at most
+* SCAN_SIGN_CPU_BUDGET_PERCENT of the time its records take to arrive, at the
+* record rate of the batch just signed. When the batch took less than a
+* second, its size is doubled.
+*******************************************************************************/
+static void tune_batch(uint32_t sign_ns, uint32_t records, uint32_t elapsed_s)
+{
+    uint64_t needed;
+
+    if (0U == elapsed_s)
+    {
+        needed = 2U * (uint64_t)scan_sign_counters.batch_records;
+    }
+    else
+    {
+        uint64_t budget_ns = (uint64_t)elapsed_s * SCAN_SIGN_CPU_BUDGET_PERCENT *
+                             (PERF_COUNTER_NS_PER_S / 100U);
+
+        needed = (((uint64_t)sign_ns * records) + budget_ns - 1U) / budget_ns;
+    }
+
+    if (needed < SCAN_SIGN_MIN_RECORDS)
+    {
+        needed = SCAN_SIGN_MIN_RECORDS;
+    }
+    else if (needed > SCAN_SIGN_MAX_RECORDS)
+    {
+        needed = SCAN_SIGN_MAX_RECORDS;
+    }
+
+    scan_sign_counters.batch_records = (uint8_t)needed;
+}
+
+/*******************************************************************************
+* Function Name: close_batch
+********************************************************************************
+* Summary:
+* Signs the batch in progress and outputs its signature record.
+*******************************************************************************/
+static void close_batch(void)
+{
+    uint8_t *record = scan_sign_record;
+
+    scan_sign_open = false;
+
+    memset(record, 0, SCAN_LOG_HEADER_SIZE);
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_MAGIC], SCAN_LOG_SIGNATURE_MAGIC);
+    record[SCAN_LOG_OFFSET_VERSION] = SCAN_LOG_VERSION;
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_LENGTH], SCAN_LOG_SIGNATURE_RECORD_SIZE);
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_AP_COUNT], (uint16_t)scan_sign_batch_count);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_SEQUENCE], scan_sign_batch_number);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_TIMESTAMP], scan_sign_last_s);
+    memcpy(&record[SCAN_LOG_HEADER_SIZE + SCAN_LOG_SIGNATURE_OFFSET_KEY_ID], scan_sign_key_id,
+           sizeof(scan_sign_key_id));
+
+    uint32_t start = perf_counter_now();
+    bool signed_ok = hash_update(record, SCAN_LOG_OFFSET_CRC) &&
+                     hash_update(scan_sign_key_id, sizeof(scan_sign_key_id)) &&
+                     hash_sign(&record[SCAN_LOG_HEADER_SIZE +
+                                       SCAN_LOG_SIGNATURE_OFFSET_SIGNATURE]);
+    uint32_t sign_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    if (!signed_ok)
+    {
+        hash_abort();
+        scan_sign_counters.failures++;
+        return;
+    }
+
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_CRC],
+                     scan_log_crc32(&record[SCAN_LOG_HEADER_SIZE],
+                                    SCAN_LOG_SIGNATURE_BODY_SIZE));
+
+    /* The time the records of this batch took to arrive, from the end of the
+     * previous batch or, for the first one, from its first record.
+     */
+    uint32_t elapsed_s = scan_sign_last_s - ((0U != scan_sign_counters.batches) ?
+                                             scan_sign_signed_s : scan_sign_first_s);
+
+    scan_sign_batch_number++;
+    scan_sign_signed_s = scan_sign_last_s;
+    scan_sign_counters.batches++;
+    scan_sign_counters.sign_ns += sign_ns;
+    scan_sign_counters.last_sign_ns = sign_ns;
+    scan_sign_counters.last_batch_s = elapsed_s;
+
+    if (sign_ns > scan_sign_counters.max_sign_ns)
+    {
+        scan_sign_counters.max_sign_ns = sign_ns;
+    }
+
+    if (scan_sign_counters.automatic)
+    {
+        tune_batch(sign_ns, scan_sign_batch_count, elapsed_s);
+    }
+
+    if (NULL != scan_sign_output)
+    {
+        scan_sign_output(record, SCAN_LOG_SIGNATURE_RECORD_SIZE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_init
+********************************************************************************
+* Summary:
+* Opens or generates the signing key of the device and derives its key
+* identifier. Signing is off, with automatic batch sizes.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if the device has a signing key
+*
+*******************************************************************************/
+bool scan_sign_init(void)
+{
+    uint8_t digest[SHA256_SIZE];
+
+    memset(&scan_sign_counters, 0, sizeof(scan_sign_counters));
+    scan_sign_counters.automatic = true;
+    scan_sign_counters.batch_records = SCAN_SIGN_MIN_RECORDS;
+    scan_sign_open = false;
+    scan_sign_batch_number = 0U;
+
+    scan_sign_counters.keyed = key_init() &&
+                               sha256(scan_sign_public, sizeof(scan_sign_public), digest);
+
+    memcpy(scan_sign_key_id, digest, sizeof(scan_sign_key_id));
+
+    return scan_sign_counters.keyed;
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_set_output
+********************************************************************************
+* Summary:
+* Selects where scan_sign_sink passes the records and the signature records.
+*
+* Parameters:
+*  scan_log_sink_t sink: Sink function or NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_sign_set_output(scan_log_sink_t sink)
+{
+    scan_sign_output = sink;
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_set_enabled
+********************************************************************************
+* Summary:
+* Turns signing on or off. The next record starts a new batch. When signing
+* is turned off, the batch in progress is signed at the next record, which is
+* then output unsigned.
+*
+* Parameters:
+*  bool enabled: true to sign the records
+*
+* Return:
+*  bool: false if signing was requested but the device has no signing key
+*
+*******************************************************************************/
+bool scan_sign_set_enabled(bool enabled)
+{
+    if (enabled && !scan_sign_counters.keyed)
+    {
+        return false;
+    }
+
+    scan_sign_counters.enabled = enabled;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_enabled
+********************************************************************************
+* Summary:
+* Returns whether the records are signed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if signing is on
+*
+*******************************************************************************/
+bool scan_sign_enabled(void)
+{
+    return scan_sign_counters.enabled;
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_set_batch
+********************************************************************************
+* Summary:
+* Sets the number of records per batch, bounded by SCAN_SIGN_MIN_RECORDS and
+* SCAN_SIGN_MAX_RECORDS, or selects automatic batch sizes. It applies from
+* the batch in progress on.
+*
+* Parameters:
+*  uint32_t records: Records per batch, or 0 for automatic batch sizes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_sign_set_batch(uint32_t records)
+{
+    scan_sign_counters.automatic = (0U == records);
+
+    if (0U != records)
+    {
+        scan_sign_counters.batch_records = (uint8_t)((records > SCAN_SIGN_MAX_RECORDS) ?
+                                                     SCAN_SIGN_MAX_RECORDS : records);
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_public_key
+********************************************************************************
+* Summary:
+* Returns the public key with which the signature records are verified.
+*
+* Parameters:
+*  uint8_t *key: Set to the key (SCAN_SIGN_PUBLIC_KEY_SIZE bytes)
+*
+* Return:
+*  bool: false if the device has no signing key
+*
+*******************************************************************************/
+bool scan_sign_public_key(uint8_t *key)
+{
+    memcpy(key, scan_sign_public, sizeof(scan_sign_public));
+
+    return scan_sign_counters.keyed;
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_sink
+********************************************************************************
+* Summary:
+* Scan log sink that adds the record to the digest of the batch in progress,
+* passes it on to the output, and signs the batch once it is complete. The
+* record is hashed in place, so the batch is never buffered.
+*
+* Parameters:
+*  const uint8_t *record: Record to output
+*  uint32_t length: Length of the record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_sign_sink(const uint8_t *record, uint32_t length)
+{
+    if (scan_sign_open && !scan_sign_counters.enabled)
+    {
+        close_batch();
+    }
+
+    if (scan_sign_counters.enabled && (length >= SCAN_LOG_HEADER_SIZE))
+    {
+        uint32_t start = perf_counter_now();
+        uint32_t timestamp = scan_log_get_u32(&record[SCAN_LOG_OFFSET_TIMESTAMP]);
+
+        if (!scan_sign_open)
+        {
+            scan_sign_open = hash_begin();
+            scan_sign_batch_count = 0U;
+            scan_sign_first_s = timestamp;
+        }
+
+        if (!(scan_sign_open && hash_update(record, length)))
+        {
+            hash_abort();
+            scan_sign_open = false;
+            scan_sign_counters.failures++;
+        }
+
+        scan_sign_counters.hash_ns += perf_counter_to_ns(perf_counter_now() - start);
+
+        if (scan_sign_open)
+        {
+            scan_sign_batch_count++;
+            scan_sign_last_s = timestamp;
+            scan_sign_counters.records++;
+            scan_sign_counters.record_bytes += length;
+        }
+    }
+
+    if (NULL != scan_sign_output)
+    {
+        scan_sign_output(record, length);
+    }
+
+    if (scan_sign_open && (scan_sign_batch_count >= scan_sign_counters.batch_records))
+    {
+        close_batch();
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_sign_stats
+********************************************************************************
+* Summary:
+* Returns the signing settings, counters and times.
+*
+* Parameters:
+*  scan_sign_stats_t *stats: Set to the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_sign_stats(scan_sign_stats_t *stats)
+{
+    *stats = scan_sign_counters;
+}
+
+/* [] END OF FILE */
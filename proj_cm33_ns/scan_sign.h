@@ -0,0 +1,123 @@
+/*******************************************************************************
+* File Name        : scan_sign.h
+*
+* Description      : This file contains the declarations of the batch signing of
+*                    the scan log records.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SCAN_SIGN_H_
+#define SOURCE_SCAN_SIGN_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_log.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Uncompressed P-256 public key: 0x04, then X and Y. */
+#define SCAN_SIGN_PUBLIC_KEY_SIZE            (65U)
+
+/* Prefix of the line carrying the public key in hexadecimal, printed by the
+ * console. The host verifier reads the key from such a line.
+ */
+#define SCAN_SIGN_KEY_PREFIX                 "#SK "
+
+/* Bounds of the number of records per batch. Larger batches spread the
+ * signature over more records, but the records of a batch can only be
+ * verified once its signature is out.
+ */
+#define SCAN_SIGN_MIN_RECORDS                (1U)
+#define SCAN_SIGN_MAX_RECORDS                (64U)
+
+/* Share of the CPU time, in percent, that the signatures may take. With
+ * automatic batch sizes, each batch is sized from the signing time and the
+ * record rate of the last one.
+ */
+#define SCAN_SIGN_CPU_BUDGET_PERCENT         (1U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    bool     keyed;
+    bool     persistent;
+    bool     enabled;
+    bool     automatic;
+    uint8_t  batch_records;
+    uint32_t batches;
+    uint32_t records;
+    uint32_t failures;
+    uint64_t record_bytes;
+    uint64_t hash_ns;
+    uint64_t sign_ns;
+    uint32_t max_sign_ns;
+    uint32_t last_sign_ns;
+    uint32_t last_batch_s;
+} scan_sign_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool scan_sign_init(void);
+void scan_sign_set_output(scan_log_sink_t sink);
+bool scan_sign_set_enabled(bool enabled);
+bool scan_sign_enabled(void);
+void scan_sign_set_batch(uint32_t records);
+bool scan_sign_public_key(uint8_t *key);
+void scan_sign_sink(const uint8_t *record, uint32_t length);
+void scan_sign_stats(scan_sign_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SCAN_SIGN_H_ */
+
+/* [] END OF FILE */
@@ -46,8 +46,34 @@
 *******************************************************************************/
 #include "cybsp.h"
 #include <inttypes.h>
+#include <time.h>
+#include "semphr.h"
 #include "scan_task.h"
 #include "retarget_io_init.h"
+#include "console_task.h"
+#include "rssi_history.h"
+#include "perf_counter.h"
+#include "scan_log.h"
+#include "scan_pipeline.h"
+#include "bssid_table.h"
+#include "ess_view.h"
+#include "directed_probe.h"
+#include "channel_plan.h"
+#include "planned_sweep.h"
+#include "presence_tracker.h"
+#include "motion_sensor.h"
+#include "six_ghz_plan.h"
+#include "interference_matrix.h"
+#include "occupancy_buckets.h"
+#include "load_shedder.h"
+#include "proximity_zones.h"
+#include "anomaly_detector.h"
+#include "ssid_escape.h"
+#include "hash_service.h"
+#include "secure_batch.h"
+#include "pseudonym.h"
+#include "scan_sign.h"
+#include "uplink_task.h"
 
 
 /*******************************************************************************
@@ -89,10 +115,40 @@ const char* band_string[] =
 
 /* Flag to keep track of button press event*/
 bool button_pressed = false;
+
+/* Protects the per-BSSID scan data, which is updated from the WCM worker
+ * thread and read by the console task.
+ */
+static SemaphoreHandle_t scan_data_mutex;
 static mtb_hal_sdio_t sdio_instance;
 cy_stc_sd_host_context_t sdhc_host_context;
 static cy_wcm_config_t wcm_config;
 
+/* ESS record of the last scan, built under the scan data lock and passed to
+ * the scan log sink after it is released.
+ */
+static uint8_t ess_record[ESS_VIEW_MAX_RECORD_SIZE];
+
+/* Occupancy record, encoded when an hour is folded into its bucket, and the
+ * number of hours folded since it was last persisted.
+ */
+static uint8_t occupancy_record[OCCUPANCY_MAX_RECORD_SIZE];
+static uint32_t occupancy_unsaved_hours;
+static const occupancy_storage_t *const occupancy_storage = SCAN_OCCUPANCY_STORAGE;
+
+/* Output of the scan in progress, selected by the output pacing before it
+ * starts.
+ */
+static scan_output_mode_t scan_output_current = SCAN_OUTPUT_FULL;
+
+/* Fields of the scan in progress, in its scan log record and its output. */
+static uint16_t scan_fields_current = SCAN_LOG_FIELDS_V1;
+
+/* true if the scan in progress covers every band the plan allows, so that a
+ * BSSID it does not report can be counted as missed.
+ */
+static bool scan_full_sweep;
+
 #if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
 
 /* SysPm callback parameter structure for SDHC */
@@ -307,23 +363,23 @@ void user_button_init(void)
 * Function Name: print_scan_result
 ********************************************************************************
 * Summary: This function prints the scan result accumulated by the scan
-*          handler.
+*          handler, with the fields selected for the scan log records.
 *
 * Parameters:
-*  cy_wcm_scan_result_t *result: Pointer to the scan result.
+*  const scan_log_ap_t *ap: Scan result.
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-static void print_scan_result(cy_wcm_scan_result_t *result)
+static void print_scan_result(const scan_log_ap_t *ap)
 {
     char* security_type_string;
 
     /* Convert the security type of the scan result to the corresponding
      * security string
      */
-    switch (result->security)
+    switch ((cy_wcm_security_t)ap->security)
     {
         case CY_WCM_SECURITY_OPEN:
             security_type_string = SECURITY_OPEN;
@@ -402,12 +458,384 @@ static void print_scan_result(cy_wcm_scan_result_t *result)
             break;
     }
 
-    printf(" %2"PRIu32"   %-32s     %4d     %2d      %02X:%02X:%02X:%02X:%02X:%02X         %-15s\n",
-           num_scan_result, result->SSID,
-           result->signal_strength, result->channel, result->BSSID[0], 
-           result->BSSID[1],result->BSSID[2], result->BSSID[3], 
-           result->BSSID[4], result->BSSID[5],
-           security_type_string);
+    /* SSIDs are arbitrary bytes, so they are escaped and padded by columns. */
+    char ssid[SSID_ESCAPE_BUFFER_SIZE];
+    uint32_t columns;
+
+    (void)ssid_escape(ap->ssid, ap->ssid_length, SSID_ESCAPE_TERMINAL, ssid, &columns);
+
+    if (SCAN_LOG_FIELDS_V1 == (scan_fields_current & SCAN_LOG_FIELDS_ALL))
+    {
+        (void)scan_output_printf(" %2"PRIu32"   %s%*s     %4d     %2d      %02X:%02X:%02X:%02X:%02X:%02X         %-15s\n",
+                                 num_scan_result, ssid,
+                                 ssid_escape_padding(columns, SSID_ESCAPE_MAX_SSID_LENGTH), "",
+                                 ap->rssi, ap->channel, ap->bssid[0],
+                                 ap->bssid[1],ap->bssid[2], ap->bssid[3],
+                                 ap->bssid[4], ap->bssid[5],
+                                 security_type_string);
+        return;
+    }
+
+    /* Other fields are printed as columns in the order of the schema. */
+    char line[SCAN_OUTPUT_LINE_SIZE];
+    int length = snprintf(line, sizeof(line), " %3"PRIu32"  %02X:%02X:%02X:%02X:%02X:%02X",
+                          num_scan_result, ap->bssid[0], ap->bssid[1], ap->bssid[2],
+                          ap->bssid[3], ap->bssid[4], ap->bssid[5]);
+
+    if (0U != (scan_fields_current & SCAN_LOG_FIELD_RSSI))
+    {
+        length += snprintf(&line[length], sizeof(line) - length, "  %4d", ap->rssi);
+    }
+
+    if (0U != (scan_fields_current & SCAN_LOG_FIELD_CHANNEL))
+    {
+        length += snprintf(&line[length], sizeof(line) - length, "  %7u", ap->channel);
+    }
+
+    if (0U != (scan_fields_current & SCAN_LOG_FIELD_BAND))
+    {
+        length += snprintf(&line[length], sizeof(line) - length, "  %-7s",
+                           (ap->band <= CY_WCM_WIFI_BAND_6GHZ) ? band_string[ap->band] : "?");
+    }
+
+    if (0U != (scan_fields_current & SCAN_LOG_FIELD_SECURITY))
+    {
+        length += snprintf(&line[length], sizeof(line) - length, "  %-18s",
+                           security_type_string);
+    }
+
+    if (0U != (scan_fields_current & SCAN_LOG_FIELD_SSID))
+    {
+        length += snprintf(&line[length], sizeof(line) - length, "  %s%*s", ssid,
+                           ssid_escape_padding(columns, SSID_ESCAPE_MAX_SSID_LENGTH), "");
+    }
+
+    if (0U != (scan_fields_current & SCAN_LOG_FIELD_WIDTH))
+    {
+        (void)snprintf(&line[length], sizeof(line) - length, "  %5u", ap->width_mhz);
+    }
+
+    (void)scan_output_printf("%s\n", line);
+}
+
+/*******************************************************************************
+* Function Name: print_scan_template
+********************************************************************************
+* Summary: Prints the header of the scan results. With other fields than the
+*          default ones, it starts with the schema of the scan log records
+*          and names the columns after the fields.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_scan_template(void)
+{
+    static const char *const columns[SCAN_LOG_FIELD_COUNT] =
+    {
+        "  MAC Address      ", "  RSSI", "  Channel", "  Band   ",
+        "  Security          ", "  SSID                            ", "  Width"
+    };
+
+    if (SCAN_LOG_FIELDS_V1 == (scan_fields_current & SCAN_LOG_FIELDS_ALL))
+    {
+        PRINT_SCAN_TEMPLATE();
+        return;
+    }
+
+    char line[SCAN_OUTPUT_LINE_SIZE];
+    int length = snprintf(line, sizeof(line), "   #");
+
+    for (uint32_t bit = 0U; bit < SCAN_LOG_FIELD_COUNT; bit++)
+    {
+        if (0U != (scan_fields_current & (1U << bit)))
+        {
+            length += snprintf(&line[length], sizeof(line) - length, "%s", columns[bit]);
+        }
+    }
+
+    (void)scan_output_printf("\n" SCAN_LOG_SCHEMA_PREFIX "%u %04X\n%s\n",
+                             SCAN_LOG_VERSION_SCHEMA,
+                             (scan_fields_current & SCAN_LOG_FIELDS_ALL), line);
+}
+
+/*******************************************************************************
+* Function Name: scan_data_lock
+********************************************************************************
+* Summary: Takes the lock that protects the per-BSSID scan data.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_data_lock(void)
+{
+    xSemaphoreTake(scan_data_mutex, portMAX_DELAY);
+}
+
+/*******************************************************************************
+* Function Name: scan_data_unlock
+********************************************************************************
+* Summary: Releases the lock that protects the per-BSSID scan data.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_data_unlock(void)
+{
+    xSemaphoreGive(scan_data_mutex);
+}
+
+/*******************************************************************************
+* Function Name: print_proximity_event
+********************************************************************************
+* Summary: Prints a proximity zone transition.
+*
+* Parameters:
+*  const proximity_event_t *event: Zone transition
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_proximity_event(const proximity_event_t *event)
+{
+    SCAN_OUTPUT_INFO(("Zone rule %u: %s -> %s (%d dBm)\n", (unsigned int)event->rule,
+                      proximity_zone_name(event->from), proximity_zone_name(event->to),
+                      event->rssi));
+}
+
+/*******************************************************************************
+* Function Name: pass_on_result
+********************************************************************************
+* Summary: Adds a scan result admitted by the load shedder to the scan log,
+* the scan pipeline and the per-sweep aggregates. Must be called with the scan
+* data lock. The scan log gets the result as it is output, with the
+* pseudonyms of the BSSID and the SSID while they are on.
+*
+* Parameters:
+*  const scan_log_ap_t *ap: Scan result
+*  const scan_log_ap_t *exported: Scan result as it is output
+*  bool pseudonyms: true if exported holds pseudonyms
+*  const bss_width_t *bss: Channels occupied by the BSS
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void pass_on_result(const scan_log_ap_t *ap, const scan_log_ap_t *exported,
+                           bool pseudonyms, const bss_width_t *bss, uint32_t now_s)
+{
+    if (pseudonyms)
+    {
+        scan_log_flag(SCAN_LOG_FLAG_PSEUDONYMS);
+    }
+
+    scan_log_add(exported);
+
+    bool first_in_scan = scan_pipeline_add(ap, now_s);
+    interference_matrix_observe(first_in_scan, ap->band, ap->rssi, bss);
+    occupancy_buckets_observe(first_in_scan, ap);
+}
+
+/*******************************************************************************
+* Function Name: record_scan_result
+********************************************************************************
+* Summary: Feeds a scan result to the modules that look at every result and
+* offers it to the load shedder, which decides whether it is added to the
+* scan log and the scan pipeline now, at the end of the scan or not at all.
+*
+* Parameters:
+*  cy_wcm_scan_result_t *result: Pointer to the scan result.
+*  scan_log_ap_t *out: Set to the scan result as it is output, with
+*   pseudonyms while they are on.
+*
+* Return:
+*  bool: true if the BSSID was not seen in this scan or the previous one
+*
+*******************************************************************************/
+static bool record_scan_result(cy_wcm_scan_result_t *result, scan_log_ap_t *out)
+{
+    uint32_t now_s = (uint32_t)time(NULL);
+    scan_log_ap_t ap;
+    bss_width_t bss;
+
+    memcpy(ap.bssid, result->BSSID, sizeof(ap.bssid));
+    ap.rssi = (int8_t)result->signal_strength;
+    ap.channel = result->channel;
+    ap.band = (uint8_t)result->band;
+    ap.security = (uint32_t)result->security;
+    ap.ssid_length = (uint8_t)strnlen((const char *)result->SSID,
+                                      SCAN_LOG_SSID_MAX_LENGTH);
+    memcpy(ap.ssid, result->SSID, ap.ssid_length);
+    bss_width_decode(ap.band, ap.channel, result->ie_ptr, result->ie_len, &bss);
+    ap.width_mhz = bss.width_mhz;
+
+    scan_data_lock();
+    channel_plan_observe(result->ie_ptr, result->ie_len);
+    six_ghz_plan_observe(ap.bssid, (CY_WCM_WIFI_BAND_6GHZ == result->band),
+                         result->ie_ptr, result->ie_len,
+                         xTaskGetTickCount() * portTICK_PERIOD_MS);
+    presence_tracker_observe(ap.bssid, ap.channel, ap.rssi);
+    proximity_zones_observe(ap.bssid, ap.ssid, ap.ssid_length, ap.rssi);
+
+    const bssid_table_entry_t *entry = bssid_table_get(bssid_table_find(ap.bssid));
+    bool repeated = (NULL != entry) && (entry->last_seen_scan == scan_pipeline_sequence());
+    bool appeared = (NULL == entry) || ((!repeated) &&
+                                        ((entry->last_seen_scan + 1U) != scan_pipeline_sequence()));
+
+    /* The pseudonyms are computed once, for both the scan log and the output. */
+    *out = ap;
+    bool pseudonyms = pseudonym_ap(out);
+
+    if (load_shedder_offer(&ap, &bss, presence_tracker_is_watched(ap.bssid), repeated))
+    {
+        pass_on_result(&ap, out, pseudonyms, &bss, now_s);
+    }
+
+    scan_data_unlock();
+
+    return appeared;
+}
+
+/*******************************************************************************
+* Function Name: commit_scan_results
+********************************************************************************
+* Summary: Passes on the results sampled by the load shedder, completes the
+* scan in the scan pipeline and the scan log, and outputs the networks of the
+* ESS view or, when the output is reduced, a summary of the scan.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void commit_scan_results(void)
+{
+    uint32_t now_s = (uint32_t)time(NULL);
+    scan_pipeline_summary_t summary;
+    load_shedder_stats_t shed;
+
+    scan_data_lock();
+
+    /* The results the load shedder held back are passed on before the scan
+     * is completed.
+     */
+    uint32_t sampled = load_shedder_commit();
+
+    for (uint32_t i = 0; i < sampled; i++)
+    {
+        scan_log_ap_t ap;
+        scan_log_ap_t exported;
+        bss_width_t bss;
+
+        if (load_shedder_get(i, &ap, &bss))
+        {
+            exported = ap;
+            pass_on_result(&ap, &exported, pseudonym_ap(&exported), &bss, now_s);
+        }
+    }
+
+    load_shedder_stats(&shed, NULL);
+    scan_pipeline_commit(now_s, &summary);
+    interference_matrix_commit(summary.sequence);
+    bool folded = occupancy_buckets_commit((uint16_t)(summary.appeared + summary.disappeared));
+    channel_plan_commit();
+    six_ghz_plan_commit(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    proximity_zones_evaluate(xTaskGetTickCount() * portTICK_PERIOD_MS, scan_full_sweep);
+    scan_data_unlock();
+
+    if (0U != shed.shed)
+    {
+        SCAN_OUTPUT_INFO(("Load shedding: %"PRIu32" results, %"PRIu32" sampled, %"PRIu32" shed "
+                          "(%"PRIu32" at 2.4 GHz, %"PRIu32" at 5 GHz, %"PRIu32" at 6 GHz)\n",
+                          shed.results, shed.sampled, shed.shed, shed.shed_by_band[0],
+                          shed.shed_by_band[1], shed.shed_by_band[2]));
+    }
+
+    for (uint8_t flag = 1U; flag < (1U << ANOMALY_FLAG_COUNT); flag <<= 1)
+    {
+        if (0U != (summary.anomalies & flag))
+        {
+            SCAN_OUTPUT_INFO(("RF anomaly: %s (%u BSSIDs, mean %d dBm, %u disappeared)\n",
+                              anomaly_flag_name(flag), summary.unique, summary.mean_rssi,
+                              summary.disappeared));
+        }
+    }
+
+    scan_log_end(now_s);
+
+    /* The networks are rendered to the console and, when logging is on, sent
+     * to the scan log sink after the snapshot record. A reduced output only
+     * summarises the scan.
+     */
+    scan_log_sink_t sink = scan_log_get_sink();
+    uint32_t ess_length = 0U;
+
+    if (SCAN_OUTPUT_FULL != scan_output_current)
+    {
+        (void)scan_output_printf("\nScan %"PRIu32": %u results, %u BSSIDs (%u appeared, "
+                                 "%u disappeared), %u networks, mean %d dBm\n",
+                                 summary.sequence, summary.results, summary.unique,
+                                 summary.appeared, summary.disappeared, summary.networks,
+                                 summary.mean_rssi);
+    }
+
+    scan_data_lock();
+
+    if (SCAN_OUTPUT_FULL == scan_output_current)
+    {
+        ess_view_print(scan_output_printf);
+    }
+
+    if (NULL != sink)
+    {
+        ess_length = ess_view_encode(ess_record, sizeof(ess_record));
+    }
+
+    scan_data_unlock();
+
+    if (NULL != sink)
+    {
+        sink(ess_record, ess_length);
+    }
+
+    /* Every hour, the occupancy buckets are exported and, every
+     * OCCUPANCY_PERSIST_HOURS, persisted.
+     */
+    bool persist = folded && (NULL != occupancy_storage) &&
+                   (++occupancy_unsaved_hours >= OCCUPANCY_PERSIST_HOURS);
+
+    if (folded && ((NULL != sink) || persist))
+    {
+        scan_data_lock();
+        uint32_t occupancy_length = occupancy_buckets_encode(occupancy_record,
+                                                             sizeof(occupancy_record), now_s);
+        scan_data_unlock();
+
+        if (NULL != sink)
+        {
+            sink(occupancy_record, occupancy_length);
+        }
+
+        if (persist && occupancy_storage->store(occupancy_record, occupancy_length))
+        {
+            occupancy_unsaved_hours = 0U;
+        }
+    }
 }
 
 /*******************************************************************************
@@ -438,13 +866,25 @@ static void scan_callback(cy_wcm_scan_result_t *result_ptr, void *user_data,
 
     if ((RESET_VAL != ssid_len) && (status == CY_WCM_SCAN_INCOMPLETE))
     {
-        /* Increment the number of scan results and print the result*/
+        /* Increment the number of scan results and print the result. A
+         * reduced output only prints the BSSIDs that appeared, or none.
+         */
+        scan_log_ap_t ap;
+
         num_scan_result++;
-        print_scan_result(result_ptr);
+        bool appeared = record_scan_result(result_ptr, &ap);
+
+        if ((SCAN_OUTPUT_FULL == scan_output_current) ||
+            ((SCAN_OUTPUT_DIFF == scan_output_current) && appeared))
+        {
+            print_scan_result(&ap);
+        }
     }
 
     if ((CY_WCM_SCAN_COMPLETE == status) )
     {
+        commit_scan_results();
+
         /* Reset the number of scan results to 0 for the next scan.*/
         num_scan_result = RESET_VAL;
 
@@ -453,6 +893,61 @@ static void scan_callback(cy_wcm_scan_result_t *result_ptr, void *user_data,
     }
 }
 
+/*******************************************************************************
+* Function Name: scan_bands
+********************************************************************************
+* Summary: Returns the bands scanned with the selected scan filter.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8_t: CHANNEL_PLAN_BAND_ flags
+*
+*******************************************************************************/
+static uint8_t scan_bands(void)
+{
+    if (SCAN_FILTER_BAND != scan_filter_mode_select)
+    {
+        return CHANNEL_PLAN_BAND_ALL;
+    }
+
+    switch (SCAN_FOR_BAND_VALUE)
+    {
+        case CY_WCM_WIFI_BAND_2_4GHZ:
+            return CHANNEL_PLAN_BAND_2_4GHZ;
+
+        case CY_WCM_WIFI_BAND_5GHZ:
+            return CHANNEL_PLAN_BAND_5GHZ;
+
+        case CY_WCM_WIFI_BAND_6GHZ:
+            return CHANNEL_PLAN_BAND_6GHZ;
+
+        default:
+            return CHANNEL_PLAN_BAND_ALL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_record_output
+********************************************************************************
+* Summary:
+* Sends a signed scan log record to the UART and to the uplink.
+*
+* Parameters:
+*  const uint8_t *record: Record to send
+*  uint32_t length: Length of the record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void scan_record_output(const uint8_t *record, uint32_t length)
+{
+    scan_log_uart_sink(record, length);
+    uplink_task_sink(record, length);
+}
+
 /*******************************************************************************
 * Function Name: scan_task
 ********************************************************************************
@@ -476,6 +971,9 @@ void scan_task(void *arg)
     cy_wcm_scan_filter_t scan_filter;
     cy_rslt_t result = CY_RSLT_SUCCESS;
     cy_wcm_mac_t scan_for_mac_value = {SCAN_FOR_MAC_ADDRESS};
+    TickType_t sweep_start;
+    channel_plan_t plan;
+    bool planned;
 
     memset(&scan_filter, RESET_VAL, sizeof(cy_wcm_scan_filter_t));
 
@@ -492,8 +990,74 @@ void scan_task(void *arg)
         handle_app_error();
     }
 
+    scan_data_mutex = xSemaphoreCreateMutex();
+
+    if(NULL == scan_data_mutex)
+    {
+        handle_app_error();
+    }
+
+    if(!scan_output_init())
+    {
+        handle_app_error();
+    }
+
+    perf_counter_init();
+    secure_batch_init();
+    pseudonym_init();
+    (void)scan_sign_init();
+    scan_sign_set_output(scan_record_output);
+
+    if (!uplink_task_init())
+    {
+        APP_INFO(("Uplink could not be started\n"));
+    }
+
+    scan_pipeline_init();
+    channel_plan_init();
+    (void)channel_plan_set_country(SCAN_COUNTRY_CODE);
+    directed_probe_init();
+    planned_sweep_init();
+    presence_tracker_init();
+    motion_sensor_init();
+    six_ghz_plan_init();
+    interference_matrix_init();
+    occupancy_buckets_init();
+    load_shedder_init();
+
+    if (NULL != occupancy_storage)
+    {
+        uint32_t length = occupancy_storage->load(occupancy_record, sizeof(occupancy_record));
+
+        if ((0U != length) && occupancy_buckets_restore(occupancy_record, length))
+        {
+            APP_INFO(("Restored %u occupancy buckets\n",
+                      scan_log_get_u16(&occupancy_record[SCAN_LOG_OFFSET_AP_COUNT])));
+        }
+    }
+
+    proximity_zones_init();
+    proximity_zones_set_handler(print_proximity_event);
+
+    APP_INFO(("RSSI history uses %u bytes per BSSID for up to %u BSSIDs\n",
+              (unsigned int)rssi_history_bytes_per_bssid(),
+              (unsigned int)RSSI_HISTORY_MAX_BSSIDS));
+
+    /* Start the console used to query the scan data. */
+    if(pdPASS != xTaskCreate(console_task, "Console task", CONSOLE_TASK_STACK_SIZE,
+                             NULL, CONSOLE_TASK_PRIORITY, NULL))
+    {
+        handle_app_error();
+    }
+
     while (true)
     {
+        /* The output of a scan is reduced, or the scan delayed, while the
+         * debug UART has not caught up with the previous ones.
+         */
+        scan_output_current = scan_output_pace();
+        scan_fields_current = scan_log_get_fields();
+
         /* check if button_pressed flag is updated to true in the button ISR */
         if(true == button_pressed )
         {
@@ -512,11 +1076,11 @@ void scan_task(void *arg)
         switch (scan_filter_mode_select)
         {
             case SCAN_FILTER_NONE:
-                APP_INFO(("Scanning without any filter\n"));
+                SCAN_OUTPUT_INFO(("Scanning without any filter\n"));
                 break;
 
             case SCAN_FILTER_SSID:
-                APP_INFO(("Scanning for %s.\n", SCAN_FOR_SSID_VALUE));
+                SCAN_OUTPUT_INFO(("Scanning for %s.\n", SCAN_FOR_SSID_VALUE));
 
                 /* Configure the scan filter for SSID specified by
                  * SCAN_FOR_SSID_VALUE.
@@ -527,7 +1091,7 @@ void scan_task(void *arg)
                 break;
 
             case SCAN_FILTER_RSSI:
-                APP_INFO(("Scanning for RSSI > %d dBm.\n", SCAN_FOR_RSSI_VALUE));
+                SCAN_OUTPUT_INFO(("Scanning for RSSI > %d dBm.\n", SCAN_FOR_RSSI_VALUE));
 
                 /* Configure the scan filter for RSSI range specified by
                  * SCAN_FOR_RSSI_VALUE.
@@ -537,7 +1101,7 @@ void scan_task(void *arg)
                 break;
 
             case SCAN_FILTER_MAC:
-                APP_INFO(("Scanning for %02X:%02X:%02X:%02X:%02X:%02X.\n", 
+                SCAN_OUTPUT_INFO(("Scanning for %02X:%02X:%02X:%02X:%02X:%02X.\n", 
                 scan_for_mac_value[0], 
                 scan_for_mac_value[1], scan_for_mac_value[2], scan_for_mac_value[3], 
                 scan_for_mac_value[4], scan_for_mac_value[5]));
@@ -549,7 +1113,7 @@ void scan_task(void *arg)
                 break;
 
             case SCAN_FILTER_BAND:
-                APP_INFO(("Scanning in %s band.\n", band_string[SCAN_FOR_BAND_VALUE]));
+                SCAN_OUTPUT_INFO(("Scanning in %s band.\n", band_string[SCAN_FOR_BAND_VALUE]));
 
                 /* Configure the scan filter for band specified by
                  * SCAN_FOR_BAND_VALUE.
@@ -562,15 +1126,70 @@ void scan_task(void *arg)
                 break;
         }
 
-        PRINT_SCAN_TEMPLATE();
+        if (SCAN_OUTPUT_SUMMARY != scan_output_current)
+        {
+            print_scan_template();
+        }
 
-        if(SCAN_FILTER_NONE == scan_filter_mode_select)
+        scan_data_lock();
+
+        /* The planned channel lists cannot describe the 6 GHz band, so while
+         * the plan includes it, some sweeps keep the default channel list.
+         * The planned sweeps in between miss the 6 GHz band and the disabled
+         * channels, so they are not full sweeps: the BSSIDs there are not
+         * counted as missed.
+         */
+        planned = channel_plan_build(scan_bands(), &plan) &&
+                  (0U != (plan.active_count + plan.passive_count)) &&
+                  ((!plan.six_ghz) ||
+                   (0U != (scan_pipeline_sequence() % PLANNED_SWEEP_6GHZ_INTERVAL)));
+        scan_full_sweep = (SCAN_FILTER_NONE == scan_filter_mode_select) &&
+                          ((!planned) || (!plan.six_ghz));
+
+        scan_pipeline_begin(scan_full_sweep);
+        six_ghz_plan_begin(scan_full_sweep, xTaskGetTickCount() * portTICK_PERIOD_MS);
+        interference_matrix_begin(scan_full_sweep);
+        occupancy_buckets_begin(scan_full_sweep, (uint32_t)time(NULL));
+        load_shedder_begin();
+        channel_plan_begin();
+
+        /* Pseudonyms of the new key start with a scan, so that a record does
+         * not mix two epochs.
+         */
+        pseudonym_stats_t pseudonyms;
+        bool rotated = pseudonym_tick((uint32_t)time(NULL));
+        pseudonym_stats(&pseudonyms);
+        scan_data_unlock();
+
+        if (rotated)
         {
-            result = cy_wcm_start_scan(scan_callback, NULL, NULL);
+            SCAN_OUTPUT_INFO(("Pseudonym key rotated, epoch %"PRIu32"\n", pseudonyms.epoch));
         }
-        else
+
+        scan_log_begin(scan_pipeline_sequence(), scan_full_sweep, scan_fields_current);
+
+        sweep_start = xTaskGetTickCount();
+
+        /* A planned sweep completes before it returns, and its completion
+         * notification is already pending when it is waited for below.
+         */
+        if (planned)
         {
-            result = cy_wcm_start_scan(scan_callback, NULL, &scan_filter);
+            planned = planned_sweep_run(&plan, (SCAN_FILTER_NONE == scan_filter_mode_select) ?
+                                        NULL : &scan_filter, scan_callback);
+            result = CY_RSLT_SUCCESS;
+        }
+
+        if (!planned)
+        {
+            if(SCAN_FILTER_NONE == scan_filter_mode_select)
+            {
+                result = cy_wcm_start_scan(scan_callback, NULL, NULL);
+            }
+            else
+            {
+                result = cy_wcm_start_scan(scan_callback, NULL, &scan_filter);
+            }
         }
 
         /* Wait for scan completion if scan was started successfully. The API
@@ -584,7 +1203,35 @@ void scan_task(void *arg)
             portMAX_DELAY);
         }
 
-        vTaskDelay(pdMS_TO_TICKS(SCAN_DELAY_MS));
+        presence_tracker_account_sweep((xTaskGetTickCount() - sweep_start) *
+                                       portTICK_PERIOD_MS);
+
+        if ((CY_RSLT_SUCCESS == result) && (SCAN_FILTER_NONE == scan_filter_mode_select))
+        {
+            scan_data_lock();
+            channel_plan_account_sweep(planned, (xTaskGetTickCount() - sweep_start) *
+                                                portTICK_PERIOD_MS);
+            scan_data_unlock();
+        }
+
+        /* While motion is sensed or BSSIDs are watched, full sweeps are spaced
+         * out and the time in between is spent on directed probes. Motion
+         * sensing needs a steady sample rate, so it has the radio to itself.
+         */
+        if (motion_sensor_active())
+        {
+            motion_sensor_run(MOTION_SWEEP_PERIOD_MS);
+        }
+        else
+        {
+            scan_data_lock();
+            uint32_t delay_ms = occupancy_buckets_scan_delay_ms(SCAN_DELAY_MS,
+                                                                (uint32_t)time(NULL));
+            scan_data_unlock();
+
+            presence_tracker_run(presence_tracker_active() ? PRESENCE_SWEEP_PERIOD_MS :
+                                                             delay_ms);
+        }
     }
 }
 
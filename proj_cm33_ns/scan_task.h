@@ -58,6 +58,7 @@ extern "C" {
 #include "cy_wcm.h"
 #include <stdio.h>
 #include <queue.h>
+#include "scan_output.h"
 
 /*******************************************************************************
 * Macros
@@ -84,9 +85,23 @@ extern "C" {
  */
 #define SCAN_FOR_RSSI_VALUE                  CY_WCM_SCAN_RSSI_FAIR
 
-/* The delay in milliseconds between successive scans.*/
+/* Provide the country whose regulatory rules restrict the channels of the
+ * scans, for example "US". Leave it empty to infer the country from the
+ * Country IEs of the APs around.
+ */
+#define SCAN_COUNTRY_CODE                    ""
+
+/* The delay in milliseconds between successive scans. It is adapted to the
+ * volatility of the hour of the week, see occupancy_buckets.h.
+ */
 #define SCAN_DELAY_MS                        (3000U)
 
+/* Provide a pointer to an occupancy_storage_t to keep the time-of-day buckets
+ * across resets, for example in a flash sector. Without one, the buckets start
+ * empty after every reset.
+ */
+#define SCAN_OCCUPANCY_STORAGE               (NULL)
+
 #define SCAN_TASK_STACK_SIZE                 (4096U)
 #define SCAN_TASK_PRIORITY                   (3U)
 
@@ -119,7 +134,7 @@ extern "C" {
 #define SECURITY_UNKNOWN                     "UNKNOWN"
 
 #define PRINT_SCAN_TEMPLATE()                \
-printf("\n----------------------------------------------" \
+(void)scan_output_text("\n----------------------------------------------" \
 "------------------------------------------------------\n" \
 "  #                  SSID                  RSSI   Channel  " \
 "     MAC Address              Security\n" \
@@ -162,6 +177,8 @@ enum scan_filter_mode
 *******************************************************************************/
 void scan_task(void* arg);
 void user_button_init(void);
+void scan_data_lock(void);
+void scan_data_unlock(void);
 
 #if defined(__cplusplus)
 }
@@ -0,0 +1,263 @@
+/*******************************************************************************
+* File Name        : secure_batch.c
+*
+* Description      : This file contains the batching layer of the calls to the
+*                    secure service. Requests are collected in an array and sent
+*                    in one call, so that the cost of entering and leaving the
+*                    secure image is paid once per batch instead of once per
+*                    request.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "secure_batch.h"
+#include "module_state.h"
+
+#include <stddef.h>
+
+#if defined(__ARM_ARCH)
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE secure_batch_stats_t secure_batch_counters;
+
+#if defined(__ARM_ARCH)
+/* Serializes the calls to the secure service, which must not overlap. It is
+ * recursive, so that a caller can hold it across a series of calls.
+ */
+static MODULE_STATE SemaphoreHandle_t secure_batch_mutex;
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: secure_batch_init
+********************************************************************************
+* Summary:
+* Creates the lock of the calls to the secure service. Must be called before
+* the first call and before the tasks that make calls are started.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void secure_batch_init(void)
+{
+#if defined(__ARM_ARCH)
+    secure_batch_mutex = xSemaphoreCreateRecursiveMutex();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: secure_batch_lock
+********************************************************************************
+* Summary:
+* Takes the lock of the calls to the secure service, so that a series of
+* calls is not interleaved with those of other tasks. secure_batch_run()
+* takes it for each call.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void secure_batch_lock(void)
+{
+#if defined(__ARM_ARCH)
+    if (NULL != secure_batch_mutex)
+    {
+        (void)xSemaphoreTakeRecursive(secure_batch_mutex, portMAX_DELAY);
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: secure_batch_unlock
+********************************************************************************
+* Summary:
+* Releases the lock taken by secure_batch_lock().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void secure_batch_unlock(void)
+{
+#if defined(__ARM_ARCH)
+    if (NULL != secure_batch_mutex)
+    {
+        (void)xSemaphoreGiveRecursive(secure_batch_mutex);
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: secure_batch_begin
+********************************************************************************
+* Summary:
+* Empties a batch.
+*
+* Parameters:
+*  secure_batch_t *batch: Batch
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void secure_batch_begin(secure_batch_t *batch)
+{
+    batch->count = 0U;
+}
+
+/*******************************************************************************
+* Function Name: secure_batch_add
+********************************************************************************
+* Summary:
+* Adds a request to a batch. Its status and output are set when the batch is
+* run.
+*
+* Parameters:
+*  secure_batch_t *batch: Batch
+*  uint8_t op: SECURE_SERVICE_OP_*
+*  uint8_t key: SECURE_SERVICE_KEY_*
+*  const uint8_t *input: Input, which must stay valid until the batch is run
+*  uint32_t length: Length of the input, at most SECURE_SERVICE_MAX_INPUT
+*
+* Return:
+*  const secure_service_item_t*: The request, or NULL if the batch is full or
+*   the input too long
+*
+*******************************************************************************/
+const secure_service_item_t* secure_batch_add(secure_batch_t *batch, uint8_t op, uint8_t key,
+                                              const uint8_t *input, uint32_t length)
+{
+    if ((batch->count >= SECURE_SERVICE_MAX_ITEMS) || (length > SECURE_SERVICE_MAX_INPUT))
+    {
+        return NULL;
+    }
+
+    secure_service_item_t *item = &batch->items[batch->count++];
+
+    item->op = op;
+    item->key = key;
+    item->length = (uint8_t)length;
+    item->status = (uint8_t)SECURE_SERVICE_STATUS_BAD_OP;
+    item->input = input;
+    item->output = 0U;
+
+    return item;
+}
+
+/*******************************************************************************
+* Function Name: secure_batch_run
+********************************************************************************
+* Summary:
+* Sends the requests of a batch to the secure service in one call and empties
+* the batch. Calls must not overlap, so each one is made with the lock taken.
+*
+* Parameters:
+*  secure_batch_t *batch: Batch
+*
+* Return:
+*  bool: true if every request succeeded
+*
+*******************************************************************************/
+bool secure_batch_run(secure_batch_t *batch)
+{
+    uint32_t count = batch->count;
+
+    if (0U == count)
+    {
+        return true;
+    }
+
+    secure_batch_lock();
+
+#if defined(__ARM_ARCH) && !defined(SECURE_SERVICE_VENEERS)
+    /* The secure image exports no veneers with this toolchain, so no request
+     * can be served. They keep the status set by secure_batch_add().
+     */
+    uint32_t succeeded = 0U;
+#else
+    uint32_t succeeded = secure_service_call(batch->items, count);
+#endif
+
+    secure_batch_counters.calls++;
+    secure_batch_counters.items += count;
+    secure_batch_counters.failed += count - succeeded;
+    secure_batch_unlock();
+    batch->count = 0U;
+
+    return succeeded == count;
+}
+
+/*******************************************************************************
+* Function Name: secure_batch_stats
+********************************************************************************
+* Summary:
+* Returns the number of calls and requests sent to the secure service.
+*
+* Parameters:
+*  secure_batch_stats_t *stats: Set to the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void secure_batch_stats(secure_batch_stats_t *stats)
+{
+    secure_batch_lock();
+    *stats = secure_batch_counters;
+    secure_batch_unlock();
+}
+
+/* [] END OF FILE */
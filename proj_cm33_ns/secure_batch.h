@@ -0,0 +1,97 @@
+/*******************************************************************************
+* File Name        : secure_batch.h
+*
+* Description      : This file contains the public interface of the batching
+*                    layer of the calls to the secure service.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SECURE_BATCH_H_
+#define SOURCE_SECURE_BATCH_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "secure_service.h"
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Requests collected for one call to the secure service. The inputs must stay
+ * valid until the batch is run.
+ */
+typedef struct
+{
+    secure_service_item_t items[SECURE_SERVICE_MAX_ITEMS];
+    uint32_t count;
+} secure_batch_t;
+
+typedef struct
+{
+    uint32_t calls;
+    uint32_t items;
+    uint32_t failed;
+} secure_batch_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void secure_batch_init(void);
+void secure_batch_lock(void);
+void secure_batch_unlock(void);
+void secure_batch_begin(secure_batch_t *batch);
+const secure_service_item_t* secure_batch_add(secure_batch_t *batch, uint8_t op, uint8_t key,
+                                              const uint8_t *input, uint32_t length);
+bool secure_batch_run(secure_batch_t *batch);
+void secure_batch_stats(secure_batch_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SECURE_BATCH_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,509 @@
+/*******************************************************************************
+* File Name        : series_codec.c
+*
+* Description      : This file contains the Gorilla-style bit-packing encoder and
+*                    decoder of (timestamp, RSSI) series used to shrink the
+*                    history before it is stored or sent.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "series_codec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BITS_PER_BYTE                        (8U)
+#define TIMESTAMP_FIRST_BITS                 (32U)
+#define VALUE_FIRST_BITS                     (8U)
+
+/* Timestamp delta-of-delta classes: prefix, prefix length, payload length.
+ * A zero delta-of-delta is coded as the single bit '0'.
+ */
+#define DOD_SMALL_PREFIX                     (0x2U)     /* '10'   */
+#define DOD_SMALL_BITS                       (7U)
+#define DOD_MEDIUM_PREFIX                    (0x6U)     /* '110'  */
+#define DOD_MEDIUM_BITS                      (9U)
+#define DOD_LARGE_PREFIX                     (0xEU)     /* '1110' */
+#define DOD_LARGE_BITS                       (12U)
+#define DOD_RAW_PREFIX                       (0xFU)     /* '1111' */
+#define DOD_RAW_BITS                         (32U)
+#define DOD_RAW_CLASS                        (4U)
+
+/* Value zigzag delta classes. A repeated value is coded as the single bit '0'
+ * and a value that cannot be coded as a short delta is stored raw.
+ */
+#define VALUE_SMALL_PREFIX                   (0x2U)     /* '10'  */
+#define VALUE_SMALL_BITS                     (3U)
+#define VALUE_MEDIUM_PREFIX                  (0x6U)     /* '110' */
+#define VALUE_MEDIUM_BITS                    (6U)
+#define VALUE_RAW_PREFIX                     (0x7U)     /* '111' */
+#define VALUE_RAW_BITS                       (8U)
+#define VALUE_RAW_CLASS                      (3U)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: zigzag32
+********************************************************************************
+* Summary:
+* Maps a signed 32-bit value to unsigned so that small magnitudes of either
+* sign become small numbers.
+*******************************************************************************/
+static inline uint32_t zigzag32(uint32_t value)
+{
+    return (value << 1) ^ (uint32_t)(-(int32_t)(value >> 31));
+}
+
+static inline uint32_t unzigzag32(uint32_t value)
+{
+    return (value >> 1) ^ (uint32_t)(-(int32_t)(value & 1U));
+}
+
+/*******************************************************************************
+* Function Name: write_bits
+********************************************************************************
+* Summary:
+* Appends the 'count' low bits of 'value' MSB first. The caller has checked
+* that they fit in the buffer.
+*******************************************************************************/
+static void write_bits(series_encoder_t *enc, uint32_t value, uint32_t count)
+{
+    while (0U != count)
+    {
+        uint32_t byte = enc->bit_pos / BITS_PER_BYTE;
+        uint32_t used = enc->bit_pos % BITS_PER_BYTE;
+        uint32_t room = BITS_PER_BYTE - used;
+        uint32_t take = (count < room) ? count : room;
+        uint32_t bits = (value >> (count - take)) & ((1U << take) - 1U);
+
+        if (0U == used)
+        {
+            enc->buffer[byte] = 0;
+        }
+
+        enc->buffer[byte] |= (uint8_t)(bits << (room - take));
+        enc->bit_pos += take;
+        count -= take;
+    }
+}
+
+/*******************************************************************************
+* Function Name: read_bits
+********************************************************************************
+* Summary:
+* Reads 'count' bits MSB first. Returns false if the stream ends before.
+*******************************************************************************/
+static bool read_bits(series_decoder_t *dec, uint32_t count, uint32_t *value)
+{
+    uint32_t result = 0;
+
+    if ((dec->bit_len - dec->bit_pos) < count)
+    {
+        return false;
+    }
+
+    while (0U != count)
+    {
+        uint32_t byte = dec->bit_pos / BITS_PER_BYTE;
+        uint32_t used = dec->bit_pos % BITS_PER_BYTE;
+        uint32_t room = BITS_PER_BYTE - used;
+        uint32_t take = (count < room) ? count : room;
+        uint32_t bits = ((uint32_t)dec->buffer[byte] >> (room - take)) &
+                        ((1U << take) - 1U);
+
+        result = (result << take) | bits;
+        dec->bit_pos += take;
+        count -= take;
+    }
+
+    *value = result;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: read_prefix
+********************************************************************************
+* Summary:
+* Reads a unary prefix of up to 'max' one bits terminated by a zero bit (the
+* terminator is not consumed after 'max' ones). Returns the number of ones.
+*******************************************************************************/
+static bool read_prefix(series_decoder_t *dec, uint32_t max, uint32_t *ones)
+{
+    uint32_t bit;
+
+    *ones = 0;
+
+    while (*ones < max)
+    {
+        if (!read_bits(dec, 1U, &bit))
+        {
+            return false;
+        }
+
+        if (0U == bit)
+        {
+            break;
+        }
+
+        (*ones)++;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: series_encoder_init
+********************************************************************************
+* Summary:
+* Starts a new stream in the given buffer.
+*
+* Parameters:
+*  series_encoder_t *enc: Encoder state
+*  uint8_t *buffer: Output buffer
+*  uint32_t capacity: Size of the output buffer in bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void series_encoder_init(series_encoder_t *enc, uint8_t *buffer,
+                         uint32_t capacity)
+{
+    memset(enc, 0, sizeof(*enc));
+    enc->buffer = buffer;
+    enc->capacity = capacity;
+}
+
+/*******************************************************************************
+* Function Name: series_encoder_put
+********************************************************************************
+* Summary:
+* Appends one record. A record is either written completely or not at all, so
+* the stream stays decodable when the buffer fills up.
+*
+* Parameters:
+*  series_encoder_t *enc: Encoder state
+*  uint32_t timestamp: Timestamp of the record
+*  uint8_t value: Value of the record
+*
+* Return:
+*  bool: false if the record does not fit in the buffer
+*
+*******************************************************************************/
+bool series_encoder_put(series_encoder_t *enc, uint32_t timestamp,
+                        uint8_t value)
+{
+    uint32_t ts_prefix = 0;
+    uint32_t ts_prefix_bits;
+    uint32_t ts_payload = 0;
+    uint32_t ts_payload_bits = 0;
+    uint32_t val_prefix;
+    uint32_t val_prefix_bits;
+    uint32_t val_payload = 0;
+    uint32_t val_payload_bits = 0;
+    uint32_t delta = timestamp - enc->prev_timestamp;
+
+    if (0U == enc->count)
+    {
+        if (((enc->capacity * BITS_PER_BYTE) - enc->bit_pos) <
+            (TIMESTAMP_FIRST_BITS + VALUE_FIRST_BITS))
+        {
+            return false;
+        }
+
+        write_bits(enc, timestamp, TIMESTAMP_FIRST_BITS);
+        write_bits(enc, value, VALUE_FIRST_BITS);
+        enc->prev_timestamp = timestamp;
+        enc->prev_delta = 0;
+        enc->prev_value = value;
+        enc->count = 1;
+
+        return true;
+    }
+
+    /* Timestamp: zigzag coded delta-of-delta in modulo 2^32 arithmetic. */
+    uint32_t dod = zigzag32(delta - enc->prev_delta);
+
+    if (0U == dod)
+    {
+        ts_prefix_bits = 1U;
+    }
+    else if (dod < (1UL << DOD_SMALL_BITS))
+    {
+        ts_prefix = DOD_SMALL_PREFIX;
+        ts_prefix_bits = 2U;
+        ts_payload = dod;
+        ts_payload_bits = DOD_SMALL_BITS;
+    }
+    else if (dod < (1UL << DOD_MEDIUM_BITS))
+    {
+        ts_prefix = DOD_MEDIUM_PREFIX;
+        ts_prefix_bits = 3U;
+        ts_payload = dod;
+        ts_payload_bits = DOD_MEDIUM_BITS;
+    }
+    else if (dod < (1UL << DOD_LARGE_BITS))
+    {
+        ts_prefix = DOD_LARGE_PREFIX;
+        ts_prefix_bits = 4U;
+        ts_payload = dod;
+        ts_payload_bits = DOD_LARGE_BITS;
+    }
+    else
+    {
+        ts_prefix = DOD_RAW_PREFIX;
+        ts_prefix_bits = 4U;
+        ts_payload = delta - enc->prev_delta;
+        ts_payload_bits = DOD_RAW_BITS;
+    }
+
+    /* Value: zigzag coded delta to the previous value. */
+    uint32_t zz = zigzag32((uint32_t)((int32_t)value - (int32_t)enc->prev_value));
+
+    if (0U == zz)
+    {
+        val_prefix = 0;
+        val_prefix_bits = 1U;
+    }
+    else if (zz < (1UL << VALUE_SMALL_BITS))
+    {
+        val_prefix = VALUE_SMALL_PREFIX;
+        val_prefix_bits = 2U;
+        val_payload = zz;
+        val_payload_bits = VALUE_SMALL_BITS;
+    }
+    else if (zz < (1UL << VALUE_MEDIUM_BITS))
+    {
+        val_prefix = VALUE_MEDIUM_PREFIX;
+        val_prefix_bits = 3U;
+        val_payload = zz;
+        val_payload_bits = VALUE_MEDIUM_BITS;
+    }
+    else
+    {
+        val_prefix = VALUE_RAW_PREFIX;
+        val_prefix_bits = 3U;
+        val_payload = value;
+        val_payload_bits = VALUE_RAW_BITS;
+    }
+
+    uint32_t total = ts_prefix_bits + ts_payload_bits +
+                     val_prefix_bits + val_payload_bits;
+
+    if (((enc->capacity * BITS_PER_BYTE) - enc->bit_pos) < total)
+    {
+        return false;
+    }
+
+    write_bits(enc, ts_prefix, ts_prefix_bits);
+    write_bits(enc, ts_payload, ts_payload_bits);
+    write_bits(enc, val_prefix, val_prefix_bits);
+    write_bits(enc, val_payload, val_payload_bits);
+
+    enc->prev_timestamp = timestamp;
+    enc->prev_delta = delta;
+    enc->prev_value = value;
+    enc->count++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: series_encoder_finish
+********************************************************************************
+* Summary:
+* Pads the last byte with one bits and returns the stream length. A run of
+* fewer than eight ones can never complete a record, so the decoder stops
+* cleanly at the padding.
+*
+* Parameters:
+*  series_encoder_t *enc: Encoder state
+*
+* Return:
+*  uint32_t: Length of the stream in bytes
+*
+*******************************************************************************/
+uint32_t series_encoder_finish(series_encoder_t *enc)
+{
+    uint32_t pad = (BITS_PER_BYTE - (enc->bit_pos % BITS_PER_BYTE)) %
+                   BITS_PER_BYTE;
+
+    write_bits(enc, (1U << pad) - 1U, pad);
+
+    return enc->bit_pos / BITS_PER_BYTE;
+}
+
+/*******************************************************************************
+* Function Name: series_decoder_init
+********************************************************************************
+* Summary:
+* Starts decoding a stream. The stream may be truncated at any byte.
+*
+* Parameters:
+*  series_decoder_t *dec: Decoder state
+*  const uint8_t *buffer: Encoded stream
+*  uint32_t length: Number of bytes available
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void series_decoder_init(series_decoder_t *dec, const uint8_t *buffer,
+                         uint32_t length)
+{
+    memset(dec, 0, sizeof(*dec));
+    dec->buffer = buffer;
+    dec->bit_len = length * BITS_PER_BYTE;
+}
+
+/*******************************************************************************
+* Function Name: series_decoder_next
+********************************************************************************
+* Summary:
+* Decodes the next record. A record cut by truncation is not returned and the
+* decoder state is left unchanged, so all the complete records before the
+* truncation point are recovered.
+*
+* Parameters:
+*  series_decoder_t *dec: Decoder state
+*  uint32_t *timestamp: Decoded timestamp
+*  uint8_t *value: Decoded value
+*
+* Return:
+*  bool: false at the end of the stream
+*
+*******************************************************************************/
+bool series_decoder_next(series_decoder_t *dec, uint32_t *timestamp,
+                         uint8_t *value)
+{
+    uint32_t start = dec->bit_pos;
+    uint32_t ones;
+    uint32_t payload = 0;
+    uint32_t dod;
+    uint32_t val;
+    static const uint8_t dod_payload_bits[] =
+    {
+        0U, DOD_SMALL_BITS, DOD_MEDIUM_BITS, DOD_LARGE_BITS, DOD_RAW_BITS
+    };
+    static const uint8_t value_payload_bits[] =
+    {
+        0U, VALUE_SMALL_BITS, VALUE_MEDIUM_BITS, VALUE_RAW_BITS
+    };
+
+    if (0U == dec->count)
+    {
+        uint32_t first_value;
+
+        if ((!read_bits(dec, TIMESTAMP_FIRST_BITS, timestamp)) ||
+            (!read_bits(dec, VALUE_FIRST_BITS, &first_value)))
+        {
+            dec->bit_pos = start;
+            return false;
+        }
+
+        *value = (uint8_t)first_value;
+        dec->prev_timestamp = *timestamp;
+        dec->prev_delta = 0;
+        dec->prev_value = *value;
+        dec->count = 1;
+
+        return true;
+    }
+
+    /* Timestamp delta-of-delta */
+    if (!read_prefix(dec, 4U, &ones))
+    {
+        dec->bit_pos = start;
+        return false;
+    }
+
+    if (0U == ones)
+    {
+        dod = 0;
+    }
+    else
+    {
+        if (!read_bits(dec, dod_payload_bits[ones], &payload))
+        {
+            dec->bit_pos = start;
+            return false;
+        }
+
+        dod = (DOD_RAW_CLASS == ones) ? payload : unzigzag32(payload);
+    }
+
+    /* Value delta */
+    if (!read_prefix(dec, 3U, &ones))
+    {
+        dec->bit_pos = start;
+        return false;
+    }
+
+    if (0U == ones)
+    {
+        val = dec->prev_value;
+    }
+    else
+    {
+        if (!read_bits(dec, value_payload_bits[ones], &payload))
+        {
+            dec->bit_pos = start;
+            return false;
+        }
+
+        val = (VALUE_RAW_CLASS == ones) ? payload :
+              (uint32_t)((int32_t)dec->prev_value + (int32_t)unzigzag32(payload));
+    }
+
+    dec->prev_delta += dod;
+    dec->prev_timestamp += dec->prev_delta;
+    dec->prev_value = (uint8_t)val;
+    dec->count++;
+
+    *timestamp = dec->prev_timestamp;
+    *value = dec->prev_value;
+
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,117 @@
+/*******************************************************************************
+* File Name        : series_codec.h
+*
+* Description      : This file contains the structures and function prototypes of
+*                    the streaming compressor for RSSI time series.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SERIES_CODEC_H_
+#define SOURCE_SERIES_CODEC_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Worst case size of one record: 4 + 32 bits of timestamp and 3 + 8 bits of
+ * value. The first record of a stream is 32 + 8 bits.
+ */
+#define SERIES_CODEC_MAX_RECORD_BITS         (47U)
+#define SERIES_CODEC_MAX_RECORD_BYTES        ((SERIES_CODEC_MAX_RECORD_BITS + 7U) / 8U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Encoder state. Records are (timestamp, 8-bit value) pairs. Timestamps are
+ * coded as delta-of-delta and values as zigzag deltas, both with variable
+ * length prefix codes, so a series sampled at a regular interval with a
+ * slowly changing value costs 2 bits per record.
+ */
+typedef struct
+{
+    uint8_t  *buffer;
+    uint32_t capacity;
+    uint32_t bit_pos;
+    uint32_t count;
+    uint32_t prev_timestamp;
+    uint32_t prev_delta;
+    uint8_t  prev_value;
+} series_encoder_t;
+
+typedef struct
+{
+    const uint8_t *buffer;
+    uint32_t bit_len;
+    uint32_t bit_pos;
+    uint32_t count;
+    uint32_t prev_timestamp;
+    uint32_t prev_delta;
+    uint8_t  prev_value;
+} series_decoder_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void series_encoder_init(series_encoder_t *enc, uint8_t *buffer,
+                         uint32_t capacity);
+bool series_encoder_put(series_encoder_t *enc, uint32_t timestamp,
+                        uint8_t value);
+uint32_t series_encoder_finish(series_encoder_t *enc);
+void series_decoder_init(series_decoder_t *dec, const uint8_t *buffer,
+                         uint32_t length);
+bool series_decoder_next(series_decoder_t *dec, uint32_t *timestamp,
+                         uint8_t *value);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SERIES_CODEC_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,379 @@
+/*******************************************************************************
+* File Name        : six_ghz_plan.c
+*
+* Description      : This file contains the 6 GHz channel plan. Blind discovery in the
+*                    6 GHz band is slow because stations may only listen on the 44
+*                    non-PSC channels. Most 6 GHz APs are co-located with a 2.4 GHz or
+*                    5 GHz AP that announces them in a Reduced Neighbor Report, so the
+*                    plan collects these announcements and reduces a 6 GHz scan to the
+*                    announced channels plus the 15 PSCs. The plan also measures how
+*                    long the scans take to find the announced APs.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "six_ghz_plan.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    six_ghz_ap_t ap;
+    bool         in_use;
+} plan_entry_t;
+
+static MODULE_STATE plan_entry_t plan_entries[SIX_GHZ_PLAN_MAX_APS];
+static MODULE_STATE six_ghz_stats_t plan_stats;
+
+/* Scan in progress. */
+static MODULE_STATE uint32_t plan_full_sweeps;
+static MODULE_STATE bool plan_full_sweep;
+static MODULE_STATE uint32_t plan_scan_start_ms;
+static MODULE_STATE const uint8_t *plan_reporter;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: find_entry
+********************************************************************************
+* Summary:
+* Returns the entry of an announced AP. APs announced without a BSSID are
+* told apart by their channel and short SSID.
+*******************************************************************************/
+static plan_entry_t* find_entry(const rnr_neighbor_t *neighbor)
+{
+    for (uint32_t i = 0; i < SIX_GHZ_PLAN_MAX_APS; i++)
+    {
+        const six_ghz_ap_t *ap = &plan_entries[i].ap;
+
+        if (!plan_entries[i].in_use || (ap->has_bssid != neighbor->has_bssid))
+        {
+            continue;
+        }
+
+        if (neighbor->has_bssid ? (0 == memcmp(ap->bssid, neighbor->bssid, RNR_BSSID_LENGTH)) :
+                                  ((ap->channel == neighbor->channel) &&
+                                   (ap->short_ssid == neighbor->short_ssid)))
+        {
+            return &plan_entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: announce
+********************************************************************************
+* Summary:
+* RNR handler. Adds or refreshes a 6 GHz neighbor. When the plan is full, the
+* entry announced least recently is replaced.
+*******************************************************************************/
+static void announce(const rnr_neighbor_t *neighbor, void *user_data)
+{
+    (void)user_data;
+
+    if ((!neighbor->is_6ghz) || (0U == neighbor->channel) ||
+        (neighbor->channel > RNR_6GHZ_MAX_CHANNEL))
+    {
+        return;
+    }
+
+    plan_entry_t *entry = find_entry(neighbor);
+
+    if (NULL == entry)
+    {
+        entry = &plan_entries[0];
+
+        for (uint32_t i = 0; i < SIX_GHZ_PLAN_MAX_APS; i++)
+        {
+            if (!plan_entries[i].in_use)
+            {
+                entry = &plan_entries[i];
+                break;
+            }
+
+            if (plan_entries[i].ap.announced_sweep < entry->ap.announced_sweep)
+            {
+                entry = &plan_entries[i];
+            }
+        }
+
+        memset(entry, 0, sizeof(*entry));
+        entry->ap.found_ms = SIX_GHZ_PLAN_NOT_FOUND;
+        entry->in_use = true;
+    }
+
+    memcpy(entry->ap.bssid, neighbor->bssid, RNR_BSSID_LENGTH);
+    memcpy(entry->ap.reporter, plan_reporter, RNR_BSSID_LENGTH);
+    entry->ap.has_bssid = neighbor->has_bssid;
+    entry->ap.channel = neighbor->channel;
+    entry->ap.short_ssid = neighbor->short_ssid;
+    entry->ap.announced_sweep = plan_full_sweeps;
+}
+
+/*******************************************************************************
+* Function Name: six_ghz_plan_init
+********************************************************************************
+* Summary:
+* Empties the plan and clears the statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void six_ghz_plan_init(void)
+{
+    memset(plan_entries, 0, sizeof(plan_entries));
+    memset(&plan_stats, 0, sizeof(plan_stats));
+    plan_full_sweeps = 0;
+    plan_full_sweep = false;
+}
+
+/*******************************************************************************
+* Function Name: six_ghz_plan_begin
+********************************************************************************
+* Summary:
+* Starts a new scan and counts the APs it is expected to find.
+*
+* Parameters:
+*  bool full_sweep: true if the scan covered all channels without filter
+*  uint32_t now_ms: Start time of the scan in milliseconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void six_ghz_plan_begin(bool full_sweep, uint32_t now_ms)
+{
+    plan_full_sweep = full_sweep;
+    plan_scan_start_ms = now_ms;
+    plan_stats.last_first_6ghz_ms = SIX_GHZ_PLAN_NOT_FOUND;
+
+    for (uint32_t i = 0; i < SIX_GHZ_PLAN_MAX_APS; i++)
+    {
+        if (plan_entries[i].in_use && plan_entries[i].ap.has_bssid)
+        {
+            plan_entries[i].ap.found_ms = SIX_GHZ_PLAN_NOT_FOUND;
+            plan_stats.announced++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: six_ghz_plan_observe
+********************************************************************************
+* Summary:
+* Takes the 6 GHz neighbors of a 2.4 GHz or 5 GHz scan result into the plan,
+* or records the discovery of a 6 GHz AP.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID of the scan result
+*  bool is_6ghz: true if the result is in the 6 GHz band
+*  const uint8_t *ies: Information elements of the result, may be NULL
+*  uint32_t ie_length: Length of the information elements
+*  uint32_t now_ms: Time of the result in milliseconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void six_ghz_plan_observe(const uint8_t *bssid, bool is_6ghz, const uint8_t *ies,
+                          uint32_t ie_length, uint32_t now_ms)
+{
+    if (!is_6ghz)
+    {
+        plan_reporter = bssid;
+        (void)rnr_parse(ies, ie_length, announce, NULL);
+        return;
+    }
+
+    uint32_t elapsed = now_ms - plan_scan_start_ms;
+
+    if (SIX_GHZ_PLAN_NOT_FOUND == plan_stats.last_first_6ghz_ms)
+    {
+        plan_stats.last_first_6ghz_ms = elapsed;
+    }
+
+    for (uint32_t i = 0; i < SIX_GHZ_PLAN_MAX_APS; i++)
+    {
+        six_ghz_ap_t *ap = &plan_entries[i].ap;
+
+        if (plan_entries[i].in_use && ap->has_bssid &&
+            (SIX_GHZ_PLAN_NOT_FOUND == ap->found_ms) &&
+            (0 == memcmp(ap->bssid, bssid, RNR_BSSID_LENGTH)))
+        {
+            ap->found_ms = elapsed;
+            plan_stats.found++;
+            plan_stats.total_discover_ms += elapsed;
+
+            if (elapsed > plan_stats.max_discover_ms)
+            {
+                plan_stats.max_discover_ms = elapsed;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: six_ghz_plan_commit
+********************************************************************************
+* Summary:
+* Completes the scan in progress. After a full sweep, the APs that have not
+* been announced for SIX_GHZ_PLAN_STALE_SWEEPS full sweeps are dropped.
+*
+* Parameters:
+*  uint32_t now_ms: End time of the scan in milliseconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void six_ghz_plan_commit(uint32_t now_ms)
+{
+    plan_stats.scans++;
+    plan_stats.last_scan_ms = now_ms - plan_scan_start_ms;
+    plan_stats.total_scan_ms += plan_stats.last_scan_ms;
+
+    if (!plan_full_sweep)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < SIX_GHZ_PLAN_MAX_APS; i++)
+    {
+        if (plan_entries[i].in_use &&
+            ((plan_full_sweeps - plan_entries[i].ap.announced_sweep) >= SIX_GHZ_PLAN_STALE_SWEEPS))
+        {
+            plan_entries[i].in_use = false;
+        }
+    }
+
+    plan_full_sweeps++;
+}
+
+/*******************************************************************************
+* Function Name: six_ghz_plan_channels
+********************************************************************************
+* Summary:
+* Returns the channels a 6 GHz scan should visit, in ascending order: the
+* PSCs and the channels of the announced APs.
+*
+* Parameters:
+*  uint8_t *channels: Channel numbers
+*  uint32_t max_channels: Capacity of 'channels'
+*
+* Return:
+*  uint32_t: Number of channels
+*
+*******************************************************************************/
+uint32_t six_ghz_plan_channels(uint8_t *channels, uint32_t max_channels)
+{
+    uint32_t count = 0;
+
+    for (uint32_t channel = 1U; (channel <= RNR_6GHZ_MAX_CHANNEL) && (count < max_channels); channel++)
+    {
+        bool wanted = rnr_is_psc((uint8_t)channel);
+
+        for (uint32_t i = 0; (!wanted) && (i < SIX_GHZ_PLAN_MAX_APS); i++)
+        {
+            wanted = plan_entries[i].in_use && (plan_entries[i].ap.channel == channel);
+        }
+
+        if (wanted)
+        {
+            channels[count++] = (uint8_t)channel;
+        }
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: six_ghz_plan_get
+********************************************************************************
+* Summary:
+* Copies an AP of the plan.
+*
+* Parameters:
+*  uint32_t index: Entry, 0 to SIX_GHZ_PLAN_MAX_APS - 1
+*  six_ghz_ap_t *ap: Copy of the AP
+*
+* Return:
+*  bool: false if the entry is not in use
+*
+*******************************************************************************/
+bool six_ghz_plan_get(uint32_t index, six_ghz_ap_t *ap)
+{
+    if ((index >= SIX_GHZ_PLAN_MAX_APS) || (!plan_entries[index].in_use))
+    {
+        return false;
+    }
+
+    *ap = plan_entries[index].ap;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: six_ghz_plan_stats
+********************************************************************************
+* Summary:
+* Copies the discovery statistics.
+*
+* Parameters:
+*  six_ghz_stats_t *stats: Copy of the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void six_ghz_plan_stats(six_ghz_stats_t *stats)
+{
+    *stats = plan_stats;
+}
+
+/* [] END OF FILE */
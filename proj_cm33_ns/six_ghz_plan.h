@@ -0,0 +1,128 @@
+/*******************************************************************************
+* File Name        : six_ghz_plan.h
+*
+* Description      : This file contains the structures and function prototypes of the
+*                    6 GHz channel plan, which collects the 6 GHz APs announced in the
+*                    Reduced Neighbor Reports of 2.4 GHz and 5 GHz APs.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SIX_GHZ_PLAN_H_
+#define SOURCE_SIX_GHZ_PLAN_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "rnr_parser.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIX_GHZ_PLAN_MAX_APS                 (16U)
+
+/* An AP not announced by any full sweep for this many full sweeps is
+ * dropped from the plan.
+ */
+#define SIX_GHZ_PLAN_STALE_SWEEPS            (10U)
+
+/* Upper bound of the channel list: every PSC plus one channel per AP. */
+#define SIX_GHZ_PLAN_MAX_CHANNELS            (15U + SIX_GHZ_PLAN_MAX_APS)
+
+#define SIX_GHZ_PLAN_NOT_FOUND               (UINT32_MAX)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* A co-located 6 GHz AP. found_ms is the time from the start of the last scan
+ * to its result in that scan, or SIX_GHZ_PLAN_NOT_FOUND.
+ */
+typedef struct
+{
+    uint8_t  bssid[RNR_BSSID_LENGTH];
+    uint8_t  reporter[RNR_BSSID_LENGTH];
+    bool     has_bssid;
+    uint8_t  channel;
+    uint32_t short_ssid;
+    uint32_t announced_sweep;
+    uint32_t found_ms;
+} six_ghz_ap_t;
+
+/* Discovery statistics of the scans. A 6 GHz AP counts as announced in a scan
+ * if it is in the plan with a BSSID when the scan starts, and as found if the
+ * scan reports it. The time to discover is measured from the start of the
+ * scan.
+ */
+typedef struct
+{
+    uint32_t scans;
+    uint32_t total_scan_ms;
+    uint32_t last_scan_ms;
+    uint32_t last_first_6ghz_ms;
+    uint32_t announced;
+    uint32_t found;
+    uint64_t total_discover_ms;
+    uint32_t max_discover_ms;
+} six_ghz_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void six_ghz_plan_init(void);
+void six_ghz_plan_begin(bool full_sweep, uint32_t now_ms);
+void six_ghz_plan_observe(const uint8_t *bssid, bool is_6ghz, const uint8_t *ies,
+                          uint32_t ie_length, uint32_t now_ms);
+void six_ghz_plan_commit(uint32_t now_ms);
+uint32_t six_ghz_plan_channels(uint8_t *channels, uint32_t max_channels);
+bool six_ghz_plan_get(uint32_t index, six_ghz_ap_t *ap);
+void six_ghz_plan_stats(six_ghz_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SIX_GHZ_PLAN_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,615 @@
+/*******************************************************************************
+* File Name        : snapshot_ring.c
+*
+* Description      : This file contains the ring of the most recent scan snapshots.
+*                    Each snapshot is a presence bitmap over a BSSID dictionary
+*                    shared by all snapshots, followed by one byte per BSSID that
+*                    holds its RSSI as a delta from the dictionary entry.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "snapshot_ring.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#if (SNAPSHOT_RING_DEPTH > 32U)
+#error "SNAPSHOT_RING_DEPTH must not exceed 32"
+#endif
+
+#if ((SNAPSHOT_RING_DICT_SIZE % 8U) != 0U) || (SNAPSHOT_RING_DICT_SIZE > 255U)
+#error "SNAPSHOT_RING_DICT_SIZE must be a multiple of 8 and at most 255"
+#endif
+
+#define DICT_NO_SLOT                         (0xFFU)
+
+/* A BSSID whose channel is the one of its dictionary entry and whose RSSI is
+ * within DELTA_MIN..DELTA_MAX of the dictionary RSSI takes one byte with the
+ * 7-bit delta. Any other BSSID takes ESCAPE followed by its RSSI and channel.
+ */
+#define DELTA_MIN                            (-64)
+#define DELTA_MAX                            (63)
+#define DELTA_MASK                           (0x7FU)
+#define ESCAPE                               (0x80U)
+#define ESCAPED_ENTRY_BYTES                  (3U)
+
+#define MAX_ENCODED_SIZE                     (SNAPSHOT_RING_BITMAP_BYTES + \
+                                              (SNAPSHOT_RING_DICT_SIZE * ESCAPED_ENTRY_BYTES))
+
+#if (SNAPSHOT_RING_POOL_SIZE < MAX_ENCODED_SIZE) || (SNAPSHOT_RING_POOL_SIZE > 0xFFFFU)
+#error "SNAPSHOT_RING_POOL_SIZE cannot hold a full snapshot"
+#endif
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* A BSSID referenced by the snapshots. The reference RSSI and channel are the
+ * ones of the first sighting and never change while a snapshot uses the
+ * entry, so the entry can only be recycled once no stored snapshot refers to
+ * it.
+ */
+typedef struct
+{
+    uint8_t  bssid[BSSID_LENGTH];
+    int8_t   rssi;
+    uint8_t  channel;
+    uint16_t table_index;
+    uint16_t generation;
+    uint8_t  refs;
+    bool     in_use;
+} dict_entry_t;
+
+/* One stored snapshot. The encoded bitmap and entries are at 'offset' in the
+ * pool.
+ */
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t timestamp;
+    uint16_t offset;
+    uint16_t length;
+    uint8_t  ap_count;
+    uint8_t  flags;
+} snapshot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE dict_entry_t dict[SNAPSHOT_RING_DICT_SIZE];
+
+/* Dictionary entry of every BSSID table entry, DICT_NO_SLOT if none. */
+static MODULE_STATE uint8_t dict_slot_of_entry[BSSID_TABLE_MAX_ENTRIES];
+
+static MODULE_STATE snapshot_t snapshots[SNAPSHOT_RING_DEPTH];
+static MODULE_STATE uint8_t snapshot_pool[SNAPSHOT_RING_POOL_SIZE];
+static MODULE_STATE uint32_t snapshot_oldest;
+static MODULE_STATE uint32_t snapshot_count;
+static MODULE_STATE uint16_t pool_tail;
+
+/* Snapshot being recorded. */
+static MODULE_STATE uint32_t pending_sequence;
+static MODULE_STATE uint8_t pending_flags;
+static MODULE_STATE uint8_t pending_bitmap[SNAPSHOT_RING_BITMAP_BYTES];
+static MODULE_STATE int8_t pending_rssi[SNAPSHOT_RING_DICT_SIZE];
+static MODULE_STATE uint8_t pending_channel[SNAPSHOT_RING_DICT_SIZE];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bitmap_test
+********************************************************************************
+* Summary:
+* Returns true if the bit of a dictionary entry is set in a bitmap.
+*******************************************************************************/
+static inline bool bitmap_test(const uint8_t *bitmap, uint32_t slot)
+{
+    return (0U != (bitmap[slot >> 3] & (1U << (slot & 7U))));
+}
+
+/*******************************************************************************
+* Function Name: entry_fits_delta
+********************************************************************************
+* Summary:
+* Returns true if the pending BSSID of a dictionary entry is coded as a delta.
+*******************************************************************************/
+static inline bool entry_fits_delta(uint32_t slot)
+{
+    int32_t delta = (int32_t)pending_rssi[slot] - dict[slot].rssi;
+
+    return ((pending_channel[slot] == dict[slot].channel) &&
+            (delta >= DELTA_MIN) && (delta <= DELTA_MAX));
+}
+
+/*******************************************************************************
+* Function Name: snapshot_at
+********************************************************************************
+* Summary:
+* Returns the snapshot of the given age, 0 being the most recent.
+*******************************************************************************/
+static snapshot_t* snapshot_at(uint32_t age)
+{
+    return &snapshots[(snapshot_oldest + snapshot_count - 1U - age) % SNAPSHOT_RING_DEPTH];
+}
+
+/*******************************************************************************
+* Function Name: dict_claim
+********************************************************************************
+* Summary:
+* Assigns a dictionary entry to a BSSID table entry. A free entry is used
+* first, then an entry that no stored snapshot refers to. Returns DICT_NO_SLOT
+* if all the entries are in use.
+*******************************************************************************/
+static uint8_t dict_claim(uint16_t table_index, uint16_t generation,
+                          const uint8_t *bssid, int8_t rssi, uint8_t channel)
+{
+    uint8_t victim = DICT_NO_SLOT;
+
+    for (uint32_t i = 0; i < SNAPSHOT_RING_DICT_SIZE; i++)
+    {
+        if (!dict[i].in_use)
+        {
+            victim = (uint8_t)i;
+            break;
+        }
+
+        if ((DICT_NO_SLOT == victim) && (0U == dict[i].refs) &&
+            !bitmap_test(pending_bitmap, i))
+        {
+            victim = (uint8_t)i;
+        }
+    }
+
+    if (DICT_NO_SLOT != victim)
+    {
+        dict_entry_t *entry = &dict[victim];
+
+        if (entry->in_use && (dict_slot_of_entry[entry->table_index] == victim))
+        {
+            dict_slot_of_entry[entry->table_index] = DICT_NO_SLOT;
+        }
+
+        memcpy(entry->bssid, bssid, BSSID_LENGTH);
+        entry->rssi = rssi;
+        entry->channel = channel;
+        entry->table_index = table_index;
+        entry->generation = generation;
+        entry->refs = 0;
+        entry->in_use = true;
+
+        dict_slot_of_entry[table_index] = victim;
+    }
+
+    return victim;
+}
+
+/*******************************************************************************
+* Function Name: snapshot_release
+********************************************************************************
+* Summary:
+* Drops the oldest snapshot and its references to the dictionary.
+*******************************************************************************/
+static void snapshot_release(void)
+{
+    const snapshot_t *snap = &snapshots[snapshot_oldest];
+    const uint8_t *bitmap = &snapshot_pool[snap->offset];
+
+    for (uint32_t i = 0; i < SNAPSHOT_RING_DICT_SIZE; i++)
+    {
+        if (bitmap_test(bitmap, i))
+        {
+            dict[i].refs--;
+        }
+    }
+
+    snapshot_oldest = (snapshot_oldest + 1U) % SNAPSHOT_RING_DEPTH;
+    snapshot_count--;
+}
+
+/*******************************************************************************
+* Function Name: pool_reserve
+********************************************************************************
+* Summary:
+* Finds room for 'length' contiguous bytes after the newest snapshot, wrapping
+* to the start of the pool if needed. Returns false if the oldest snapshot
+* is in the way.
+*******************************************************************************/
+static bool pool_reserve(uint16_t length, uint16_t *offset)
+{
+    if (0U == snapshot_count)
+    {
+        *offset = 0;
+        return true;
+    }
+
+    uint16_t head = snapshots[snapshot_oldest].offset;
+
+    if (pool_tail > head)
+    {
+        if (((uint32_t)pool_tail + length) <= SNAPSHOT_RING_POOL_SIZE)
+        {
+            *offset = pool_tail;
+            return true;
+        }
+
+        if (length <= head)
+        {
+            *offset = 0;
+            return true;
+        }
+
+        return false;
+    }
+
+    if (((uint32_t)pool_tail + length) <= head)
+    {
+        *offset = pool_tail;
+        return true;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_init
+********************************************************************************
+* Summary:
+* Clears the ring and the dictionary.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void snapshot_ring_init(void)
+{
+    memset(dict, 0, sizeof(dict));
+    memset(dict_slot_of_entry, DICT_NO_SLOT, sizeof(dict_slot_of_entry));
+    memset(pending_bitmap, 0, sizeof(pending_bitmap));
+    snapshot_oldest = 0;
+    snapshot_count = 0;
+    pool_tail = 0;
+    pending_flags = 0;
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_begin
+********************************************************************************
+* Summary:
+* Starts recording the snapshot of a new scan.
+*
+* Parameters:
+*  uint32_t sequence: Scan sequence number
+*  bool full_sweep: true if the scan covered all channels without filter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void snapshot_ring_begin(uint32_t sequence, bool full_sweep)
+{
+    memset(pending_bitmap, 0, sizeof(pending_bitmap));
+    pending_sequence = sequence;
+    pending_flags = full_sweep ? SNAPSHOT_RING_FLAG_FULL_SWEEP : 0U;
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_observe
+********************************************************************************
+* Summary:
+* Adds a BSSID to the snapshot being recorded. If the BSSID is reported more
+* than once, the strongest RSSI is kept. If the dictionary is full, the BSSID
+* is dropped and the snapshot is flagged as truncated.
+*
+* Parameters:
+*  uint16_t table_index: Index of the BSSID in the BSSID table
+*  uint16_t generation: Generation of the BSSID table entry
+*  const uint8_t *bssid: BSSID
+*  int8_t rssi: RSSI in dBm
+*  uint8_t channel: Channel
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void snapshot_ring_observe(uint16_t table_index, uint16_t generation,
+                           const uint8_t *bssid, int8_t rssi, uint8_t channel)
+{
+    if (table_index >= BSSID_TABLE_MAX_ENTRIES)
+    {
+        return;
+    }
+
+    uint8_t slot = dict_slot_of_entry[table_index];
+
+    if ((DICT_NO_SLOT == slot) || (dict[slot].table_index != table_index) ||
+        (dict[slot].generation != generation))
+    {
+        slot = dict_claim(table_index, generation, bssid, rssi, channel);
+
+        if (DICT_NO_SLOT == slot)
+        {
+            pending_flags |= SNAPSHOT_RING_FLAG_TRUNCATED;
+            return;
+        }
+    }
+
+    if (!bitmap_test(pending_bitmap, slot) || (rssi > pending_rssi[slot]))
+    {
+        pending_bitmap[slot >> 3] |= (uint8_t)(1U << (slot & 7U));
+        pending_rssi[slot] = rssi;
+        pending_channel[slot] = channel;
+    }
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_commit
+********************************************************************************
+* Summary:
+* Encodes the recorded snapshot and stores it as the most recent one, dropping
+* the oldest snapshots if the ring or the pool is full.
+*
+* Parameters:
+*  uint32_t timestamp: Time of scan completion in seconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void snapshot_ring_commit(uint32_t timestamp)
+{
+    uint16_t length = SNAPSHOT_RING_BITMAP_BYTES;
+    uint16_t offset;
+    uint8_t ap_count = 0;
+
+    for (uint32_t i = 0; i < SNAPSHOT_RING_DICT_SIZE; i++)
+    {
+        if (bitmap_test(pending_bitmap, i))
+        {
+            length += entry_fits_delta(i) ? 1U : ESCAPED_ENTRY_BYTES;
+            ap_count++;
+        }
+    }
+
+    while ((SNAPSHOT_RING_DEPTH == snapshot_count) || !pool_reserve(length, &offset))
+    {
+        snapshot_release();
+    }
+
+    uint8_t *p = &snapshot_pool[offset];
+
+    memcpy(p, pending_bitmap, SNAPSHOT_RING_BITMAP_BYTES);
+    p += SNAPSHOT_RING_BITMAP_BYTES;
+
+    for (uint32_t i = 0; i < SNAPSHOT_RING_DICT_SIZE; i++)
+    {
+        if (bitmap_test(pending_bitmap, i))
+        {
+            if (entry_fits_delta(i))
+            {
+                *p++ = (uint8_t)(pending_rssi[i] - dict[i].rssi) & DELTA_MASK;
+            }
+            else
+            {
+                *p++ = ESCAPE;
+                *p++ = (uint8_t)pending_rssi[i];
+                *p++ = pending_channel[i];
+            }
+
+            dict[i].refs++;
+        }
+    }
+
+    snapshot_t *snap = &snapshots[(snapshot_oldest + snapshot_count) % SNAPSHOT_RING_DEPTH];
+
+    snap->sequence = pending_sequence;
+    snap->timestamp = timestamp;
+    snap->offset = offset;
+    snap->length = length;
+    snap->ap_count = ap_count;
+    snap->flags = pending_flags;
+
+    snapshot_count++;
+    pool_tail = offset + length;
+
+    memset(pending_bitmap, 0, sizeof(pending_bitmap));
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_count
+********************************************************************************
+* Summary:
+* Returns the number of stored snapshots.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: Number of snapshots
+*
+*******************************************************************************/
+uint32_t snapshot_ring_count(void)
+{
+    return snapshot_count;
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_get
+********************************************************************************
+* Summary:
+* Decodes a stored snapshot.
+*
+* Parameters:
+*  uint32_t age: 0 for the most recent snapshot, 1 for the one before, ...
+*  snapshot_ring_info_t *info: Description of the snapshot
+*  snapshot_ring_ap_t *aps: BSSIDs of the snapshot, may be NULL
+*  uint32_t max_aps: Capacity of 'aps'
+*
+* Return:
+*  bool: false if there is no snapshot of this age
+*
+*******************************************************************************/
+bool snapshot_ring_get(uint32_t age, snapshot_ring_info_t *info,
+                       snapshot_ring_ap_t *aps, uint32_t max_aps)
+{
+    if (age >= snapshot_count)
+    {
+        return false;
+    }
+
+    const snapshot_t *snap = snapshot_at(age);
+    const uint8_t *bitmap = &snapshot_pool[snap->offset];
+    const uint8_t *p = bitmap + SNAPSHOT_RING_BITMAP_BYTES;
+    uint32_t count = 0;
+
+    info->sequence = snap->sequence;
+    info->timestamp = snap->timestamp;
+    info->ap_count = snap->ap_count;
+    info->bytes = (uint16_t)(snap->length + sizeof(snapshot_t));
+    info->flags = snap->flags;
+
+    for (uint32_t i = 0; (i < SNAPSHOT_RING_DICT_SIZE) && (NULL != aps) && (count < max_aps); i++)
+    {
+        if (!bitmap_test(bitmap, i))
+        {
+            continue;
+        }
+
+        snapshot_ring_ap_t *ap = &aps[count++];
+
+        memcpy(ap->bssid, dict[i].bssid, BSSID_LENGTH);
+
+        if (ESCAPE == *p)
+        {
+            ap->rssi = (int8_t)p[1];
+            ap->channel = p[2];
+            p += ESCAPED_ENTRY_BYTES;
+        }
+        else
+        {
+            /* Sign-extend the 7-bit delta. */
+            int32_t delta = (int32_t)((uint32_t)*p ^ 0x40U) - 0x40;
+
+            ap->rssi = (int8_t)(dict[i].rssi + delta);
+            ap->channel = dict[i].channel;
+            p++;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_presence
+********************************************************************************
+* Summary:
+* Returns the presence of a BSSID in the stored snapshots.
+*
+* Parameters:
+*  const uint8_t *bssid: BSSID
+*
+* Return:
+*  uint32_t: Bit n is set if the BSSID is in the snapshot of age n
+*
+*******************************************************************************/
+uint32_t snapshot_ring_presence(const uint8_t *bssid)
+{
+    uint32_t presence = 0;
+
+    /* The same BSSID can own more than one dictionary entry if its BSSID table
+     * entry was recycled while snapshots still referred to the old one.
+     */
+    for (uint32_t i = 0; i < SNAPSHOT_RING_DICT_SIZE; i++)
+    {
+        if (!dict[i].in_use || (0U == dict[i].refs) ||
+            (0 != memcmp(dict[i].bssid, bssid, BSSID_LENGTH)))
+        {
+            continue;
+        }
+
+        for (uint32_t age = 0; age < snapshot_count; age++)
+        {
+            if (bitmap_test(&snapshot_pool[snapshot_at(age)->offset], i))
+            {
+                presence |= (1UL << age);
+            }
+        }
+    }
+
+    return presence;
+}
+
+/*******************************************************************************
+* Function Name: snapshot_ring_stats
+********************************************************************************
+* Summary:
+* Returns the memory used by the ring.
+*
+* Parameters:
+*  snapshot_ring_stats_t *stats: Ring statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void snapshot_ring_stats(snapshot_ring_stats_t *stats)
+{
+    stats->count = snapshot_count;
+    stats->pool_used = 0;
+    stats->dict_used = 0;
+    stats->total_bytes = (uint32_t)(sizeof(dict) + sizeof(dict_slot_of_entry) +
+                                    sizeof(snapshots) + sizeof(snapshot_pool));
+
+    for (uint32_t age = 0; age < snapshot_count; age++)
+    {
+        stats->pool_used += snapshot_at(age)->length;
+    }
+
+    for (uint32_t i = 0; i < SNAPSHOT_RING_DICT_SIZE; i++)
+    {
+        stats->dict_used += (dict[i].in_use && (0U != dict[i].refs)) ? 1U : 0U;
+    }
+}
+
+/* [] END OF FILE */
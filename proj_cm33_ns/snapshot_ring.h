@@ -0,0 +1,143 @@
+/*******************************************************************************
+* File Name        : snapshot_ring.h
+*
+* Description      : This file contains the structures and function prototypes of
+*                    the in-RAM ring of the most recent scan snapshots.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SNAPSHOT_RING_H_
+#define SOURCE_SNAPSHOT_RING_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "bssid_table.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of snapshots kept. At most 32 so that the presence of a BSSID over
+ * the whole ring fits in a 32-bit mask.
+ */
+#ifndef SNAPSHOT_RING_DEPTH
+#define SNAPSHOT_RING_DEPTH                  (32U)
+#endif
+
+/* Number of BSSIDs in the dictionary shared by the snapshots. Must be a
+ * multiple of 8 and at most 255.
+ */
+#ifndef SNAPSHOT_RING_DICT_SIZE
+#define SNAPSHOT_RING_DICT_SIZE              (128U)
+#endif
+
+/* Bytes available for the encoded snapshots. When the pool is full, the
+ * oldest snapshots are dropped even if fewer than SNAPSHOT_RING_DEPTH are
+ * stored.
+ */
+#ifndef SNAPSHOT_RING_POOL_SIZE
+#define SNAPSHOT_RING_POOL_SIZE              (2048U)
+#endif
+
+#define SNAPSHOT_RING_BITMAP_BYTES           (SNAPSHOT_RING_DICT_SIZE / 8U)
+
+/* Snapshot flags */
+#define SNAPSHOT_RING_FLAG_FULL_SWEEP        (0x01U)
+#define SNAPSHOT_RING_FLAG_TRUNCATED         (0x02U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* One BSSID of a decoded snapshot. */
+typedef struct
+{
+    uint8_t bssid[BSSID_LENGTH];
+    int8_t  rssi;
+    uint8_t channel;
+} snapshot_ring_ap_t;
+
+/* Description of one stored snapshot. 'bytes' is the RAM used by the
+ * snapshot, including its entry in the ring.
+ */
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t timestamp;
+    uint16_t ap_count;
+    uint16_t bytes;
+    uint8_t  flags;
+} snapshot_ring_info_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t pool_used;
+    uint32_t dict_used;
+    uint32_t total_bytes;
+} snapshot_ring_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void snapshot_ring_init(void);
+void snapshot_ring_begin(uint32_t sequence, bool full_sweep);
+void snapshot_ring_observe(uint16_t table_index, uint16_t generation,
+                           const uint8_t *bssid, int8_t rssi, uint8_t channel);
+void snapshot_ring_commit(uint32_t timestamp);
+uint32_t snapshot_ring_count(void);
+bool snapshot_ring_get(uint32_t age, snapshot_ring_info_t *info,
+                       snapshot_ring_ap_t *aps, uint32_t max_aps);
+uint32_t snapshot_ring_presence(const uint8_t *bssid);
+void snapshot_ring_stats(snapshot_ring_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SNAPSHOT_RING_H_ */
+
+/* [] END OF FILE */
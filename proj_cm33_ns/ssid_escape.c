@@ -0,0 +1,494 @@
+/*******************************************************************************
+* File Name        : ssid_escape.c
+*
+* Description      : This file contains the SSID escaping for terminal, JSON
+*                    and CSV output, with a word-at-a-time check for the common
+*                    SSIDs that need no escaping.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "ssid_escape.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bytes of a 32-bit word, and their high bits. */
+#define SWAR_ONES                            (0x01010101UL)
+#define SWAR_HIGHS                           (0x80808080UL)
+#define SWAR_WORD_SIZE                       (4U)
+
+/* Filler of the last partial word, a byte that needs no escaping. */
+#define SWAR_FILLER                          (0x41414141UL)
+
+#define ASCII_SPACE                          (0x20U)
+#define ASCII_DELETE                         (0x7FU)
+#define ASCII_MAX                            (0x7FU)
+
+#define HEX_ESCAPE_LENGTH                    (4U)
+#define JSON_UNICODE_ESCAPE_LENGTH           (6U)
+
+/* UTF-8 lead bytes and the range of the second byte that avoids overlong
+ * forms, surrogates and code points above U+10FFFF.
+ */
+#define UTF8_CONTINUATION_MASK               (0xC0U)
+#define UTF8_CONTINUATION                    (0x80U)
+#define UTF8_LEAD_2_MIN                      (0xC2U)
+#define UTF8_LEAD_3_MIN                      (0xE0U)
+#define UTF8_LEAD_4_MIN                      (0xF0U)
+#define UTF8_LEAD_MAX                        (0xF4U)
+#define UTF8_SURROGATE_LEAD                  (0xEDU)
+
+#define UNICODE_REPLACEMENT                  (0xFFFDUL)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+} code_point_range_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char hex_digits[] = "0123456789ABCDEF";
+
+/* Characters that are escaped although they are valid: C1 controls, which
+ * some terminals act on, and the bidirectional formatting characters, which
+ * reorder the text that follows them.
+ */
+static const code_point_range_t unsafe_ranges[] =
+{
+    { 0x0080UL, 0x009FUL }, { 0x202AUL, 0x202EUL }, { 0x2066UL, 0x2069UL }
+};
+
+/* Combining and zero width characters, which take no column. */
+static const code_point_range_t zero_width_ranges[] =
+{
+    { 0x0300UL, 0x036FUL }, { 0x200BUL, 0x200FUL }, { 0x20D0UL, 0x20FFUL },
+    { 0xFE00UL, 0xFE0FUL }, { 0xFE20UL, 0xFE2FUL }
+};
+
+/* East Asian wide and fullwidth characters and emoji, which take two
+ * columns.
+ */
+static const code_point_range_t wide_ranges[] =
+{
+    { 0x1100UL, 0x115FUL }, { 0x2E80UL, 0x303EUL }, { 0x3041UL, 0x33FFUL },
+    { 0x3400UL, 0x4DBFUL }, { 0x4E00UL, 0x9FFFUL }, { 0xA000UL, 0xA4CFUL },
+    { 0xAC00UL, 0xD7A3UL }, { 0xF900UL, 0xFAFFUL }, { 0xFE30UL, 0xFE4FUL },
+    { 0xFF00UL, 0xFF60UL }, { 0xFFE0UL, 0xFFE6UL }, { 0x1F300UL, 0x1F64FUL },
+    { 0x1F900UL, 0x1F9FFUL }, { 0x20000UL, 0x2FFFDUL }, { 0x30000UL, 0x3FFFDUL }
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: swar_less
+********************************************************************************
+* Summary:
+* Returns non-zero if a byte of the word is less than n, which is at most 128.
+*******************************************************************************/
+static inline uint32_t swar_less(uint32_t word, uint32_t n)
+{
+    return (word - (SWAR_ONES * n)) & ~word & SWAR_HIGHS;
+}
+
+/*******************************************************************************
+* Function Name: swar_equal
+********************************************************************************
+* Summary:
+* Returns non-zero if a byte of the word equals c.
+*******************************************************************************/
+static inline uint32_t swar_equal(uint32_t word, uint32_t c)
+{
+    return swar_less(word ^ (SWAR_ONES * c), 1U);
+}
+
+/*******************************************************************************
+* Function Name: swar_special
+********************************************************************************
+* Summary:
+* Returns non-zero if a byte of the word is not printable ASCII, or is a
+* character that the context escapes.
+*******************************************************************************/
+static inline uint32_t swar_special(uint32_t word, ssid_escape_context_t context)
+{
+    uint32_t special = (word & SWAR_HIGHS) | swar_less(word, ASCII_SPACE) |
+                       swar_equal(word, ASCII_DELETE) | swar_equal(word, '\\');
+
+    if (SSID_ESCAPE_TERMINAL != context)
+    {
+        special |= swar_equal(word, '"');
+    }
+
+    if (SSID_ESCAPE_CSV == context)
+    {
+        special |= swar_equal(word, ',');
+    }
+
+    return special;
+}
+
+/*******************************************************************************
+* Function Name: ssid_escape_is_plain
+********************************************************************************
+* Summary:
+* Checks a word at a time whether an SSID is printable ASCII that the
+* context does not escape, so that it can be printed as it is.
+*
+* Parameters:
+*  const uint8_t *ssid: SSID bytes
+*  uint32_t length: Length of the SSID
+*  ssid_escape_context_t context: Output context
+*
+* Return:
+*  bool: true if the SSID needs no escaping
+*
+*******************************************************************************/
+bool ssid_escape_is_plain(const uint8_t *ssid, uint32_t length, ssid_escape_context_t context)
+{
+    uint32_t word;
+    uint32_t i = 0U;
+
+    for (; (i + SWAR_WORD_SIZE) <= length; i += SWAR_WORD_SIZE)
+    {
+        memcpy(&word, &ssid[i], SWAR_WORD_SIZE);
+
+        if (0U != swar_special(word, context))
+        {
+            return false;
+        }
+    }
+
+    word = SWAR_FILLER;
+    memcpy(&word, &ssid[i], length - i);
+
+    return (0U == swar_special(word, context));
+}
+
+/*******************************************************************************
+* Function Name: in_ranges
+********************************************************************************
+* Summary:
+* Returns true if a code point is in one of the ranges.
+*******************************************************************************/
+static bool in_ranges(uint32_t code_point, const code_point_range_t *ranges, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if ((code_point >= ranges[i].first) && (code_point <= ranges[i].last))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: code_point_columns
+********************************************************************************
+* Summary:
+* Returns the number of terminal columns of a printable code point.
+*******************************************************************************/
+static uint32_t code_point_columns(uint32_t code_point)
+{
+    if (in_ranges(code_point, zero_width_ranges,
+                  sizeof(zero_width_ranges) / sizeof(zero_width_ranges[0])))
+    {
+        return 0U;
+    }
+
+    return in_ranges(code_point, wide_ranges, sizeof(wide_ranges) / sizeof(wide_ranges[0])) ?
+           2U : 1U;
+}
+
+/*******************************************************************************
+* Function Name: decode_utf8
+********************************************************************************
+* Summary:
+* Decodes the UTF-8 sequence of a non-ASCII code point. Returns its length,
+* or 0 if it is invalid, overlong, a surrogate or truncated.
+*******************************************************************************/
+static uint32_t decode_utf8(const uint8_t *p, uint32_t available, uint32_t *code_point)
+{
+    uint8_t lead = p[0];
+    uint8_t min = UTF8_CONTINUATION;
+    uint8_t max = UTF8_CONTINUATION | 0x3FU;
+    uint32_t length;
+
+    if ((lead < UTF8_LEAD_2_MIN) || (lead > UTF8_LEAD_MAX))
+    {
+        return 0U;
+    }
+
+    if (lead < UTF8_LEAD_3_MIN)
+    {
+        length = 2U;
+        *code_point = lead & 0x1FU;
+    }
+    else if (lead < UTF8_LEAD_4_MIN)
+    {
+        length = 3U;
+        *code_point = lead & 0x0FU;
+        min = (UTF8_LEAD_3_MIN == lead) ? 0xA0U : min;
+        max = (UTF8_SURROGATE_LEAD == lead) ? 0x9FU : max;
+    }
+    else
+    {
+        length = 4U;
+        *code_point = lead & 0x07U;
+        min = (UTF8_LEAD_4_MIN == lead) ? 0x90U : min;
+        max = (UTF8_LEAD_MAX == lead) ? 0x8FU : max;
+    }
+
+    if ((available < length) || (p[1] < min) || (p[1] > max))
+    {
+        return 0U;
+    }
+
+    for (uint32_t i = 1U; i < length; i++)
+    {
+        if (UTF8_CONTINUATION != (p[i] & UTF8_CONTINUATION_MASK))
+        {
+            return 0U;
+        }
+
+        *code_point = (*code_point << 6) | (p[i] & 0x3FU);
+    }
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: put_hex_escape
+********************************************************************************
+* Summary:
+* Writes a byte as \xHH and returns the number of characters.
+*******************************************************************************/
+static uint32_t put_hex_escape(char *out, uint8_t byte)
+{
+    out[0] = '\\';
+    out[1] = 'x';
+    out[2] = hex_digits[byte >> 4];
+    out[3] = hex_digits[byte & 0x0FU];
+
+    return HEX_ESCAPE_LENGTH;
+}
+
+/*******************************************************************************
+* Function Name: put_json_escape
+********************************************************************************
+* Summary:
+* Writes a code point of the Basic Multilingual Plane as a JSON escape and
+* returns the number of characters.
+*******************************************************************************/
+static uint32_t put_json_escape(char *out, uint32_t code_point)
+{
+    const char *const short_escapes = "btnvfr";
+
+    if ((code_point >= '\b') && (code_point <= '\r') && ('\v' != code_point))
+    {
+        out[0] = '\\';
+        out[1] = short_escapes[code_point - '\b'];
+        return 2U;
+    }
+
+    out[0] = '\\';
+    out[1] = 'u';
+
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        out[2U + i] = hex_digits[(code_point >> (12U - (4U * i))) & 0x0FU];
+    }
+
+    return JSON_UNICODE_ESCAPE_LENGTH;
+}
+
+/*******************************************************************************
+* Function Name: ssid_escape
+********************************************************************************
+* Summary:
+* Escapes an SSID for an output context and counts the terminal columns the
+* result takes, with two for wide characters and none for combining ones.
+* SSIDs that ssid_escape_is_plain() accepts are copied as they are.
+*
+* Parameters:
+*  const uint8_t *ssid: SSID bytes, of which at most
+*   SSID_ESCAPE_MAX_SSID_LENGTH are used
+*  uint32_t length: Length of the SSID
+*  ssid_escape_context_t context: Output context
+*  char *out: Buffer of SSID_ESCAPE_BUFFER_SIZE bytes for the NUL-terminated
+*   result
+*  uint32_t *columns: Set to the number of terminal columns of the result
+*
+* Return:
+*  uint32_t: Length of the result
+*
+*******************************************************************************/
+uint32_t ssid_escape(const uint8_t *ssid, uint32_t length, ssid_escape_context_t context,
+                     char *out, uint32_t *columns)
+{
+    uint32_t written = 0U;
+    uint32_t width = 0U;
+    bool quoted;
+
+    length = (length > SSID_ESCAPE_MAX_SSID_LENGTH) ? SSID_ESCAPE_MAX_SSID_LENGTH : length;
+
+    if (ssid_escape_is_plain(ssid, length, context))
+    {
+        memcpy(out, ssid, length);
+        out[length] = '\0';
+        *columns = length;
+        return length;
+    }
+
+    /* Commas and quotes are ASCII, so they are never part of a sequence. */
+    quoted = (SSID_ESCAPE_CSV == context) &&
+             ((NULL != memchr(ssid, ',', length)) || (NULL != memchr(ssid, '"', length)));
+
+    if (quoted)
+    {
+        out[written++] = '"';
+    }
+
+    for (uint32_t i = 0U; i < length;)
+    {
+        uint8_t byte = ssid[i];
+        uint32_t code_point = byte;
+        uint32_t sequence = 1U;
+        uint32_t start = written;
+        bool unsafe;
+
+        if (byte > ASCII_MAX)
+        {
+            sequence = decode_utf8(&ssid[i], length - i, &code_point);
+        }
+
+        if (0U == sequence)
+        {
+            /* Invalid UTF-8: the byte alone is escaped. */
+            if (SSID_ESCAPE_JSON == context)
+            {
+                written += put_json_escape(&out[written], UNICODE_REPLACEMENT);
+            }
+            else
+            {
+                written += put_hex_escape(&out[written], byte);
+            }
+
+            width += written - start;
+            i++;
+            continue;
+        }
+
+        unsafe = (code_point < ASCII_SPACE) || (ASCII_DELETE == code_point) ||
+                 in_ranges(code_point, unsafe_ranges,
+                           sizeof(unsafe_ranges) / sizeof(unsafe_ranges[0]));
+
+        if (unsafe)
+        {
+            if (SSID_ESCAPE_JSON == context)
+            {
+                written += put_json_escape(&out[written], code_point);
+            }
+            else
+            {
+                for (uint32_t j = 0U; j < sequence; j++)
+                {
+                    written += put_hex_escape(&out[written], ssid[i + j]);
+                }
+            }
+
+            width += written - start;
+        }
+        else if (('\\' == code_point) ||
+                 (('"' == code_point) && (SSID_ESCAPE_TERMINAL != context)))
+        {
+            out[written++] = (SSID_ESCAPE_CSV == context) ? (char)code_point : '\\';
+            out[written++] = (char)code_point;
+            width += 2U;
+        }
+        else
+        {
+            memcpy(&out[written], &ssid[i], sequence);
+            written += sequence;
+            width += (sequence > 1U) ? code_point_columns(code_point) : 1U;
+        }
+
+        i += sequence;
+    }
+
+    if (quoted)
+    {
+        out[written++] = '"';
+    }
+
+    out[written] = '\0';
+    *columns = width + (quoted ? 2U : 0U);
+
+    return written;
+}
+
+/*******************************************************************************
+* Function Name: ssid_escape_padding
+********************************************************************************
+* Summary:
+* Returns the number of spaces that pad an escaped SSID to a column width,
+* for printing it with "%s%*s", as "%-32s" pads by bytes rather than columns.
+*
+* Parameters:
+*  uint32_t columns: Columns of the escaped SSID
+*  uint32_t width: Width of the column
+*
+* Return:
+*  int: Number of spaces
+*
+*******************************************************************************/
+int ssid_escape_padding(uint32_t columns, uint32_t width)
+{
+    return (columns < width) ? (int)(width - columns) : 0;
+}
+
+/* [] END OF FILE */
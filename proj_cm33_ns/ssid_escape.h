@@ -0,0 +1,102 @@
+/*******************************************************************************
+* File Name        : ssid_escape.h
+*
+* Description      : This file contains the public interface of the SSID escaping
+*                    for terminal, JSON and CSV output.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SSID_ESCAPE_H_
+#define SOURCE_SSID_ESCAPE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SSID_ESCAPE_MAX_SSID_LENGTH          (32U)
+
+/* Every byte may become a 6 character JSON escape, and CSV fields may be
+ * quoted with every byte doubled.
+ */
+#define SSID_ESCAPE_BUFFER_SIZE              ((6U * SSID_ESCAPE_MAX_SSID_LENGTH) + 1U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Output contexts:
+ *  TERMINAL: control characters, C1 controls, bidirectional formatting
+ *            characters and invalid UTF-8 bytes become \xHH, and '\' is
+ *            doubled.
+ *  JSON:     the content of a string. '"', '\' and the same characters
+ *            become JSON escapes, with U+FFFD for invalid UTF-8 bytes.
+ *  CSV:      a field, escaped as for TERMINAL, and quoted with '"' doubled
+ *            if it contains ',' or '"'.
+ */
+typedef enum
+{
+    SSID_ESCAPE_TERMINAL,
+    SSID_ESCAPE_JSON,
+    SSID_ESCAPE_CSV
+} ssid_escape_context_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool ssid_escape_is_plain(const uint8_t *ssid, uint32_t length, ssid_escape_context_t context);
+uint32_t ssid_escape(const uint8_t *ssid, uint32_t length, ssid_escape_context_t context,
+                     char *out, uint32_t *columns);
+int ssid_escape_padding(uint32_t columns, uint32_t width);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SSID_ESCAPE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,932 @@
+/*******************************************************************************
+* File Name        : uplink.c
+*
+* Description      : This file publishes batches of scan log records to a server
+*                    over TLS. The connection is kept between publishes and a new
+*                    connection resumes the last TLS session, so that a full
+*                    handshake is only needed when the session is lost.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "uplink.h"
+#include "module_state.h"
+
+#include <errno.h>
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lwip/sockets.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define NO_SOCKET                            (-1)
+#define MS_PER_S                             (1000U)
+#define US_PER_MS                            (1000U)
+#define NS_PER_MS                            (1000000U)
+
+#if defined(__ARM_ARCH)
+#define CLOSE_SOCKET(s)                      lwip_close(s)
+#else
+#define CLOSE_SOCKET(s)                      close(s)
+#endif
+
+/* A publish that fails on a connection is tried once more on a new one. */
+#define PUBLISH_ATTEMPTS                     (2U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static MODULE_STATE const uplink_config_t *uplink_config;
+static MODULE_STATE int uplink_socket = NO_SOCKET;
+static MODULE_STATE bool uplink_open;
+static MODULE_STATE bool uplink_has_session;
+static MODULE_STATE uint32_t uplink_last_s;
+static MODULE_STATE uplink_stats_t uplink_counters;
+
+/* Serialized session as last loaded from or written to the storage, so that
+ * an unchanged session is not written again.
+ */
+static MODULE_STATE uint8_t uplink_stored[UPLINK_SESSION_MAX_SIZE];
+static MODULE_STATE uint32_t uplink_stored_length;
+
+#if defined(__ARM_ARCH)
+static MODULE_STATE bool uplink_tls_ready;
+static MODULE_STATE mbedtls_ssl_context uplink_ssl;
+static MODULE_STATE mbedtls_ssl_config uplink_ssl_config;
+static MODULE_STATE mbedtls_x509_crt uplink_ca;
+static MODULE_STATE mbedtls_entropy_context uplink_entropy;
+static MODULE_STATE mbedtls_ctr_drbg_context uplink_drbg;
+static MODULE_STATE mbedtls_ssl_session uplink_session;
+
+/* Set when the handshake in progress checks the server certificate, which a
+ * resumed handshake does not.
+ */
+static MODULE_STATE bool uplink_cert_checked;
+#else
+static SSL_CTX *uplink_context;
+static SSL *uplink_ssl;
+static SSL_SESSION *uplink_session;
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tcp_connect
+********************************************************************************
+* Summary:
+* Opens the TCP connection to the server, with send and receive timeouts and
+* keepalive probes.
+*******************************************************************************/
+static bool tcp_connect(void)
+{
+    struct sockaddr_in server;
+    struct timeval timeout = { UPLINK_IO_TIMEOUT_MS / MS_PER_S,
+                               (UPLINK_IO_TIMEOUT_MS % MS_PER_S) * US_PER_MS };
+    int enable = 1;
+
+    memset(&server, 0, sizeof(server));
+    server.sin_family = AF_INET;
+    server.sin_port = htons(uplink_config->port);
+
+    if (1 != inet_pton(AF_INET, uplink_config->address, &server.sin_addr))
+    {
+        return false;
+    }
+
+    uplink_socket = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (uplink_socket < 0)
+    {
+        uplink_socket = NO_SOCKET;
+        return false;
+    }
+
+    (void)setsockopt(uplink_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    (void)setsockopt(uplink_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    (void)setsockopt(uplink_socket, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable));
+    (void)setsockopt(uplink_socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+    int idle_s = (int)UPLINK_KEEPALIVE_S;
+    int probes = (int)UPLINK_KEEPALIVE_PROBES;
+
+    (void)setsockopt(uplink_socket, IPPROTO_TCP, TCP_KEEPIDLE, &idle_s, sizeof(idle_s));
+    (void)setsockopt(uplink_socket, IPPROTO_TCP, TCP_KEEPINTVL, &idle_s, sizeof(idle_s));
+    (void)setsockopt(uplink_socket, IPPROTO_TCP, TCP_KEEPCNT, &probes, sizeof(probes));
+#endif
+
+    return (0 == connect(uplink_socket, (struct sockaddr *)&server, sizeof(server)));
+}
+
+/*******************************************************************************
+* Function Name: tcp_alive
+********************************************************************************
+* Summary:
+* Returns whether a kept connection can still be used. The server sends
+* nothing between publishes, so any pending byte is its close_notify alert,
+* and the end of the stream means that it closed the connection. Keepalive
+* failures show as an error.
+*******************************************************************************/
+static bool tcp_alive(void)
+{
+    uint8_t byte;
+    int received = recv(uplink_socket, &byte, 1U, MSG_PEEK | MSG_DONTWAIT);
+
+    return (received < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno));
+}
+
+/*******************************************************************************
+* Function Name: tcp_close
+********************************************************************************
+* Summary:
+* Closes the TCP connection.
+*******************************************************************************/
+static void tcp_close(void)
+{
+    if (NO_SOCKET != uplink_socket)
+    {
+        (void)CLOSE_SOCKET(uplink_socket);
+        uplink_socket = NO_SOCKET;
+    }
+}
+
+#if defined(__ARM_ARCH)
+
+/*******************************************************************************
+* Function Name: bio_send
+********************************************************************************
+* Summary:
+* Sends TLS records on the socket of the connection.
+*******************************************************************************/
+static int bio_send(void *context, const unsigned char *data, size_t length)
+{
+    int sent = send(*(int *)context, data, length, 0);
+
+    if (sent >= 0)
+    {
+        return sent;
+    }
+
+    return ((EAGAIN == errno) || (EWOULDBLOCK == errno)) ? MBEDTLS_ERR_SSL_WANT_WRITE :
+           MBEDTLS_ERR_NET_SEND_FAILED;
+}
+
+/*******************************************************************************
+* Function Name: bio_recv
+********************************************************************************
+* Summary:
+* Receives TLS records from the socket of the connection.
+*******************************************************************************/
+static int bio_recv(void *context, unsigned char *data, size_t length)
+{
+    int received = recv(*(int *)context, data, length, 0);
+
+    if (received > 0)
+    {
+        return received;
+    }
+
+    if (0 == received)
+    {
+        return MBEDTLS_ERR_NET_CONN_RESET;
+    }
+
+    return ((EAGAIN == errno) || (EWOULDBLOCK == errno)) ? MBEDTLS_ERR_SSL_TIMEOUT :
+           MBEDTLS_ERR_NET_RECV_FAILED;
+}
+
+/*******************************************************************************
+* Function Name: cert_check
+********************************************************************************
+* Summary:
+* Called for each certificate of the server chain that is verified. Records
+* that the handshake was a full one and leaves the result of the check.
+*******************************************************************************/
+static int cert_check(void *context, mbedtls_x509_crt *cert, int depth, uint32_t *flags)
+{
+    (void)context;
+    (void)cert;
+    (void)depth;
+    (void)flags;
+
+    uplink_cert_checked = true;
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: tls_setup
+********************************************************************************
+* Summary:
+* Configures TLS 1.2 with session tickets, whose ticket arrives during the
+* handshake, and the verification of the server certificate.
+*******************************************************************************/
+static bool tls_setup(void)
+{
+    if (uplink_tls_ready)
+    {
+        mbedtls_ssl_config_free(&uplink_ssl_config);
+        mbedtls_x509_crt_free(&uplink_ca);
+        mbedtls_ctr_drbg_free(&uplink_drbg);
+        mbedtls_entropy_free(&uplink_entropy);
+        mbedtls_ssl_session_free(&uplink_session);
+    }
+
+    mbedtls_ssl_config_init(&uplink_ssl_config);
+    mbedtls_x509_crt_init(&uplink_ca);
+    mbedtls_entropy_init(&uplink_entropy);
+    mbedtls_ctr_drbg_init(&uplink_drbg);
+    mbedtls_ssl_session_init(&uplink_session);
+    uplink_tls_ready = true;
+
+    if ((0 != mbedtls_ctr_drbg_seed(&uplink_drbg, mbedtls_entropy_func, &uplink_entropy,
+                                    NULL, 0U)) ||
+        (0 != mbedtls_x509_crt_parse(&uplink_ca, (const unsigned char *)uplink_config->ca_pem,
+                                     strlen(uplink_config->ca_pem) + 1U)) ||
+        (0 != mbedtls_ssl_config_defaults(&uplink_ssl_config, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT)))
+    {
+        return false;
+    }
+
+    mbedtls_ssl_conf_authmode(&uplink_ssl_config, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_ca_chain(&uplink_ssl_config, &uplink_ca, NULL);
+    mbedtls_ssl_conf_verify(&uplink_ssl_config, cert_check, NULL);
+    mbedtls_ssl_conf_rng(&uplink_ssl_config, mbedtls_ctr_drbg_random, &uplink_drbg);
+    mbedtls_ssl_conf_max_tls_version(&uplink_ssl_config, MBEDTLS_SSL_VERSION_TLS1_2);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&uplink_ssl_config, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tls_connect
+********************************************************************************
+* Summary:
+* Runs the handshake on the TCP connection, offering the kept session. A
+* session is resumed when the handshake did not check the server certificate,
+* as only a full handshake sends it.
+*******************************************************************************/
+static bool tls_connect(bool resume, bool *resumed)
+{
+    mbedtls_ssl_session current;
+    int result;
+
+    mbedtls_ssl_init(&uplink_ssl);
+
+    if ((0 != mbedtls_ssl_setup(&uplink_ssl, &uplink_ssl_config)) ||
+        (0 != mbedtls_ssl_set_hostname(&uplink_ssl, uplink_config->server_name)))
+    {
+        return false;
+    }
+
+    mbedtls_ssl_set_bio(&uplink_ssl, &uplink_socket, bio_send, bio_recv, NULL);
+
+    if (resume && (0 != mbedtls_ssl_set_session(&uplink_ssl, &uplink_session)))
+    {
+        resume = false;
+    }
+
+    uplink_cert_checked = false;
+
+    do
+    {
+        result = mbedtls_ssl_handshake(&uplink_ssl);
+    } while ((MBEDTLS_ERR_SSL_WANT_READ == result) || (MBEDTLS_ERR_SSL_WANT_WRITE == result));
+
+    if (0 != result)
+    {
+        return false;
+    }
+
+    mbedtls_ssl_session_init(&current);
+
+    if (0 != mbedtls_ssl_get_session(&uplink_ssl, &current))
+    {
+        mbedtls_ssl_session_free(&current);
+        *resumed = false;
+        return true;
+    }
+
+    *resumed = resume && (!uplink_cert_checked);
+
+    /* The kept session takes over the new one, with its ticket. */
+    mbedtls_ssl_session_free(&uplink_session);
+    uplink_session = current;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tls_send
+********************************************************************************
+* Summary:
+* Sends the whole buffer on the connection.
+*******************************************************************************/
+static bool tls_send(const uint8_t *data, uint32_t length)
+{
+    while (0U != length)
+    {
+        int sent = mbedtls_ssl_write(&uplink_ssl, data, length);
+
+        if ((MBEDTLS_ERR_SSL_WANT_READ == sent) || (MBEDTLS_ERR_SSL_WANT_WRITE == sent))
+        {
+            continue;
+        }
+
+        if (sent <= 0)
+        {
+            return false;
+        }
+
+        data += sent;
+        length -= (uint32_t)sent;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tls_close
+********************************************************************************
+* Summary:
+* Sends the close_notify alert, if the connection is still up, and frees the
+* TLS context. The kept session stays.
+*******************************************************************************/
+static void tls_close(bool notify)
+{
+    if (notify)
+    {
+        (void)mbedtls_ssl_close_notify(&uplink_ssl);
+    }
+
+    mbedtls_ssl_free(&uplink_ssl);
+}
+
+/*******************************************************************************
+* Function Name: session_save
+********************************************************************************
+* Summary:
+* Serializes the kept session. Returns its length, 0 if it does not fit.
+*******************************************************************************/
+static uint32_t session_save(uint8_t *buffer, uint32_t size)
+{
+    size_t length = 0U;
+
+    return (0 == mbedtls_ssl_session_save(&uplink_session, buffer, size, &length)) ?
+           (uint32_t)length : 0U;
+}
+
+/*******************************************************************************
+* Function Name: session_load
+********************************************************************************
+* Summary:
+* Restores the kept session from its serialized form.
+*******************************************************************************/
+static bool session_load(const uint8_t *buffer, uint32_t length)
+{
+    mbedtls_ssl_session_free(&uplink_session);
+    mbedtls_ssl_session_init(&uplink_session);
+
+    return (0 == mbedtls_ssl_session_load(&uplink_session, buffer, length));
+}
+
+/*******************************************************************************
+* Function Name: session_clear
+********************************************************************************
+* Summary:
+* Forgets the kept session.
+*******************************************************************************/
+static void session_clear(void)
+{
+    mbedtls_ssl_session_free(&uplink_session);
+    mbedtls_ssl_session_init(&uplink_session);
+}
+
+#else
+
+/* The host tools use OpenSSL, with the same protocol version and policy. */
+static bool tls_setup(void)
+{
+    BIO *bio = BIO_new_mem_buf(uplink_config->ca_pem, -1);
+    X509 *ca = (NULL != bio) ? PEM_read_bio_X509(bio, NULL, NULL, NULL) : NULL;
+
+    SSL_CTX_free(uplink_context);
+    uplink_context = SSL_CTX_new(TLS_client_method());
+
+    bool ready = (NULL != uplink_context) && (NULL != ca) &&
+                 (1 == SSL_CTX_set_max_proto_version(uplink_context, TLS1_2_VERSION)) &&
+                 (1 == X509_STORE_add_cert(SSL_CTX_get_cert_store(uplink_context), ca));
+
+    if (ready)
+    {
+        SSL_CTX_set_verify(uplink_context, SSL_VERIFY_PEER, NULL);
+    }
+
+    X509_free(ca);
+    BIO_free(bio);
+
+    return ready;
+}
+
+static bool tls_connect(bool resume, bool *resumed)
+{
+    uplink_ssl = SSL_new(uplink_context);
+
+    if ((NULL == uplink_ssl) || (1 != SSL_set_fd(uplink_ssl, uplink_socket)) ||
+        (1 != SSL_set_tlsext_host_name(uplink_ssl, uplink_config->server_name)) ||
+        (1 != SSL_set1_host(uplink_ssl, uplink_config->server_name)) ||
+        (resume && (1 != SSL_set_session(uplink_ssl, uplink_session))) ||
+        (1 != SSL_connect(uplink_ssl)))
+    {
+        ERR_clear_error();
+        return false;
+    }
+
+    *resumed = resume && (1 == SSL_session_reused(uplink_ssl));
+
+    SSL_SESSION_free(uplink_session);
+    uplink_session = SSL_get1_session(uplink_ssl);
+
+    return true;
+}
+
+static bool tls_send(const uint8_t *data, uint32_t length)
+{
+    size_t written = 0U;
+    bool sent = (1 == SSL_write_ex(uplink_ssl, data, length, &written)) && (written == length);
+
+    ERR_clear_error();
+
+    return sent;
+}
+
+static void tls_close(bool notify)
+{
+    /* OpenSSL would not resume a session whose connection ended without
+     * close_notify. The records carry their length, so a cut batch is found
+     * without it.
+     */
+    if (notify)
+    {
+        (void)SSL_shutdown(uplink_ssl);
+    }
+    else if (NULL != uplink_ssl)
+    {
+        SSL_set_shutdown(uplink_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+    }
+
+    SSL_free(uplink_ssl);
+    uplink_ssl = NULL;
+    ERR_clear_error();
+}
+
+static uint32_t session_save(uint8_t *buffer, uint32_t size)
+{
+    int length = i2d_SSL_SESSION(uplink_session, NULL);
+
+    if ((length <= 0) || ((uint32_t)length > size))
+    {
+        return 0U;
+    }
+
+    return (uint32_t)i2d_SSL_SESSION(uplink_session, &buffer);
+}
+
+static bool session_load(const uint8_t *buffer, uint32_t length)
+{
+    SSL_SESSION_free(uplink_session);
+    uplink_session = d2i_SSL_SESSION(NULL, &buffer, (long)length);
+
+    return (NULL != uplink_session);
+}
+
+static void session_clear(void)
+{
+    SSL_SESSION_free(uplink_session);
+    uplink_session = NULL;
+}
+
+#endif /* defined(__ARM_ARCH) */
+
+/*******************************************************************************
+* Function Name: clock_now
+********************************************************************************
+* Summary:
+* Returns the start of a time measured by elapsed_ns(). The handshakes and
+* publishes can take seconds, longer than the cycle counter of perf_counter.h
+* can time, so the device times them with the RTOS tick.
+*******************************************************************************/
+static uint64_t clock_now(void)
+{
+#if defined(__ARM_ARCH)
+    return xTaskGetTickCount();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * MS_PER_S * NS_PER_MS) + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: elapsed_ns
+********************************************************************************
+* Summary:
+* Returns the time in nanoseconds since start, a value of clock_now().
+*******************************************************************************/
+static uint64_t elapsed_ns(uint64_t start)
+{
+#if defined(__ARM_ARCH)
+    TickType_t ticks = xTaskGetTickCount() - (TickType_t)start;
+
+    return (uint64_t)ticks * portTICK_PERIOD_MS * NS_PER_MS;
+#else
+    return clock_now() - start;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: store_session
+********************************************************************************
+* Summary:
+* Writes the kept session to the storage if it changed, as after a full
+* handshake or a renewed ticket.
+*******************************************************************************/
+static void store_session(void)
+{
+    static uint8_t serialized[UPLINK_SESSION_MAX_SIZE];
+    uint32_t length = session_save(serialized, sizeof(serialized));
+
+    if ((0U == length) ||
+        ((length == uplink_stored_length) && (0 == memcmp(serialized, uplink_stored, length))))
+    {
+        return;
+    }
+
+    if (uplink_config->storage->store(serialized, length))
+    {
+        memcpy(uplink_stored, serialized, length);
+        uplink_stored_length = length;
+        uplink_counters.sessions_stored++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: close_connection
+********************************************************************************
+* Summary:
+* Closes the connection, with a close_notify alert if it is still up.
+*******************************************************************************/
+static void close_connection(bool notify)
+{
+    if (uplink_open)
+    {
+        tls_close(notify);
+        uplink_open = false;
+    }
+
+    tcp_close();
+}
+
+/*******************************************************************************
+* Function Name: open_connection
+********************************************************************************
+* Summary:
+* Connects to the server and runs the handshake, resuming the kept session
+* if there is one. Counts and times the handshake.
+*******************************************************************************/
+static bool open_connection(void)
+{
+    bool resume = uplink_config->resume && uplink_has_session;
+    bool resumed = false;
+    uint64_t start = clock_now();
+
+    uplink_counters.connects++;
+
+    if (!tcp_connect())
+    {
+        tcp_close();
+        uplink_counters.failed_handshakes++;
+        return false;
+    }
+
+    if (!tls_connect(resume, &resumed))
+    {
+        tls_close(false);
+        tcp_close();
+        uplink_counters.failed_handshakes++;
+        return false;
+    }
+
+    uint64_t ns = elapsed_ns(start);
+
+    uplink_open = true;
+
+    if (resumed)
+    {
+        uplink_counters.resumed_handshakes++;
+        uplink_counters.resumed_handshake_ns += ns;
+    }
+    else
+    {
+        uplink_counters.full_handshakes++;
+        uplink_counters.full_handshake_ns += ns;
+    }
+
+    if (ns > uplink_counters.max_handshake_ns)
+    {
+        uplink_counters.max_handshake_ns = ns;
+    }
+
+    uplink_has_session = uplink_config->resume;
+
+    if (uplink_has_session && (NULL != uplink_config->storage))
+    {
+        store_session();
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uplink_init
+********************************************************************************
+* Summary:
+* Configures the uplink and, with session resumption and a session storage,
+* loads the stored session, so that the first connection is resumed. No
+* connection is made until the first publish.
+*
+* Parameters:
+*  const uplink_config_t *config: Server and connection policy, kept by
+*   reference
+*
+* Return:
+*  bool: false if the TLS configuration or the CA certificate is invalid
+*
+*******************************************************************************/
+bool uplink_init(const uplink_config_t *config)
+{
+    if (NULL != uplink_config)
+    {
+        close_connection(true);
+    }
+
+    uplink_config = config;
+    uplink_open = false;
+    uplink_has_session = false;
+    uplink_stored_length = 0U;
+    memset(&uplink_counters, 0, sizeof(uplink_counters));
+
+    if (!tls_setup())
+    {
+        return false;
+    }
+
+    session_clear();
+
+    if (config->resume && (NULL != config->storage))
+    {
+        uplink_stored_length = config->storage->load(uplink_stored, sizeof(uplink_stored));
+
+        if ((0U != uplink_stored_length) && session_load(uplink_stored, uplink_stored_length))
+        {
+            uplink_has_session = true;
+            uplink_counters.sessions_loaded++;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uplink_publish
+********************************************************************************
+* Summary:
+* Sends a batch to the server. A kept connection is used if the server has
+* not closed it; otherwise a new connection is made. If the batch cannot be
+* sent on a kept connection, it is sent once more on a new one. Without
+* connection reuse, the connection is closed after the batch.
+*
+* Parameters:
+*  const uint8_t *data: Batch to send
+*  uint32_t length: Length of the batch
+*  uint32_t now_s: Current time in seconds, for the idle timeout
+*
+* Return:
+*  bool: true if the whole batch was handed to TLS
+*
+*******************************************************************************/
+bool uplink_publish(const uint8_t *data, uint32_t length, uint32_t now_s)
+{
+    uint64_t start = clock_now();
+    bool sent = false;
+
+    if (uplink_open)
+    {
+        if (tcp_alive())
+        {
+            uplink_counters.reused++;
+        }
+        else
+        {
+            uplink_counters.lost++;
+            close_connection(false);
+        }
+    }
+
+    for (uint32_t attempt = 0; (!sent) && (attempt < PUBLISH_ATTEMPTS); attempt++)
+    {
+        if ((!uplink_open) && (!open_connection()))
+        {
+            break;
+        }
+
+        sent = tls_send(data, length);
+
+        if (!sent)
+        {
+            close_connection(false);
+        }
+    }
+
+    if (!uplink_config->reuse)
+    {
+        close_connection(true);
+    }
+
+    uplink_counters.publish_ns += elapsed_ns(start);
+    uplink_last_s = now_s;
+
+    if (sent)
+    {
+        uplink_counters.publishes++;
+        uplink_counters.bytes += length;
+    }
+    else
+    {
+        uplink_counters.failures++;
+    }
+
+    return sent;
+}
+
+/*******************************************************************************
+* Function Name: uplink_poll
+********************************************************************************
+* Summary:
+* Closes a kept connection that has been idle for UPLINK_IDLE_S.
+*
+* Parameters:
+*  uint32_t now_s: Current time in seconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_poll(uint32_t now_s)
+{
+    if (uplink_open && ((now_s - uplink_last_s) >= UPLINK_IDLE_S))
+    {
+        close_connection(true);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uplink_close
+********************************************************************************
+* Summary:
+* Closes the connection. The kept session stays, so the next connection is
+* resumed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_close(void)
+{
+    close_connection(true);
+}
+
+/*******************************************************************************
+* Function Name: uplink_forget_session
+********************************************************************************
+* Summary:
+* Forgets the kept session, so that the next connection makes a full
+* handshake. The stored session is replaced after that handshake.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_forget_session(void)
+{
+    session_clear();
+    uplink_has_session = false;
+}
+
+/*******************************************************************************
+* Function Name: uplink_connected
+********************************************************************************
+* Summary:
+* Returns whether a connection is open.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if a connection is open
+*
+*******************************************************************************/
+bool uplink_connected(void)
+{
+    return uplink_open;
+}
+
+/*******************************************************************************
+* Function Name: uplink_stats
+********************************************************************************
+* Summary:
+* Returns the publish and handshake counters.
+*
+* Parameters:
+*  uplink_stats_t *stats: Set to the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_stats(uplink_stats_t *stats)
+{
+    *stats = uplink_counters;
+}
+
+/* [] END OF FILE */
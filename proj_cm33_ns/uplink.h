@@ -0,0 +1,154 @@
+/*******************************************************************************
+* File Name        : uplink.h
+*
+* Description      : This file contains the declarations of the TLS uplink, which
+*                    publishes batches of scan log records to a server over a kept
+*                    connection with TLS session resumption.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_UPLINK_H_
+#define SOURCE_UPLINK_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest serialized TLS session, with its ticket and the server certificate,
+ * that can be kept in the session storage.
+ */
+#define UPLINK_SESSION_MAX_SIZE              (2048U)
+
+/* A kept connection is closed after this long without a publish. Until then,
+ * TCP keepalive probes every UPLINK_KEEPALIVE_S seconds of silence detect a
+ * connection lost on the way.
+ */
+#define UPLINK_IDLE_S                        (300U)
+#define UPLINK_KEEPALIVE_S                   (60U)
+#define UPLINK_KEEPALIVE_PROBES              (3U)
+
+/* Time a send or a handshake message may take before the connection is
+ * given up.
+ */
+#define UPLINK_IO_TIMEOUT_MS                 (10000U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Persistent storage of the TLS session, for example in a flash sector, so
+ * that the first connection after a reset is resumed. 'load' copies the
+ * stored session to the buffer and returns its length, 0 if there is none.
+ * The session holds its master secret, so the storage must not be readable
+ * from outside the device.
+ */
+typedef struct
+{
+    uint32_t (*load)(uint8_t *session, uint32_t size);
+    bool (*store)(const uint8_t *session, uint32_t length);
+} uplink_session_storage_t;
+
+/* Server and connection policy. 'ca_pem' is the NUL terminated PEM
+ * certificate of the authority that signed the server certificate, which
+ * must be issued to 'server_name'. With 'reuse', the connection is kept open
+ * between publishes; with 'resume', a new connection resumes the last TLS
+ * session, kept in RAM and, with 'storage', across resets.
+ */
+typedef struct
+{
+    const char *address;
+    uint16_t port;
+    const char *server_name;
+    const char *ca_pem;
+    bool reuse;
+    bool resume;
+    const uplink_session_storage_t *storage;
+} uplink_config_t;
+
+/* Publish and handshake counters. Times are wall-clock times on the device, in
+ * steps of the RTOS tick, from the start of the TCP connection to the end of
+ * the handshake for the handshakes, and include the handshake, if any, for the
+ * publishes.
+ */
+typedef struct
+{
+    uint32_t publishes;
+    uint32_t failures;
+    uint64_t bytes;
+    uint32_t reused;
+    uint32_t lost;
+    uint32_t connects;
+    uint32_t full_handshakes;
+    uint32_t resumed_handshakes;
+    uint32_t failed_handshakes;
+    uint64_t full_handshake_ns;
+    uint64_t resumed_handshake_ns;
+    uint64_t max_handshake_ns;
+    uint64_t publish_ns;
+    uint32_t sessions_loaded;
+    uint32_t sessions_stored;
+} uplink_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool uplink_init(const uplink_config_t *config);
+bool uplink_publish(const uint8_t *data, uint32_t length, uint32_t now_s);
+void uplink_poll(uint32_t now_s);
+void uplink_close(void);
+void uplink_forget_session(void);
+bool uplink_connected(void);
+void uplink_stats(uplink_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_UPLINK_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,328 @@
+/*******************************************************************************
+* File Name        : uplink_task.c
+*
+* Description      : This file contains the task that collects the scan log records
+*                    into batches and publishes them over the TLS uplink, connecting
+*                    to the AP when needed.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "cybsp.h"
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "uplink_task.h"
+#include "module_state.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uplink_config_t uplink_task_config =
+{
+    UPLINK_SERVER_ADDRESS, UPLINK_SERVER_PORT, UPLINK_SERVER_NAME, UPLINK_CA_CERT,
+    true, true, UPLINK_SESSION_STORAGE
+};
+
+static MODULE_STATE SemaphoreHandle_t uplink_mutex;
+static MODULE_STATE TaskHandle_t uplink_task_handle;
+
+/* Records waiting for the next batch, filled by the scan task, and the batch
+ * being published. A batch stays until it is published.
+ */
+static MODULE_STATE uint8_t uplink_waiting[UPLINK_BUFFER_SIZE];
+static MODULE_STATE uint32_t uplink_waiting_length;
+static MODULE_STATE uint32_t uplink_waiting_s;
+static MODULE_STATE uint8_t uplink_batch[UPLINK_BUFFER_SIZE];
+static MODULE_STATE uint32_t uplink_batch_length;
+static MODULE_STATE uint32_t uplink_retry_s;
+
+/* Requests of the console, handled by the task between publishes. */
+static MODULE_STATE bool uplink_close_requested;
+static MODULE_STATE bool uplink_forget_requested;
+
+static MODULE_STATE uplink_task_stats_t uplink_task_counters;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: wifi_connect
+********************************************************************************
+* Summary:
+* Connects to the AP of the uplink, unless already connected. Scans go on
+* while connected.
+*******************************************************************************/
+static bool wifi_connect(void)
+{
+    cy_wcm_connect_params_t params;
+    cy_wcm_ip_address_t ip_address;
+
+    if (0U != cy_wcm_is_connected_to_ap())
+    {
+        return true;
+    }
+
+    memset(&params, 0, sizeof(params));
+    memcpy(params.ap_credentials.SSID, UPLINK_WIFI_SSID, sizeof(UPLINK_WIFI_SSID));
+    memcpy(params.ap_credentials.password, UPLINK_WIFI_PASSWORD, sizeof(UPLINK_WIFI_PASSWORD));
+    params.ap_credentials.security = UPLINK_WIFI_SECURITY;
+
+    uplink_task_counters.wifi_connects++;
+
+    if (CY_RSLT_SUCCESS != cy_wcm_connect_ap(&params, &ip_address))
+    {
+        uplink_task_counters.wifi_failures++;
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uplink_task
+********************************************************************************
+* Summary:
+* Takes the waiting records as a batch when it is due and publishes it,
+* keeping the connection between batches until it is idle.
+*******************************************************************************/
+static void uplink_task(void *arg)
+{
+    uplink_stats_t link;
+
+    (void)arg;
+
+    for (;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(UPLINK_POLL_MS));
+
+        uint32_t now_s = (uint32_t)time(NULL);
+
+        xSemaphoreTake(uplink_mutex, portMAX_DELAY);
+
+        bool close = uplink_close_requested;
+        bool forget = uplink_forget_requested;
+
+        uplink_close_requested = false;
+        uplink_forget_requested = false;
+
+        if ((0U == uplink_batch_length) && (0U != uplink_waiting_length) &&
+            ((uplink_waiting_length >= UPLINK_PUBLISH_BYTES) ||
+             ((now_s - uplink_waiting_s) >= UPLINK_PUBLISH_S)))
+        {
+            memcpy(uplink_batch, uplink_waiting, uplink_waiting_length);
+            uplink_batch_length = uplink_waiting_length;
+            uplink_waiting_length = 0U;
+        }
+
+        xSemaphoreGive(uplink_mutex);
+
+        if (forget)
+        {
+            uplink_forget_session();
+        }
+
+        if (close)
+        {
+            uplink_close();
+        }
+
+        if ((0U != uplink_batch_length) && ((int32_t)(now_s - uplink_retry_s) >= 0))
+        {
+            if (wifi_connect() && uplink_publish(uplink_batch, uplink_batch_length, now_s))
+            {
+                uplink_batch_length = 0U;
+            }
+            else
+            {
+                uplink_retry_s = now_s + UPLINK_RETRY_S;
+            }
+        }
+
+        uplink_poll(now_s);
+        uplink_stats(&link);
+
+        xSemaphoreTake(uplink_mutex, portMAX_DELAY);
+        uplink_task_counters.link = link;
+        uplink_task_counters.connected = uplink_connected();
+        xSemaphoreGive(uplink_mutex);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uplink_task_init
+********************************************************************************
+* Summary:
+* Configures the uplink and starts its task, if a server is configured.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: false if the uplink is configured but could not be started
+*
+*******************************************************************************/
+bool uplink_task_init(void)
+{
+    memset(&uplink_task_counters, 0, sizeof(uplink_task_counters));
+    uplink_waiting_length = 0U;
+    uplink_batch_length = 0U;
+    uplink_retry_s = 0U;
+
+    if (0U == strlen(UPLINK_SERVER_ADDRESS))
+    {
+        return true;
+    }
+
+    uplink_mutex = xSemaphoreCreateMutex();
+
+    if ((NULL == uplink_mutex) || (!uplink_init(&uplink_task_config)))
+    {
+        return false;
+    }
+
+    uplink_task_counters.enabled = true;
+
+    return (pdPASS == xTaskCreate(uplink_task, "Uplink task", UPLINK_TASK_STACK_SIZE, NULL,
+                                  UPLINK_TASK_PRIORITY, &uplink_task_handle));
+}
+
+/*******************************************************************************
+* Function Name: uplink_task_sink
+********************************************************************************
+* Summary:
+* Scan log sink that adds a record to the next batch of the uplink. The
+* record is dropped if the batch has no room for it, or ignored if the uplink
+* is off.
+*
+* Parameters:
+*  const uint8_t *record: Record to publish
+*  uint32_t length: Length of the record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_task_sink(const uint8_t *record, uint32_t length)
+{
+    if (!uplink_task_counters.enabled)
+    {
+        return;
+    }
+
+    xSemaphoreTake(uplink_mutex, portMAX_DELAY);
+
+    if ((uplink_waiting_length + length) > UPLINK_BUFFER_SIZE)
+    {
+        uplink_task_counters.dropped_records++;
+    }
+    else
+    {
+        if (0U == uplink_waiting_length)
+        {
+            uplink_waiting_s = (uint32_t)time(NULL);
+        }
+
+        memcpy(&uplink_waiting[uplink_waiting_length], record, length);
+        uplink_waiting_length += length;
+    }
+
+    xSemaphoreGive(uplink_mutex);
+}
+
+/*******************************************************************************
+* Function Name: uplink_task_request
+********************************************************************************
+* Summary:
+* Asks the task to close the connection or to forget the TLS session, so
+* that the next connection makes a full handshake.
+*
+* Parameters:
+*  bool close: true to close the connection
+*  bool forget: true to forget the session
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_task_request(bool close, bool forget)
+{
+    if (!uplink_task_counters.enabled)
+    {
+        return;
+    }
+
+    xSemaphoreTake(uplink_mutex, portMAX_DELAY);
+    uplink_close_requested = uplink_close_requested || close;
+    uplink_forget_requested = uplink_forget_requested || forget;
+    xSemaphoreGive(uplink_mutex);
+}
+
+/*******************************************************************************
+* Function Name: uplink_task_stats
+********************************************************************************
+* Summary:
+* Returns the state of the batches and the uplink counters as of the last
+* pass of the task.
+*
+* Parameters:
+*  uplink_task_stats_t *stats: Set to the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_task_stats(uplink_task_stats_t *stats)
+{
+    if (!uplink_task_counters.enabled)
+    {
+        *stats = uplink_task_counters;
+        return;
+    }
+
+    xSemaphoreTake(uplink_mutex, portMAX_DELAY);
+    *stats = uplink_task_counters;
+    stats->waiting_bytes = uplink_waiting_length;
+    stats->unsent_bytes = uplink_batch_length;
+    xSemaphoreGive(uplink_mutex);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,129 @@
+/*******************************************************************************
+* File Name        : uplink_task.h
+*
+* Description      : This file contains the configuration and declarations of the
+*                    task that publishes the scan log records over the TLS uplink.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_UPLINK_TASK_H_
+#define SOURCE_UPLINK_TASK_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_wcm.h"
+#include "uplink.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Provide the IPv4 address and port of the server that receives the scan log
+ * records over TLS, the name its certificate is issued to, and the PEM
+ * certificate of the authority that signed it. Leave the address empty to
+ * keep the uplink off.
+ */
+#define UPLINK_SERVER_ADDRESS                ""
+#define UPLINK_SERVER_PORT                   (8443U)
+#define UPLINK_SERVER_NAME                   ""
+#define UPLINK_CA_CERT                       ""
+
+/* Provide the AP through which the server is reached. */
+#define UPLINK_WIFI_SSID                     ""
+#define UPLINK_WIFI_PASSWORD                 ""
+#define UPLINK_WIFI_SECURITY                 CY_WCM_SECURITY_WPA2_AES_PSK
+
+/* Provide a pointer to an uplink_session_storage_t to resume the TLS session
+ * after a reset, for example from a flash sector. Without one, the session
+ * is only kept in RAM.
+ */
+#define UPLINK_SESSION_STORAGE               (NULL)
+
+/* Records wait in a buffer of UPLINK_BUFFER_SIZE bytes and are published as
+ * one batch once UPLINK_PUBLISH_BYTES are waiting or the oldest has waited
+ * UPLINK_PUBLISH_S. A record that does not fit is dropped. A batch that
+ * cannot be published is tried again every UPLINK_RETRY_S.
+ */
+#define UPLINK_BUFFER_SIZE                   (8192U)
+#define UPLINK_PUBLISH_BYTES                 (4096U)
+#define UPLINK_PUBLISH_S                     (60U)
+#define UPLINK_RETRY_S                       (10U)
+#define UPLINK_POLL_MS                       (1000U)
+
+/* The TLS handshake needs a large stack. */
+#define UPLINK_TASK_STACK_SIZE               (8192U)
+#define UPLINK_TASK_PRIORITY                 (1U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    bool     enabled;
+    bool     connected;
+    uint32_t waiting_bytes;
+    uint32_t unsent_bytes;
+    uint32_t dropped_records;
+    uint32_t wifi_connects;
+    uint32_t wifi_failures;
+    uplink_stats_t link;
+} uplink_task_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool uplink_task_init(void);
+void uplink_task_sink(const uint8_t *record, uint32_t length);
+void uplink_task_request(bool close, bool forget);
+void uplink_task_stats(uplink_task_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_UPLINK_TASK_H_ */
+
+/* [] END OF FILE */
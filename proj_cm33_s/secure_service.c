@@ -0,0 +1,296 @@
+/*******************************************************************************
+* File Name        : secure_service.c
+*
+* Description      : This file contains the secure service, which keeps keys in
+*                    secure memory and processes arrays of keyed-hash requests
+*                    from the non-secure image, so that one transition through
+*                    the non-secure callable veneer serves many requests.
+*                    
+*                    Outside the device, it is compiled into the host tools as a
+*                    stand-in for the secure image.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "secure_service.h"
+#include "siphash.h"
+
+#include <string.h>
+
+#if defined(__ARM_FEATURE_CMSE) && (3 == __ARM_FEATURE_CMSE)
+#include <arm_cmse.h>
+#define SECURE_SERVICE_ENTRY                 __attribute__((cmse_nonsecure_entry))
+#define SECURE_SERVICE_CHECKED               (1)
+#else
+#define SECURE_SERVICE_ENTRY
+#define SECURE_SERVICE_CHECKED               (0)
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Domain byte of the key derivation. */
+#define KEY_DERIVATION_DOMAIN                (0xFFU)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    uint8_t  key[SECURE_SERVICE_KEY_SIZE];
+    uint32_t epoch;
+    bool     set;
+} secure_key_t;
+
+static secure_key_t secure_keys[SECURE_SERVICE_KEY_COUNT];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: is_readable
+********************************************************************************
+* Summary:
+* Returns whether the non-secure image may read a range, so that it cannot
+* make the secure image read secure memory for it.
+*******************************************************************************/
+static bool is_readable(const void *p, uint32_t size)
+{
+#if SECURE_SERVICE_CHECKED
+    return (0U == size) ||
+           (NULL != cmse_check_address_range((void *)p, size, CMSE_NONSECURE | CMSE_MPU_READ));
+#else
+    return (0U == size) || (NULL != p);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: is_writable
+********************************************************************************
+* Summary:
+* Returns whether the non-secure image may write a range.
+*******************************************************************************/
+static bool is_writable(void *p, uint32_t size)
+{
+#if SECURE_SERVICE_CHECKED
+    return NULL != cmse_check_address_range(p, size, CMSE_NONSECURE | CMSE_MPU_READWRITE);
+#else
+    (void)size;
+
+    return NULL != p;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: rotate_key
+********************************************************************************
+* Summary:
+* Replaces a key with one derived from it, which does not reveal it, mixed
+* with the random bytes if there are some.
+*******************************************************************************/
+static secure_service_status_t rotate_key(secure_key_t *key, const uint8_t *random,
+                                          uint32_t length)
+{
+    uint8_t input[6];
+    uint8_t next[SECURE_SERVICE_KEY_SIZE];
+
+    if ((0U != length) && (SECURE_SERVICE_KEY_SIZE != length))
+    {
+        return SECURE_SERVICE_STATUS_BAD_INPUT;
+    }
+
+    if ((!key->set) && (0U == length))
+    {
+        return SECURE_SERVICE_STATUS_NO_KEY;
+    }
+
+    input[0] = KEY_DERIVATION_DOMAIN;
+    input[1] = (uint8_t)key->epoch;
+    input[2] = (uint8_t)(key->epoch >> 8);
+    input[3] = (uint8_t)(key->epoch >> 16);
+    input[4] = (uint8_t)(key->epoch >> 24);
+
+    for (uint32_t half = 0; half < 2U; half++)
+    {
+        input[5] = (uint8_t)half;
+        uint64_t value = siphash_2_4(key->key, input, sizeof(input));
+
+        for (uint32_t i = 0; i < 8U; i++)
+        {
+            next[(8U * half) + i] = (uint8_t)(value >> (8U * i));
+        }
+    }
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        next[i] ^= random[i];
+    }
+
+    memcpy(key->key, next, sizeof(key->key));
+    memset(next, 0, sizeof(next));
+    key->set = true;
+    key->epoch++;
+
+    return SECURE_SERVICE_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: process_item
+********************************************************************************
+* Summary:
+* Processes one request. The input is copied to secure memory first, so that
+* the non-secure image cannot change it while it is used.
+*******************************************************************************/
+static secure_service_status_t process_item(const secure_service_item_t *item,
+                                            uint64_t *output)
+{
+    uint8_t input[SECURE_SERVICE_MAX_INPUT];
+    secure_service_status_t status = SECURE_SERVICE_STATUS_OK;
+
+    if (SECURE_SERVICE_OP_NOP == item->op)
+    {
+        return SECURE_SERVICE_STATUS_OK;
+    }
+
+    if (item->op >= SECURE_SERVICE_OP_COUNT)
+    {
+        return SECURE_SERVICE_STATUS_BAD_OP;
+    }
+
+    if (item->key >= SECURE_SERVICE_KEY_COUNT)
+    {
+        return SECURE_SERVICE_STATUS_BAD_KEY;
+    }
+
+    if (item->length > SECURE_SERVICE_MAX_INPUT)
+    {
+        return SECURE_SERVICE_STATUS_BAD_INPUT;
+    }
+
+    if (!is_readable(item->input, item->length))
+    {
+        return SECURE_SERVICE_STATUS_BAD_ADDRESS;
+    }
+
+    secure_key_t *key = &secure_keys[item->key];
+
+    memcpy(input, item->input, item->length);
+
+    switch (item->op)
+    {
+        case SECURE_SERVICE_OP_SIPHASH:
+            if (!key->set)
+            {
+                status = SECURE_SERVICE_STATUS_NO_KEY;
+                break;
+            }
+
+            *output = siphash_2_4(key->key, input, item->length);
+            break;
+
+        case SECURE_SERVICE_OP_SET_KEY:
+            if (SECURE_SERVICE_KEY_SIZE != item->length)
+            {
+                status = SECURE_SERVICE_STATUS_BAD_INPUT;
+                break;
+            }
+
+            memcpy(key->key, input, SECURE_SERVICE_KEY_SIZE);
+            key->set = true;
+            key->epoch++;
+            *output = key->epoch;
+            break;
+
+        default:
+            status = rotate_key(key, input, item->length);
+            *output = key->epoch;
+            break;
+    }
+
+    memset(input, 0, sizeof(input));
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: secure_service_call
+********************************************************************************
+* Summary:
+* Processes an array of requests in order and sets their status and output.
+* The whole array is handled in one transition from the non-secure image,
+* whose cost is paid once instead of once per request.
+*
+* Parameters:
+*  secure_service_item_t *items: Requests, in non-secure memory
+*  uint32_t count: Number of requests, at most SECURE_SERVICE_MAX_ITEMS
+*
+* Return:
+*  uint32_t: Number of requests that succeeded. None is processed if the
+*   array is invalid.
+*
+*******************************************************************************/
+SECURE_SERVICE_ENTRY uint32_t secure_service_call(secure_service_item_t *items, uint32_t count)
+{
+    uint32_t succeeded = 0U;
+
+    if ((count > SECURE_SERVICE_MAX_ITEMS) ||
+        ((0U != count) && (!is_writable(items, count * sizeof(*items)))))
+    {
+        return 0U;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        secure_service_item_t item = items[i];
+        uint64_t output = 0U;
+        secure_service_status_t status = process_item(&item, &output);
+
+        items[i].status = (uint8_t)status;
+        items[i].output = output;
+
+        if (SECURE_SERVICE_STATUS_OK == status)
+        {
+            succeeded++;
+        }
+    }
+
+    return succeeded;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,136 @@
+/*******************************************************************************
+* File Name        : secure_service.h
+*
+* Description      : This file contains the interface of the secure service,
+*                    which keeps keys in secure memory and processes arrays of
+*                    keyed-hash requests from the non-secure image in one call.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef SOURCE_SECURE_SERVICE_H_
+#define SOURCE_SECURE_SERVICE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SECURE_SERVICE_KEY_SIZE              (16U)
+
+/* Items per call and bytes per input. A call with more items is rejected. */
+#define SECURE_SERVICE_MAX_ITEMS             (32U)
+#define SECURE_SERVICE_MAX_INPUT             (64U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+typedef enum
+{
+    /* Does nothing, for measuring the cost of a call. */
+    SECURE_SERVICE_OP_NOP,
+    /* Sets the output to the SipHash-2-4 of the input with the key. */
+    SECURE_SERVICE_OP_SIPHASH,
+    /* Sets the key to the input (SECURE_SERVICE_KEY_SIZE bytes). */
+    SECURE_SERVICE_OP_SET_KEY,
+    /* Derives a new key from the key and the input, which may be empty or
+     * SECURE_SERVICE_KEY_SIZE random bytes. A key that was never set needs the
+     * random bytes.
+     */
+    SECURE_SERVICE_OP_ROTATE_KEY,
+    SECURE_SERVICE_OP_COUNT
+} secure_service_op_t;
+
+typedef enum
+{
+    SECURE_SERVICE_KEY_PSEUDONYM,
+    /* For tests and measurements. */
+    SECURE_SERVICE_KEY_SCRATCH,
+    SECURE_SERVICE_KEY_COUNT
+} secure_service_key_t;
+
+typedef enum
+{
+    SECURE_SERVICE_STATUS_OK,
+    SECURE_SERVICE_STATUS_BAD_OP,
+    SECURE_SERVICE_STATUS_BAD_KEY,
+    SECURE_SERVICE_STATUS_NO_KEY,
+    SECURE_SERVICE_STATUS_BAD_INPUT,
+    SECURE_SERVICE_STATUS_BAD_ADDRESS
+} secure_service_status_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* One request. The output of the key operations is the number of times the
+ * key was set or rotated (its epoch).
+ */
+typedef struct
+{
+    uint8_t        op;
+    uint8_t        key;
+    uint8_t        length;
+    uint8_t        status;
+    const uint8_t *input;
+    uint64_t       output;
+} secure_service_item_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Entry point of the secure image, called from the non-secure image through
+ * its veneer. Calls must not overlap.
+ */
+uint32_t secure_service_call(secure_service_item_t *items, uint32_t count);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOURCE_SECURE_SERVICE_H_ */
+
+/* [] END OF FILE */
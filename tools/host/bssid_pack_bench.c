@@ -0,0 +1,325 @@
+/*******************************************************************************
+* File Name        : bssid_pack_bench.c
+*
+* Description      : Host benchmark of the packed BSSIDs of the scan log
+*                    records. Packs the BSSIDs of every snapshot of a binary scan
+*                    log written by the firmware, or of a synthetic dense site
+*                    without one, checks that they unpack to the same BSSIDs, from
+*                    every truncated record too, and reports the bytes per BSSID
+*                    by form.
+*                    
+*                    Build: cc -O2 -I../../proj_cm33_ns bssid_pack_bench.c
+*                           ../../proj_cm33_ns/hash_service.c -o bssid_pack_bench
+*                    Usage: bssid_pack_bench [scan_log.bin]
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "scan_log_format.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_MAX_LOG_SIZE                   (64U * 1024U * 1024U)
+#define BENCH_MAX_APS                        (512U)
+#define BENCH_FORMS                          (5U)
+
+/* Synthetic site: APs of a few vendors, each with a BSSID per radio and
+ * SSID, some with locally administered virtual BSSIDs, and hotspots with
+ * random addresses.
+ */
+#define BENCH_SYNTHETIC_SCANS                (200U)
+#define BENCH_SYNTHETIC_VENDORS              (6U)
+#define BENCH_SYNTHETIC_APS                  (48U)
+#define BENCH_SYNTHETIC_BSSIDS_PER_AP        (6U)
+#define BENCH_SYNTHETIC_HOTSPOTS             (12U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char *const form_names[BENCH_FORMS] =
+{
+    "OUI index + NIC", "Sibling", "Local sibling", "New OUI", "Literal"
+};
+
+static uint8_t bssids[BENCH_MAX_APS][SCAN_LOG_BSSID_LENGTH];
+static uint8_t packed[BENCH_MAX_APS * SCAN_LOG_PACKED_BSSID_MAX_SIZE];
+static uint64_t form_count[BENCH_FORMS];
+static uint64_t form_bytes[BENCH_FORMS];
+static uint64_t total_bssids;
+static uint64_t total_records;
+static uint64_t total_bytes;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static uint32_t rng_next(uint32_t *rng)
+{
+    *rng ^= *rng << 13;
+    *rng ^= *rng >> 17;
+    *rng ^= *rng << 5;
+
+    return *rng;
+}
+
+static uint32_t form_of(uint8_t tag)
+{
+    if (SCAN_LOG_PACKED_TAG_LITERAL == tag)
+    {
+        return 4U;
+    }
+
+    if (SCAN_LOG_PACKED_TAG_NEW_OUI == tag)
+    {
+        return 3U;
+    }
+
+    return tag >> 6;
+}
+
+/* Packs the BSSIDs of one record, unpacks them from the full and from every
+ * truncated stream, and accounts for the forms.
+ */
+static void bench_record(uint32_t count)
+{
+    scan_log_oui_dict_t dict = { 0 };
+    uint32_t length = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t size = scan_log_pack_bssid(&dict, bssids[i], &packed[length]);
+        uint32_t form = form_of(packed[length]);
+
+        form_count[form]++;
+        form_bytes[form] += size;
+        length += size;
+    }
+
+    for (uint32_t cut = 0; cut <= length; cut++)
+    {
+        uint32_t offset = 0;
+        uint32_t i = 0;
+        uint8_t bssid[SCAN_LOG_BSSID_LENGTH];
+
+        dict.count = 0U;
+
+        while (i < count)
+        {
+            uint32_t size = scan_log_unpack_bssid(&dict, &packed[offset], cut - offset, bssid);
+
+            if (0U == size)
+            {
+                break;
+            }
+
+            if (0 != memcmp(bssid, bssids[i], SCAN_LOG_BSSID_LENGTH))
+            {
+                printf("Mismatch at BSSID %u of record %llu\n", (unsigned int)i,
+                       (unsigned long long)total_records);
+                exit(EXIT_FAILURE);
+            }
+
+            offset += size;
+            i++;
+        }
+
+        if ((cut == length) && (i != count))
+        {
+            printf("Record %llu does not unpack\n", (unsigned long long)total_records);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    total_bssids += count;
+    total_bytes += length;
+    total_records++;
+}
+
+static void bench_log(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t *log = malloc(BENCH_MAX_LOG_SIZE);
+    size_t size;
+
+    if ((NULL == file) || (NULL == log))
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+
+    size = fread(log, 1, BENCH_MAX_LOG_SIZE, file);
+    fclose(file);
+
+    for (size_t pos = 0; pos < size;)
+    {
+        scan_log_header_t hdr;
+        scan_log_ap_t ap;
+        uint32_t offset;
+        uint32_t count = 0;
+
+        if (!scan_log_parse_header(log + pos, (uint32_t)(size - pos), &hdr) ||
+            !scan_log_check_crc(log + pos, &hdr))
+        {
+            pos++;
+            continue;
+        }
+
+        offset = hdr.body;
+
+        while ((count < hdr.ap_count) && (count < BENCH_MAX_APS) &&
+               scan_log_parse_ap(log + pos, &hdr, &offset, &ap))
+        {
+            memcpy(bssids[count++], ap.bssid, SCAN_LOG_BSSID_LENGTH);
+        }
+
+        bench_record(count);
+        pos += hdr.length;
+    }
+
+    free(log);
+}
+
+static void bench_synthetic(void)
+{
+    static uint8_t site[(BENCH_SYNTHETIC_APS * BENCH_SYNTHETIC_BSSIDS_PER_AP) +
+                        BENCH_SYNTHETIC_HOTSPOTS][SCAN_LOG_BSSID_LENGTH];
+    uint8_t ouis[BENCH_SYNTHETIC_VENDORS][3];
+    uint32_t rng = 0x9E3779B9U;
+    uint32_t sites = 0;
+
+    for (uint32_t v = 0; v < BENCH_SYNTHETIC_VENDORS; v++)
+    {
+        ouis[v][0] = (uint8_t)(rng_next(&rng) & 0xFCU);
+        ouis[v][1] = (uint8_t)rng_next(&rng);
+        ouis[v][2] = (uint8_t)rng_next(&rng);
+    }
+
+    for (uint32_t a = 0; a < BENCH_SYNTHETIC_APS; a++)
+    {
+        uint32_t vendor = rng_next(&rng) % BENCH_SYNTHETIC_VENDORS;
+        bool local = (0U == (vendor & 1U));
+        uint8_t nic[3] = { (uint8_t)rng_next(&rng), (uint8_t)rng_next(&rng),
+                           (uint8_t)(rng_next(&rng) & 0xF0U) };
+
+        /* One BSSID per radio and SSID. Vendors with virtual BSSIDs set the
+         * locally administered bit and a radio index in the first byte.
+         */
+        for (uint32_t b = 0; b < BENCH_SYNTHETIC_BSSIDS_PER_AP; b++)
+        {
+            memcpy(site[sites], ouis[vendor], 3);
+            memcpy(&site[sites][3], nic, 3);
+            site[sites][5] = (uint8_t)(nic[2] + b);
+
+            if (local && (0U != b))
+            {
+                site[sites][0] = (uint8_t)(ouis[vendor][0] | 0x02U | (b << 4));
+                site[sites][5] = nic[2];
+            }
+
+            sites++;
+        }
+    }
+
+    for (uint32_t h = 0; h < BENCH_SYNTHETIC_HOTSPOTS; h++)
+    {
+        for (uint32_t i = 0; i < SCAN_LOG_BSSID_LENGTH; i++)
+        {
+            site[sites][i] = (uint8_t)rng_next(&rng);
+        }
+
+        site[sites++][0] |= 0x02U;
+    }
+
+    /* Each scan sees most of the site, in scan order. */
+    for (uint32_t s = 0; s < BENCH_SYNTHETIC_SCANS; s++)
+    {
+        uint32_t count = 0;
+
+        for (uint32_t i = 0; i < sites; i++)
+        {
+            if ((rng_next(&rng) % 10U) < 7U)
+            {
+                memcpy(bssids[count++], site[i], SCAN_LOG_BSSID_LENGTH);
+            }
+        }
+
+        bench_record(count);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        bench_log(argv[1]);
+    }
+    else
+    {
+        bench_synthetic();
+    }
+
+    if (0U == total_bssids)
+    {
+        printf("No BSSIDs\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Records             : %llu\n", (unsigned long long)total_records);
+    printf("BSSIDs              : %llu\n", (unsigned long long)total_bssids);
+    printf("Plain bytes         : %llu\n",
+           (unsigned long long)(total_bssids * SCAN_LOG_BSSID_LENGTH));
+    printf("Packed bytes        : %llu (%.2f bytes/BSSID, %.2fx)\n",
+           (unsigned long long)total_bytes, (double)total_bytes / total_bssids,
+           (double)(total_bssids * SCAN_LOG_BSSID_LENGTH) / total_bytes);
+
+    for (uint32_t f = 0; f < BENCH_FORMS; f++)
+    {
+        printf("  %-18s: %5.1f%% of BSSIDs, %llu bytes\n", form_names[f],
+               (100.0 * form_count[f]) / total_bssids, (unsigned long long)form_bytes[f]);
+    }
+
+    printf("Truncated unpacking : OK\n");
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,263 @@
+/*******************************************************************************
+* File Name        : hash_bench.c
+*
+* Description      : Host benchmark of the hash service. Checks the slicing-by-8
+*                    CRC-32 against a bitwise one for every length and alignment,
+*                    the 64-bit hash against XXH64 test vectors and SipHash-2-4
+*                    against its reference vectors, then measures the latency of
+*                    the CRC and hash functions for 6 to 64 byte inputs and their
+*                    throughput on long ones.
+*                    
+*                    Build: cc -O2 -I../../proj_cm33_ns -I../../common hash_bench.c
+*                           ../../proj_cm33_ns/hash_service.c ../../common/siphash.c
+*                           -o hash_bench
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_service.h"
+#include "siphash.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_MAX_CHECK_LENGTH               (300U)
+#define BENCH_LONG_SIZE                      (4096U)
+#define BENCH_CALLS                          (1000000U)
+#define BENCH_LONG_CALLS                     (20000U)
+#define BENCH_FUNCTIONS                      (4U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint32_t (*function)(const uint8_t *, uint32_t);
+} bench_function_t;
+
+typedef struct
+{
+    const char *input;
+    uint64_t seed;
+    uint64_t hash;
+} hash_vector_t;
+
+typedef struct
+{
+    uint32_t length;
+    uint64_t hash;
+} siphash_vector_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t buffer[BENCH_LONG_SIZE + 8];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/* The bitwise CRC-32 that scan_log_crc32() used before the hash service. */
+static uint32_t crc32_bitwise(const uint8_t *data, uint32_t length)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+
+        for (uint32_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (uint32_t)(-(int32_t)(crc & 1U)));
+        }
+    }
+
+    return ~crc;
+}
+
+static const bench_function_t functions[BENCH_FUNCTIONS] =
+{
+    { "CRC-32 bitwise", crc32_bitwise },
+    { "CRC-32 slice-8", hash_service_crc32 },
+    { "Hash (64-bit)", hash_service_hash32 },
+    { "FNV-1a", hash_service_fnv1a32 },
+};
+
+static const hash_vector_t vectors[] =
+{
+    { "", 0, 0xEF46DB3751D8E999ULL },
+    { "abc", 0, 0x44BC2CF5AD770999ULL },
+    { "\x00\x01\x02\x03\x04\x05", 0, 0x438E2507BF950423ULL },
+    { "0123456789abcdefghijklmnopq", 7, 0x6D6B912388ABB45EULL },
+};
+
+/* SipHash-2-4 of the bytes 0, 1, ... length - 1 with the key 0, 1, ... 15. */
+static const siphash_vector_t siphash_vectors[] =
+{
+    { 0, 0x726FDB47DD0E0E31ULL },
+    { 1, 0x74F839C593DC67FDULL },
+    { 7, 0xAB0200F58B01D137ULL },
+    { 8, 0x93F5F5799A932462ULL },
+    { 15, 0xA129CA6149BE45E5ULL },
+    { 16, 0x3F2ACC7F57C29BDBULL },
+    { 63, 0x958A324CEB064572ULL },
+};
+
+static double time_calls(uint32_t (*function)(const uint8_t *, uint32_t), uint32_t size,
+                         uint32_t calls)
+{
+    volatile uint32_t sink = 0;
+    uint64_t ns;
+    uint32_t start = perf_counter_now();
+
+    for (uint32_t i = 0; i < calls; i++)
+    {
+        /* Moves the input so that the calls do not fold into one. */
+        sink ^= function(&buffer[i & 7U], size);
+    }
+
+    ns = perf_counter_to_ns(perf_counter_now() - start);
+    (void)sink;
+
+    return (double)ns / calls;
+}
+
+int main(void)
+{
+    static const uint32_t sizes[] = { 6, 8, 12, 16, 24, 32, 48, 64 };
+    uint32_t rng = 0x9E3779B9U;
+
+    for (uint32_t i = 0; i < sizeof(buffer); i++)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        buffer[i] = (uint8_t)rng;
+    }
+
+    if (0xCBF43926UL != hash_service_crc32((const uint8_t *)"123456789", 9))
+    {
+        printf("FAIL: CRC-32 check value\n");
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t offset = 0; offset < 8U; offset++)
+    {
+        for (uint32_t length = 0; length <= BENCH_MAX_CHECK_LENGTH; length++)
+        {
+            if (crc32_bitwise(&buffer[offset], length) !=
+                hash_service_crc32(&buffer[offset], length))
+            {
+                printf("FAIL: CRC-32 of %u bytes at offset %u\n", (unsigned int)length,
+                       (unsigned int)offset);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < (sizeof(vectors) / sizeof(vectors[0])); i++)
+    {
+        uint32_t length = (2 == i) ? 6U : (uint32_t)strlen(vectors[i].input);
+
+        if (vectors[i].hash !=
+            hash_service_hash64((const uint8_t *)vectors[i].input, length, vectors[i].seed))
+        {
+            printf("FAIL: hash of vector %u\n", (unsigned int)i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (uint32_t i = 0; i < (sizeof(siphash_vectors) / sizeof(siphash_vectors[0])); i++)
+    {
+        uint8_t key[SIPHASH_KEY_SIZE];
+        uint8_t message[64];
+
+        for (uint32_t j = 0; j < sizeof(message); j++)
+        {
+            message[j] = (uint8_t)j;
+            key[j % sizeof(key)] = (uint8_t)(j % sizeof(key));
+        }
+
+        if (siphash_vectors[i].hash !=
+            siphash_2_4(key, message, siphash_vectors[i].length))
+        {
+            printf("FAIL: SipHash of %u bytes\n", (unsigned int)siphash_vectors[i].length);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("CRC-32 and hash checks : OK\n");
+    printf("\nLatency (ns per call)\n%6s", "Bytes");
+
+    for (uint32_t f = 0; f < BENCH_FUNCTIONS; f++)
+    {
+        printf(" %15s", functions[f].name);
+    }
+
+    printf("\n");
+
+    for (uint32_t s = 0; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+        printf("%6u", (unsigned int)sizes[s]);
+
+        for (uint32_t f = 0; f < BENCH_FUNCTIONS; f++)
+        {
+            printf(" %15.1f", time_calls(functions[f].function, sizes[s], BENCH_CALLS));
+        }
+
+        printf("\n");
+    }
+
+    printf("\nThroughput on %u bytes (MB/s)\n", (unsigned int)BENCH_LONG_SIZE);
+
+    for (uint32_t f = 0; f < BENCH_FUNCTIONS; f++)
+    {
+        double ns = time_calls(functions[f].function, BENCH_LONG_SIZE, BENCH_LONG_CALLS);
+
+        printf("  %-15s: %.0f\n", functions[f].name, (1e3 * BENCH_LONG_SIZE) / ns);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
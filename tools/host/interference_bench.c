@@ -0,0 +1,511 @@
+/*******************************************************************************
+* File Name        : interference_bench.c
+*
+* Description      : Host benchmark of the interference matrix. Feeds synthetic
+*                    sweeps of 500 BSSs of every band and width, with their HT, VHT
+*                    and HE Operation elements, through the firmware sources, checks
+*                    the decoded widths, the matrix and the recommendations against a
+*                    double precision reference and reports the update cost.
+*                    
+*                    Build: cc -O2 -I../../proj_cm33_ns interference_bench.c
+*                           ../../proj_cm33_ns/interference_matrix.c
+*                           ../../proj_cm33_ns/bss_width.c
+*                           ../../proj_cm33_ns/channel_plan.c -lm -o interference_bench
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "bss_width.h"
+#include "channel_plan.h"
+#include "interference_matrix.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_BSS                            (500U)
+#define BENCH_SWEEPS                         (2000U)
+#define BENCH_IE_SIZE                        (48U)
+#define BENCH_TOLERANCE                      (1e-4)
+#define NS_PER_SECOND                        (1000000000ULL)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint8_t  band;
+    uint8_t  channel;
+    int16_t  rssi;
+    uint16_t width_mhz;
+    uint8_t  count;
+    uint8_t  subchannels[BSS_WIDTH_MAX_SUBCHANNELS];
+    uint8_t  ies[BENCH_IE_SIZE];
+    uint32_t ie_length;
+} bench_bss_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static bench_bss_t bench_bss[BENCH_BSS];
+
+/* Reference matrix, indexed by band and channel. */
+static double ref_load[4][256];
+static double ref_score[4][256];
+
+/* First channels of the bonding runs of the 5 GHz band and their lengths. */
+static const uint8_t runs_5ghz[][2] = { { 36U, 8U }, { 100U, 12U }, { 149U, 8U } };
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * NS_PER_SECOND) + (uint64_t)ts.tv_nsec;
+}
+
+static void add_ie(bench_bss_t *bss, uint8_t id, const uint8_t *body, uint8_t length)
+{
+    bss->ies[bss->ie_length++] = id;
+    bss->ies[bss->ie_length++] = length;
+    memcpy(&bss->ies[bss->ie_length], body, length);
+    bss->ie_length += length;
+}
+
+/* Picks an aligned block of 'span' 20 MHz channels, 4 apart, from a run and
+ * a primary channel in it.
+ */
+static uint8_t pick_block(uint32_t *rng, uint8_t first, uint8_t count, uint32_t span,
+                          bench_bss_t *bss)
+{
+    uint32_t blocks = count / span;
+    uint8_t start = (uint8_t)(first + ((xorshift32(rng) % blocks) * span * 4U));
+
+    for (uint32_t i = 0; i < span; i++)
+    {
+        bss->subchannels[bss->count++] = (uint8_t)(start + (i * 4U));
+    }
+
+    return (uint8_t)(start + ((span - 1U) * 2U));
+}
+
+static void make_2_4ghz(uint32_t *rng, bench_bss_t *bss)
+{
+    uint8_t ht[22] = { 0 };
+
+    bss->band = BSS_WIDTH_BAND_2_4GHZ;
+    bss->channel = (uint8_t)(1U + (xorshift32(rng) % 13U));
+    bss->subchannels[bss->count++] = bss->channel;
+    bss->width_mhz = 20U;
+    ht[0] = bss->channel;
+
+    if (0U == (xorshift32(rng) % 4U))
+    {
+        bool above = (bss->channel <= 9U) && ((bss->channel < 5U) || (0U != (xorshift32(rng) & 1U)));
+
+        ht[1] = (uint8_t)(0x04U | (above ? 0x01U : 0x03U));
+        bss->subchannels[0] = above ? bss->channel : (uint8_t)(bss->channel - 4U);
+        bss->subchannels[bss->count++] = (uint8_t)(bss->subchannels[0] + 4U);
+        bss->width_mhz = 40U;
+    }
+
+    add_ie(bss, BSS_WIDTH_HT_OPERATION_ID, ht, sizeof(ht));
+}
+
+static void make_5ghz(uint32_t *rng, bench_bss_t *bss)
+{
+    static const uint16_t widths[] = { 20U, 40U, 80U, 160U, 160U };
+    uint8_t ht[22] = { 0 };
+    uint8_t vht[5] = { 0 };
+    uint32_t run = xorshift32(rng) % 3U;
+    uint16_t width = widths[xorshift32(rng) % 5U];
+    bool split = (160U == width) && (0U != (xorshift32(rng) & 1U));
+
+    bss->band = BSS_WIDTH_BAND_5GHZ;
+    bss->width_mhz = width;
+
+    if (split)
+    {
+        /* 80+80 MHz: 36-48 with 149-161. */
+        vht[1] = pick_block(rng, 36U, 4U, 4U, bss);
+        vht[2] = pick_block(rng, 149U, 4U, 4U, bss);
+    }
+    else
+    {
+        uint8_t center = pick_block(rng, runs_5ghz[run][0], runs_5ghz[run][1], width / 20U, bss);
+
+        if (width >= 80U)
+        {
+            vht[1] = (160U == width) ? (uint8_t)(center - 8U) : center;
+            vht[2] = (160U == width) ? center : 0U;
+        }
+    }
+
+    /* The primary of an 80+80 MHz BSS is in its first segment. */
+    bss->channel = bss->subchannels[xorshift32(rng) % (split ? 4U : bss->count)];
+
+    ht[0] = bss->channel;
+
+    if (width >= 40U)
+    {
+        /* The 40 MHz pair of the primary is the aligned one. */
+        bool above = (0U == (((bss->channel - ((bss->channel >= 149U) ? 149U : 36U)) / 4U) & 1U));
+
+        ht[1] = (uint8_t)(0x04U | (above ? 0x01U : 0x03U));
+    }
+
+    add_ie(bss, BSS_WIDTH_HT_OPERATION_ID, ht, sizeof(ht));
+
+    if (width >= 80U)
+    {
+        vht[0] = 1U;
+        add_ie(bss, BSS_WIDTH_VHT_OPERATION_ID, vht, sizeof(vht));
+    }
+}
+
+static void make_6ghz(uint32_t *rng, bench_bss_t *bss)
+{
+    static const uint16_t widths[] = { 20U, 40U, 80U, 160U };
+    uint8_t he[12] = { BSS_WIDTH_HE_OPERATION_EXT_ID, 0U, 0U, 0x02U, 0U, 0U, 0U };
+    uint32_t choice = xorshift32(rng) % 4U;
+    uint16_t width = widths[choice];
+    uint8_t center = pick_block(rng, 1U, 56U, width / 20U, bss);
+
+    bss->band = BSS_WIDTH_BAND_6GHZ;
+    bss->width_mhz = width;
+    bss->channel = bss->subchannels[xorshift32(rng) % bss->count];
+
+    he[7] = bss->channel;
+    he[8] = (uint8_t)choice;
+    he[9] = (160U == width) ? (uint8_t)(center - 8U) : center;
+    he[10] = (160U == width) ? center : 0U;
+    add_ie(bss, BSS_WIDTH_EXTENSION_ID, he, sizeof(he));
+}
+
+static double reference_power(int16_t rssi)
+{
+    return pow(10.0, (double)(rssi - INTERFERENCE_FLOOR_DBM) / 10.0);
+}
+
+static void build_reference(void)
+{
+    memset(ref_load, 0, sizeof(ref_load));
+    memset(ref_score, 0, sizeof(ref_score));
+
+    for (uint32_t b = 0; b < BENCH_BSS; b++)
+    {
+        const bench_bss_t *bss = &bench_bss[b];
+        double power = reference_power(bss->rssi);
+
+        for (uint32_t i = 0; i < bss->count; i++)
+        {
+            uint8_t sub = bss->subchannels[i];
+
+            ref_load[bss->band][sub] += power;
+
+            if (BSS_WIDTH_BAND_2_4GHZ != bss->band)
+            {
+                ref_score[bss->band][sub] += power;
+                continue;
+            }
+
+            for (uint8_t other = 1U; other <= 14U; other++)
+            {
+                double mhz = fabs((double)bss_width_frequency(bss->band, other) -
+                                  (double)bss_width_frequency(bss->band, sub));
+
+                if (mhz < 20.0)
+                {
+                    ref_score[bss->band][other] += power * (20.0 - mhz) / 20.0;
+                }
+            }
+        }
+    }
+}
+
+static bool close_enough(double value, double reference)
+{
+    return fabs(value - reference) <= (BENCH_TOLERANCE * (fabs(reference) + 1.0));
+}
+
+/* Lowest scoring block of a band and width by brute force, lowest channel
+ * first on ties, or 0 if there is none.
+ */
+static uint8_t reference_best(uint8_t band, uint16_t width_mhz, double *best_score)
+{
+    uint32_t span = width_mhz / 20U;
+    uint8_t best = 0U;
+
+    *best_score = 0.0;
+
+    for (uint32_t r = 0; r < 5U; r++)
+    {
+        uint8_t first;
+        uint8_t count;
+
+        if (BSS_WIDTH_BAND_2_4GHZ == band)
+        {
+            if ((r > 0U) || (20U != width_mhz))
+            {
+                break;
+            }
+            first = 1U;
+            count = 13U;
+        }
+        else if (BSS_WIDTH_BAND_6GHZ == band)
+        {
+            if (r > 0U)
+            {
+                break;
+            }
+            first = 1U;
+            count = 59U;
+        }
+        else
+        {
+            if (r >= 3U)
+            {
+                break;
+            }
+            first = runs_5ghz[r][0];
+            count = runs_5ghz[r][1];
+        }
+
+        uint32_t step = (BSS_WIDTH_BAND_2_4GHZ == band) ? 1U : 4U;
+
+        for (uint32_t start = 0; (start + span) <= count; start += span)
+        {
+            double score = 0.0;
+
+            for (uint32_t i = 0; i < span; i++)
+            {
+                score += ref_score[band][first + ((start + i) * step)];
+            }
+
+            uint8_t center = (uint8_t)(first + (start * step) + (((span - 1U) * step) / 2U));
+
+            if ((0U == best) || (score < *best_score))
+            {
+                best = center;
+                *best_score = score;
+            }
+        }
+    }
+
+    return best;
+}
+
+int main(void)
+{
+    static const uint16_t widths[] = { 20U, 40U, 80U, 160U };
+    uint32_t rng = 0x2468ACE1U;
+    uint32_t errors = 0U;
+    uint32_t wide = 0U;
+
+    channel_plan_init();
+    interference_matrix_init();
+
+    for (uint32_t b = 0; b < BENCH_BSS; b++)
+    {
+        bench_bss_t *bss = &bench_bss[b];
+        uint32_t band = xorshift32(&rng) % 10U;
+
+        memset(bss, 0, sizeof(*bss));
+        bss->rssi = (int16_t)(-95 + (int16_t)(xorshift32(&rng) % 70U));
+
+        if (band < 4U)
+        {
+            make_2_4ghz(&rng, bss);
+        }
+        else if (band < 8U)
+        {
+            make_5ghz(&rng, bss);
+        }
+        else
+        {
+            make_6ghz(&rng, bss);
+        }
+
+        wide += (bss->width_mhz > 20U) ? 1U : 0U;
+    }
+
+    /* Decoded widths. */
+    for (uint32_t b = 0; b < BENCH_BSS; b++)
+    {
+        const bench_bss_t *bss = &bench_bss[b];
+        bss_width_t decoded;
+
+        bss_width_decode(bss->band, bss->channel, bss->ies, bss->ie_length, &decoded);
+
+        if ((decoded.width_mhz != bss->width_mhz) || (decoded.count != bss->count) ||
+            (0 != memcmp(decoded.subchannels, bss->subchannels, bss->count)))
+        {
+            if (errors++ < 10U)
+            {
+                printf("BSS %u band %u channel %u: decoded %u MHz over %u channels, expected %u MHz over %u\n",
+                       b, bss->band, bss->channel, decoded.width_mhz, decoded.count,
+                       bss->width_mhz, bss->count);
+            }
+        }
+    }
+
+    /* Sweeps, timed. */
+    uint64_t observe_ns = 0;
+    uint64_t commit_ns = 0;
+
+    for (uint32_t sweep = 0; sweep < BENCH_SWEEPS; sweep++)
+    {
+        uint64_t start = now_ns();
+
+        interference_matrix_begin(true);
+
+        for (uint32_t b = 0; b < BENCH_BSS; b++)
+        {
+            const bench_bss_t *bss = &bench_bss[b];
+            bss_width_t width;
+
+            bss_width_decode(bss->band, bss->channel, bss->ies, bss->ie_length, &width);
+            interference_matrix_observe(true, bss->band, bss->rssi, &width);
+        }
+
+        uint64_t mid = now_ns();
+
+        interference_matrix_commit(sweep + 1U);
+        commit_ns += now_ns() - mid;
+        observe_ns += mid - start;
+    }
+
+    build_reference();
+
+    for (uint8_t band = BSS_WIDTH_BAND_2_4GHZ; band <= BSS_WIDTH_BAND_6GHZ; band++)
+    {
+        for (uint32_t channel = 1U; channel <= 233U; channel++)
+        {
+            interference_channel_t state;
+
+            if (!interference_matrix_channel(band, (uint8_t)channel, &state))
+            {
+                continue;
+            }
+
+            if ((!close_enough(state.load, ref_load[band][channel])) ||
+                (!close_enough(state.score, ref_score[band][channel])))
+            {
+                if (errors++ < 10U)
+                {
+                    printf("Band %u channel %u: load %.1f score %.1f, expected %.1f %.1f\n",
+                           band, channel, state.load, state.score,
+                           ref_load[band][channel], ref_score[band][channel]);
+                }
+            }
+        }
+    }
+
+    /* Recommendations, timed. */
+    uint64_t recommend_ns = 0;
+    uint32_t recommendations = 0U;
+
+    for (uint8_t band = BSS_WIDTH_BAND_2_4GHZ; band <= BSS_WIDTH_BAND_6GHZ; band++)
+    {
+        for (uint32_t w = 0; w < (sizeof(widths) / sizeof(widths[0])); w++)
+        {
+            interference_candidate_t candidates[4];
+            double best_score;
+            uint8_t best = reference_best(band, widths[w], &best_score);
+            uint64_t start = now_ns();
+            uint32_t found = interference_matrix_recommend(band, widths[w], candidates, 4U);
+
+            recommend_ns += now_ns() - start;
+            recommendations++;
+
+            bool sorted = true;
+
+            for (uint32_t i = 1; i < found; i++)
+            {
+                sorted &= (candidates[i - 1U].score <= candidates[i].score);
+            }
+
+            if ((!sorted) || ((0U == best) != (0U == found)) ||
+                ((0U != found) && (!close_enough(candidates[0].score, best_score))))
+            {
+                errors++;
+                printf("Band %u %u MHz: best %u, expected %u\n", band, widths[w],
+                       (0U != found) ? candidates[0].channel : 0U, best);
+            }
+            else if (0U != found)
+            {
+                printf("Band %u %3u MHz: best channel %3u (%d dBm), reference %3u\n", band,
+                       widths[w], candidates[0].channel,
+                       interference_matrix_dbm(candidates[0].score), best);
+            }
+        }
+    }
+
+    printf("%u BSSs, %u wider than 20 MHz, %u sweeps\n", BENCH_BSS, wide, BENCH_SWEEPS);
+    printf("Matrix: %u channels, %u bytes per copy\n", (unsigned int)INTERFERENCE_CHANNELS,
+           (unsigned int)(INTERFERENCE_CHANNELS * sizeof(interference_channel_t)));
+    printf("Decode and observe: %.1f ns per BSS\n",
+           (double)observe_ns / ((double)BENCH_SWEEPS * (double)BENCH_BSS));
+    printf("Commit: %.1f ns per sweep\n", (double)commit_ns / (double)BENCH_SWEEPS);
+    printf("Recommend: %.1f ns per call\n", (double)recommend_ns / (double)recommendations);
+    printf("%u errors\n", errors);
+
+    return (0U == errors) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,335 @@
+/*******************************************************************************
+* File Name        : motion_replay.c
+*
+* Description      : Host tool that replays a motion trace through the motion features
+*                    and kernels of the firmware. It checks the kernels against a
+*                    double-precision reference, measures their cost, reports the
+*                    sampling jitter of the trace and prints the motion events.
+*                    The trace is a UART capture of 'motion trace on' or any file of
+*                    lines 'time_us,rssi[,rssi...]', with an empty field for a missed
+*                    sample.
+*
+*                    Build: cc -O2 -I../../proj_cm33_ns motion_replay.c
+*                           ../../proj_cm33_ns/motion_features.c
+*                           ../../proj_cm33_ns/motion_kernels.c -lm -o motion_replay
+*
+*                    Usage: motion_replay <trace> [threshold_dB2]
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include "motion_features.h"
+#include "motion_kernels.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TRACE_PREFIX                         "#MT "
+#define LINE_LENGTH                          (256U)
+#define NOMINAL_PERIOD_US                    (100000U)
+#define KERNEL_ITERATIONS                    (200000U)
+#define NS_PER_SECOND                        (1000000000ULL)
+#define PI                                   (3.14159265358979)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Copy of the windows kept by the features module, rebuilt here to compute
+ * the reference features.
+ */
+static int16_t ref_window[MOTION_MAX_LINKS][MOTION_WINDOW];
+static bool ref_valid[MOTION_MAX_LINKS];
+static uint32_t ref_head;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * NS_PER_SECOND) + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t parse_line(char *line, uint32_t *time_us, int16_t *rssi)
+{
+    char *p = line;
+    uint32_t links = 0;
+
+    if (0 == strncmp(p, TRACE_PREFIX, strlen(TRACE_PREFIX)))
+    {
+        p += strlen(TRACE_PREFIX);
+    }
+
+    if ((*p < '0') || (*p > '9'))
+    {
+        return 0;
+    }
+
+    *time_us = (uint32_t)strtoul(p, &p, 10);
+
+    while ((',' == *p) && (links < MOTION_MAX_LINKS))
+    {
+        char *end;
+        long value = strtol(p + 1, &end, 10);
+
+        rssi[links++] = (end == (p + 1)) ? MOTION_NO_SAMPLE : (int16_t)value;
+        p = end;
+    }
+
+    return links;
+}
+
+static void ref_push(const int16_t *rssi, uint32_t links)
+{
+    for (uint32_t link = 0; link < links; link++)
+    {
+        if (MOTION_NO_SAMPLE != rssi[link])
+        {
+            if (!ref_valid[link])
+            {
+                for (uint32_t i = 0; i < MOTION_WINDOW; i++)
+                {
+                    ref_window[link][i] = rssi[link];
+                }
+            }
+
+            ref_valid[link] = true;
+            ref_window[link][ref_head] = rssi[link];
+        }
+        else
+        {
+            ref_window[link][ref_head] = ref_window[link][(ref_head + MOTION_WINDOW - 1U) %
+                                                          MOTION_WINDOW];
+        }
+    }
+
+    ref_head = (ref_head + 1U) % MOTION_WINDOW;
+}
+
+static void ref_features(uint32_t link, double *variance, double *band_percent)
+{
+    double x[MOTION_WINDOW];
+    double mean = 0.0;
+    double energy = 0.0;
+    double band = 0.0;
+
+    for (uint32_t i = 0; i < MOTION_WINDOW; i++)
+    {
+        x[i] = ref_window[link][(ref_head + i) % MOTION_WINDOW];
+        mean += x[i];
+    }
+
+    mean /= MOTION_WINDOW;
+
+    for (uint32_t i = 0; i < MOTION_WINDOW; i++)
+    {
+        x[i] -= mean;
+        energy += x[i] * x[i];
+    }
+
+    for (uint32_t k = MOTION_BAND_FIRST_BIN; k <= MOTION_BAND_LAST_BIN; k++)
+    {
+        double re = 0.0;
+        double im = 0.0;
+
+        for (uint32_t n = 0; n < MOTION_WINDOW; n++)
+        {
+            re += x[n] * cos((2.0 * PI * k * n) / MOTION_WINDOW);
+            im += x[n] * sin((2.0 * PI * k * n) / MOTION_WINDOW);
+        }
+
+        band += (re * re) + (im * im);
+    }
+
+    *variance = energy / MOTION_WINDOW;
+    *band_percent = (energy > 0.0) ? fmin(100.0, (200.0 * band) / (MOTION_WINDOW * energy)) : 0.0;
+}
+
+static void bench_kernels(void)
+{
+    int16_t x[MOTION_WINDOW];
+    int16_t y[MOTION_WINDOW];
+    volatile int32_t sink = 0;
+    int32_t sum;
+    int32_t sum_sq;
+
+    for (uint32_t i = 0; i < MOTION_WINDOW; i++)
+    {
+        x[i] = (int16_t)(-60 + (int16_t)(i % 7U));
+        y[i] = (int16_t)(32767.0 * cos((2.0 * PI * 3.0 * i) / MOTION_WINDOW));
+    }
+
+    uint64_t start = now_ns();
+
+    for (uint32_t i = 0; i < KERNEL_ITERATIONS; i++)
+    {
+        motion_kernel_sums(x, MOTION_WINDOW, &sum, &sum_sq);
+        sink += sum + sum_sq;
+        sink += motion_kernel_diff_energy(x, MOTION_WINDOW);
+        sink += motion_kernel_dot(x, y, MOTION_WINDOW);
+        x[i % MOTION_WINDOW] ^= 1;
+    }
+
+    printf("Kernels              : %.1f ns per window (sums, diff, one dot product)\n",
+           (double)(now_ns() - start) / KERNEL_ITERATIONS);
+    (void)sink;
+}
+
+int main(int argc, char **argv)
+{
+    char line[LINE_LENGTH];
+    int16_t rssi[MOTION_MAX_LINKS];
+    motion_features_result_t result;
+    uint32_t links = 0;
+    uint32_t samples = 0;
+    uint32_t evaluations = 0;
+    uint32_t events = 0;
+    uint32_t overruns = 0;
+    uint32_t last_us = 0;
+    uint64_t total_jitter_us = 0;
+    uint32_t max_jitter_us = 0;
+    double max_variance_error = 0.0;
+    double max_band_error = 0.0;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <trace> [threshold_dB2]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *trace = fopen(argv[1], "r");
+
+    if (NULL == trace)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    if (argc > 2)
+    {
+        motion_features_set_threshold((uint32_t)lrint(atof(argv[2]) * MOTION_Q4_ONE));
+    }
+
+    while (NULL != fgets(line, sizeof(line), trace))
+    {
+        uint32_t time_us;
+        uint32_t n = parse_line(line, &time_us, rssi);
+
+        if (0U == n)
+        {
+            continue;
+        }
+
+        if (0U == links)
+        {
+            links = n;
+            motion_features_init(links);
+        }
+
+        for (uint32_t i = n; i < links; i++)
+        {
+            rssi[i] = MOTION_NO_SAMPLE;
+        }
+
+        if (0U != samples)
+        {
+            uint32_t interval = time_us - last_us;
+            uint32_t jitter = (interval > NOMINAL_PERIOD_US) ? (interval - NOMINAL_PERIOD_US) :
+                                                               (NOMINAL_PERIOD_US - interval);
+
+            total_jitter_us += jitter;
+            max_jitter_us = (jitter > max_jitter_us) ? jitter : max_jitter_us;
+            overruns += ((2U * interval) > (3U * NOMINAL_PERIOD_US)) ? 1U : 0U;
+        }
+
+        last_us = time_us;
+        samples++;
+        ref_push(rssi, links);
+
+        if (!motion_features_push(rssi, &result))
+        {
+            continue;
+        }
+
+        evaluations++;
+
+        for (uint32_t link = 0; link < links; link++)
+        {
+            double variance;
+            double band_percent;
+
+            ref_features(link, &variance, &band_percent);
+            max_variance_error = fmax(max_variance_error,
+                                      fabs(variance - ((double)result.variance_q4[link] / MOTION_Q4_ONE)));
+            max_band_error = fmax(max_band_error, fabs(band_percent - result.band_percent[link]));
+        }
+
+        if (result.changed)
+        {
+            events++;
+            printf("%10.3f s  motion %s, variance %.2f dB^2\n", time_us / 1e6,
+                   result.motion ? "detected" : "ended", (double)result.score_q4 / MOTION_Q4_ONE);
+        }
+    }
+
+    fclose(trace);
+
+    printf("Samples              : %" PRIu32 " of %" PRIu32 " links\n", samples, links);
+    printf("Jitter (us)          : mean %.0f, max %" PRIu32 ", %" PRIu32 " overruns\n",
+           (samples > 1U) ? ((double)total_jitter_us / (samples - 1U)) : 0.0,
+           max_jitter_us, overruns);
+    printf("Evaluations          : %" PRIu32 ", %" PRIu32 " motion events\n", evaluations, events);
+    printf("Max variance error   : %.3f dB^2\n", max_variance_error);
+    printf("Max band error       : %.1f %%\n", max_band_error);
+    bench_kernels();
+
+    return 0;
+}
+
+/* [] END OF FILE */
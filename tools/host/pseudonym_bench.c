@@ -0,0 +1,304 @@
+/*******************************************************************************
+* File Name        : pseudonym_bench.c
+*
+* Description      : Host benchmark of the export pseudonyms. Checks the
+*                    properties of the pseudonyms, then measures what replacing
+*                    the BSSID and the SSID costs per exported record, with and
+*                    without the caches, next to the cost of encoding the record.
+*                    The secure service runs in the process as its stand-in.
+*                    
+*                    Build: cc -O2 -I../../proj_cm33_ns -I../../proj_cm33_s -I../../common
+*                           pseudonym_bench.c ../../proj_cm33_ns/pseudonym.c
+*                           ../../proj_cm33_ns/bssid_table.c ../../proj_cm33_ns/hash_service.c
+*                           ../../proj_cm33_ns/secure_batch.c ../../proj_cm33_s/secure_service.c
+*                           ../../common/siphash.c -o pseudonym_bench
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "pseudonym.h"
+#include "bssid_table.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A busy site: APs of a few vendors, each with several BSSIDs (siblings), and
+ * fewer networks than BSSIDs.
+ */
+#define BENCH_VENDORS                        (8U)
+#define BENCH_APS_PER_VENDOR                 (3U)
+#define BENCH_BSSIDS_PER_AP                  (2U)
+#define BENCH_APS                            (BENCH_VENDORS * BENCH_APS_PER_VENDOR * \
+                                              BENCH_BSSIDS_PER_AP)
+#define BENCH_NETWORKS                       (12U)
+#define BENCH_SCANS                          (20000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static scan_log_ap_t aps[BENCH_APS];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static void make_site(void)
+{
+    for (uint32_t i = 0; i < BENCH_APS; i++)
+    {
+        uint32_t vendor = i / (BENCH_APS_PER_VENDOR * BENCH_BSSIDS_PER_AP);
+        uint32_t ap = i / BENCH_BSSIDS_PER_AP;
+        scan_log_ap_t *result = &aps[i];
+
+        memset(result, 0, sizeof(*result));
+        result->bssid[0] = (uint8_t)(vendor * 4U);
+        result->bssid[1] = (uint8_t)(0x10U + vendor);
+        result->bssid[2] = 0x5AU;
+        result->bssid[3] = (uint8_t)(ap * 7U);
+        result->bssid[4] = (uint8_t)(ap * 13U);
+        result->bssid[5] = (uint8_t)(0x10U * (i % BENCH_BSSIDS_PER_AP));
+        result->rssi = (int8_t)(-40 - (int32_t)i);
+        result->channel = (uint8_t)(1U + (5U * (i % 3U)));
+        result->security = 0x00400004UL;
+        result->ssid_length = (uint8_t)snprintf((char *)result->ssid, sizeof(result->ssid),
+                                                "network-%u", (unsigned int)(i % BENCH_NETWORKS));
+    }
+
+    /* A hidden network. */
+    aps[BENCH_APS - 1U].ssid_length = 0U;
+
+    bssid_table_init();
+
+    for (uint32_t i = 0; i < BENCH_APS; i++)
+    {
+        (void)bssid_table_insert(aps[i].bssid, 1U);
+    }
+}
+
+static uint32_t packed_size(const scan_log_ap_t *site)
+{
+    scan_log_oui_dict_t dict;
+    uint8_t packed[SCAN_LOG_PACKED_BSSID_MAX_SIZE];
+    uint32_t size = 0U;
+
+    dict.count = 0U;
+
+    for (uint32_t i = 0; i < BENCH_APS; i++)
+    {
+        size += scan_log_pack_bssid(&dict, site[i].bssid, packed);
+    }
+
+    return size;
+}
+
+static int check_pseudonyms(void)
+{
+    static scan_log_ap_t first[BENCH_APS];
+    static scan_log_ap_t again[BENCH_APS];
+    uint8_t key[PSEUDONYM_KEY_SIZE];
+
+    for (uint32_t i = 0; i < PSEUDONYM_KEY_SIZE; i++)
+    {
+        key[i] = (uint8_t)(0xA5U ^ i);
+    }
+
+    pseudonym_init();
+
+    if (pseudonym_set_enabled(true))
+    {
+        printf("FAIL: pseudonyms on without a key\n");
+        return EXIT_FAILURE;
+    }
+
+    pseudonym_set_key(key);
+    (void)pseudonym_set_enabled(true);
+
+    for (uint32_t i = 0; i < BENCH_APS; i++)
+    {
+        first[i] = aps[i];
+        again[i] = aps[i];
+        (void)pseudonym_ap(&first[i]);
+        (void)pseudonym_ap(&again[i]);
+
+        if (0 != memcmp(&first[i], &again[i], sizeof(first[i])))
+        {
+            printf("FAIL: pseudonym of result %u is not stable\n", (unsigned int)i);
+            return EXIT_FAILURE;
+        }
+
+        if ((0x02U != (first[i].bssid[0] & 0x03U)) ||
+            (0 == memcmp(first[i].bssid, aps[i].bssid, BSSID_LENGTH)))
+        {
+            printf("FAIL: BSSID pseudonym of result %u\n", (unsigned int)i);
+            return EXIT_FAILURE;
+        }
+
+        if ((0U == aps[i].ssid_length) != (0U == first[i].ssid_length))
+        {
+            printf("FAIL: SSID pseudonym of result %u\n", (unsigned int)i);
+            return EXIT_FAILURE;
+        }
+
+        for (uint32_t j = 0; j < i; j++)
+        {
+            bool same_bssid = (0 == memcmp(aps[i].bssid, aps[j].bssid, BSSID_LENGTH));
+            bool same_ssid = (aps[i].ssid_length == aps[j].ssid_length) &&
+                             (0 == memcmp(aps[i].ssid, aps[j].ssid, aps[i].ssid_length));
+
+            if ((same_bssid != (0 == memcmp(first[i].bssid, first[j].bssid, BSSID_LENGTH))) ||
+                (same_ssid != ((first[i].ssid_length == first[j].ssid_length) &&
+                               (0 == memcmp(first[i].ssid, first[j].ssid,
+                                            first[i].ssid_length)))))
+            {
+                printf("FAIL: pseudonyms of results %u and %u\n", (unsigned int)j,
+                       (unsigned int)i);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (packed_size(first) != packed_size(aps))
+    {
+        printf("FAIL: packed BSSIDs take %u bytes with pseudonyms, %u without\n",
+               (unsigned int)packed_size(first), (unsigned int)packed_size(aps));
+        return EXIT_FAILURE;
+    }
+
+    (void)pseudonym_rotate();
+    again[0] = aps[0];
+    (void)pseudonym_ap(&again[0]);
+
+    if (0 == memcmp(again[0].bssid, first[0].bssid, BSSID_LENGTH))
+    {
+        printf("FAIL: pseudonym unchanged by key rotation\n");
+        return EXIT_FAILURE;
+    }
+
+    (void)pseudonym_set_enabled(false);
+    again[0] = aps[0];
+
+    if (pseudonym_ap(&again[0]) || (0 != memcmp(&again[0], &aps[0], sizeof(aps[0]))))
+    {
+        printf("FAIL: result changed with pseudonyms off\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Pseudonym checks       : OK (packed BSSIDs %u bytes for %u results)\n",
+           (unsigned int)packed_size(first), (unsigned int)BENCH_APS);
+
+    return EXIT_SUCCESS;
+}
+
+/* Returns the mean time in nanoseconds to replace and encode the results of a
+ * scan, per result. The key is rotated before each scan if cold is set, so
+ * that every pseudonym is computed.
+ */
+static double time_scans(bool pseudonyms, bool cold, uint32_t *checksum)
+{
+    uint8_t record[SCAN_LOG_MAX_RECORD_SIZE];
+    scan_log_oui_dict_t dict;
+    uint64_t ns = 0U;
+
+    (void)pseudonym_set_enabled(pseudonyms);
+
+    for (uint32_t scan = 0; scan < BENCH_SCANS; scan++)
+    {
+        uint32_t length = 0U;
+
+        if (cold)
+        {
+            (void)pseudonym_rotate();
+        }
+
+        uint32_t start = perf_counter_now();
+
+        dict.count = 0U;
+
+        for (uint32_t i = 0; i < BENCH_APS; i++)
+        {
+            scan_log_ap_t exported = aps[i];
+
+            (void)pseudonym_ap(&exported);
+            length += scan_log_encode_ap(&record[length], SCAN_LOG_FIELDS_ALL |
+                                         SCAN_LOG_SCHEMA_PACKED_BSSID, &dict, &exported);
+        }
+
+        ns += perf_counter_to_ns(perf_counter_now() - start);
+        *checksum += scan_log_crc32(record, length);
+    }
+
+    return (double)ns / (BENCH_SCANS * BENCH_APS);
+}
+
+int main(void)
+{
+    uint32_t checksum = 0U;
+
+    make_site();
+
+    if (EXIT_SUCCESS != check_pseudonyms())
+    {
+        return EXIT_FAILURE;
+    }
+
+    double plain = time_scans(false, false, &checksum);
+    double cached = time_scans(true, false, &checksum);
+    double cold = time_scans(true, true, &checksum);
+    pseudonym_stats_t stats;
+
+    pseudonym_stats(&stats);
+
+    printf("\nPer exported result (ns), %u results per scan\n", (unsigned int)BENCH_APS);
+    printf("  Encode only          : %.1f\n", plain);
+    printf("  Pseudonyms, cached   : %.1f (+%.1f)\n", cached, cached - plain);
+    printf("  Pseudonyms, uncached : %.1f (+%.1f)\n", cold, cold - plain);
+    printf("  Self-timed, all runs : %.1f (one in %u records)\n",
+           (double)stats.timed_ns / stats.timed_records, (unsigned int)PSEUDONYM_TIMING_INTERVAL);
+    printf("\nBSSIDs: %u cached, %u computed; SSIDs: %u cached, %u computed\n",
+           (unsigned int)stats.bssid_hits, (unsigned int)stats.bssid_misses,
+           (unsigned int)stats.ssid_hits, (unsigned int)stats.ssid_misses);
+    printf("Checksum %08X\n", (unsigned int)checksum);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
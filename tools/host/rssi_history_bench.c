@@ -0,0 +1,156 @@
+/*******************************************************************************
+* File Name        : rssi_history_bench.c
+*
+* Description      : Host benchmark of the per-BSSID RSSI history. Replays
+*                    synthetic scans of 512 tracked BSSIDs through the firmware
+*                    sources and reports the memory and the update cost.
+*                    
+*                    Build: cc -O2 -I../../proj_cm33_ns
+*                           -DBSSID_TABLE_MAX_ENTRIES=1024U -DRSSI_HISTORY_MAX_BSSIDS=512U
+*                           rssi_history_bench.c ../../proj_cm33_ns/bssid_table.c
+*                           ../../proj_cm33_ns/rssi_history.c
+*                           ../../proj_cm33_ns/series_codec.c
+*                           ../../proj_cm33_ns/hash_service.c -o rssi_history_bench
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include "bssid_table.h"
+#include "rssi_history.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_BSSIDS                         (512U)
+#define BENCH_SCAN_INTERVAL_S                (10U)
+#define BENCH_SCANS                          (2U * 24U * 360U)
+#define BENCH_VISIBLE_PERCENT                (90U)
+#define NS_PER_SECOND                        (1000000000ULL)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * NS_PER_SECOND) + (uint64_t)ts.tv_nsec;
+}
+
+int main(void)
+{
+    static int16_t rssi[BENCH_BSSIDS];
+    uint32_t rng = 0x12345678U;
+    uint64_t observe_ns = 0;
+    uint64_t commit_ns = 0;
+    uint64_t observations = 0;
+    uint32_t now_s = 1700000000U;
+
+    bssid_table_init();
+    rssi_history_init();
+
+    for (uint32_t i = 0; i < BENCH_BSSIDS; i++)
+    {
+        rssi[i] = (int16_t)(-40 - (int16_t)(xorshift32(&rng) % 50U));
+    }
+
+    for (uint32_t scan = 0; scan < BENCH_SCANS; scan++)
+    {
+        uint64_t start = now_ns();
+
+        for (uint32_t i = 0; i < BENCH_BSSIDS; i++)
+        {
+            uint32_t r = xorshift32(&rng);
+
+            if ((r % 100U) >= BENCH_VISIBLE_PERCENT)
+            {
+                continue;
+            }
+
+            uint8_t bssid[BSSID_LENGTH] = { 0x02, 0x11, 0x22,
+                                            (uint8_t)(i >> 8), (uint8_t)i, 0x01 };
+
+            rssi[i] = (int16_t)(rssi[i] + (int16_t)((r >> 8) % 5U) - 2);
+
+            uint16_t index = bssid_table_insert(bssid, scan);
+
+            rssi_history_observe(index, bssid_table_get(index)->generation,
+                                 rssi[i], now_s);
+            observations++;
+        }
+
+        uint64_t mid = now_ns();
+
+        rssi_history_commit(now_s, true);
+        commit_ns += now_ns() - mid;
+        observe_ns += mid - start;
+        now_s += BENCH_SCAN_INTERVAL_S;
+    }
+
+    printf("Tracked BSSIDs         : %u\n", (unsigned int)BENCH_BSSIDS);
+    printf("Bytes per BSSID        : %zu\n", rssi_history_bytes_per_bssid());
+    printf("Total history bytes    : %zu\n", rssi_history_total_bytes());
+    printf("Scans replayed         : %u (%u s apart)\n",
+           (unsigned int)BENCH_SCANS, (unsigned int)BENCH_SCAN_INTERVAL_S);
+    printf("Observe (ns/result)    : %.1f\n",
+           (double)observe_ns / (double)observations);
+    printf("Commit (ns/BSSID/scan) : %.1f\n",
+           (double)commit_ns / ((double)BENCH_SCANS * BENCH_BSSIDS));
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,609 @@
+/*******************************************************************************
+* File Name        : scan_log_analytics.cpp
+*
+* Description      : Host tool that replays many binary scan logs (see
+*                    scan_log_format.h) in parallel through the firmware scan
+*                    pipeline, checks its results against exact ground truth and
+*                    merges the per-device analytics.
+*                    
+*                    Build: cc -O2 -std=gnu11 -DSCAN_HOST_THREADED -I../../proj_cm33_ns
+*                           -I../../proj_cm33_s -I../../common -c
+*                           ../../proj_cm33_ns/bssid_table.c ../../proj_cm33_ns/rssi_history.c
+*                           ../../proj_cm33_ns/series_codec.c ../../proj_cm33_ns/snapshot_ring.c
+*                           ../../proj_cm33_ns/anomaly_detector.c ../../proj_cm33_ns/bssid_stability.c
+*                           ../../proj_cm33_ns/ess_view.c ../../proj_cm33_ns/scan_pipeline.c
+*                           ../../proj_cm33_ns/ssid_escape.c ../../proj_cm33_ns/hash_service.c
+*                           ../../proj_cm33_ns/pseudonym.c ../../proj_cm33_ns/secure_batch.c
+*                           ../../proj_cm33_s/secure_service.c ../../common/siphash.c
+*                    
+*                           c++ -O2 -std=c++17 -pthread -I../../proj_cm33_ns -I../../proj_cm33_s
+*                           scan_log_analytics.cpp bssid_table.o rssi_history.o
+*                           series_codec.o snapshot_ring.o anomaly_detector.o
+*                           bssid_stability.o ess_view.o scan_pipeline.o ssid_escape.o
+*                           hash_service.o pseudonym.o secure_batch.o secure_service.o
+*                           siphash.o -o scan_log_analytics
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "scan_log_reader.hpp"
+#include "scan_pipeline.h"
+#include "ess_view.h"
+#include "anomaly_detector.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HLL_PRECISION                        (12U)
+#define HLL_REGISTERS                        (1U << HLL_PRECISION)
+#define RSSI_BUCKETS                         (128U)     /* 0 dBm to -127 dBm */
+#define CHANNEL_BUCKETS                      (256U)
+#define APS_PER_SCAN_BUCKETS                 (65U)      /* Last bucket is 64 or more */
+
+/*******************************************************************************
+* Mergeable analytics. Every worker fills its own instance and the instances
+* are merged once all files are processed, so the result does not depend on
+* the number of threads or the order in which the files were processed.
+*******************************************************************************/
+/* HyperLogLog sketch of the distinct BSSIDs across all logs. */
+class hll_sketch
+{
+public:
+    void add(uint64_t key)
+    {
+        uint64_t hash = mix(key);
+        uint32_t index = static_cast<uint32_t>(hash >> (64U - HLL_PRECISION));
+        uint64_t rest = (hash << HLL_PRECISION) | (1ULL << (HLL_PRECISION - 1U));
+        uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+
+        registers_[index] = std::max(registers_[index], rank);
+    }
+
+    void merge(const hll_sketch &other)
+    {
+        for (uint32_t i = 0; i < HLL_REGISTERS; i++)
+        {
+            registers_[i] = std::max(registers_[i], other.registers_[i]);
+        }
+    }
+
+    double estimate() const
+    {
+        double m = HLL_REGISTERS;
+        double alpha = 0.7213 / (1.0 + 1.079 / m);
+        double sum = 0.0;
+        uint32_t zeros = 0;
+
+        for (uint8_t reg : registers_)
+        {
+            sum += std::ldexp(1.0, -reg);
+            zeros += (0U == reg) ? 1U : 0U;
+        }
+
+        double raw = alpha * m * m / sum;
+
+        /* Linear counting is more accurate for small cardinalities. */
+        if ((raw <= 2.5 * m) && (0U != zeros))
+        {
+            return m * std::log(m / zeros);
+        }
+
+        return raw;
+    }
+
+private:
+    /* SplitMix64 finalizer, spreads the OUI-heavy BSSID keys. */
+    static uint64_t mix(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    std::array<uint8_t, HLL_REGISTERS> registers_ = {};
+};
+
+struct analytics_t
+{
+    uint64_t files = 0;
+    uint64_t bytes = 0;
+    uint64_t skipped_bytes = 0;
+    uint64_t scans = 0;
+    uint64_t results = 0;
+    uint64_t unique = 0;
+    uint64_t appeared = 0;
+    uint64_t disappeared = 0;
+
+    /* Scans for which the pipeline disagreed with the exact ground truth,
+     * which happens when the BSSID table evicts a live entry.
+     */
+    uint64_t mismatched_scans = 0;
+
+    /* Full sweeps flagged by the anomaly detector. On traces recorded without
+     * interference, these are false positives.
+     */
+    uint64_t full_sweeps = 0;
+    uint64_t flagged_sweeps = 0;
+    std::array<uint64_t, ANOMALY_FLAG_COUNT> anomalies = {};
+
+    hll_sketch distinct_bssids;
+    std::array<uint64_t, RSSI_BUCKETS> rssi = {};
+    std::array<uint64_t, CHANNEL_BUCKETS> channels = {};
+    std::array<uint64_t, APS_PER_SCAN_BUCKETS> aps_per_scan = {};
+
+    void merge(const analytics_t &other)
+    {
+        files += other.files;
+        bytes += other.bytes;
+        skipped_bytes += other.skipped_bytes;
+        scans += other.scans;
+        results += other.results;
+        unique += other.unique;
+        appeared += other.appeared;
+        disappeared += other.disappeared;
+        mismatched_scans += other.mismatched_scans;
+        full_sweeps += other.full_sweeps;
+        flagged_sweeps += other.flagged_sweeps;
+
+        for (uint32_t i = 0; i < ANOMALY_FLAG_COUNT; i++)
+        {
+            anomalies[i] += other.anomalies[i];
+        }
+        distinct_bssids.merge(other.distinct_bssids);
+
+        for (uint32_t i = 0; i < RSSI_BUCKETS; i++)
+        {
+            rssi[i] += other.rssi[i];
+        }
+
+        for (uint32_t i = 0; i < CHANNEL_BUCKETS; i++)
+        {
+            channels[i] += other.channels[i];
+        }
+
+        for (uint32_t i = 0; i < APS_PER_SCAN_BUCKETS; i++)
+        {
+            aps_per_scan[i] += other.aps_per_scan[i];
+        }
+    }
+};
+
+/*******************************************************************************
+* Work-stealing thread pool. Each worker owns a deque of file indices, takes
+* work from the back of its own deque and steals from the front of the others
+* when it runs dry, so a few large logs do not leave the other threads idle.
+*******************************************************************************/
+class work_stealing_pool
+{
+public:
+    explicit work_stealing_pool(unsigned int threads) : queues_(threads) {}
+
+    void push(unsigned int worker, size_t task)
+    {
+        queues_[worker].tasks.push_back(task);
+    }
+
+    bool pop(unsigned int worker, size_t *task)
+    {
+        if (take(queues_[worker], false, task))
+        {
+            return true;
+        }
+
+        for (size_t i = 1; i < queues_.size(); i++)
+        {
+            if (take(queues_[(worker + i) % queues_.size()], true, task))
+            {
+                steals_++;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename fn_t>
+    void run(fn_t fn)
+    {
+        std::vector<std::thread> workers;
+
+        for (unsigned int w = 0; w < queues_.size(); w++)
+        {
+            workers.emplace_back([this, w, &fn]()
+                                 {
+                                     size_t task;
+
+                                     while (pop(w, &task))
+                                     {
+                                         fn(w, task);
+                                     }
+                                 });
+        }
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    uint64_t steals() const { return steals_; }
+
+private:
+    struct queue_t
+    {
+        std::mutex lock;
+        std::deque<size_t> tasks;
+    };
+
+    static bool take(queue_t &queue, bool front, size_t *task)
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        if (front)
+        {
+            *task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        else
+        {
+            *task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+
+        return true;
+    }
+
+    std::vector<queue_t> queues_;
+    std::atomic<uint64_t> steals_{0};
+};
+
+/*******************************************************************************
+* Helpers
+*******************************************************************************/
+static uint64_t bssid_key(const uint8_t *bssid)
+{
+    uint64_t key = 0;
+
+    for (uint32_t i = 0; i < SCAN_LOG_BSSID_LENGTH; i++)
+    {
+        key = (key << 8) | bssid[i];
+    }
+
+    return key;
+}
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start).count();
+}
+
+/*******************************************************************************
+* Log replay
+*******************************************************************************/
+/* Replays one device log through the scan pipeline. The pipeline state is
+ * thread local, so it is reset at the start of every log.
+ */
+static void analyze_log(const std::string &path, analytics_t *out)
+{
+    mapped_file log(path);
+    scan_log_header_t hdr = {};
+    scan_log_ap_t ap;
+    scan_pipeline_summary_t summary;
+    std::unordered_set<uint64_t> previous;
+    std::unordered_set<uint64_t> current;
+    std::set<std::pair<std::string, uint32_t>> networks;
+    size_t expected = 0;
+    size_t pos = scan_log_next_record(log.data(), log.size(), 0, &hdr);
+
+    scan_pipeline_init();
+
+    out->files++;
+    out->bytes += log.size();
+
+    while (pos < log.size())
+    {
+        bool full_sweep = (0U != (hdr.flags & SCAN_LOG_FLAG_FULL_SWEEP));
+        uint32_t offset = hdr.body;
+        uint32_t results = 0;
+        uint32_t appeared = 0;
+        uint32_t disappeared = 0;
+
+        out->skipped_bytes += pos - expected;
+        current.clear();
+        networks.clear();
+        scan_pipeline_begin(full_sweep);
+
+        for (uint32_t i = 0; i < hdr.ap_count; i++)
+        {
+            if (!scan_log_parse_ap(log.data() + pos, &hdr, &offset, &ap))
+            {
+                break;
+            }
+
+            uint64_t key = bssid_key(ap.bssid);
+
+            scan_pipeline_add(&ap, hdr.timestamp);
+
+            results++;
+            out->distinct_bssids.add(key);
+            out->rssi[std::min<uint32_t>(static_cast<uint32_t>(-ap.rssi), RSSI_BUCKETS - 1U)]++;
+            out->channels[ap.channel]++;
+
+            networks.emplace(std::string(reinterpret_cast<const char *>(ap.ssid), ap.ssid_length),
+                             ap.security);
+
+            if (current.insert(key).second && (0U == previous.count(key)))
+            {
+                appeared++;
+            }
+        }
+
+        scan_pipeline_commit(hdr.timestamp, &summary);
+
+        if (full_sweep)
+        {
+            for (uint64_t key : previous)
+            {
+                disappeared += (0U == current.count(key)) ? 1U : 0U;
+            }
+        }
+
+        if ((summary.results != results) || (summary.unique != current.size()) ||
+            (summary.appeared != appeared) || (summary.disappeared != disappeared) ||
+            (summary.networks != std::min<size_t>(networks.size(), ESS_VIEW_MAX_GROUPS)))
+        {
+            out->mismatched_scans++;
+        }
+
+        if (full_sweep)
+        {
+            out->full_sweeps++;
+            out->flagged_sweeps += (0U != summary.anomalies) ? 1U : 0U;
+
+            for (uint32_t i = 0; i < ANOMALY_FLAG_COUNT; i++)
+            {
+                out->anomalies[i] += (0U != (summary.anomalies & (1U << i))) ? 1U : 0U;
+            }
+        }
+
+        out->scans++;
+        out->results += summary.results;
+        out->unique += summary.unique;
+        out->appeared += summary.appeared;
+        out->disappeared += summary.disappeared;
+        out->aps_per_scan[std::min<uint32_t>(summary.unique, APS_PER_SCAN_BUCKETS - 1U)]++;
+
+        previous.swap(current);
+        expected = pos + hdr.length;
+        pos = scan_log_next_record(log.data(), log.size(), expected, &hdr);
+    }
+
+    out->skipped_bytes += log.size() - std::min(expected, log.size());
+}
+
+static analytics_t analyze_logs(const std::vector<std::string> &paths,
+                                unsigned int threads, bool verbose)
+{
+    std::vector<analytics_t> partial(threads);
+    work_stealing_pool pool(threads);
+
+    /* Deal the files out round robin; stealing balances what is left. */
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        pool.push(static_cast<unsigned int>(i % threads), i);
+    }
+
+    pool.run([&](unsigned int worker, size_t task)
+             {
+                 analyze_log(paths[task], &partial[worker]);
+             });
+
+    for (unsigned int w = 1; w < threads; w++)
+    {
+        partial[0].merge(partial[w]);
+    }
+
+    if (verbose)
+    {
+        fprintf(stderr, "%u threads, %" PRIu64 " steals\n", threads, pool.steals());
+    }
+
+    return partial[0];
+}
+
+/*******************************************************************************
+* Reports
+*******************************************************************************/
+static void print_histogram(const char *title, const uint64_t *buckets,
+                            uint32_t count, int32_t scale, const char *unit)
+{
+    uint64_t peak = *std::max_element(buckets, buckets + count);
+
+    printf("%s\n", title);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (0U != buckets[i])
+        {
+            int bar = static_cast<int>((40U * buckets[i] + peak - 1U) / peak);
+
+            printf("  %5d %-4s %10" PRIu64 " %.*s\n", scale * static_cast<int32_t>(i),
+                   unit, buckets[i], bar, "########################################");
+        }
+    }
+}
+
+static void print_report(const analytics_t &a)
+{
+    printf("Files              : %" PRIu64 " (%" PRIu64 " bytes, %" PRIu64 " skipped)\n",
+           a.files, a.bytes, a.skipped_bytes);
+    printf("Scans              : %" PRIu64 "\n", a.scans);
+    printf("Results            : %" PRIu64 " (%" PRIu64 " unique per scan)\n",
+           a.results, a.unique);
+    printf("Appeared           : %" PRIu64 "\n", a.appeared);
+    printf("Disappeared        : %" PRIu64 "\n", a.disappeared);
+    printf("Distinct BSSIDs    : ~%.0f\n", a.distinct_bssids.estimate());
+    printf("Mismatched scans   : %" PRIu64 "\n", a.mismatched_scans);
+    printf("Flagged sweeps     : %" PRIu64 " of %" PRIu64 " (%.2f per 1000)\n",
+           a.flagged_sweeps, a.full_sweeps,
+           (0U != a.full_sweeps) ? (1000.0 * a.flagged_sweeps / a.full_sweeps) : 0.0);
+
+    for (uint32_t i = 0; i < ANOMALY_FLAG_COUNT; i++)
+    {
+        printf("  %-17s: %" PRIu64 "\n", anomaly_flag_name(static_cast<uint8_t>(1U << i)),
+               a.anomalies[i]);
+    }
+
+    print_histogram("RSSI", a.rssi.data(), RSSI_BUCKETS, -1, "dBm");
+    print_histogram("Channels", a.channels.data(), CHANNEL_BUCKETS, 1, "ch");
+    print_histogram("BSSIDs per scan", a.aps_per_scan.data(), APS_PER_SCAN_BUCKETS, 1, "");
+}
+
+/* Runs the whole archive with 1, 2, 4, ... up to 'max_threads' threads and
+ * reports the speed-up and the parallel efficiency against one thread.
+ */
+static void report_scaling(const std::vector<std::string> &paths, unsigned int max_threads)
+{
+    std::vector<unsigned int> steps;
+    double base_ms = 0.0;
+
+    for (unsigned int threads = 1; threads < max_threads; threads *= 2U)
+    {
+        steps.push_back(threads);
+    }
+
+    steps.push_back(max_threads);
+
+    printf("Threads    Time ms   Speed-up  Efficiency\n");
+
+    for (unsigned int threads : steps)
+    {
+        auto start = std::chrono::steady_clock::now();
+        analytics_t a = analyze_logs(paths, threads, false);
+        double ms = elapsed_ms(start);
+
+        if (1U == threads)
+        {
+            base_ms = ms;
+        }
+
+        printf("%7u %10.1f %10.2f %10.0f%%   (%" PRIu64 " scans)\n", threads, ms,
+               base_ms / ms, 100.0 * base_ms / (ms * threads), a.scans);
+    }
+}
+
+/*******************************************************************************
+* Main
+*******************************************************************************/
+static void usage(void)
+{
+    fprintf(stderr,
+            "Usage:\n"
+            "  scan_log_analytics [-j threads] <log.bin>...\n"
+            "  scan_log_analytics --scaling [-j max_threads] <log.bin>...\n"
+            "Logs captured from the UART are converted with 'scan_log_index import'.\n");
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int threads = std::max(1U, std::thread::hardware_concurrency());
+    bool scaling = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-j")) && ((i + 1) < argc))
+        {
+            threads = std::max(1, atoi(argv[++i]));
+        }
+        else if (0 == strcmp(argv[i], "--scaling"))
+        {
+            scaling = true;
+        }
+        else
+        {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (paths.empty())
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    if (scaling)
+    {
+        report_scaling(paths, threads);
+        return EXIT_SUCCESS;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    analytics_t a = analyze_logs(paths, threads, true);
+
+    print_report(a);
+    fprintf(stderr, "Processed in %.1f ms\n", elapsed_ms(start));
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,758 @@
+/*******************************************************************************
+* File Name        : scan_log_index.cpp
+*
+* Description      : Host tool that memory-maps a binary scan log written by the
+*                    firmware (see scan_log_format.h), builds an on-disk index in
+*                    parallel, and answers BSSID, SSID and channel queries.
+*                    
+*                    Build: c++ -O2 -std=c++17 -pthread -I../../proj_cm33_ns
+*                           scan_log_index.cpp ../../proj_cm33_ns/ssid_escape.c
+*                           ../../proj_cm33_ns/hash_service.c -o scan_log_index
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <queue>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "scan_log_reader.hpp"
+#include "ssid_escape.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define INDEX_MAGIC                          (0x58494C53U)   /* "SLIX" */
+#define INDEX_VERSION                        (1U)
+#define INDEX_SUFFIX                         ".idx"
+#define UART_RECORD_PREFIX                   "#SL "
+
+/*******************************************************************************
+* Index file layout. All sections follow the header back to back.
+*******************************************************************************/
+struct index_header_t
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t log_size;
+    uint64_t snapshot_count;
+    uint64_t bssid_count;
+    uint64_t range_count;
+    uint64_t ssid_count;
+};
+
+/* One scan, in log order. */
+struct index_snapshot_t
+{
+    uint64_t offset;
+    uint32_t timestamp;
+    uint32_t sequence;
+};
+
+/* A BSSID and its presence ranges, sorted by key. */
+struct index_bssid_t
+{
+    uint64_t key;
+    uint32_t first_range;
+    uint32_t range_count;
+};
+
+/* Snapshots [first, last] in log order in which the BSSID was seen. */
+struct index_range_t
+{
+    uint32_t first;
+    uint32_t last;
+};
+
+/* SSID to BSSID mapping, sorted by SSID then BSSID. */
+struct index_ssid_t
+{
+    uint8_t length;
+    uint8_t ssid[SCAN_LOG_SSID_MAX_LENGTH];
+    uint8_t bssid[SCAN_LOG_BSSID_LENGTH];
+    uint8_t reserved;
+};
+
+/*******************************************************************************
+* Helpers
+*******************************************************************************/
+static uint64_t bssid_key(const uint8_t *bssid)
+{
+    uint64_t key = 0;
+
+    for (uint32_t i = 0; i < SCAN_LOG_BSSID_LENGTH; i++)
+    {
+        key = (key << 8) | bssid[i];
+    }
+
+    return key;
+}
+
+static bool parse_bssid(const char *text, uint8_t *bssid)
+{
+    unsigned int b[SCAN_LOG_BSSID_LENGTH];
+
+    if (6 != sscanf(text, "%x:%x:%x:%x:%x:%x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < SCAN_LOG_BSSID_LENGTH; i++)
+    {
+        bssid[i] = static_cast<uint8_t>(b[i]);
+    }
+
+    return true;
+}
+
+static std::string format_bssid(const uint8_t *bssid)
+{
+    char text[18];
+
+    snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X",
+             bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+
+    return text;
+}
+
+/* FNV-1a hash of an SSID, used to skip SSID/BSSID pairs already recorded. */
+static uint64_t ssid_hash(const scan_log_ap_t &ap)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (uint32_t i = 0; i < ap.ssid_length; i++)
+    {
+        hash = (hash ^ ap.ssid[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start).count();
+}
+
+/*******************************************************************************
+* Index building
+*******************************************************************************/
+struct posting_t
+{
+    uint64_t key;
+    uint32_t snapshot;
+};
+
+struct chunk_result_t
+{
+    std::vector<index_snapshot_t> snapshots;
+    std::vector<posting_t> postings;
+    std::vector<index_ssid_t> ssids;
+};
+
+/* Indexes the records that start in [begin, end). Snapshot numbers in the
+ * postings are local to the chunk and rebased after all workers finish.
+ */
+static void index_chunk(const uint8_t *log, size_t size, size_t begin,
+                        size_t end, chunk_result_t *out)
+{
+    scan_log_header_t hdr = {};
+    scan_log_ap_t ap;
+    size_t pos = scan_log_next_record(log, size, begin, &hdr);
+    std::unordered_set<uint64_t> seen_ssids;
+
+    while (pos < end)
+    {
+        uint32_t local = static_cast<uint32_t>(out->snapshots.size());
+        uint32_t offset = hdr.body;
+
+        out->snapshots.push_back({ pos, hdr.timestamp, hdr.sequence });
+
+        for (uint32_t i = 0; i < hdr.ap_count; i++)
+        {
+            if (!scan_log_parse_ap(log + pos, &hdr, &offset, &ap))
+            {
+                break;
+            }
+
+            out->postings.push_back({ bssid_key(ap.bssid), local });
+
+            index_ssid_t ssid = {};
+
+            ssid.length = ap.ssid_length;
+            memcpy(ssid.ssid, ap.ssid, ap.ssid_length);
+            memcpy(ssid.bssid, ap.bssid, SCAN_LOG_BSSID_LENGTH);
+
+            if (seen_ssids.insert(bssid_key(ap.bssid) ^ (ssid_hash(ap) << 1)).second)
+            {
+                out->ssids.push_back(ssid);
+            }
+        }
+
+        pos = scan_log_next_record(log, size, pos + hdr.length, &hdr);
+    }
+
+    std::sort(out->postings.begin(), out->postings.end(),
+              [](const posting_t &a, const posting_t &b)
+              {
+                  return std::tie(a.key, a.snapshot) < std::tie(b.key, b.snapshot);
+              });
+
+}
+
+static int build_index(const std::string &log_path, unsigned int threads)
+{
+    auto start = std::chrono::steady_clock::now();
+    mapped_file log(log_path);
+    std::vector<chunk_result_t> chunks(threads);
+    std::vector<std::thread> workers;
+    size_t chunk_size = (log.size() + threads - 1U) / threads;
+
+    for (unsigned int t = 0; t < threads; t++)
+    {
+        size_t begin = std::min(log.size(), t * chunk_size);
+        size_t end = std::min(log.size(), begin + chunk_size);
+
+        workers.emplace_back(index_chunk, log.data(), log.size(), begin, end, &chunks[t]);
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    /* Concatenate the snapshots and rebase the chunk-local snapshot numbers. */
+    std::vector<index_snapshot_t> snapshots;
+    std::vector<uint32_t> bases;
+
+    for (auto &chunk : chunks)
+    {
+        bases.push_back(static_cast<uint32_t>(snapshots.size()));
+        snapshots.insert(snapshots.end(), chunk.snapshots.begin(), chunk.snapshots.end());
+    }
+
+    /* K-way merge of the sorted postings. Chunks are in log order, so ties on
+     * the key are resolved by chunk number to keep the snapshots ascending.
+     */
+    using head_t = std::tuple<uint64_t, uint32_t, size_t>;   /* key, chunk, position */
+    std::priority_queue<head_t, std::vector<head_t>, std::greater<head_t>> heads;
+    std::vector<index_bssid_t> bssids;
+    std::vector<index_range_t> ranges;
+
+    for (uint32_t c = 0; c < chunks.size(); c++)
+    {
+        if (!chunks[c].postings.empty())
+        {
+            heads.emplace(chunks[c].postings[0].key, c, 0U);
+        }
+    }
+
+    while (!heads.empty())
+    {
+        auto [key, c, pos] = heads.top();
+        heads.pop();
+
+        uint32_t snapshot = bases[c] + chunks[c].postings[pos].snapshot;
+
+        if (bssids.empty() || (bssids.back().key != key))
+        {
+            bssids.push_back({ key, static_cast<uint32_t>(ranges.size()), 0U });
+        }
+
+        index_bssid_t &bssid = bssids.back();
+
+        if ((0U != bssid.range_count) && (ranges.back().last + 1U >= snapshot))
+        {
+            ranges.back().last = snapshot;
+        }
+        else
+        {
+            ranges.push_back({ snapshot, snapshot });
+            bssid.range_count++;
+        }
+
+        if (++pos < chunks[c].postings.size())
+        {
+            heads.emplace(chunks[c].postings[pos].key, c, pos);
+        }
+    }
+
+    std::vector<index_ssid_t> ssids;
+
+    for (auto &chunk : chunks)
+    {
+        ssids.insert(ssids.end(), chunk.ssids.begin(), chunk.ssids.end());
+    }
+
+    std::sort(ssids.begin(), ssids.end(), [](const index_ssid_t &a, const index_ssid_t &b)
+              {
+                  return memcmp(&a, &b, sizeof(a)) < 0;
+              });
+    ssids.erase(std::unique(ssids.begin(), ssids.end(),
+                            [](const index_ssid_t &a, const index_ssid_t &b)
+                            {
+                                return 0 == memcmp(&a, &b, sizeof(a));
+                            }),
+                ssids.end());
+
+    std::vector<uint32_t> time_order(snapshots.size());
+
+    for (uint32_t i = 0; i < time_order.size(); i++)
+    {
+        time_order[i] = i;
+    }
+
+    std::stable_sort(time_order.begin(), time_order.end(), [&](uint32_t a, uint32_t b)
+                     {
+                         return snapshots[a].timestamp < snapshots[b].timestamp;
+                     });
+
+    index_header_t header = { INDEX_MAGIC, INDEX_VERSION, log.size(), snapshots.size(),
+                              bssids.size(), ranges.size(), ssids.size() };
+    std::ofstream out(log_path + INDEX_SUFFIX, std::ios::binary | std::ios::trunc);
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(snapshots.data()), snapshots.size() * sizeof(snapshots[0]));
+    out.write(reinterpret_cast<const char *>(time_order.data()), time_order.size() * sizeof(time_order[0]));
+    out.write(reinterpret_cast<const char *>(bssids.data()), bssids.size() * sizeof(bssids[0]));
+    out.write(reinterpret_cast<const char *>(ranges.data()), ranges.size() * sizeof(ranges[0]));
+    out.write(reinterpret_cast<const char *>(ssids.data()), ssids.size() * sizeof(ssids[0]));
+
+    if (!out)
+    {
+        fprintf(stderr, "Failed to write %s%s\n", log_path.c_str(), INDEX_SUFFIX);
+        return EXIT_FAILURE;
+    }
+
+    printf("Indexed %zu bytes: %zu snapshots, %zu BSSIDs, %zu ranges, %zu SSID/BSSID pairs"
+           " with %u threads in %.1f ms\n", log.size(), snapshots.size(), bssids.size(),
+           ranges.size(), ssids.size(), threads, elapsed_ms(start));
+
+    return EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+* Index access
+*******************************************************************************/
+class scan_log_index
+{
+public:
+    explicit scan_log_index(const std::string &log_path)
+        : log_(log_path), index_(log_path + INDEX_SUFFIX)
+    {
+        const uint8_t *p = index_.data();
+
+        if (index_.size() < sizeof(index_header_t))
+        {
+            fail("index is too small");
+        }
+
+        memcpy(&header_, p, sizeof(header_));
+
+        if ((INDEX_MAGIC != header_.magic) || (INDEX_VERSION != header_.version))
+        {
+            fail("not an index file");
+        }
+
+        if (header_.log_size != log_.size())
+        {
+            fail("index is out of date, run 'build' again");
+        }
+
+        p += sizeof(header_);
+        snapshots_ = reinterpret_cast<const index_snapshot_t *>(p);
+        p += header_.snapshot_count * sizeof(index_snapshot_t);
+        time_order_ = reinterpret_cast<const uint32_t *>(p);
+        p += header_.snapshot_count * sizeof(uint32_t);
+        bssids_ = reinterpret_cast<const index_bssid_t *>(p);
+        p += header_.bssid_count * sizeof(index_bssid_t);
+        ranges_ = reinterpret_cast<const index_range_t *>(p);
+        p += header_.range_count * sizeof(index_range_t);
+        ssids_ = reinterpret_cast<const index_ssid_t *>(p);
+        p += header_.ssid_count * sizeof(index_ssid_t);
+
+        if (static_cast<size_t>(p - index_.data()) != index_.size())
+        {
+            fail("index is corrupted");
+        }
+    }
+
+    /* Prints every sighting of a BSSID between t1 and t2. */
+    void query_bssid(const uint8_t *bssid, uint32_t t1, uint32_t t2) const
+    {
+        uint64_t key = bssid_key(bssid);
+        const index_bssid_t *end = bssids_ + header_.bssid_count;
+        const index_bssid_t *entry = std::lower_bound(bssids_, end, key,
+            [](const index_bssid_t &e, uint64_t k) { return e.key < k; });
+        uint32_t count = 0;
+
+        if ((end == entry) || (entry->key != key))
+        {
+            printf("BSSID not found\n");
+            return;
+        }
+
+        printf("%-10s %-8s %5s %7s\n", "Timestamp", "Sequence", "RSSI", "Channel");
+
+        for (uint32_t r = 0; r < entry->range_count; r++)
+        {
+            const index_range_t &range = ranges_[entry->first_range + r];
+
+            for (uint32_t s = range.first; s <= range.last; s++)
+            {
+                const index_snapshot_t &snap = snapshots_[s];
+                scan_log_ap_t ap;
+
+                if ((snap.timestamp < t1) || (snap.timestamp > t2) || (!find_ap(snap, key, &ap)))
+                {
+                    continue;
+                }
+
+                printf("%-10" PRIu32 " %-8" PRIu32 " %5d %7u\n", snap.timestamp,
+                       snap.sequence, ap.rssi, ap.channel);
+                count++;
+            }
+        }
+
+        printf("%u sightings in %u ranges\n", count, entry->range_count);
+    }
+
+    /* Prints the BSSIDs that advertised an SSID. */
+    void query_ssid(const std::string &ssid) const
+    {
+        index_ssid_t probe = {};
+
+        probe.length = static_cast<uint8_t>(std::min<size_t>(ssid.size(), SCAN_LOG_SSID_MAX_LENGTH));
+        memcpy(probe.ssid, ssid.data(), probe.length);
+
+        const index_ssid_t *end = ssids_ + header_.ssid_count;
+        const index_ssid_t *it = std::lower_bound(ssids_, end, probe,
+            [](const index_ssid_t &a, const index_ssid_t &b)
+            {
+                return memcmp(&a, &b, offsetof(index_ssid_t, bssid)) < 0;
+            });
+        uint32_t count = 0;
+
+        for (; (it != end) && (0 == memcmp(it, &probe, offsetof(index_ssid_t, bssid))); ++it)
+        {
+            printf("%s\n", format_bssid(it->bssid).c_str());
+            count++;
+        }
+
+        printf("%u BSSIDs\n", count);
+    }
+
+    /* Prints a summary of every AP seen on a channel between t1 and t2. */
+    void query_channel(uint8_t channel, uint32_t t1, uint32_t t2) const
+    {
+        struct summary_t
+        {
+            uint32_t first;
+            uint32_t last;
+            uint32_t count;
+            int min_rssi;
+            int max_rssi;
+            std::string ssid;
+        };
+        std::map<uint64_t, summary_t> aps;
+        const uint32_t *begin = time_order_;
+        const uint32_t *end = time_order_ + header_.snapshot_count;
+        const uint32_t *it = std::lower_bound(begin, end, t1,
+            [this](uint32_t s, uint32_t t) { return snapshots_[s].timestamp < t; });
+        uint32_t scanned = 0;
+
+        for (; (it != end) && (snapshots_[*it].timestamp <= t2); ++it)
+        {
+            const index_snapshot_t &snap = snapshots_[*it];
+            const uint8_t *record = log_.data() + snap.offset;
+            scan_log_header_t hdr;
+            scan_log_ap_t ap;
+
+            if (!scan_log_parse_header(record, static_cast<uint32_t>(log_.size() - snap.offset), &hdr))
+            {
+                continue;
+            }
+
+            scanned++;
+
+            uint32_t offset = hdr.body;
+
+            for (uint32_t i = 0; (i < hdr.ap_count) && scan_log_parse_ap(record, &hdr, &offset, &ap); i++)
+            {
+                if (ap.channel != channel)
+                {
+                    continue;
+                }
+
+                auto res = aps.try_emplace(bssid_key(ap.bssid),
+                    summary_t{ snap.timestamp, snap.timestamp, 0U, ap.rssi, ap.rssi,
+                               std::string(reinterpret_cast<const char *>(ap.ssid), ap.ssid_length) });
+                summary_t &sum = res.first->second;
+
+                sum.first = std::min(sum.first, snap.timestamp);
+                sum.last = std::max(sum.last, snap.timestamp);
+                sum.count++;
+                sum.min_rssi = std::min<int>(sum.min_rssi, ap.rssi);
+                sum.max_rssi = std::max<int>(sum.max_rssi, ap.rssi);
+            }
+        }
+
+        printf("%-17s %-32s %6s %10s %10s %9s\n", "BSSID", "SSID", "Seen", "First", "Last", "RSSI");
+
+        for (const auto &[key, sum] : aps)
+        {
+            uint8_t bssid[SCAN_LOG_BSSID_LENGTH];
+
+            for (int i = SCAN_LOG_BSSID_LENGTH - 1; i >= 0; i--)
+            {
+                bssid[i] = static_cast<uint8_t>(key >> (8 * (SCAN_LOG_BSSID_LENGTH - 1 - i)));
+            }
+
+            char ssid[SSID_ESCAPE_BUFFER_SIZE];
+            uint32_t columns;
+
+            ssid_escape(reinterpret_cast<const uint8_t *>(sum.ssid.data()),
+                        static_cast<uint32_t>(sum.ssid.size()), SSID_ESCAPE_TERMINAL, ssid, &columns);
+            printf("%-17s %s%*s %6u %10u %10u %4d/%4d\n", format_bssid(bssid).c_str(), ssid,
+                   ssid_escape_padding(columns, SSID_ESCAPE_MAX_SSID_LENGTH), "", sum.count, sum.first, sum.last, sum.min_rssi, sum.max_rssi);
+        }
+
+        printf("%zu APs in %u snapshots\n", aps.size(), scanned);
+    }
+
+private:
+    [[noreturn]] static void fail(const char *reason)
+    {
+        fprintf(stderr, "Cannot use index: %s\n", reason);
+        exit(EXIT_FAILURE);
+    }
+
+    bool find_ap(const index_snapshot_t &snap, uint64_t key, scan_log_ap_t *ap) const
+    {
+        const uint8_t *record = log_.data() + snap.offset;
+        scan_log_header_t hdr;
+
+        if (!scan_log_parse_header(record, static_cast<uint32_t>(log_.size() - snap.offset), &hdr))
+        {
+            return false;
+        }
+
+        uint32_t offset = hdr.body;
+
+        for (uint32_t i = 0; (i < hdr.ap_count) && scan_log_parse_ap(record, &hdr, &offset, ap); i++)
+        {
+            if (bssid_key(ap->bssid) == key)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    mapped_file log_;
+    mapped_file index_;
+    index_header_t header_ = {};
+    const index_snapshot_t *snapshots_ = nullptr;
+    const uint32_t *time_order_ = nullptr;
+    const index_bssid_t *bssids_ = nullptr;
+    const index_range_t *ranges_ = nullptr;
+    const index_ssid_t *ssids_ = nullptr;
+};
+
+/*******************************************************************************
+* UART capture import
+*******************************************************************************/
+static int import_capture(const std::string &capture_path, const std::string &log_path)
+{
+    std::ifstream in(capture_path);
+    std::ofstream out(log_path, std::ios::binary | std::ios::app);
+    std::string line;
+    std::vector<uint8_t> record;
+    uint32_t imported = 0;
+    uint32_t rejected = 0;
+    uint32_t derived = 0;
+
+    while (std::getline(in, line))
+    {
+        size_t pos = line.find(UART_RECORD_PREFIX);
+
+        if (std::string::npos == pos)
+        {
+            continue;
+        }
+
+        record.clear();
+
+        for (pos += strlen(UART_RECORD_PREFIX); (pos + 1U) < line.size(); pos += 2U)
+        {
+            if ((!isxdigit(static_cast<unsigned char>(line[pos]))) ||
+                (!isxdigit(static_cast<unsigned char>(line[pos + 1U]))))
+            {
+                break;
+            }
+
+            record.push_back(static_cast<uint8_t>(std::stoul(line.substr(pos, 2U), nullptr, 16)));
+        }
+
+        scan_log_header_t hdr;
+
+        /* ESS and occupancy records are derived from the snapshots and not
+         * indexed. Signature records are checked by scan_log_verify on the
+         * capture itself.
+         */
+        if ((record.size() >= SCAN_LOG_HEADER_SIZE) &&
+            ((SCAN_LOG_ESS_MAGIC == scan_log_get_u16(record.data() + SCAN_LOG_OFFSET_MAGIC)) ||
+             (SCAN_LOG_OCCUPANCY_MAGIC == scan_log_get_u16(record.data() + SCAN_LOG_OFFSET_MAGIC)) ||
+             (SCAN_LOG_SIGNATURE_MAGIC == scan_log_get_u16(record.data() + SCAN_LOG_OFFSET_MAGIC))))
+        {
+            derived++;
+            continue;
+        }
+
+        if (scan_log_parse_header(record.data(), static_cast<uint32_t>(record.size()), &hdr) &&
+            (hdr.length == record.size()) && scan_log_check_crc(record.data(), &hdr))
+        {
+            out.write(reinterpret_cast<const char *>(record.data()), record.size());
+            imported++;
+        }
+        else
+        {
+            rejected++;
+        }
+    }
+
+    printf("Imported %u records, rejected %u, skipped %u ESS, occupancy and signature records\n",
+           imported, rejected, derived);
+
+    return out ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+* Main
+*******************************************************************************/
+static void usage(void)
+{
+    fprintf(stderr,
+            "Usage:\n"
+            "  scan_log_index import <capture.txt> <log.bin>\n"
+            "  scan_log_index build <log.bin> [threads]\n"
+            "  scan_log_index bssid <log.bin> <bssid> [t1 [t2]]\n"
+            "  scan_log_index ssid <log.bin> <ssid>\n"
+            "  scan_log_index channel <log.bin> <channel> [t1 [t2]]\n"
+            "Times are in seconds since the epoch, for example $(date -d 'last tuesday' +%%s).\n");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    std::string command = argv[1];
+    std::string log_path = argv[2];
+
+    if (("import" == command) && (argc == 4))
+    {
+        return import_capture(argv[2], argv[3]);
+    }
+
+    if ("build" == command)
+    {
+        unsigned int threads = (argc > 3) ? static_cast<unsigned int>(atoi(argv[3])) :
+                                            std::thread::hardware_concurrency();
+
+        return build_index(log_path, std::max(1U, threads));
+    }
+
+    if (argc < 4)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    uint32_t t1 = (argc > 4) ? static_cast<uint32_t>(strtoul(argv[4], nullptr, 10)) : 0U;
+    uint32_t t2 = (argc > 5) ? static_cast<uint32_t>(strtoul(argv[5], nullptr, 10)) : UINT32_MAX;
+    auto start = std::chrono::steady_clock::now();
+    scan_log_index index(log_path);
+
+    if ("bssid" == command)
+    {
+        uint8_t bssid[SCAN_LOG_BSSID_LENGTH];
+
+        if (!parse_bssid(argv[3], bssid))
+        {
+            usage();
+            return EXIT_FAILURE;
+        }
+
+        index.query_bssid(bssid, t1, t2);
+    }
+    else if ("ssid" == command)
+    {
+        index.query_ssid(argv[3]);
+    }
+    else if ("channel" == command)
+    {
+        index.query_channel(static_cast<uint8_t>(atoi(argv[3])), t1, t2);
+    }
+    else
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "Query time %.2f ms\n", elapsed_ms(start));
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,143 @@
+/*******************************************************************************
+* File Name        : scan_log_reader.hpp
+*
+* Description      : Memory-mapped scan log access shared by the host tools.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*  Include guard
+*******************************************************************************/
+#ifndef TOOLS_HOST_SCAN_LOG_READER_HPP_
+#define TOOLS_HOST_SCAN_LOG_READER_HPP_
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "scan_log_format.h"
+
+/*******************************************************************************
+* Read-only memory-mapped file
+*******************************************************************************/
+class mapped_file
+{
+public:
+    explicit mapped_file(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat st;
+
+        if ((fd < 0) || (0 != fstat(fd, &st)))
+        {
+            perror(path.c_str());
+            exit(EXIT_FAILURE);
+        }
+
+        size_ = static_cast<size_t>(st.st_size);
+
+        if (0U != size_)
+        {
+            void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (MAP_FAILED == addr)
+            {
+                perror("mmap");
+                exit(EXIT_FAILURE);
+            }
+
+            data_ = static_cast<const uint8_t *>(addr);
+            madvise(addr, size_, MADV_WILLNEED);
+        }
+
+        close(fd);
+    }
+
+    ~mapped_file()
+    {
+        if (nullptr != data_)
+        {
+            munmap(const_cast<uint8_t *>(data_), size_);
+        }
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    const uint8_t *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/*******************************************************************************
+* Record scanning
+*******************************************************************************/
+/* Returns the offset of the first valid record at or after 'pos', or 'size'
+ * if there is none. Corrupted regions are skipped byte by byte.
+ */
+static inline size_t scan_log_next_record(const uint8_t *log, size_t size, size_t pos,
+                                          scan_log_header_t *hdr)
+{
+    while (pos < size)
+    {
+        if (scan_log_parse_header(log + pos, static_cast<uint32_t>(std::min<size_t>(size - pos, UINT32_MAX)), hdr) &&
+            scan_log_check_crc(log + pos, hdr))
+        {
+            return pos;
+        }
+
+        pos++;
+    }
+
+    return size;
+}
+
+#endif /* TOOLS_HOST_SCAN_LOG_READER_HPP_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,630 @@
+/*******************************************************************************
+* File Name        : scan_log_verify.cpp
+*
+* Description      : Host tool that verifies the batch signatures of the scan log
+*                    records in a UART capture (see scan_log_format.h and
+*                    scan_sign.h) against the public key of the device, and
+*                    reports the records that are unsigned or fail. The
+*                    selftest signs synthetic records with the firmware signer,
+*                    checks that tampering is detected and measures the signing
+*                    and verification time per batch.
+*                    
+*                    Build: cc -O2 -std=gnu11 -I../../proj_cm33_ns -c
+*                           ../../proj_cm33_ns/scan_sign.c ../../proj_cm33_ns/hash_service.c
+*                    
+*                           c++ -O2 -std=c++17 -I../../proj_cm33_ns scan_log_verify.cpp
+*                           scan_sign.o hash_service.o -lcrypto -o scan_log_verify
+*
+*                    Usage: scan_log_verify <capture.txt> <key>
+*                           scan_log_verify selftest
+*                           The key is the hexadecimal public key printed by the
+*                           console command "sign", or a file with its line.
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <openssl/core_names.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+
+#include "scan_log_format.h"
+#include "scan_sign.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UART_RECORD_PREFIX                   "#SL "
+#define SHA256_SIZE                          (32U)
+#define P256_COORDINATE_SIZE                 (32U)
+
+#define SELFTEST_SCANS                       (512U)
+#define SELFTEST_SCAN_PERIOD_S               (10U)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef std::vector<uint8_t> record_t;
+
+struct verify_result_t
+{
+    uint32_t batches_ok = 0;
+    uint32_t batches_failed = 0;
+    uint32_t batches_missing = 0;
+    uint32_t restarts = 0;
+    uint32_t records_verified = 0;
+    uint32_t records_unsigned = 0;
+    uint32_t records_pending = 0;
+    uint64_t verify_ns = 0;
+    uint64_t max_verify_ns = 0;
+};
+
+/*******************************************************************************
+* Helpers
+*******************************************************************************/
+static bool parse_hex(const std::string &text, size_t pos, record_t &out)
+{
+    out.clear();
+
+    for (; (pos + 1U) < text.size(); pos += 2U)
+    {
+        if ((!isxdigit(static_cast<unsigned char>(text[pos]))) ||
+            (!isxdigit(static_cast<unsigned char>(text[pos + 1U]))))
+        {
+            break;
+        }
+
+        out.push_back(static_cast<uint8_t>(std::stoul(text.substr(pos, 2U), nullptr, 16)));
+    }
+
+    return !out.empty();
+}
+
+/* Reads the records of a UART capture, in output order. */
+static std::vector<record_t> read_capture(std::istream &in)
+{
+    std::vector<record_t> records;
+    std::string line;
+    record_t record;
+
+    while (std::getline(in, line))
+    {
+        size_t pos = line.find(UART_RECORD_PREFIX);
+
+        if ((std::string::npos != pos) && parse_hex(line, pos + strlen(UART_RECORD_PREFIX), record))
+        {
+            records.push_back(record);
+        }
+    }
+
+    return records;
+}
+
+/* Reads the public key, given in hexadecimal or as a file with a
+ * SCAN_SIGN_KEY_PREFIX line.
+ */
+static bool read_key(const std::string &arg, record_t &key)
+{
+    std::ifstream in(arg);
+    std::string line;
+
+    if (!in)
+    {
+        return parse_hex(arg, 0U, key) && (SCAN_SIGN_PUBLIC_KEY_SIZE == key.size());
+    }
+
+    while (std::getline(in, line))
+    {
+        size_t pos = line.find(SCAN_SIGN_KEY_PREFIX);
+
+        if ((std::string::npos != pos) &&
+            parse_hex(line, pos + strlen(SCAN_SIGN_KEY_PREFIX), key) &&
+            (SCAN_SIGN_PUBLIC_KEY_SIZE == key.size()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool is_signature(const record_t &record)
+{
+    return (SCAN_LOG_SIGNATURE_RECORD_SIZE == record.size()) &&
+           (SCAN_LOG_SIGNATURE_MAGIC == scan_log_get_u16(record.data() + SCAN_LOG_OFFSET_MAGIC)) &&
+           (SCAN_LOG_SIGNATURE_RECORD_SIZE ==
+            scan_log_get_u16(record.data() + SCAN_LOG_OFFSET_LENGTH)) &&
+           (scan_log_get_u32(record.data() + SCAN_LOG_OFFSET_CRC) ==
+            scan_log_crc32(record.data() + SCAN_LOG_HEADER_SIZE, SCAN_LOG_SIGNATURE_BODY_SIZE));
+}
+
+static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+/*******************************************************************************
+* Batch verifier
+*******************************************************************************/
+class batch_verifier
+{
+public:
+    explicit batch_verifier(const record_t &public_key)
+    {
+        OSSL_PARAM params[] =
+        {
+            OSSL_PARAM_construct_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME,
+                                             const_cast<char *>("prime256v1"), 0),
+            OSSL_PARAM_construct_octet_string(OSSL_PKEY_PARAM_PUB_KEY,
+                                              const_cast<uint8_t *>(public_key.data()),
+                                              public_key.size()),
+            OSSL_PARAM_construct_end()
+        };
+        EVP_PKEY_CTX *context = EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr);
+        uint8_t digest[SHA256_SIZE];
+
+        if ((nullptr == context) || (1 != EVP_PKEY_fromdata_init(context)) ||
+            (1 != EVP_PKEY_fromdata(context, &key_, EVP_PKEY_PUBLIC_KEY, params)))
+        {
+            key_ = nullptr;
+        }
+
+        EVP_PKEY_CTX_free(context);
+        EVP_Digest(public_key.data(), public_key.size(), digest, nullptr, EVP_sha256(), nullptr);
+        memcpy(key_id_, digest, sizeof(key_id_));
+    }
+
+    ~batch_verifier()
+    {
+        EVP_PKEY_free(key_);
+    }
+
+    batch_verifier(const batch_verifier &) = delete;
+    batch_verifier &operator=(const batch_verifier &) = delete;
+
+    bool valid() const { return nullptr != key_; }
+
+    /* Takes the next record of the capture. */
+    void add(const record_t &record)
+    {
+        if (!is_signature(record))
+        {
+            pending_.push_back(&record);
+            return;
+        }
+
+        const uint8_t *p = record.data();
+        uint32_t count = scan_log_get_u16(p + SCAN_LOG_OFFSET_AP_COUNT);
+        uint32_t number = scan_log_get_u32(p + SCAN_LOG_OFFSET_SEQUENCE);
+        auto start = std::chrono::steady_clock::now();
+        bool ok = (count <= pending_.size()) && (0U != count) &&
+                  (0 == memcmp(p + SCAN_LOG_HEADER_SIZE + SCAN_LOG_SIGNATURE_OFFSET_KEY_ID,
+                               key_id_, sizeof(key_id_))) &&
+                  check(p, count);
+        uint64_t ns = elapsed_ns(start);
+
+        result_.verify_ns += ns;
+        result_.max_verify_ns = std::max(result_.max_verify_ns, ns);
+
+        /* Records before those of the batch were output with signing off, or
+         * belong to a batch whose signature is missing.
+         */
+        uint32_t covered = std::min<uint32_t>(count, static_cast<uint32_t>(pending_.size()));
+
+        result_.records_unsigned += static_cast<uint32_t>(pending_.size()) - covered;
+
+        if (started_ && (0U == number) && (0U != expected_))
+        {
+            result_.restarts++;
+        }
+        else if (number > expected_)
+        {
+            result_.batches_missing += number - expected_;
+        }
+        else if (started_ && (number < expected_))
+        {
+            ok = false;
+        }
+
+        if (ok)
+        {
+            result_.batches_ok++;
+            result_.records_verified += count;
+        }
+        else
+        {
+            result_.batches_failed++;
+            failed_.push_back(number);
+        }
+
+        started_ = true;
+        expected_ = number + 1U;
+        pending_.clear();
+    }
+
+    /* Records after the last signature are not signed yet. */
+    const verify_result_t &finish()
+    {
+        result_.records_pending = static_cast<uint32_t>(pending_.size());
+        pending_.clear();
+
+        return result_;
+    }
+
+    const std::vector<uint32_t> &failed() const { return failed_; }
+
+private:
+    bool check(const uint8_t *signature_record, uint32_t count) const
+    {
+        EVP_MD_CTX *hash = EVP_MD_CTX_new();
+        uint8_t digest[SHA256_SIZE];
+        uint8_t der[EVP_MAX_MD_SIZE * 3U];
+        uint8_t *der_end = der;
+        const uint8_t *signature = signature_record + SCAN_LOG_HEADER_SIZE +
+                                   SCAN_LOG_SIGNATURE_OFFSET_SIGNATURE;
+        bool ok = (nullptr != hash) && (1 == EVP_DigestInit_ex(hash, EVP_sha256(), nullptr));
+
+        for (size_t i = pending_.size() - count; ok && (i < pending_.size()); i++)
+        {
+            ok = (1 == EVP_DigestUpdate(hash, pending_[i]->data(), pending_[i]->size()));
+        }
+
+        ok = ok && (1 == EVP_DigestUpdate(hash, signature_record, SCAN_LOG_OFFSET_CRC)) &&
+             (1 == EVP_DigestUpdate(hash, key_id_, sizeof(key_id_))) &&
+             (1 == EVP_DigestFinal_ex(hash, digest, nullptr));
+        EVP_MD_CTX_free(hash);
+
+        ECDSA_SIG *sig = ECDSA_SIG_new();
+        BIGNUM *r = BN_bin2bn(signature, P256_COORDINATE_SIZE, nullptr);
+        BIGNUM *s = BN_bin2bn(signature + P256_COORDINATE_SIZE, P256_COORDINATE_SIZE, nullptr);
+
+        if ((nullptr == sig) || (1 != ECDSA_SIG_set0(sig, r, s)))
+        {
+            BN_free(r);
+            BN_free(s);
+            ok = false;
+        }
+
+        int der_length = ok ? i2d_ECDSA_SIG(sig, &der_end) : 0;
+        ECDSA_SIG_free(sig);
+
+        EVP_PKEY_CTX *context = EVP_PKEY_CTX_new(key_, nullptr);
+
+        ok = ok && (der_length > 0) && (nullptr != context) &&
+             (1 == EVP_PKEY_verify_init(context)) &&
+             (1 == EVP_PKEY_verify(context, der, static_cast<size_t>(der_length), digest,
+                                   sizeof(digest)));
+        EVP_PKEY_CTX_free(context);
+
+        return ok;
+    }
+
+    EVP_PKEY *key_ = nullptr;
+    uint8_t key_id_[SCAN_LOG_SIGNATURE_KEY_ID_SIZE] = {};
+    std::vector<const record_t *> pending_;
+    std::vector<uint32_t> failed_;
+    verify_result_t result_;
+    uint32_t expected_ = 0;
+    bool started_ = false;
+};
+
+static verify_result_t verify_records(const std::vector<record_t> &records, const record_t &key,
+                                      std::vector<uint32_t> *failed)
+{
+    batch_verifier verifier(key);
+
+    for (const record_t &record : records)
+    {
+        verifier.add(record);
+    }
+
+    if (nullptr != failed)
+    {
+        *failed = verifier.failed();
+    }
+
+    return verifier.finish();
+}
+
+static void print_result(const verify_result_t &result)
+{
+    uint32_t batches = result.batches_ok + result.batches_failed;
+
+    printf("Batches: %u verified, %u failed, %u missing, %u restarts\n", result.batches_ok,
+           result.batches_failed, result.batches_missing, result.restarts);
+    printf("Records: %u verified, %u unsigned, %u not signed yet\n", result.records_verified,
+           result.records_unsigned, result.records_pending);
+
+    if (0U != batches)
+    {
+        printf("Verification: %.1f us per batch, max %.1f us\n",
+               (result.verify_ns / 1000.0) / batches, result.max_verify_ns / 1000.0);
+    }
+}
+
+/*******************************************************************************
+* Selftest
+*******************************************************************************/
+static std::vector<record_t> selftest_output;
+
+static void selftest_sink(const uint8_t *record, uint32_t length)
+{
+    selftest_output.emplace_back(record, record + length);
+}
+
+/* Builds a record with a valid header and CRC, of the sizes of a snapshot
+ * and an ESS record.
+ */
+static record_t make_record(uint16_t magic, uint32_t sequence, uint32_t timestamp,
+                            uint32_t length, uint32_t *seed)
+{
+    record_t record(length, 0U);
+
+    for (uint32_t i = SCAN_LOG_HEADER_SIZE; i < length; i++)
+    {
+        *seed = (*seed * 1664525U) + 1013904223U;
+        record[i] = static_cast<uint8_t>(*seed >> 24);
+    }
+
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_MAGIC], magic);
+    record[SCAN_LOG_OFFSET_VERSION] = SCAN_LOG_VERSION;
+    scan_log_put_u16(&record[SCAN_LOG_OFFSET_LENGTH], static_cast<uint16_t>(length));
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_SEQUENCE], sequence);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_TIMESTAMP], timestamp);
+    scan_log_put_u32(&record[SCAN_LOG_OFFSET_CRC],
+                     scan_log_crc32(&record[SCAN_LOG_HEADER_SIZE], length - SCAN_LOG_HEADER_SIZE));
+
+    return record;
+}
+
+/* Signs SELFTEST_SCANS scans of two records each in batches of the given
+ * size, 0 for automatic sizes, and returns the output.
+ */
+static std::vector<record_t> sign_scans(uint32_t batch, uint32_t period_s)
+{
+    uint32_t seed = 1U;
+
+    selftest_output.clear();
+    scan_sign_set_batch(batch);
+    (void)scan_sign_set_enabled(true);
+
+    for (uint32_t scan = 0; scan < SELFTEST_SCANS; scan++)
+    {
+        uint32_t timestamp = 1700000000U + (scan * period_s);
+        record_t snapshot = make_record(SCAN_LOG_MAGIC, scan, timestamp, 600U + (scan % 900U),
+                                        &seed);
+        record_t ess = make_record(SCAN_LOG_ESS_MAGIC, scan, timestamp, 300U, &seed);
+
+        scan_sign_sink(snapshot.data(), static_cast<uint32_t>(snapshot.size()));
+        scan_sign_sink(ess.data(), static_cast<uint32_t>(ess.size()));
+    }
+
+    /* The batch in progress is signed at the next record after signing is
+     * turned off.
+     */
+    (void)scan_sign_set_enabled(false);
+    record_t last = make_record(SCAN_LOG_MAGIC, SELFTEST_SCANS, 1800000000U, 100U, &seed);
+    scan_sign_sink(last.data(), static_cast<uint32_t>(last.size()));
+
+    return selftest_output;
+}
+
+static size_t nth_record(const std::vector<record_t> &records, size_t n, bool signature)
+{
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        if ((is_signature(records[i]) == signature) && (0U == n--))
+        {
+            return i;
+        }
+    }
+
+    return records.size();
+}
+
+#define SELFTEST_CHECK(condition, message) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            printf("FAIL: %s\n", (message)); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+static int selftest(void)
+{
+    static const uint32_t batches[] = { 1, 2, 4, 8, 16, 32, SCAN_SIGN_MAX_RECORDS };
+    uint8_t public_key[SCAN_SIGN_PUBLIC_KEY_SIZE];
+    scan_sign_stats_t stats;
+
+    SELFTEST_CHECK(scan_sign_init() && scan_sign_public_key(public_key), "signing key");
+    scan_sign_set_output(selftest_sink);
+
+    record_t key(public_key, public_key + sizeof(public_key));
+    std::vector<record_t> output = sign_scans(8U, SELFTEST_SCAN_PERIOD_S);
+    verify_result_t result = verify_records(output, key, nullptr);
+
+    SELFTEST_CHECK((128U == result.batches_ok) && (0U == result.batches_failed) &&
+                   ((2U * SELFTEST_SCANS) == result.records_verified) &&
+                   (0U == result.records_unsigned) && (1U == result.records_pending),
+                   "signed batches");
+
+    /* A record changed along with its CRC. */
+    std::vector<record_t> tampered = output;
+    size_t i = nth_record(tampered, 100U, false);
+    tampered[i][SCAN_LOG_HEADER_SIZE + 5U] ^= 0x01U;
+    scan_log_put_u32(&tampered[i][SCAN_LOG_OFFSET_CRC],
+                     scan_log_crc32(&tampered[i][SCAN_LOG_HEADER_SIZE],
+                                    static_cast<uint32_t>(tampered[i].size()) -
+                                    SCAN_LOG_HEADER_SIZE));
+    result = verify_records(tampered, key, nullptr);
+    SELFTEST_CHECK((127U == result.batches_ok) && (1U == result.batches_failed),
+                   "changed record");
+
+    /* A record removed, then two records swapped. */
+    tampered = output;
+    tampered.erase(tampered.begin() + static_cast<long>(nth_record(tampered, 200U, false)));
+    result = verify_records(tampered, key, nullptr);
+    SELFTEST_CHECK((127U == result.batches_ok) && (1U == result.batches_failed),
+                   "removed record");
+
+    tampered = output;
+    i = nth_record(tampered, 300U, false);
+    std::swap(tampered[i], tampered[i + 1U]);
+    result = verify_records(tampered, key, nullptr);
+    SELFTEST_CHECK((127U == result.batches_ok) && (1U == result.batches_failed),
+                   "reordered records");
+
+    /* A signature removed: its records are reported unsigned. */
+    tampered = output;
+    tampered.erase(tampered.begin() + static_cast<long>(nth_record(tampered, 50U, true)));
+    result = verify_records(tampered, key, nullptr);
+    SELFTEST_CHECK((127U == result.batches_ok) && (0U == result.batches_failed) &&
+                   (1U == result.batches_missing) && (8U == result.records_unsigned),
+                   "removed signature");
+
+    /* Another key. */
+    SELFTEST_CHECK(scan_sign_init() && scan_sign_public_key(public_key), "second signing key");
+    result = verify_records(output, record_t(public_key, public_key + sizeof(public_key)),
+                            nullptr);
+    SELFTEST_CHECK((0U == result.batches_ok) && (128U == result.batches_failed),
+                   "other key");
+
+    printf("Tamper checks          : OK\n\n");
+
+    /* Signing and verification time per batch, on this host. */
+    printf("%8s %10s %14s %14s %12s\n", "Records", "Batches", "Sign us/batch",
+           "Verify us/batch", "Hash ns/KB");
+
+    for (uint32_t b : batches)
+    {
+        SELFTEST_CHECK(scan_sign_init(), "signing key");
+        SELFTEST_CHECK(scan_sign_public_key(public_key), "signing key");
+        key.assign(public_key, public_key + sizeof(public_key));
+        output = sign_scans(b, SELFTEST_SCAN_PERIOD_S);
+        result = verify_records(output, key, nullptr);
+        scan_sign_stats(&stats);
+
+        SELFTEST_CHECK((0U == result.batches_failed) && (0U == result.records_unsigned),
+                       "batch size");
+        printf("%8u %10u %14.1f %14.1f %12.1f\n", b, stats.batches,
+               (stats.sign_ns / 1000.0) / stats.batches,
+               (result.verify_ns / 1000.0) / result.batches_ok,
+               (stats.hash_ns * 1024.0) / stats.record_bytes);
+    }
+
+    /* Automatic sizes: with records less than a second apart, the batches
+     * grow to the largest size.
+     */
+    SELFTEST_CHECK(scan_sign_init(), "signing key");
+    (void)sign_scans(0U, 0U);
+    scan_sign_stats(&stats);
+    SELFTEST_CHECK(SCAN_SIGN_MAX_RECORDS == stats.batch_records, "automatic batch size");
+    printf("\nAutomatic batch size, all records in one second: %u\n", stats.batch_records);
+
+    return EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+* Main
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    if ((2 == argc) && (0 == strcmp(argv[1], "selftest")))
+    {
+        return selftest();
+    }
+
+    if (3 != argc)
+    {
+        fprintf(stderr, "Usage:\n"
+                        "  scan_log_verify <capture.txt> <key>\n"
+                        "  scan_log_verify selftest\n");
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream in(argv[1]);
+    record_t key;
+
+    if (!in)
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    if (!read_key(argv[2], key))
+    {
+        fprintf(stderr, "No public key in %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<record_t> records = read_capture(in);
+    std::vector<uint32_t> failed;
+    batch_verifier check_key(key);
+
+    if (!check_key.valid())
+    {
+        fprintf(stderr, "Invalid public key\n");
+        return EXIT_FAILURE;
+    }
+
+    verify_result_t result = verify_records(records, key, &failed);
+
+    for (uint32_t number : failed)
+    {
+        printf("Batch %u: signature does not match\n", number);
+    }
+
+    print_result(result);
+
+    return ((0U == result.batches_failed) && (0U == result.records_unsigned)) ?
+           EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
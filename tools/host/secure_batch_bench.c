@@ -0,0 +1,261 @@
+/*******************************************************************************
+* File Name        : secure_batch_bench.c
+*
+* Description      : Host test and benchmark of the batched calls to the secure
+*                    service, which runs in the process as its stand-in. Checks
+*                    the requests and their errors, that batched and single
+*                    requests give the same results, then measures the time per
+*                    request for batches of 1 to SECURE_SERVICE_MAX_ITEMS. On the
+*                    host a call is a plain function call; the console command
+*                    "secure" measures the cost of the secure image transition
+*                    on the device.
+*
+*                    Build: cc -O2 -I../../proj_cm33_ns -I../../proj_cm33_s -I../../common
+*                           secure_batch_bench.c ../../proj_cm33_ns/secure_batch.c
+*                           ../../proj_cm33_s/secure_service.c
+*                           ../../common/siphash.c -o secure_batch_bench
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "secure_batch.h"
+#include "siphash.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_REQUESTS                       (2000000U)
+
+#define CHECK(condition, message) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            printf("FAIL: %s\n", (message)); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint8_t key[SECURE_SERVICE_KEY_SIZE] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+static uint8_t inputs[SECURE_SERVICE_MAX_ITEMS][7];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/* Runs a batch of one request and returns its status. */
+static uint8_t run_one(uint8_t op, uint8_t slot, const uint8_t *input, uint32_t length,
+                       uint64_t *output)
+{
+    secure_batch_t batch;
+
+    secure_batch_begin(&batch);
+    const secure_service_item_t *item = secure_batch_add(&batch, op, slot, input, length);
+
+    if (NULL == item)
+    {
+        return 0xFFU;
+    }
+
+    (void)secure_batch_run(&batch);
+    *output = item->output;
+
+    return item->status;
+}
+
+static int check_requests(void)
+{
+    secure_batch_t batch;
+    uint64_t output;
+    uint64_t before;
+    uint8_t long_input[SECURE_SERVICE_MAX_INPUT + 1U] = { 0 };
+
+    CHECK(SECURE_SERVICE_STATUS_NO_KEY ==
+          run_one(SECURE_SERVICE_OP_SIPHASH, SECURE_SERVICE_KEY_SCRATCH, key, 6U, &output),
+          "keyed hash without a key");
+    CHECK(SECURE_SERVICE_STATUS_NO_KEY ==
+          run_one(SECURE_SERVICE_OP_ROTATE_KEY, SECURE_SERVICE_KEY_SCRATCH, NULL, 0U, &output),
+          "rotation of a key that was never set");
+    CHECK(SECURE_SERVICE_STATUS_BAD_INPUT ==
+          run_one(SECURE_SERVICE_OP_SET_KEY, SECURE_SERVICE_KEY_SCRATCH, key, 8U, &output),
+          "short key");
+    CHECK(SECURE_SERVICE_STATUS_OK ==
+          run_one(SECURE_SERVICE_OP_SET_KEY, SECURE_SERVICE_KEY_SCRATCH, key, sizeof(key),
+                  &output) && (1U == output), "set key");
+    CHECK(SECURE_SERVICE_STATUS_OK ==
+          run_one(SECURE_SERVICE_OP_SIPHASH, SECURE_SERVICE_KEY_SCRATCH, key, 15U, &output) &&
+          (siphash_2_4(key, key, 15U) == output), "keyed hash");
+
+    before = output;
+    CHECK(SECURE_SERVICE_STATUS_OK ==
+          run_one(SECURE_SERVICE_OP_ROTATE_KEY, SECURE_SERVICE_KEY_SCRATCH, NULL, 0U, &output) &&
+          (2U == output), "key rotation");
+    CHECK(SECURE_SERVICE_STATUS_OK ==
+          run_one(SECURE_SERVICE_OP_SIPHASH, SECURE_SERVICE_KEY_SCRATCH, key, 15U, &output) &&
+          (before != output), "keyed hash after key rotation");
+    CHECK(SECURE_SERVICE_STATUS_BAD_INPUT ==
+          run_one(SECURE_SERVICE_OP_ROTATE_KEY, SECURE_SERVICE_KEY_SCRATCH, key, 5U, &output),
+          "rotation with a short random input");
+    CHECK(SECURE_SERVICE_STATUS_BAD_OP ==
+          run_one(SECURE_SERVICE_OP_COUNT, SECURE_SERVICE_KEY_SCRATCH, key, 6U, &output),
+          "unknown operation");
+    CHECK(SECURE_SERVICE_STATUS_BAD_KEY ==
+          run_one(SECURE_SERVICE_OP_SIPHASH, SECURE_SERVICE_KEY_COUNT, key, 6U, &output),
+          "unknown key");
+    CHECK(SECURE_SERVICE_STATUS_NO_KEY ==
+          run_one(SECURE_SERVICE_OP_SIPHASH, SECURE_SERVICE_KEY_PSEUDONYM, key, 6U, &output),
+          "keys are separate");
+
+    /* Inputs that are too long are refused by the batch and by the service. */
+    secure_batch_begin(&batch);
+    CHECK(NULL == secure_batch_add(&batch, SECURE_SERVICE_OP_SIPHASH, SECURE_SERVICE_KEY_SCRATCH,
+                                   long_input, sizeof(long_input)), "long input in a batch");
+
+    batch.items[0].op = SECURE_SERVICE_OP_SIPHASH;
+    batch.items[0].key = SECURE_SERVICE_KEY_SCRATCH;
+    batch.items[0].length = (uint8_t)sizeof(long_input);
+    batch.items[0].input = long_input;
+    CHECK((0U == secure_service_call(batch.items, 1U)) &&
+          (SECURE_SERVICE_STATUS_BAD_INPUT == batch.items[0].status), "long input");
+
+    /* A full batch, with a failing request that does not stop the others. */
+    secure_batch_begin(&batch);
+
+    for (uint32_t i = 0; i < SECURE_SERVICE_MAX_ITEMS; i++)
+    {
+        inputs[i][0] = (uint8_t)i;
+        CHECK(NULL != secure_batch_add(&batch, SECURE_SERVICE_OP_SIPHASH,
+                                       (5U == i) ? SECURE_SERVICE_KEY_PSEUDONYM :
+                                       SECURE_SERVICE_KEY_SCRATCH, inputs[i], 1U + (i % 7U)),
+              "full batch");
+    }
+
+    CHECK(NULL == secure_batch_add(&batch, SECURE_SERVICE_OP_NOP, 0U, NULL, 0U),
+          "request beyond a full batch");
+    CHECK(!secure_batch_run(&batch), "batch with a failing request");
+
+    for (uint32_t i = 0; i < SECURE_SERVICE_MAX_ITEMS; i++)
+    {
+        uint64_t single;
+        uint8_t status = run_one(SECURE_SERVICE_OP_SIPHASH, (5U == i) ?
+                                 SECURE_SERVICE_KEY_PSEUDONYM : SECURE_SERVICE_KEY_SCRATCH,
+                                 inputs[i], 1U + (i % 7U), &single);
+
+        CHECK((status == batch.items[i].status) && (single == batch.items[i].output),
+              "batched and single requests differ");
+    }
+
+    CHECK(0U == secure_service_call(batch.items, SECURE_SERVICE_MAX_ITEMS + 1U),
+          "batch larger than the service accepts");
+
+    printf("Secure service checks  : OK\n");
+
+    return EXIT_SUCCESS;
+}
+
+/* Returns the mean time per request in nanoseconds for batches of a size. */
+static double time_requests(uint8_t op, uint32_t size)
+{
+    secure_batch_t batch;
+    uint32_t calls = BENCH_REQUESTS / size;
+    uint64_t sink = 0U;
+    uint32_t start = perf_counter_now();
+
+    for (uint32_t call = 0; call < calls; call++)
+    {
+        secure_batch_begin(&batch);
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            (void)secure_batch_add(&batch, op, SECURE_SERVICE_KEY_SCRATCH, inputs[i], 6U);
+        }
+
+        (void)secure_batch_run(&batch);
+        sink += batch.items[size - 1U].output;
+    }
+
+    uint32_t ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    if (1U == (sink & 0xFFFFFFFFFFFFULL))
+    {
+        printf(" ");
+    }
+
+    return (double)ns / (calls * size);
+}
+
+int main(void)
+{
+    static const uint32_t sizes[] = { 1, 2, 4, 8, 16, SECURE_SERVICE_MAX_ITEMS };
+    secure_batch_stats_t stats;
+
+    if (EXIT_SUCCESS != check_requests())
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("\nTime per request (ns), host stand-in\n%6s %10s %10s\n", "Batch", "Empty",
+           "SipHash");
+
+    for (uint32_t i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        printf("%6u %10.1f %10.1f\n", (unsigned int)sizes[i],
+               time_requests(SECURE_SERVICE_OP_NOP, sizes[i]),
+               time_requests(SECURE_SERVICE_OP_SIPHASH, sizes[i]));
+    }
+
+    secure_batch_stats(&stats);
+    printf("\n%u calls, %u requests, %u failed\n", (unsigned int)stats.calls,
+           (unsigned int)stats.items, (unsigned int)stats.failed);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
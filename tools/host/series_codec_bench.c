@@ -0,0 +1,203 @@
+/*******************************************************************************
+* File Name        : series_codec_bench.c
+*
+* Description      : Host benchmark of the RSSI series codec. Encodes a series
+*                    read from a 'timestamp,rssi' CSV file (or a synthetic one),
+*                    reports the compression ratio and the encode and decode
+*                    throughput, and checks decoding of every truncated prefix.
+*                    
+*                    Build: cc -O2 -I../../proj_cm33_ns series_codec_bench.c
+*                           ../../proj_cm33_ns/series_codec.c -o series_codec_bench
+*                    Usage: series_codec_bench [replay.csv]
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "series_codec.h"
+#include "rssi_history.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_MAX_RECORDS                    (1000000U)
+#define BENCH_SYNTHETIC_RECORDS              (100000U)
+#define BENCH_SYNTHETIC_INTERVAL_S           (10U)
+#define BENCH_ITERATIONS                     (20U)
+#define RAW_RECORD_BYTES                     (5U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t timestamps[BENCH_MAX_RECORDS];
+static uint8_t values[BENCH_MAX_RECORDS];
+static uint8_t stream[BENCH_MAX_RECORDS * SERIES_CODEC_MAX_RECORD_BYTES];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static uint32_t load_csv(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    unsigned long timestamp;
+    int rssi;
+    uint32_t count = 0;
+
+    if (NULL == file)
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+
+    while ((count < BENCH_MAX_RECORDS) &&
+           (2 == fscanf(file, "%lu,%d", &timestamp, &rssi)))
+    {
+        timestamps[count] = (uint32_t)timestamp;
+        values[count] = rssi_history_encode((int16_t)rssi);
+        count++;
+    }
+
+    fclose(file);
+
+    return count;
+}
+
+static uint32_t make_synthetic(void)
+{
+    uint32_t rng = 0x9E3779B9U;
+    uint32_t timestamp = 1700000000U;
+    int32_t rssi = -60;
+
+    for (uint32_t i = 0; i < BENCH_SYNTHETIC_RECORDS; i++)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+
+        /* Regular interval with occasional one-second jitter and a slow RSSI
+         * random walk, which is typical for a static AP.
+         */
+        timestamp += BENCH_SYNTHETIC_INTERVAL_S + (((rng & 0xFU) == 0U) ? 1U : 0U);
+
+        if ((rng & 0x30U) == 0U)
+        {
+            rssi += (int32_t)((rng >> 8) % 3U) - 1;
+        }
+
+        timestamps[i] = timestamp;
+        values[i] = rssi_history_encode((int16_t)rssi);
+    }
+
+    return BENCH_SYNTHETIC_RECORDS;
+}
+
+int main(int argc, char **argv)
+{
+    series_encoder_t enc;
+    series_decoder_t dec;
+    uint32_t count = (argc > 1) ? load_csv(argv[1]) : make_synthetic();
+    uint32_t length = 0;
+    uint64_t encode_ns = 0;
+    uint64_t decode_ns = 0;
+    uint32_t timestamp;
+    uint8_t value;
+
+    for (uint32_t iter = 0; iter < BENCH_ITERATIONS; iter++)
+    {
+        uint32_t start = perf_counter_now();
+
+        series_encoder_init(&enc, stream, sizeof(stream));
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            series_encoder_put(&enc, timestamps[i], values[i]);
+        }
+
+        length = series_encoder_finish(&enc);
+        encode_ns += perf_counter_to_ns(perf_counter_now() - start);
+
+        start = perf_counter_now();
+        series_decoder_init(&dec, stream, length);
+
+        while (series_decoder_next(&dec, &timestamp, &value))
+        {
+        }
+
+        decode_ns += perf_counter_to_ns(perf_counter_now() - start);
+    }
+
+    /* Every prefix of the stream must decode to a prefix of the input. */
+    uint32_t step = (length / 1000U) + 1U;
+
+    for (uint32_t cut = 0; cut <= length; cut += step)
+    {
+        uint32_t i = 0;
+
+        series_decoder_init(&dec, stream, cut);
+
+        while (series_decoder_next(&dec, &timestamp, &value))
+        {
+            if ((timestamps[i] != timestamp) || (values[i] != value))
+            {
+                printf("Mismatch at record %u of stream truncated to %u bytes\n",
+                       (unsigned int)i, (unsigned int)cut);
+                return EXIT_FAILURE;
+            }
+
+            i++;
+        }
+    }
+
+    double mrec = (double)count * BENCH_ITERATIONS / 1e6;
+
+    printf("Records             : %u\n", (unsigned int)count);
+    printf("Raw bytes           : %u\n", (unsigned int)(count * RAW_RECORD_BYTES));
+    printf("Compressed bytes    : %u (%.2f bits/record, %.2fx)\n",
+           (unsigned int)length, (8.0 * length) / count,
+           (double)(count * RAW_RECORD_BYTES) / length);
+    printf("Encode (Mrecords/s) : %.1f\n", mrec / ((double)encode_ns / 1e9));
+    printf("Decode (Mrecords/s) : %.1f\n", mrec / ((double)decode_ns / 1e9));
+    printf("Truncated decoding  : OK\n");
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
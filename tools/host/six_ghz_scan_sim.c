@@ -0,0 +1,375 @@
+/*******************************************************************************
+* File Name        : six_ghz_scan_sim.c
+*
+* Description      : Host tool that simulates 6 GHz discovery. Random deployments of
+*                    2.4/5 GHz APs are generated. Some of them announce a co-located
+*                    6 GHz AP in a Reduced Neighbor Report, and a few 6 GHz-only APs sit
+*                    on PSCs. The RNR elements go through the firmware parser and 6 GHz
+*                    plan. The tool then compares a full-band sweep with a sweep whose
+*                    6 GHz part is reduced to the plan's channels. It reports sweep
+*                    time, time to discover each 6 GHz AP and missed APs. Dwell times
+*                    follow the WHD defaults: active scanning, except passive on DFS
+*                    and non-PSC 6 GHz channels that were not announced.
+*
+*                    Build: cc -O2 -I../../proj_cm33_ns six_ghz_scan_sim.c
+*                           ../../proj_cm33_ns/rnr_parser.c ../../proj_cm33_ns/six_ghz_plan.c
+*                           -o six_ghz_scan_sim
+*
+*                    Usage: six_ghz_scan_sim [colocated [standalone [legacy [trials]]]]
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rnr_parser.h"
+#include "six_ghz_plan.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ACTIVE_DWELL_MS                      (40U)
+#define PASSIVE_DWELL_MS                     (110U)
+
+#define DEFAULT_COLOCATED                    (8U)
+#define DEFAULT_STANDALONE                   (2U)
+#define DEFAULT_LEGACY                       (30U)
+#define DEFAULT_TRIALS                       (1000U)
+#define MAX_APS                              (64U)
+#define MAX_VISITS                           (128U)
+
+#define BAND_2G                              (0U)
+#define BAND_5G                              (1U)
+#define BAND_6G                              (2U)
+#define BAND_COUNT                           (3U)
+
+#define OP_CLASS_6GHZ_20MHZ                  (131U)
+#define RNR_IE_LENGTH                        (2U + 4U + 12U)
+#define NUM_6G_CHANNELS                      ((RNR_6GHZ_MAX_CHANNEL + 3U) / 4U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint8_t bssid[RNR_BSSID_LENGTH];
+    uint8_t band;
+    uint8_t channel;
+    int32_t announces;
+    uint8_t ie[RNR_IE_LENGTH];
+} sim_ap_t;
+
+typedef struct
+{
+    uint8_t band;
+    uint8_t channel;
+    bool    passive;
+} visit_t;
+
+typedef struct
+{
+    uint64_t sweep_ms;
+    uint64_t six_ghz_ms;
+    uint64_t channels_6g;
+    uint64_t discover_ms;
+    uint64_t found;
+    uint32_t max_discover_ms;
+    uint64_t missed;
+} mode_stats_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint8_t channels_2g[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+static const uint8_t channels_5g[] = { 36, 40, 44, 48, 52, 56, 60, 64, 100, 104, 108, 112,
+                                       116, 120, 124, 128, 132, 136, 140, 144, 149, 153,
+                                       157, 161, 165 };
+
+static sim_ap_t aps[MAX_APS];
+static uint32_t ap_count;
+static uint32_t rng = 0x2468ACE1U;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static uint32_t xorshift32(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+
+    return rng;
+}
+
+static bool is_dfs(uint8_t channel)
+{
+    return (channel >= 52U) && (channel <= 144U);
+}
+
+static uint8_t random_6g_channel(bool psc_only)
+{
+    if (psc_only)
+    {
+        return (uint8_t)(RNR_PSC_FIRST_CHANNEL + (RNR_PSC_SPACING * (xorshift32() % 15U)));
+    }
+
+    return (uint8_t)(1U + (4U * (xorshift32() % NUM_6G_CHANNELS)));
+}
+
+/* Builds an RNR element with one Neighbor AP Information field carrying the
+ * BSSID, short SSID and BSS parameters of the co-located AP.
+ */
+static void build_rnr(sim_ap_t *reporter, const sim_ap_t *neighbor)
+{
+    uint8_t *p = reporter->ie;
+
+    *p++ = RNR_ELEMENT_ID;
+    *p++ = RNR_IE_LENGTH - 2U;
+    *p++ = 0x00U;                            /* One TBTT Information field */
+    *p++ = 12U;                              /* BSSID, short SSID, BSS params */
+    *p++ = OP_CLASS_6GHZ_20MHZ;
+    *p++ = neighbor->channel;
+    *p++ = 0xFFU;                            /* TBTT offset unknown */
+    memcpy(p, neighbor->bssid, RNR_BSSID_LENGTH);
+    p += RNR_BSSID_LENGTH;
+    memset(p, 0x5A, 4U);
+    p += 4U;
+    *p = 0x04U;                              /* Co-located AP */
+}
+
+static void add_ap(uint8_t band, uint8_t channel)
+{
+    sim_ap_t *ap = &aps[ap_count];
+
+    memset(ap, 0, sizeof(*ap));
+    ap->bssid[0] = 0x02U;
+    ap->bssid[4] = (uint8_t)(ap_count >> 8);
+    ap->bssid[5] = (uint8_t)ap_count;
+    ap->band = band;
+    ap->channel = channel;
+    ap->announces = -1;
+    ap_count++;
+}
+
+static void build_deployment(uint32_t colocated, uint32_t standalone, uint32_t legacy)
+{
+    ap_count = 0;
+
+    for (uint32_t i = 0; i < legacy; i++)
+    {
+        if (0U != (xorshift32() & 1U))
+        {
+            add_ap(BAND_2G, channels_2g[xorshift32() % sizeof(channels_2g)]);
+        }
+        else
+        {
+            add_ap(BAND_5G, channels_5g[xorshift32() % sizeof(channels_5g)]);
+        }
+    }
+
+    /* Co-located 6 GHz APs may use any channel since they are announced. */
+    for (uint32_t i = 0; (i < colocated) && (i < legacy); i++)
+    {
+        add_ap(BAND_6G, random_6g_channel(false));
+        aps[i].announces = (int32_t)(ap_count - 1U);
+        build_rnr(&aps[i], &aps[ap_count - 1U]);
+    }
+
+    /* A 6 GHz-only AP must be discoverable without RNR, so it uses a PSC. */
+    for (uint32_t i = 0; i < standalone; i++)
+    {
+        add_ap(BAND_6G, random_6g_channel(true));
+    }
+}
+
+static uint32_t plan_visits(visit_t *visits, bool guided)
+{
+    uint32_t count = 0;
+    uint8_t channels[SIX_GHZ_PLAN_MAX_CHANNELS];
+
+    for (uint32_t i = 0; i < sizeof(channels_2g); i++)
+    {
+        visits[count++] = (visit_t){ BAND_2G, channels_2g[i], false };
+    }
+
+    for (uint32_t i = 0; i < sizeof(channels_5g); i++)
+    {
+        visits[count++] = (visit_t){ BAND_5G, channels_5g[i], is_dfs(channels_5g[i]) };
+    }
+
+    if (guided)
+    {
+        /* Announced channels may be probed actively, like the PSCs. */
+        uint32_t n = six_ghz_plan_channels(channels, SIX_GHZ_PLAN_MAX_CHANNELS);
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            visits[count++] = (visit_t){ BAND_6G, channels[i], false };
+        }
+    }
+    else
+    {
+        for (uint32_t channel = 1U; channel <= RNR_6GHZ_MAX_CHANNEL; channel += 4U)
+        {
+            visits[count++] = (visit_t){ BAND_6G, (uint8_t)channel, !rnr_is_psc((uint8_t)channel) };
+        }
+    }
+
+    return count;
+}
+
+/* Runs one sweep through the 6 GHz plan. The results of a channel are
+ * reported at the end of its dwell time.
+ */
+static void run_sweep(const visit_t *visits, uint32_t count, mode_stats_t *stats)
+{
+    uint32_t now = 0;
+    uint32_t six_ghz_start = 0;
+    bool found[MAX_APS] = { false };
+
+    six_ghz_plan_begin(true, 0U);
+
+    for (uint32_t v = 0; v < count; v++)
+    {
+        if ((BAND_6G == visits[v].band) && (0U == six_ghz_start))
+        {
+            six_ghz_start = now;
+        }
+
+        now += visits[v].passive ? PASSIVE_DWELL_MS : ACTIVE_DWELL_MS;
+
+        for (uint32_t i = 0; i < ap_count; i++)
+        {
+            if ((aps[i].band != visits[v].band) || (aps[i].channel != visits[v].channel))
+            {
+                continue;
+            }
+
+            six_ghz_plan_observe(aps[i].bssid, (BAND_6G == aps[i].band),
+                                 (aps[i].announces >= 0) ? aps[i].ie : NULL,
+                                 (aps[i].announces >= 0) ? RNR_IE_LENGTH : 0U, now);
+
+            if ((NULL != stats) && (BAND_6G == aps[i].band) && (!found[i]))
+            {
+                found[i] = true;
+                stats->found++;
+                stats->discover_ms += now;
+                stats->max_discover_ms = (now > stats->max_discover_ms) ? now : stats->max_discover_ms;
+            }
+        }
+
+        if ((NULL != stats) && (BAND_6G == visits[v].band))
+        {
+            stats->channels_6g++;
+        }
+    }
+
+    six_ghz_plan_commit(now);
+
+    if (NULL != stats)
+    {
+        stats->sweep_ms += now;
+        stats->six_ghz_ms += now - six_ghz_start;
+
+        for (uint32_t i = 0; i < ap_count; i++)
+        {
+            stats->missed += ((BAND_6G == aps[i].band) && (!found[i])) ? 1U : 0U;
+        }
+    }
+}
+
+static void print_row(const char *name, double full, double guided)
+{
+    printf("%-28s %10.1f %10.1f\n", name, full, guided);
+}
+
+int main(int argc, char **argv)
+{
+    static visit_t visits[MAX_VISITS];
+    uint32_t colocated = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : DEFAULT_COLOCATED;
+    uint32_t standalone = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : DEFAULT_STANDALONE;
+    uint32_t legacy = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 10) : DEFAULT_LEGACY;
+    uint32_t trials = (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 10) : DEFAULT_TRIALS;
+    mode_stats_t full = { 0 };
+    mode_stats_t guided = { 0 };
+
+    if ((legacy + colocated + standalone) > MAX_APS)
+    {
+        fprintf(stderr, "At most %u APs\n", (unsigned int)MAX_APS);
+        return 1;
+    }
+
+    for (uint32_t t = 0; t < trials; t++)
+    {
+        build_deployment(colocated, standalone, legacy);
+
+        /* A first full-band sweep collects the RNR elements. */
+        six_ghz_plan_init();
+        run_sweep(visits, plan_visits(visits, false), NULL);
+
+        run_sweep(visits, plan_visits(visits, false), &full);
+        run_sweep(visits, plan_visits(visits, true), &guided);
+    }
+
+    double per_trial = (double)trials;
+    double six_ghz_aps = (double)trials * (double)(((colocated < legacy) ? colocated : legacy) + standalone);
+
+    printf("Trials: %u, %u legacy APs, %u co-located and %u standalone 6 GHz APs\n",
+           (unsigned int)trials, (unsigned int)legacy, (unsigned int)colocated,
+           (unsigned int)standalone);
+    printf("Dwell: %u ms active, %u ms passive\n\n", (unsigned int)ACTIVE_DWELL_MS,
+           (unsigned int)PASSIVE_DWELL_MS);
+    printf("%-28s %10s %10s\n", "", "Full band", "RNR + PSC");
+    print_row("Sweep time (ms)", (double)full.sweep_ms / per_trial, (double)guided.sweep_ms / per_trial);
+    print_row("6 GHz part (ms)", (double)full.six_ghz_ms / per_trial, (double)guided.six_ghz_ms / per_trial);
+    print_row("6 GHz channels visited", (double)full.channels_6g / per_trial,
+              (double)guided.channels_6g / per_trial);
+    print_row("Time to discover, mean (ms)",
+              (0U != full.found) ? ((double)full.discover_ms / (double)full.found) : 0.0,
+              (0U != guided.found) ? ((double)guided.discover_ms / (double)guided.found) : 0.0);
+    print_row("Time to discover, max (ms)", (double)full.max_discover_ms, (double)guided.max_discover_ms);
+    print_row("6 GHz APs missed (%)", (100.0 * (double)full.missed) / six_ghz_aps,
+              (100.0 * (double)guided.missed) / six_ghz_aps);
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,551 @@
+/*******************************************************************************
+* File Name        : ssid_escape_bench.c
+*
+* Description      : Host benchmark and fuzzer of the SSID escaping. Checks fixed
+*                    cases and millions of random SSIDs of ASCII, UTF-8 and invalid
+*                    bytes: the word-at-a-time check against a byte-at-a-time one,
+*                    that the results contain no control characters, that terminal
+*                    and CSV results unescape to the SSID and JSON results to the SSID
+*                    with U+FFFD for invalid bytes, then measures the time per SSID.
+*                    
+*                    Build: cc -O2 -I../../proj_cm33_ns ssid_escape_bench.c
+*                           ../../proj_cm33_ns/ssid_escape.c -o ssid_escape_bench
+*                    Usage: ssid_escape_bench [iterations]
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ssid_escape.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_FUZZ_ITERATIONS                (2000000U)
+#define BENCH_SSIDS                          (1024U)
+#define BENCH_PASSES                         (2000U)
+#define BENCH_CONTEXTS                       (3U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    const char *ssid;
+    ssid_escape_context_t context;
+    const char *escaped;
+    uint32_t columns;
+} fixed_case_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const fixed_case_t fixed_cases[] =
+{
+    { "HomeNet", SSID_ESCAPE_TERMINAL, "HomeNet", 7 },
+    { "", SSID_ESCAPE_JSON, "", 0 },
+    { "a\\b", SSID_ESCAPE_TERMINAL, "a\\\\b", 4 },
+    { "\x1B[2Jevil", SSID_ESCAPE_TERMINAL, "\\x1B[2Jevil", 11 },
+    { "Caf\xC3\xA9", SSID_ESCAPE_TERMINAL, "Caf\xC3\xA9", 4 },
+    { "Cafe\xCC\x81", SSID_ESCAPE_TERMINAL, "Cafe\xCC\x81", 4 },
+    { "\xE6\x97\xA5\xE6\x9C\xAC", SSID_ESCAPE_TERMINAL, "\xE6\x97\xA5\xE6\x9C\xAC", 4 },
+    { "\xF0\x9F\x93\xB6 wifi", SSID_ESCAPE_TERMINAL, "\xF0\x9F\x93\xB6 wifi", 7 },
+    { "\xC3(", SSID_ESCAPE_TERMINAL, "\\xC3(", 5 },
+    { "\xC0\xAF", SSID_ESCAPE_TERMINAL, "\\xC0\\xAF", 8 },
+    { "\xED\xA0\x80", SSID_ESCAPE_TERMINAL, "\\xED\\xA0\\x80", 12 },
+    { "\xE2\x80\xAEtxt", SSID_ESCAPE_TERMINAL, "\\xE2\\x80\\xAEtxt", 15 },
+    { "\xC2\x9B" "1m", SSID_ESCAPE_TERMINAL, "\\xC2\\x9B1m", 10 },
+    { "say \"hi\"\n", SSID_ESCAPE_JSON, "say \\\"hi\\\"\\n", 12 },
+    { "\x01\x7F", SSID_ESCAPE_JSON, "\\u0001\\u007F", 12 },
+    { "bad\xFF", SSID_ESCAPE_JSON, "bad\\uFFFD", 9 },
+    { "a,b", SSID_ESCAPE_CSV, "\"a,b\"", 5 },
+    { "a\"b", SSID_ESCAPE_CSV, "\"a\"\"b\"", 6 },
+    { "a\tb", SSID_ESCAPE_CSV, "a\\x09b", 6 },
+};
+
+static const char *const context_names[BENCH_CONTEXTS] = { "terminal", "JSON", "CSV" };
+
+static uint8_t bench_ssids[BENCH_SSIDS][SSID_ESCAPE_MAX_SSID_LENGTH];
+static uint32_t bench_lengths[BENCH_SSIDS];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+static uint32_t rng_next(uint32_t *rng)
+{
+    *rng ^= *rng << 13;
+    *rng ^= *rng >> 17;
+    *rng ^= *rng << 5;
+
+    return *rng;
+}
+
+/* Reference UTF-8 decoder, by the minimum code point of each length. Returns
+ * the length of a valid sequence, or 0.
+ */
+static uint32_t reference_decode(const uint8_t *p, uint32_t available, uint32_t *code_point)
+{
+    static const uint32_t min_code_point[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+    uint32_t length = (p[0] < 0x80) ? 1 : (p[0] >> 5) == 6 ? 2 : (p[0] >> 4) == 14 ? 3 :
+                      (p[0] >> 3) == 30 ? 4 : 0;
+
+    if ((0 == length) || (length > available))
+    {
+        return 0;
+    }
+
+    *code_point = (1 == length) ? p[0] : (p[0] & (0x7F >> length));
+
+    for (uint32_t i = 1; i < length; i++)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+
+        *code_point = (*code_point << 6) | (p[i] & 0x3F);
+    }
+
+    if ((*code_point < min_code_point[length]) || (*code_point > 0x10FFFF) ||
+        ((*code_point >= 0xD800) && (*code_point <= 0xDFFF)))
+    {
+        return 0;
+    }
+
+    return length;
+}
+
+static bool reference_is_plain(const uint8_t *ssid, uint32_t length, ssid_escape_context_t context)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint8_t c = ssid[i];
+
+        if ((c < 0x20) || (c >= 0x7F) || (c == '\\') ||
+            ((c == '"') && (SSID_ESCAPE_TERMINAL != context)) ||
+            ((c == ',') && (SSID_ESCAPE_CSV == context)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint32_t hex_value(char c)
+{
+    return (c <= '9') ? (uint32_t)(c - '0') : (uint32_t)(c - 'A' + 10);
+}
+
+static void fail(const char *what, const uint8_t *ssid, uint32_t length,
+                 ssid_escape_context_t context, const char *escaped)
+{
+    printf("FAIL (%s, %s): ", what, context_names[context]);
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        printf("%02X", ssid[i]);
+    }
+
+    printf(" -> \"%s\"\n", escaped);
+    exit(EXIT_FAILURE);
+}
+
+/* Checks that the result is printable ASCII or valid UTF-8 without control,
+ * C1 or bidirectional formatting characters.
+ */
+static bool is_safe(const char *escaped, uint32_t length)
+{
+    const uint8_t *p = (const uint8_t *)escaped;
+
+    for (uint32_t i = 0; i < length;)
+    {
+        uint32_t cp;
+        uint32_t n = reference_decode(&p[i], length - i, &cp);
+
+        if ((0 == n) || (cp < 0x20) || ((cp >= 0x7F) && (cp <= 0x9F)) ||
+            ((cp >= 0x202A) && (cp <= 0x202E)) || ((cp >= 0x2066) && (cp <= 0x2069)))
+        {
+            return false;
+        }
+
+        i += n;
+    }
+
+    return true;
+}
+
+/* Undoes the terminal escapes. Returns the length, or UINT32_MAX if an escape
+ * is malformed.
+ */
+static uint32_t unescape_terminal(const char *in, uint32_t length, uint8_t *out)
+{
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if ('\\' != in[i])
+        {
+            out[n++] = (uint8_t)in[i];
+        }
+        else if (((i + 1) < length) && ('\\' == in[i + 1]))
+        {
+            out[n++] = '\\';
+            i++;
+        }
+        else if (((i + 3) < length) && ('x' == in[i + 1]))
+        {
+            out[n++] = (uint8_t)((hex_value(in[i + 2]) << 4) | hex_value(in[i + 3]));
+            i += 3;
+        }
+        else
+        {
+            return UINT32_MAX;
+        }
+    }
+
+    return n;
+}
+
+/* Writes the code point as UTF-8 and returns its length. */
+static uint32_t put_utf8(uint32_t cp, uint8_t *out)
+{
+    if (cp < 0x80)
+    {
+        out[0] = (uint8_t)cp;
+        return 1;
+    }
+
+    if (cp < 0x800)
+    {
+        out[0] = (uint8_t)(0xC0 | (cp >> 6));
+        out[1] = (uint8_t)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+
+    out[0] = (uint8_t)(0xE0 | (cp >> 12));
+    out[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = (uint8_t)(0x80 | (cp & 0x3F));
+    return 3;
+}
+
+/* Decodes the content of a JSON string. Returns the length, or UINT32_MAX if
+ * it is not valid JSON.
+ */
+static uint32_t unescape_json(const char *in, uint32_t length, uint8_t *out)
+{
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        const char *shorts = strchr("\"\\/bfnrt", (i + 1 < length) ? in[i + 1] : 'x');
+
+        if ('"' == in[i])
+        {
+            return UINT32_MAX;
+        }
+
+        if ('\\' != in[i])
+        {
+            out[n++] = (uint8_t)in[i];
+        }
+        else if ((NULL != shorts) && ('\0' != *shorts))
+        {
+            out[n++] = (uint8_t)"\"\\/\b\f\n\r\t"[shorts - "\"\\/bfnrt"];
+            i++;
+        }
+        else if (((i + 5) < length) && ('u' == in[i + 1]))
+        {
+            uint32_t cp = 0;
+
+            for (uint32_t k = 2; k < 6; k++)
+            {
+                cp = (cp << 4) | hex_value(in[i + k]);
+            }
+
+            n += put_utf8(cp, &out[n]);
+            i += 5;
+        }
+        else
+        {
+            return UINT32_MAX;
+        }
+    }
+
+    return n;
+}
+
+/* Expected JSON content: the SSID with U+FFFD for every invalid byte. */
+static uint32_t replace_invalid(const uint8_t *ssid, uint32_t length, uint8_t *out)
+{
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < length;)
+    {
+        uint32_t cp;
+        uint32_t size = reference_decode(&ssid[i], length - i, &cp);
+
+        if (0 == size)
+        {
+            n += put_utf8(0xFFFD, &out[n]);
+            i++;
+        }
+        else
+        {
+            memcpy(&out[n], &ssid[i], size);
+            n += size;
+            i += size;
+        }
+    }
+
+    return n;
+}
+
+static void check(const uint8_t *ssid, uint32_t length, ssid_escape_context_t context)
+{
+    char escaped[SSID_ESCAPE_BUFFER_SIZE + 16];
+    uint8_t decoded[4 * SSID_ESCAPE_BUFFER_SIZE];
+    uint8_t expected[4 * SSID_ESCAPE_BUFFER_SIZE];
+    uint32_t columns;
+    uint32_t n;
+
+    memset(escaped, 0x5A, sizeof(escaped));
+    n = ssid_escape(ssid, length, context, escaped, &columns);
+
+    if ((n >= SSID_ESCAPE_BUFFER_SIZE) || ('\0' != escaped[n]) || (strlen(escaped) != n))
+    {
+        fail("length", ssid, length, context, escaped);
+    }
+
+    if (ssid_escape_is_plain(ssid, length, context) != reference_is_plain(ssid, length, context))
+    {
+        fail("plain check", ssid, length, context, escaped);
+    }
+
+    if (!is_safe(escaped, n) || (columns > n) ||
+        (reference_is_plain(ssid, length, context) && (columns != length)))
+    {
+        fail("safety", ssid, length, context, escaped);
+    }
+
+    if (SSID_ESCAPE_JSON == context)
+    {
+        uint32_t size = unescape_json(escaped, n, decoded);
+
+        if ((replace_invalid(ssid, length, expected) != size) ||
+            (0 != memcmp(decoded, expected, size)))
+        {
+            fail("JSON round trip", ssid, length, context, escaped);
+        }
+
+        return;
+    }
+
+    if (SSID_ESCAPE_CSV == context)
+    {
+        bool needs_quotes = (NULL != memchr(ssid, ',', length)) ||
+                            (NULL != memchr(ssid, '"', length));
+        uint32_t k = 0;
+
+        if (needs_quotes != ((n >= 2) && ('"' == escaped[0]) && ('"' == escaped[n - 1])))
+        {
+            fail("CSV quoting", ssid, length, context, escaped);
+        }
+
+        /* Undoes the quoting into 'expected' and leaves the terminal escapes. */
+        for (uint32_t i = needs_quotes ? 1 : 0; i < (needs_quotes ? (n - 1) : n); i++)
+        {
+            if ('"' == escaped[i])
+            {
+                if (!needs_quotes || ('"' != escaped[i + 1]))
+                {
+                    fail("CSV quote", ssid, length, context, escaped);
+                }
+
+                i++;
+            }
+
+            expected[k++] = (uint8_t)escaped[i];
+        }
+
+        memcpy(escaped, expected, k);
+        n = k;
+    }
+
+    if ((unescape_terminal(escaped, n, decoded) != length) || (0 != memcmp(decoded, ssid, length)))
+    {
+        fail("round trip", ssid, length, context, escaped);
+    }
+}
+
+/* Random SSID of ASCII, of valid multi-byte sequences or of random bytes. */
+static uint32_t random_ssid(uint32_t *rng, uint8_t *ssid)
+{
+    static const char *const pieces[] =
+    {
+        "\xC3\xA9", "\xE6\x97\xA5", "\xF0\x9F\x93\xB6", "\xCC\x81", "\xE2\x80\xAE",
+        "\xC2\x85", "\xEF\xBC\xA1", "\xF4\x8F\xBF\xBF", "\\", "\"", ",", "\x1B", "\n"
+    };
+    uint32_t length = rng_next(rng) % (SSID_ESCAPE_MAX_SSID_LENGTH + 1);
+    uint32_t style = rng_next(rng) % 4;
+    uint32_t n = 0;
+
+    while (n < length)
+    {
+        uint32_t r = rng_next(rng);
+
+        if ((0 == style) || ((r & 7) < 5))
+        {
+            ssid[n++] = (uint8_t)(0x20 + ((r >> 8) % 0x5F));
+        }
+        else if (1 == style)
+        {
+            ssid[n++] = (uint8_t)(r >> 8);
+        }
+        else
+        {
+            const char *piece = pieces[(r >> 8) % (sizeof(pieces) / sizeof(pieces[0]))];
+            uint32_t size = (uint32_t)strlen(piece);
+
+            /* Sometimes cut the piece short, at the end of the SSID too. */
+            size = ((3 == style) && ((r >> 20) & 1)) ? (size + 1) / 2 : size;
+            size = (size > (length - n)) ? (length - n) : size;
+            memcpy(&ssid[n], piece, size);
+            n += size;
+        }
+    }
+
+    return length;
+}
+
+static double bench(ssid_escape_context_t context)
+{
+    char escaped[SSID_ESCAPE_BUFFER_SIZE];
+    uint32_t columns;
+    uint64_t total = 0;
+    uint64_t ns = 0;
+
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        uint32_t start = perf_counter_now();
+
+        for (uint32_t i = 0; i < BENCH_SSIDS; i++)
+        {
+            total += ssid_escape(bench_ssids[i], bench_lengths[i], context, escaped, &columns);
+        }
+
+        ns += perf_counter_to_ns(perf_counter_now() - start);
+    }
+
+    if (0 == total)
+    {
+        printf("\n");
+    }
+
+    return (double)ns / ((double)BENCH_PASSES * BENCH_SSIDS);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_FUZZ_ITERATIONS;
+    uint32_t rng = 0x9E3779B9U;
+    uint8_t ssid[SSID_ESCAPE_MAX_SSID_LENGTH];
+
+    for (uint32_t i = 0; i < (sizeof(fixed_cases) / sizeof(fixed_cases[0])); i++)
+    {
+        const fixed_case_t *c = &fixed_cases[i];
+        char escaped[SSID_ESCAPE_BUFFER_SIZE];
+        uint32_t columns;
+
+        ssid_escape((const uint8_t *)c->ssid, (uint32_t)strlen(c->ssid), c->context, escaped,
+                    &columns);
+
+        if ((0 != strcmp(escaped, c->escaped)) || (columns != c->columns))
+        {
+            printf("FAIL (case %u): \"%s\", %u columns\n", (unsigned int)i, escaped,
+                   (unsigned int)columns);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        uint32_t length = random_ssid(&rng, ssid);
+
+        for (uint32_t context = 0; context < BENCH_CONTEXTS; context++)
+        {
+            check(ssid, length, (ssid_escape_context_t)context);
+        }
+    }
+
+    printf("Fixed cases         : %u OK\n",
+           (unsigned int)(sizeof(fixed_cases) / sizeof(fixed_cases[0])));
+    printf("Fuzzed SSIDs        : %u OK\n", (unsigned int)iterations);
+
+    /* Typical SSIDs: printable ASCII of 4 to 20 characters. */
+    for (uint32_t i = 0; i < BENCH_SSIDS; i++)
+    {
+        bench_lengths[i] = 4 + (rng_next(&rng) % 17);
+
+        for (uint32_t k = 0; k < bench_lengths[i]; k++)
+        {
+            bench_ssids[i][k] = (uint8_t)('A' + (rng_next(&rng) % 26));
+        }
+    }
+
+    for (uint32_t context = 0; context < BENCH_CONTEXTS; context++)
+    {
+        printf("ASCII, %-8s (ns) : %.1f\n", context_names[context],
+               bench((ssid_escape_context_t)context));
+    }
+
+    for (uint32_t i = 0; i < BENCH_SSIDS; i++)
+    {
+        bench_lengths[i] = random_ssid(&rng, bench_ssids[i]);
+    }
+
+    printf("Mixed, terminal (ns) : %.1f\n", bench(SSID_ESCAPE_TERMINAL));
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,412 @@
+/*******************************************************************************
+* File Name        : uplink_bench.c
+*
+* Description      : Host benchmark of the TLS uplink against a local TLS server
+*                    in a thread. Publishes batches with the connection lost
+*                    every few batches, with and without connection reuse and
+*                    session resumption, checks that the server received every
+*                    byte and compares the handshakes and the time per batch.
+*                    Also checks that a session kept in storage resumes the
+*                    first connection after a reset. The TLS functions of
+*                    uplink.c are those of OpenSSL here; its mbedTLS functions
+*                    are built for the device only.
+*
+*                    Build: cc -O2 -std=gnu11 -pthread -I../../proj_cm33_ns uplink_bench.c
+*                           ../../proj_cm33_ns/uplink.c -lssl -lcrypto -o uplink_bench
+*
+* Related Document : See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include "uplink.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_BATCHES                        (200U)
+#define BENCH_BATCH_SIZE                     (4096U)
+#define BENCH_BATCHES_PER_LOSS               (10U)
+#define BENCH_SERVER_NAME                    "localhost"
+#define BENCH_POLL_MS                        (5)
+#define BENCH_WAIT_MS                        (5000U)
+
+#define CHECK(condition, message) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            printf("FAIL: %s\n", (message)); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static SSL_CTX *server_context;
+static int server_socket;
+static uint16_t server_port;
+static char server_ca[4096];
+
+/* The main thread asks the server to drop its connection, as a lost link
+ * would, and waits until it is gone.
+ */
+static atomic_bool server_stop;
+static atomic_bool server_drop;
+static atomic_ulong server_bytes;
+static atomic_uint server_connections;
+
+static uint8_t stored_session[UPLINK_SESSION_MAX_SIZE];
+static uint32_t stored_length;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/* Creates a self-signed certificate for BENCH_SERVER_NAME, and the server
+ * context with a session cache and session tickets.
+ */
+static int server_setup(void)
+{
+    EVP_PKEY *key = EVP_PKEY_Q_keygen(NULL, NULL, "EC", "P-256");
+    X509 *cert = X509_new();
+    X509_NAME *name = X509_get_subject_name(cert);
+    BIO *bio = BIO_new(BIO_s_mem());
+    static const unsigned char context_id[] = "uplink_bench";
+
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               (const unsigned char *)BENCH_SERVER_NAME, -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_set_pubkey(cert, key);
+    X509_sign(cert, key, EVP_sha256());
+
+    PEM_write_bio_X509(bio, cert);
+    int length = BIO_read(bio, server_ca, sizeof(server_ca) - 1);
+    server_ca[(length > 0) ? length : 0] = '\0';
+
+    server_context = SSL_CTX_new(TLS_server_method());
+
+    int ok = (NULL != server_context) && (length > 0) &&
+             (1 == SSL_CTX_set_max_proto_version(server_context, TLS1_2_VERSION)) &&
+             (1 == SSL_CTX_use_certificate(server_context, cert)) &&
+             (1 == SSL_CTX_use_PrivateKey(server_context, key)) &&
+             (1 == SSL_CTX_set_session_id_context(server_context, context_id,
+                                                  sizeof(context_id)));
+
+    BIO_free(bio);
+    X509_free(cert);
+    EVP_PKEY_free(key);
+
+    struct sockaddr_in address;
+    socklen_t address_length = sizeof(address);
+    int enable = 1;
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    server_socket = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    ok = ok && (0 == bind(server_socket, (struct sockaddr *)&address, sizeof(address))) &&
+         (0 == listen(server_socket, 4)) &&
+         (0 == getsockname(server_socket, (struct sockaddr *)&address, &address_length));
+    server_port = ntohs(address.sin_port);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* Serves one connection until the client closes it or a drop is asked. */
+static void serve(int client)
+{
+    SSL *ssl = SSL_new(server_context);
+    uint8_t buffer[16384];
+
+    SSL_set_fd(ssl, client);
+
+    if (1 == SSL_accept(ssl))
+    {
+        atomic_fetch_add(&server_connections, 1U);
+
+        for (;;)
+        {
+            struct pollfd fd = { client, POLLIN, 0 };
+
+            if (atomic_load(&server_drop) || atomic_load(&server_stop))
+            {
+                break;
+            }
+
+            if ((SSL_pending(ssl) <= 0) && (poll(&fd, 1, BENCH_POLL_MS) <= 0))
+            {
+                continue;
+            }
+
+            int received = SSL_read(ssl, buffer, sizeof(buffer));
+
+            if (received <= 0)
+            {
+                break;
+            }
+
+            atomic_fetch_add(&server_bytes, (unsigned long)received);
+        }
+    }
+
+    /* A dropped connection ends without close_notify. */
+    SSL_free(ssl);
+    close(client);
+    ERR_clear_error();
+}
+
+static void *server_thread(void *arg)
+{
+    (void)arg;
+
+    while (!atomic_load(&server_stop))
+    {
+        struct pollfd fd = { server_socket, POLLIN, 0 };
+
+        if (atomic_load(&server_drop))
+        {
+            atomic_store(&server_drop, false);
+        }
+
+        if (poll(&fd, 1, BENCH_POLL_MS) > 0)
+        {
+            int client = accept(server_socket, NULL, NULL);
+
+            if (client >= 0)
+            {
+                serve(client);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void drop_connection(void)
+{
+    atomic_store(&server_drop, true);
+
+    while (atomic_load(&server_drop))
+    {
+        usleep(1000);
+    }
+}
+
+/* Waits until the server has received the given number of bytes. */
+static int wait_bytes(unsigned long expected)
+{
+    for (uint32_t waited = 0; waited < BENCH_WAIT_MS; waited++)
+    {
+        if (atomic_load(&server_bytes) >= expected)
+        {
+            break;
+        }
+
+        usleep(1000);
+    }
+
+    return (atomic_load(&server_bytes) == expected) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static uint32_t storage_load(uint8_t *session, uint32_t size)
+{
+    if (stored_length > size)
+    {
+        return 0U;
+    }
+
+    memcpy(session, stored_session, stored_length);
+
+    return stored_length;
+}
+
+static bool storage_store(const uint8_t *session, uint32_t length)
+{
+    memcpy(stored_session, session, length);
+    stored_length = length;
+
+    return true;
+}
+
+static const uplink_session_storage_t storage = { storage_load, storage_store };
+
+/* Publishes BENCH_BATCHES batches, losing the connection every
+ * BENCH_BATCHES_PER_LOSS batches, and returns the counters.
+ */
+static int run(const char *label, bool reuse, bool resume, uplink_stats_t *stats)
+{
+    static uint8_t batch[BENCH_BATCH_SIZE];
+    uplink_config_t config =
+    {
+        "127.0.0.1", server_port, BENCH_SERVER_NAME, server_ca, reuse, resume, NULL
+    };
+
+    for (uint32_t i = 0; i < sizeof(batch); i++)
+    {
+        batch[i] = (uint8_t)(i * 7U);
+    }
+
+    atomic_store(&server_bytes, 0UL);
+    CHECK(uplink_init(&config), "uplink configuration");
+
+    for (uint32_t i = 0; i < BENCH_BATCHES; i++)
+    {
+        /* The link is lost between batches, once the server has them. */
+        if ((0U != i) && (0U == (i % BENCH_BATCHES_PER_LOSS)))
+        {
+            CHECK(EXIT_SUCCESS == wait_bytes((unsigned long)i * BENCH_BATCH_SIZE),
+                  "bytes received by the server");
+            drop_connection();
+        }
+
+        CHECK(uplink_publish(batch, sizeof(batch), i), "publish");
+    }
+
+    uplink_close();
+    uplink_stats(stats);
+    CHECK(EXIT_SUCCESS == wait_bytes((unsigned long)BENCH_BATCHES * BENCH_BATCH_SIZE),
+          "bytes received by the server");
+
+    uint32_t handshakes = stats->full_handshakes + stats->resumed_handshakes;
+
+    printf("%-26s %5u %5u %5u %11.1f %11.1f %11.1f %11.1f\n", label, stats->reused,
+           stats->full_handshakes, stats->resumed_handshakes,
+           (0U != stats->full_handshakes) ?
+           (stats->full_handshake_ns / 1000.0) / stats->full_handshakes : 0.0,
+           (0U != stats->resumed_handshakes) ?
+           (stats->resumed_handshake_ns / 1000.0) / stats->resumed_handshakes : 0.0,
+           ((stats->full_handshake_ns + stats->resumed_handshake_ns) / 1000.0) / BENCH_BATCHES,
+           (stats->publish_ns / 1000.0) / BENCH_BATCHES);
+
+    CHECK(handshakes == stats->connects, "handshake count");
+
+    return EXIT_SUCCESS;
+}
+
+int main(void)
+{
+    uplink_stats_t plain;
+    uplink_stats_t resumed;
+    uplink_stats_t kept;
+    uplink_stats_t best;
+    pthread_t thread;
+    uint32_t losses = (BENCH_BATCHES - 1U) / BENCH_BATCHES_PER_LOSS;
+
+    signal(SIGPIPE, SIG_IGN);
+    CHECK(EXIT_SUCCESS == server_setup(), "server setup");
+    CHECK(0 == pthread_create(&thread, NULL, server_thread, NULL), "server thread");
+
+    printf("%u batches of %u bytes, connection lost every %u batches\n\n", BENCH_BATCHES,
+           BENCH_BATCH_SIZE, BENCH_BATCHES_PER_LOSS);
+    printf("%-26s %5s %5s %5s %11s %11s %11s %11s\n", "", "Kept", "Full", "Resum",
+           "Full us", "Resumed us", "HS us/batch", "us/batch");
+
+    if ((EXIT_SUCCESS != run("New connection per batch", false, false, &plain)) ||
+        (EXIT_SUCCESS != run("  with resumption", false, true, &resumed)) ||
+        (EXIT_SUCCESS != run("Kept connection", true, false, &kept)) ||
+        (EXIT_SUCCESS != run("  with resumption", true, true, &best)))
+    {
+        return EXIT_FAILURE;
+    }
+
+    CHECK((BENCH_BATCHES == plain.full_handshakes) && (0U == plain.resumed_handshakes),
+          "full handshake per batch");
+    CHECK((1U == resumed.full_handshakes) && ((BENCH_BATCHES - 1U) == resumed.resumed_handshakes),
+          "resumed handshake per batch");
+    CHECK(((losses + 1U) == kept.full_handshakes) && (losses == kept.lost),
+          "full handshake per lost connection");
+    CHECK((1U == best.full_handshakes) && (losses == best.resumed_handshakes) &&
+          ((BENCH_BATCHES - losses - 1U) == best.reused), "resumed handshake per lost connection");
+
+    /* A session in storage resumes the first connection after a reset. */
+    uplink_config_t config =
+    {
+        "127.0.0.1", server_port, BENCH_SERVER_NAME, server_ca, true, true, &storage
+    };
+    uplink_stats_t stats;
+    static const uint8_t batch[64] = { 0 };
+
+    atomic_store(&server_bytes, 0UL);
+    CHECK(uplink_init(&config) && uplink_publish(batch, sizeof(batch), 0U), "stored session");
+    uplink_stats(&stats);
+    CHECK((1U == stats.full_handshakes) && (1U == stats.sessions_stored), "session stored");
+
+    CHECK(uplink_init(&config) && uplink_publish(batch, sizeof(batch), 0U), "stored session");
+    uplink_stats(&stats);
+    CHECK((1U == stats.sessions_loaded) && (1U == stats.resumed_handshakes) &&
+          (0U == stats.sessions_stored), "session resumed after a reset");
+
+    uplink_poll(UPLINK_IDLE_S);
+    CHECK(!uplink_connected(), "idle connection closed");
+    CHECK(EXIT_SUCCESS == wait_bytes(2U * sizeof(batch)), "bytes received by the server");
+
+    printf("\nSession storage        : OK\n");
+    printf("Handshake time per batch: %.1fx less than a new connection per batch\n",
+           (double)(plain.full_handshake_ns + plain.resumed_handshake_ns) /
+           (double)(best.full_handshake_ns + best.resumed_handshake_ns));
+
+    atomic_store(&server_stop, true);
+    pthread_join(thread, NULL);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */